@@ -0,0 +1,359 @@
+// code/adapters/CompiledCity.cpp
+#include "CompiledCity.h"
+#include "../core/City.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GRIDLOCK_HAVE_MMAP 1
+#endif
+
+namespace {
+    constexpr char kMagic[8] = {'G', 'L', 'C', 'I', 'T', 'Y', '\0', '\0'};
+    constexpr std::uint32_t kEndianTag = 0x01020304u;
+    constexpr std::size_t kAlignment = 8;
+
+    enum SectionId : std::uint32_t {
+        NODE_ID = 1,
+        NODE_ROW = 2,
+        NODE_COL = 3,
+        EDGE_ID = 10,
+        EDGE_FROM = 11,
+        EDGE_TO = 12,
+        EDGE_LENGTH = 13,
+        EDGE_CAPACITY = 14,
+        EDGE_BLOCKED_BITS = 15,
+        ADJACENCY_OFFSETS = 20,
+        ADJACENCY_EDGES = 21
+    };
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianTag;
+        std::uint64_t fingerprint;
+        std::int32_t nodeCount;
+        std::int32_t edgeCount;
+        std::int32_t adjacencySlots;
+        std::uint32_t sectionCount;
+        std::uint8_t reserved[24];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Compiled city header must stay 64 bytes");
+
+    struct SectionEntry {
+        std::uint32_t id;
+        std::uint32_t elementSize;
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+    static_assert(sizeof(SectionEntry) == 24, "Section entry must stay 24 bytes");
+
+    std::size_t alignUp(std::size_t value) {
+        return (value + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+    struct PendingSection {
+        SectionEntry entry;
+        const void* bytes;
+    };
+
+    template <typename T>
+    PendingSection section(std::uint32_t id, const std::vector<T>& values) {
+        return {{id, static_cast<std::uint32_t>(sizeof(T)), 0, static_cast<std::uint64_t>(values.size())},
+                values.data()};
+    }
+}
+
+std::vector<std::uint8_t> CompiledCity::encode(const CityTopology& topology, const std::vector<Blob>& blobs) {
+    const auto& nodes = topology.getNodes();
+    const auto& edges = topology.getEdges();
+
+    std::vector<std::int32_t> nodeIds, nodeRows, nodeCols;
+    nodeIds.reserve(nodes.size());
+    nodeRows.reserve(nodes.size());
+    nodeCols.reserve(nodes.size());
+    for (const Node& node : nodes) {
+        nodeIds.push_back(node.getId());
+        nodeRows.push_back(node.getRow());
+        nodeCols.push_back(node.getCol());
+    }
+
+    std::vector<std::int32_t> edgeIds, edgeFrom, edgeTo, edgeCapacities;
+    std::vector<double> edgeLengths;
+    std::vector<std::uint64_t> blocked((edges.size() + 63) / 64, 0);
+    edgeIds.reserve(edges.size());
+    edgeFrom.reserve(edges.size());
+    edgeTo.reserve(edges.size());
+    edgeLengths.reserve(edges.size());
+    edgeCapacities.reserve(edges.size());
+    int adjacencySlots = 0;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const Edge& edge = edges[i];
+        edgeIds.push_back(edge.getId());
+        edgeFrom.push_back(edge.getFrom());
+        edgeTo.push_back(edge.getTo());
+        edgeLengths.push_back(edge.getLength());
+        edgeCapacities.push_back(edge.getCapacity());
+        if (edge.isBlocked()) {
+            blocked[i >> 6] |= std::uint64_t{1} << (i & 63);
+        }
+        adjacencySlots = std::max(adjacencySlots, edge.getFrom() + 1);
+    }
+    for (const Node& node : nodes) {
+        adjacencySlots = std::max(adjacencySlots, node.getId() + 1);
+    }
+
+    // CSR over NodeId slots, preserving per-node insertion order
+    std::vector<std::uint32_t> adjacencyOffsets(static_cast<size_t>(adjacencySlots) + 1, 0);
+    std::vector<std::int32_t> adjacencyEdges;
+    adjacencyEdges.reserve(edges.size());
+    for (int id = 0; id < adjacencySlots; ++id) {
+        const auto& outgoing = topology.outgoing(id);
+        adjacencyEdges.insert(adjacencyEdges.end(), outgoing.begin(), outgoing.end());
+        adjacencyOffsets[static_cast<size_t>(id) + 1] = static_cast<std::uint32_t>(adjacencyEdges.size());
+    }
+
+    std::vector<PendingSection> sections = {
+        section(NODE_ID, nodeIds),
+        section(NODE_ROW, nodeRows),
+        section(NODE_COL, nodeCols),
+        section(EDGE_ID, edgeIds),
+        section(EDGE_FROM, edgeFrom),
+        section(EDGE_TO, edgeTo),
+        section(EDGE_LENGTH, edgeLengths),
+        section(EDGE_CAPACITY, edgeCapacities),
+        section(EDGE_BLOCKED_BITS, blocked),
+        section(ADJACENCY_OFFSETS, adjacencyOffsets),
+        section(ADJACENCY_EDGES, adjacencyEdges)
+    };
+    for (const Blob& blob : blobs) {
+        if (blob.id < kFirstBlobId) {
+            throw std::runtime_error("Compiled city blob id is reserved: " + std::to_string(blob.id));
+        }
+        sections.push_back(section(blob.id, blob.bytes));
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.endianTag = kEndianTag;
+    header.fingerprint = topology.fingerprint();
+    header.nodeCount = topology.getNodeCount();
+    header.edgeCount = topology.getEdgeCount();
+    header.adjacencySlots = adjacencySlots;
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+
+    std::size_t offset = alignUp(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry));
+    for (auto& pending : sections) {
+        pending.entry.offset = offset;
+        offset = alignUp(offset + pending.entry.count * pending.entry.elementSize);
+    }
+
+    std::vector<std::uint8_t> out(offset, 0);
+    std::memcpy(out.data(), &header, sizeof(header));
+    std::size_t dirPos = sizeof(FileHeader);
+    for (const auto& pending : sections) {
+        std::memcpy(out.data() + dirPos, &pending.entry, sizeof(SectionEntry));
+        dirPos += sizeof(SectionEntry);
+        std::size_t bytes = pending.entry.count * pending.entry.elementSize;
+        if (bytes > 0) {
+            std::memcpy(out.data() + pending.entry.offset, pending.bytes, bytes);
+        }
+    }
+    return out;
+}
+
+void CompiledCity::writeFile(const std::string& path, const CityTopology& topology,
+                             const std::vector<Blob>& blobs) {
+    std::vector<std::uint8_t> bytes = encode(topology, blobs);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open compiled city for writing: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write compiled city: " + path);
+    }
+}
+
+CompiledCity::CompiledCity(const std::string& path) {
+#ifdef GRIDLOCK_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open compiled city: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Compiled city is empty: " + path);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Could not map compiled city: " + path);
+    }
+    mapping = mapped;
+    data = static_cast<const std::uint8_t*>(mapped);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open compiled city: " + path);
+    }
+    ownedBytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data = ownedBytes.data();
+    size = ownedBytes.size();
+#endif
+    try {
+        bind();
+    } catch (...) {
+#ifdef GRIDLOCK_HAVE_MMAP
+        ::munmap(mapping, size);
+#endif
+        throw;
+    }
+}
+
+CompiledCity::CompiledCity(const std::uint8_t* bytes, std::size_t length)
+    : ownedBytes(bytes, bytes + length) {
+    data = ownedBytes.data();
+    size = ownedBytes.size();
+    bind();
+}
+
+CompiledCity::~CompiledCity() {
+#ifdef GRIDLOCK_HAVE_MMAP
+    if (mapping) {
+        ::munmap(mapping, size);
+    }
+#endif
+}
+
+void CompiledCity::bind() {
+    if (!data || size < sizeof(FileHeader)) {
+        throw std::runtime_error("Compiled city is truncated");
+    }
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a compiled city file");
+    }
+    if (header.endianTag != kEndianTag) {
+        throw std::runtime_error("Compiled city was written with a different byte order");
+    }
+    if (header.version != kFormatVersion) {
+        throw std::runtime_error("Unsupported compiled city version: " + std::to_string(header.version));
+    }
+    if (header.nodeCount < 0 || header.edgeCount < 0 || header.adjacencySlots < 0) {
+        throw std::runtime_error("Compiled city has negative counts");
+    }
+    std::size_t dirEnd = sizeof(FileHeader) + static_cast<std::size_t>(header.sectionCount) * sizeof(SectionEntry);
+    if (dirEnd > size) {
+        throw std::runtime_error("Compiled city directory is truncated");
+    }
+    nodeCount = header.nodeCount;
+    edgeCount = header.edgeCount;
+    adjacencySlots = header.adjacencySlots;
+    fingerprint = header.fingerprint;
+
+    std::vector<SectionEntry> entries(header.sectionCount);
+    if (!entries.empty()) {
+        std::memcpy(entries.data(), data + sizeof(FileHeader), entries.size() * sizeof(SectionEntry));
+    }
+    for (const auto& entry : entries) {
+        if (entry.elementSize == 0 || entry.offset % kAlignment != 0 || entry.offset > size ||
+            entry.count > (size - entry.offset) / entry.elementSize) {
+            throw std::runtime_error("Compiled city section " + std::to_string(entry.id) + " is out of bounds");
+        }
+        if (entry.id >= kFirstBlobId) {
+            blobs.push_back({entry.id, entry.offset, entry.count * entry.elementSize});
+        }
+    }
+
+    // Points a column at its section after checking width and length
+    auto column = [&](std::uint32_t id, std::size_t elementSize, std::size_t expectedCount) -> const void* {
+        for (const auto& entry : entries) {
+            if (entry.id != id) continue;
+            if (entry.elementSize != elementSize || entry.count != expectedCount) {
+                throw std::runtime_error("Compiled city section " + std::to_string(id) + " has wrong shape");
+            }
+            return data + entry.offset;
+        }
+        throw std::runtime_error("Compiled city section missing: " + std::to_string(id));
+    };
+
+    const auto nodes = static_cast<std::size_t>(nodeCount);
+    const auto edges = static_cast<std::size_t>(edgeCount);
+    nodeIdColumn = static_cast<const std::int32_t*>(column(NODE_ID, 4, nodes));
+    nodeRowColumn = static_cast<const std::int32_t*>(column(NODE_ROW, 4, nodes));
+    nodeColColumn = static_cast<const std::int32_t*>(column(NODE_COL, 4, nodes));
+    edgeIdColumn = static_cast<const std::int32_t*>(column(EDGE_ID, 4, edges));
+    edgeFromColumn = static_cast<const std::int32_t*>(column(EDGE_FROM, 4, edges));
+    edgeToColumn = static_cast<const std::int32_t*>(column(EDGE_TO, 4, edges));
+    edgeLengthColumn = static_cast<const double*>(column(EDGE_LENGTH, 8, edges));
+    edgeCapacityColumn = static_cast<const std::int32_t*>(column(EDGE_CAPACITY, 4, edges));
+    blockedWords = static_cast<const std::uint64_t*>(column(EDGE_BLOCKED_BITS, 8, (edges + 63) / 64));
+    adjacencyOffsetColumn = static_cast<const std::uint32_t*>(
+        column(ADJACENCY_OFFSETS, 4, static_cast<std::size_t>(adjacencySlots) + 1));
+    adjacencyEdgeColumn = static_cast<const std::int32_t*>(column(ADJACENCY_EDGES, 4, edges));
+
+    // Readers index the CSR arrays directly, so the offsets must be sane
+    if (adjacencyOffsetColumn[0] != 0 || adjacencyOffsetColumn[adjacencySlots] != edges) {
+        throw std::runtime_error("Compiled city adjacency does not match edge count");
+    }
+    for (int i = 0; i < adjacencySlots; ++i) {
+        if (adjacencyOffsetColumn[i + 1] < adjacencyOffsetColumn[i]) {
+            throw std::runtime_error("Compiled city adjacency offsets are not monotonic");
+        }
+    }
+}
+
+const std::uint8_t* CompiledCity::findBlob(std::uint32_t id, std::size_t& blobSize) const {
+    for (const auto& blob : blobs) {
+        if (blob.id == id) {
+            blobSize = static_cast<std::size_t>(blob.size);
+            return data + blob.offset;
+        }
+    }
+    blobSize = 0;
+    return nullptr;
+}
+
+std::shared_ptr<const CityTopology> CompiledCity::createTopology() const {
+    std::vector<Node> nodes;
+    nodes.reserve(static_cast<size_t>(nodeCount));
+    for (int i = 0; i < nodeCount; ++i) {
+        nodes.emplace_back(nodeIdColumn[i], nodeRowColumn[i], nodeColColumn[i]);
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(static_cast<size_t>(edgeCount));
+    for (int i = 0; i < edgeCount; ++i) {
+        edges.emplace_back(edgeIdColumn[i], edgeFromColumn[i], edgeToColumn[i],
+                           edgeLengthColumn[i], edgeCapacityColumn[i]);
+        if (isEdgeBlocked(i)) {
+            edges.back().setBlocked(true);
+        }
+    }
+
+    auto topology = std::make_shared<const CityTopology>(
+        std::move(nodes), std::move(edges),
+        std::span<const std::uint32_t>(adjacencyOffsetColumn, static_cast<size_t>(adjacencySlots) + 1),
+        std::span<const std::int32_t>(adjacencyEdgeColumn, static_cast<size_t>(edgeCount)));
+    // A file edited or truncated after it was written no longer hashes to its header
+    if (topology->fingerprint() != fingerprint) {
+        throw std::runtime_error("Compiled city does not match its fingerprint");
+    }
+    return topology;
+}
+
+std::unique_ptr<City> CompiledCity::createCity() const {
+    return std::make_unique<City>(createTopology());
+}
@@ -0,0 +1,156 @@
+// code/adapters/CompiledCity.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../core/CityTopology.h"
+
+class City;
+
+/**
+ * CompiledCity - Binary, memory-mappable road network ("GLCITY" files).
+ *
+ * Layout (little-endian, all sections 8-byte aligned, same header/section
+ * directory scheme as SnapshotSerializer):
+ *   - 64-byte header: magic "GLCITY", format version, endian tag, topology
+ *     fingerprint, node/edge/adjacency-slot counts
+ *   - section directory: {id, element size, offset, element count}
+ *   - node columns: id, row, col
+ *   - edge columns in insertion order: id, from, to, length, capacity,
+ *     blocked bitset
+ *   - CSR adjacency: offsets per NodeId slot plus outgoing edge ids
+ *   - optional blobs (routing preprocessing etc.) under caller-chosen ids
+ *
+ * Opening a file maps it read-only; the column accessors point straight
+ * into the mapping, so nothing is parsed. createTopology() turns the columns
+ * and the stored CSR adjacency into a CityTopology in linear passes and
+ * checks the result against the header fingerprint. Presets name their
+ * compiled city through Preset::setCompiledCity (see PresetLoader).
+ */
+class CompiledCity {
+public:
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    /**
+     * Ids at or above this value are free for caller-defined blobs.
+     */
+    static constexpr std::uint32_t kFirstBlobId = 1000;
+
+    /**
+     * Opaque payload stored alongside the network (e.g. routing preprocessing).
+     */
+    struct Blob {
+        std::uint32_t id;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    /**
+     * Encode a topology into a byte buffer.
+     * @param topology Network to encode
+     * @param blobs Extra payloads (ids must be >= kFirstBlobId)
+     * @return Encoded bytes
+     */
+    static std::vector<std::uint8_t> encode(const CityTopology& topology,
+                                            const std::vector<Blob>& blobs = {});
+
+    /**
+     * Write a topology to a compiled city file.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    static void writeFile(const std::string& path, const CityTopology& topology,
+                          const std::vector<Blob>& blobs = {});
+
+    /**
+     * Map a compiled city file read-only and validate its directory.
+     * @throws std::runtime_error if the file cannot be opened or is malformed
+     */
+    explicit CompiledCity(const std::string& path);
+
+    /**
+     * Use an already loaded buffer (copied; mainly for tests and embedding).
+     */
+    CompiledCity(const std::uint8_t* data, std::size_t size);
+
+    ~CompiledCity();
+    CompiledCity(const CompiledCity&) = delete;
+    CompiledCity& operator=(const CompiledCity&) = delete;
+
+    int getNodeCount() const { return nodeCount; }
+    int getEdgeCount() const { return edgeCount; }
+    std::uint64_t getFingerprint() const { return fingerprint; }
+
+    // Columns, valid for the lifetime of this object
+    const std::int32_t* nodeIds() const { return nodeIdColumn; }
+    const std::int32_t* nodeRows() const { return nodeRowColumn; }
+    const std::int32_t* nodeCols() const { return nodeColColumn; }
+    const std::int32_t* edgeIds() const { return edgeIdColumn; }
+    const std::int32_t* edgeFrom() const { return edgeFromColumn; }
+    const std::int32_t* edgeTo() const { return edgeToColumn; }
+    const double* edgeLengths() const { return edgeLengthColumn; }
+    const std::int32_t* edgeCapacities() const { return edgeCapacityColumn; }
+    bool isEdgeBlocked(int edgeIndex) const {
+        return (blockedWords[edgeIndex >> 6] >> (edgeIndex & 63)) & 1u;
+    }
+
+    /**
+     * CSR adjacency: outgoing edge ids of node id n are
+     * adjacencyEdges()[adjacencyOffsets()[n] .. adjacencyOffsets()[n + 1]).
+     */
+    int getAdjacencySlots() const { return adjacencySlots; }
+    const std::uint32_t* adjacencyOffsets() const { return adjacencyOffsetColumn; }
+    const std::int32_t* adjacencyEdges() const { return adjacencyEdgeColumn; }
+
+    /**
+     * Look up an optional blob.
+     * @param size Receives the blob size in bytes
+     * @return Pointer into the mapping, or nullptr if the blob is absent
+     */
+    const std::uint8_t* findBlob(std::uint32_t id, std::size_t& size) const;
+
+    /**
+     * Build a shareable topology from the mapped columns and CSR adjacency.
+     * @throws std::runtime_error if the adjacency does not match the edges
+     *         or the topology does not hash to the stored fingerprint
+     */
+    std::shared_ptr<const CityTopology> createTopology() const;
+
+    /**
+     * Build a City over a fresh topology (equivalent to City(createTopology())).
+     */
+    std::unique_ptr<City> createCity() const;
+
+private:
+    void bind();
+
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    void* mapping = nullptr;                // Non-null when data is an mmap
+    std::vector<std::uint8_t> ownedBytes;   // Used when mapping is unavailable
+
+    int nodeCount = 0;
+    int edgeCount = 0;
+    int adjacencySlots = 0;
+    std::uint64_t fingerprint = 0;
+
+    const std::int32_t* nodeIdColumn = nullptr;
+    const std::int32_t* nodeRowColumn = nullptr;
+    const std::int32_t* nodeColColumn = nullptr;
+    const std::int32_t* edgeIdColumn = nullptr;
+    const std::int32_t* edgeFromColumn = nullptr;
+    const std::int32_t* edgeToColumn = nullptr;
+    const double* edgeLengthColumn = nullptr;
+    const std::int32_t* edgeCapacityColumn = nullptr;
+    const std::uint64_t* blockedWords = nullptr;
+    const std::uint32_t* adjacencyOffsetColumn = nullptr;
+    const std::int32_t* adjacencyEdgeColumn = nullptr;
+
+    struct BlobRef {
+        std::uint32_t id;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+    std::vector<BlobRef> blobs;
+};
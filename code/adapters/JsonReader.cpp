@@ -1,18 +1,341 @@
 // code/adapters/JsonReader.cpp
 #include "JsonReader.h"
+#include <charconv>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 
+namespace {
+    constexpr std::size_t kChunkSize = 64 * 1024;
+    constexpr std::size_t kMaxNumberLength = 64;
+
+    bool isWhitespace(int c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    void appendUtf8(std::string& out, unsigned long codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+}
+
+JsonReader::JsonReader() = default;
+
+JsonReader::~JsonReader() = default;
+
 std::string JsonReader::read(const std::string& path) {
     std::ifstream file(path);
-    
+
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file: " + path);
     }
-    
+
     std::stringstream buffer;
     buffer << file.rdbuf();
-    
+
     return buffer.str();
 }
+
+void JsonReader::open(const std::string& path) {
+    auto file = std::make_unique<std::ifstream>(path, std::ios::binary);
+    if (!file->is_open()) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    ownedInput = std::move(file);
+    attach(*ownedInput);
+}
+
+void JsonReader::attach(std::istream& in) {
+    input = &in;
+    buffer.resize(kChunkSize);
+    pos = 0;
+    end = 0;
+    consumed = 0;
+    stack.clear();
+    rootDone = false;
+}
+
+bool JsonReader::refill() {
+    if (!input) {
+        return false;
+    }
+    consumed += end;
+    pos = 0;
+    input->read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    end = static_cast<std::size_t>(input->gcount());
+    return end > 0;
+}
+
+int JsonReader::peekChar() {
+    if (pos == end && !refill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(buffer[pos]);
+}
+
+int JsonReader::getChar() {
+    int c = peekChar();
+    if (c >= 0) {
+        ++pos;
+    }
+    return c;
+}
+
+void JsonReader::skipWhitespace() {
+    while (true) {
+        while (pos < end && isWhitespace(static_cast<unsigned char>(buffer[pos]))) {
+            ++pos;
+        }
+        if (pos < end || !refill()) {
+            return;
+        }
+    }
+}
+
+void JsonReader::fail(const std::string& message) const {
+    throw std::runtime_error("JSON error at byte " + std::to_string(position()) + ": " + message);
+}
+
+void JsonReader::valueDone() {
+    if (stack.empty()) {
+        rootDone = true;
+        return;
+    }
+    Frame& top = stack.back();
+    top.afterItem = true;
+    top.afterComma = false;
+    if (top.isObject) {
+        top.expectKey = true;
+    }
+}
+
+JsonReader::Token JsonReader::next() {
+    if (!input) {
+        fail("no input attached");
+    }
+    skipWhitespace();
+
+    if (stack.empty() && rootDone) {
+        if (peekChar() >= 0) {
+            fail("unexpected data after root value");
+        }
+        return Token::END_OF_INPUT;
+    }
+
+    int c = peekChar();
+    if (c < 0) {
+        if (stack.empty()) {
+            return Token::END_OF_INPUT;  // Empty document
+        }
+        fail("unexpected end of input");
+    }
+
+    if (!stack.empty()) {
+        Frame& top = stack.back();
+        char close = top.isObject ? '}' : ']';
+
+        // A key must be followed by its value before the object can close
+        if (c == close && !top.afterComma && (!top.isObject || top.expectKey)) {
+            ++pos;
+            bool wasObject = top.isObject;
+            stack.pop_back();
+            valueDone();
+            return wasObject ? Token::END_OBJECT : Token::END_ARRAY;
+        }
+        if (top.afterItem) {
+            if (c != ',') {
+                fail(std::string("expected ',' or '") + close + "'");
+            }
+            ++pos;
+            top.afterItem = false;
+            top.afterComma = true;
+            skipWhitespace();
+            c = peekChar();
+        }
+        if (top.isObject && top.expectKey) {
+            if (c != '"') {
+                fail("expected object key");
+            }
+            ++pos;
+            readString();
+            skipWhitespace();
+            if (getChar() != ':') {
+                fail("expected ':' after key");
+            }
+            top.expectKey = false;
+            top.afterComma = false;
+            return Token::KEY;
+        }
+        top.afterComma = false;
+    }
+
+    switch (c) {
+        case '{':
+            ++pos;
+            stack.push_back({true, true, false, false});
+            return Token::BEGIN_OBJECT;
+        case '[':
+            ++pos;
+            stack.push_back({false, false, false, false});
+            return Token::BEGIN_ARRAY;
+        case '"':
+            ++pos;
+            readString();
+            valueDone();
+            return Token::STRING;
+        case 't':
+            readLiteral("true");
+            valueDone();
+            return Token::TRUE_VALUE;
+        case 'f':
+            readLiteral("false");
+            valueDone();
+            return Token::FALSE_VALUE;
+        case 'n':
+            readLiteral("null");
+            valueDone();
+            return Token::NULL_VALUE;
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                readNumber();
+                valueDone();
+                return Token::NUMBER;
+            }
+            fail(std::string("unexpected character '") + static_cast<char>(c) + "'");
+    }
+}
+
+void JsonReader::skipValue() {
+    int depth = 0;
+    do {
+        Token token = next();
+        switch (token) {
+            case Token::BEGIN_OBJECT:
+            case Token::BEGIN_ARRAY:
+                ++depth;
+                break;
+            case Token::END_OBJECT:
+            case Token::END_ARRAY:
+                --depth;
+                break;
+            case Token::KEY:
+                continue;  // Key is followed by its value at the same depth
+            case Token::END_OF_INPUT:
+                fail("unexpected end of input");
+            default:
+                break;
+        }
+    } while (depth > 0);
+}
+
+long long JsonReader::intValue() const {
+    if (!isInteger) {
+        fail("expected an integer");
+    }
+    return integer;
+}
+
+void JsonReader::readString() {
+    text.clear();
+    while (true) {
+        // Copy runs of plain characters straight from the buffer
+        std::size_t start = pos;
+        while (pos < end && buffer[pos] != '"' && buffer[pos] != '\\') {
+            ++pos;
+        }
+        text.append(buffer.data() + start, pos - start);
+        if (pos == end) {
+            if (!refill()) {
+                fail("unterminated string");
+            }
+            continue;
+        }
+
+        char c = buffer[pos++];
+        if (c == '"') {
+            return;
+        }
+
+        int escape = getChar();
+        switch (escape) {
+            case '"': text += '"'; break;
+            case '\\': text += '\\'; break;
+            case '/': text += '/'; break;
+            case 'b': text += '\b'; break;
+            case 'f': text += '\f'; break;
+            case 'n': text += '\n'; break;
+            case 'r': text += '\r'; break;
+            case 't': text += '\t'; break;
+            case 'u': {
+                unsigned long codePoint = 0;
+                for (int i = 0; i < 4; ++i) {
+                    int h = getChar();
+                    codePoint <<= 4;
+                    if (h >= '0' && h <= '9') codePoint |= static_cast<unsigned long>(h - '0');
+                    else if (h >= 'a' && h <= 'f') codePoint |= static_cast<unsigned long>(h - 'a' + 10);
+                    else if (h >= 'A' && h <= 'F') codePoint |= static_cast<unsigned long>(h - 'A' + 10);
+                    else fail("invalid \\u escape");
+                }
+                appendUtf8(text, codePoint);
+                break;
+            }
+            default:
+                fail("invalid escape sequence");
+        }
+    }
+}
+
+void JsonReader::readNumber() {
+    char digits[kMaxNumberLength];
+    std::size_t length = 0;
+    bool integral = true;
+
+    while (true) {
+        int c = peekChar();
+        bool numeric = (c >= '0' && c <= '9') || c == '-' || c == '+';
+        bool fractional = c == '.' || c == 'e' || c == 'E';
+        if (!numeric && !fractional) {
+            break;
+        }
+        if (length == kMaxNumberLength) {
+            fail("number too long");
+        }
+        integral = integral && !fractional;
+        digits[length++] = static_cast<char>(c);
+        ++pos;
+    }
+
+    const char* first = digits;
+    const char* last = digits + length;
+    auto [ptr, ec] = std::from_chars(first, last, number);
+    if (ec != std::errc() || ptr != last) {
+        fail("invalid number");
+    }
+
+    isInteger = false;
+    if (integral) {
+        auto [intPtr, intEc] = std::from_chars(first, last, integer);
+        isInteger = intEc == std::errc() && intPtr == last;
+    }
+}
+
+void JsonReader::readLiteral(const char* literal) {
+    for (const char* p = literal; *p; ++p) {
+        if (getChar() != *p) {
+            fail(std::string("invalid literal, expected '") + literal + "'");
+        }
+    }
+}
@@ -1,20 +1,124 @@
 // code/adapters/JsonReader.h
 #pragma once
 
+#include <cstddef>
+#include <istream>
+#include <memory>
 #include <string>
+#include <vector>
 
 /**
- * JsonReader - Thin JSON wrapper.
- * Stub implementation for Deliverable 2.
- * Full implementation will parse JSON files in Deliverable 3.
+ * JsonReader - Streaming pull tokenizer for JSON.
+ *
+ * Reads input in fixed-size chunks, so arbitrarily large documents (e.g.
+ * presets with tens of thousands of blocked edges) are parsed in one pass
+ * without holding the whole file in memory. Callers drive it with next()
+ * and build their own recursive-descent parser on top; string tokens reuse
+ * one internal buffer, so steady-state parsing does not allocate.
+ *
+ * Structural errors (bad nesting, missing ':' or ',', trailing data) are
+ * reported as std::runtime_error with the byte offset.
  */
 class JsonReader {
 public:
+    enum class Token {
+        BEGIN_OBJECT,
+        END_OBJECT,
+        BEGIN_ARRAY,
+        END_ARRAY,
+        KEY,            // Object member name; text in stringValue()
+        STRING,
+        NUMBER,
+        TRUE_VALUE,
+        FALSE_VALUE,
+        NULL_VALUE,
+        END_OF_INPUT
+    };
+
+    JsonReader();
+    ~JsonReader();
+
     /**
      * Read JSON content from a file.
      * @param path Path to JSON file
-     * @return JSON content as string (empty string for stub)
+     * @return JSON content as string
      */
     std::string read(const std::string& path);
-};
 
+    /**
+     * Start tokenizing a file.
+     * @param path Path to JSON file
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    void open(const std::string& path);
+
+    /**
+     * Start tokenizing a caller-owned stream (must outlive the reader).
+     */
+    void attach(std::istream& input);
+
+    /**
+     * Advance to the next token.
+     * @return Token type; END_OF_INPUT once the root value is complete
+     */
+    Token next();
+
+    /**
+     * Skip the next complete value (scalar, or whole object/array).
+     */
+    void skipValue();
+
+    /**
+     * Text of the last KEY or STRING token (valid until the next call to next()).
+     */
+    const std::string& stringValue() const { return text; }
+
+    /**
+     * Value of the last NUMBER token.
+     */
+    double numberValue() const { return number; }
+
+    /**
+     * Value of the last NUMBER token as an integer.
+     * @throws std::runtime_error if the number is not an integer in range
+     */
+    long long intValue() const;
+
+    /**
+     * Number of bytes consumed so far (for error messages).
+     */
+    std::size_t position() const { return consumed + pos; }
+
+private:
+    struct Frame {
+        bool isObject;
+        bool expectKey;     // Object: next item must be a key
+        bool afterItem;     // A value was just completed; ',' or close expected
+        bool afterComma;    // A ',' was consumed; an item is required
+    };
+
+    int peekChar();
+    int getChar();
+    bool refill();
+    void skipWhitespace();
+    void readString();
+    void readNumber();
+    void readLiteral(const char* literal);
+    void valueDone();
+    [[noreturn]] void fail(const std::string& message) const;
+
+    std::unique_ptr<std::istream> ownedInput;
+    std::istream* input = nullptr;
+    std::vector<char> buffer;
+    std::size_t pos = 0;
+    std::size_t end = 0;
+    std::size_t consumed = 0;
+
+    std::vector<Frame> stack;
+    bool rootDone = false;
+
+    std::string text;
+    double number = 0.0;
+    long long integer = 0;
+    bool isInteger = false;
+};
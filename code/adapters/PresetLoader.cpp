@@ -1,163 +1,309 @@
 // code/adapters/PresetLoader.cpp
 #include "PresetLoader.h"
 #include "JsonReader.h"
+#include "CompiledCity.h"
 #include "../core/City.h"
 #include "../core/Node.h"
 #include "../core/Edge.h"
 #include "../core/Agent.h"
 #include "../core/Preset.h"
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <random>
-#include <unordered_set>
 #include <stdexcept>
-#include <sstream>
 #include <algorithm>
-#include <cctype>
+#include <limits>
+#include <string>
+#include <utility>
 
-// Simple JSON parsing helper functions
+// Recursive-descent helpers over the streaming JsonReader
 namespace {
-    std::string trim(const std::string& str) {
-        size_t start = str.find_first_not_of(" \t\n\r");
-        if (start == std::string::npos) return "";
-        size_t end = str.find_last_not_of(" \t\n\r");
-        return str.substr(start, end - start + 1);
-    }
+    using Token = JsonReader::Token;
     
-    std::string extractStringValue(const std::string& json, const std::string& key) {
-        std::string searchKey = "\"" + key + "\"";
-        size_t pos = json.find(searchKey);
-        if (pos == std::string::npos) return "";
-        
-        pos = json.find(':', pos);
-        if (pos == std::string::npos) return "";
-        
-        pos = json.find('"', pos);
-        if (pos == std::string::npos) return "";
-        
-        size_t start = pos + 1;
-        size_t end = json.find('"', start);
-        if (end == std::string::npos) return "";
-        
-        return json.substr(start, end - start);
+    // Error text is only built on failure so the hot path never allocates
+    void expectToken(JsonReader& reader, Token expected, const char* what, const std::string& key) {
+        if (reader.next() != expected) {
+            throw std::runtime_error("JSON error at byte " + std::to_string(reader.position()) +
+                                     ": expected " + what + " \"" + key + "\"");
+        }
     }
     
-    int extractIntValue(const std::string& json, const std::string& key, int defaultValue = 0) {
-        std::string searchKey = "\"" + key + "\"";
-        size_t pos = json.find(searchKey);
-        if (pos == std::string::npos) return defaultValue;
-        
-        pos = json.find(':', pos);
-        if (pos == std::string::npos) return defaultValue;
-        
-        // Skip whitespace
-        pos++;
-        while (pos < json.size() && std::isspace(json[pos])) pos++;
-        
-        // Read number
-        std::string numStr;
-        while (pos < json.size() && (std::isdigit(json[pos]) || json[pos] == '-')) {
-            numStr += json[pos];
-            pos++;
+    int readInt(JsonReader& reader, const std::string& key) {
+        expectToken(reader, Token::NUMBER, "integer for", key);
+        long long value = reader.intValue();
+        if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+            throw std::runtime_error("Value out of range for \"" + key + "\"");
         }
-        
-        if (numStr.empty()) return defaultValue;
-        return std::stoi(numStr);
+        return static_cast<int>(value);
     }
     
-    std::vector<std::pair<int, int>> extractBlockedEdges(const std::string& json) {
-        std::vector<std::pair<int, int>> blocked;
-        
-        std::string searchKey = "\"blocked\"";
-        size_t pos = json.find(searchKey);
-        if (pos == std::string::npos) return blocked;
-        
-        pos = json.find('[', pos);
-        if (pos == std::string::npos) return blocked;
-        
-        size_t end = json.find(']', pos);
-        if (end == std::string::npos) return blocked;
-        
-        std::string arrayContent = json.substr(pos + 1, end - pos - 1);
-        
-        // Parse array of pairs like [[0,1], [2,3]]
-        size_t innerStart = 0;
-        while ((innerStart = arrayContent.find('[', innerStart)) != std::string::npos) {
-            size_t innerEnd = arrayContent.find(']', innerStart);
-            if (innerEnd == std::string::npos) break;
-            
-            std::string pairStr = arrayContent.substr(innerStart + 1, innerEnd - innerStart - 1);
-            
-            // Extract two numbers
-            std::istringstream iss(pairStr);
-            int from, to;
-            char comma;
-            if (iss >> from >> comma >> to) {
-                blocked.push_back({from, to});
+    std::string readString(JsonReader& reader, const std::string& key) {
+        expectToken(reader, Token::STRING, "string for", key);
+        return reader.stringValue();
+    }
+    
+    // Streams an array of [a, b] pairs straight into `out`
+    void readPairArray(JsonReader& reader, const std::string& key,
+                       std::vector<std::pair<NodeId, NodeId>>& out) {
+        expectToken(reader, Token::BEGIN_ARRAY, "array for", key);
+        while (true) {
+            Token token = reader.next();
+            if (token == Token::END_ARRAY) {
+                return;
             }
-            
-            innerStart = innerEnd + 1;
+            if (token != Token::BEGIN_ARRAY) {
+                throw std::runtime_error("JSON error at byte " + std::to_string(reader.position()) +
+                                         ": expected [from, to] pair in \"" + key + "\"");
+            }
+            NodeId first = readInt(reader, key);
+            NodeId second = readInt(reader, key);
+            expectToken(reader, Token::END_ARRAY, "end of pair in", key);
+            out.push_back({first, second});
         }
-        
-        return blocked;
     }
 }
 
 Preset PresetLoader::loadFromJson(const std::string& path) {
     JsonReader reader;
-    std::string json;
     
     try {
-        json = reader.read(path);
+        reader.open(path);
     } catch (const std::exception& e) {
         // Re-throw so caller can try different paths
         throw std::runtime_error("Failed to read file: " + path + " - " + e.what());
     }
     
-    if (json.empty()) {
+    Token root = reader.next();
+    if (root == Token::END_OF_INPUT) {
         throw std::runtime_error("File is empty: " + path);
     }
+    if (root != Token::BEGIN_OBJECT) {
+        throw std::runtime_error("Preset must be a JSON object: " + path);
+    }
     
-    Preset preset;
+    // Defaults for missing fields
+    std::string name;
+    int rows = 5;
+    int cols = 5;
+    int agentCount = 10;
+    int tickMs = 100;
+    std::string policyStr;
+    std::string compiledCity;
+    std::vector<std::pair<NodeId, NodeId>> blockedEdges;
+    std::vector<std::pair<NodeId, NodeId>> agentRoutes;
     
-    // Parse JSON fields
-    std::string name = extractStringValue(json, "name");
-    preset.setName(name.empty() ? "unnamed" : name);
+    // Single pass over the top-level members; unknown keys are skipped
+    while (true) {
+        Token token = reader.next();
+        if (token == Token::END_OBJECT) {
+            break;
+        }
+        const std::string key = reader.stringValue();
+        if (key == "name") {
+            name = readString(reader, key);
+        } else if (key == "rows") {
+            rows = readInt(reader, key);
+        } else if (key == "cols") {
+            cols = readInt(reader, key);
+        } else if (key == "agentCount") {
+            agentCount = readInt(reader, key);
+        } else if (key == "tickMs") {
+            tickMs = readInt(reader, key);
+        } else if (key == "policy") {
+            policyStr = readString(reader, key);
+        } else if (key == "compiledCity") {
+            compiledCity = readString(reader, key);
+        } else if (key == "blocked") {
+            readPairArray(reader, key, blockedEdges);
+        } else if (key == "agents") {
+            readPairArray(reader, key, agentRoutes);
+        } else {
+            reader.skipValue();
+        }
+    }
+    expectToken(reader, Token::END_OF_INPUT, "end of document after", "}");
     
-    int rows = extractIntValue(json, "rows", 5);
+    Preset preset;
+    preset.setName(name.empty() ? "unnamed" : name);
     preset.setRows(rows);
-    
-    int cols = extractIntValue(json, "cols", 5);
     preset.setCols(cols);
-    
-    int agentCount = extractIntValue(json, "agentCount", 10);
     preset.setAgentCount(agentCount);
-    
-    int tickMs = extractIntValue(json, "tickMs", 100);
     preset.setTickMs(tickMs);
     
     // Parse policy
-    std::string policyStr = extractStringValue(json, "policy");
     if (policyStr == "CONGESTION_AWARE" || policyStr == "congestion_aware") {
         preset.setPolicy(PolicyType::CONGESTION_AWARE);
+    } else if (policyStr == "BPR" || policyStr == "bpr") {
+        preset.setPolicy(PolicyType::BPR);
+    } else if (policyStr == "CONICAL" || policyStr == "conical") {
+        preset.setPolicy(PolicyType::CONICAL);
+    } else if (policyStr == "SYSTEM_OPTIMAL" || policyStr == "system_optimal") {
+        preset.setPolicy(PolicyType::SYSTEM_OPTIMAL);
+    } else if (policyStr == "CONICAL_SYSTEM_OPTIMAL" || policyStr == "conical_system_optimal") {
+        preset.setPolicy(PolicyType::CONICAL_SYSTEM_OPTIMAL);
+    } else if (policyStr == "ROUTE_DIVERSITY" || policyStr == "route_diversity") {
+        preset.setPolicy(PolicyType::ROUTE_DIVERSITY);
     } else {
         preset.setPolicy(PolicyType::SHORTEST_PATH);
     }
     
-    // Parse blocked edges
-    std::vector<std::pair<int, int>> blocked = extractBlockedEdges(json);
-    std::vector<std::pair<NodeId, NodeId>> blockedEdges;
-    for (const auto& pair : blocked) {
-        blockedEdges.push_back({static_cast<NodeId>(pair.first), static_cast<NodeId>(pair.second)});
-    }
     preset.setBlockedEdges(blockedEdges);
+    preset.setAgentRoutes(std::move(agentRoutes));
+    
+    // Relative compiled city paths are relative to the preset file
+    if (!compiledCity.empty()) {
+        std::filesystem::path cityPath(compiledCity);
+        if (cityPath.is_relative()) {
+            cityPath = std::filesystem::path(path).parent_path() / cityPath;
+        }
+        preset.setCompiledCity(cityPath.string());
+    }
     
     return preset;
 }
 
+namespace {
+    // Compiled city blob holding networkSignature() of the preset it was built from
+    constexpr std::uint32_t kSignatureBlobId = CompiledCity::kFirstBlobId;
+    
+    // Buffered writer for the (potentially very large) pair arrays
+    class JsonWriter {
+    public:
+        explicit JsonWriter(std::ofstream& out) : out(out) {
+            buffer.reserve(kFlushBytes + 64);
+        }
+        ~JsonWriter() { flush(); }
+        
+        void raw(const char* text) { buffer += text; maybeFlush(); }
+        
+        void number(long long value) {
+            char digits[24];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            buffer.append(digits, result.ptr);
+            maybeFlush();
+        }
+        
+        void string(const std::string& value) {
+            buffer += '"';
+            for (char c : value) {
+                if (c == '"' || c == '\\') {
+                    buffer += '\\';
+                    buffer += c;
+                } else if (static_cast<unsigned char>(c) < 0x20) {
+                    static const char hex[] = "0123456789abcdef";
+                    buffer += "\\u00";
+                    buffer += hex[(c >> 4) & 0xF];
+                    buffer += hex[c & 0xF];
+                } else {
+                    buffer += c;
+                }
+            }
+            buffer += '"';
+            maybeFlush();
+        }
+        
+        void pairs(const std::vector<std::pair<NodeId, NodeId>>& values) {
+            buffer += '[';
+            for (size_t i = 0; i < values.size(); ++i) {
+                buffer += i ? ", [" : "[";
+                number(values[i].first);
+                buffer += ", ";
+                number(values[i].second);
+                buffer += ']';
+            }
+            buffer += ']';
+            maybeFlush();
+        }
+        
+        void flush() {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+        
+    private:
+        static constexpr size_t kFlushBytes = 64 * 1024;
+        
+        void maybeFlush() {
+            if (buffer.size() >= kFlushBytes) flush();
+        }
+        
+        std::ofstream& out;
+        std::string buffer;
+    };
+    
+    const char* policyName(PolicyType policy) {
+        switch (policy) {
+            case PolicyType::CONGESTION_AWARE: return "\"CONGESTION_AWARE\"";
+            case PolicyType::BPR: return "\"BPR\"";
+            case PolicyType::CONICAL: return "\"CONICAL\"";
+            case PolicyType::SYSTEM_OPTIMAL: return "\"SYSTEM_OPTIMAL\"";
+            case PolicyType::CONICAL_SYSTEM_OPTIMAL: return "\"CONICAL_SYSTEM_OPTIMAL\"";
+            case PolicyType::ROUTE_DIVERSITY: return "\"ROUTE_DIVERSITY\"";
+            default: return "\"SHORTEST_PATH\"";
+        }
+    }
+}
+
+void PresetLoader::saveToJson(const Preset& preset, const std::string& path) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to open file for writing: " + path);
+    }
+    
+    {
+        JsonWriter writer(out);
+        writer.raw("{\n  \"name\": ");
+        writer.string(preset.getName());
+        writer.raw(",\n  \"rows\": ");
+        writer.number(preset.getRows());
+        writer.raw(",\n  \"cols\": ");
+        writer.number(preset.getCols());
+        writer.raw(",\n  \"agentCount\": ");
+        writer.number(preset.getAgentCount());
+        writer.raw(",\n  \"tickMs\": ");
+        writer.number(preset.getTickMs());
+        writer.raw(",\n  \"policy\": ");
+        writer.raw(policyName(preset.getPolicy()));
+        if (!preset.getCompiledCity().empty()) {
+            writer.raw(",\n  \"compiledCity\": ");
+            writer.string(preset.getCompiledCity());
+        }
+        writer.raw(",\n  \"blocked\": ");
+        writer.pairs(preset.getBlockedEdges());
+        if (!preset.getAgentRoutes().empty()) {
+            writer.raw(",\n  \"agents\": ");
+            writer.pairs(preset.getAgentRoutes());
+        }
+        writer.raw("\n}\n");
+    }
+    
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + path);
+    }
+}
+
 std::unique_ptr<City> PresetLoader::buildCity(const Preset& preset) {
     if (!preset.validate()) {
         throw std::runtime_error("Invalid preset configuration");
     }
     
+    if (!preset.getCompiledCity().empty()) {
+        CompiledCity compiled(preset.getCompiledCity());
+        std::size_t size = 0;
+        const std::uint8_t* blob = compiled.findBlob(kSignatureBlobId, size);
+        std::uint64_t signature = 0;
+        if (blob && size == sizeof(signature)) {
+            std::memcpy(&signature, blob, sizeof(signature));
+        }
+        if (!blob || size != sizeof(signature) ||
+            signature != networkSignature(preset.getRows(), preset.getCols(), preset.getBlockedEdges())) {
+            throw std::runtime_error("Compiled city is stale for this preset: " + preset.getCompiledCity());
+        }
+        return compiled.createCity();
+    }
+    
     // Create grid topology
     auto city = createGridTopology(preset.getRows(), preset.getCols());
     
@@ -167,12 +313,56 @@ std::unique_ptr<City> PresetLoader::buildCity(const Preset& preset) {
     return city;
 }
 
+void PresetLoader::compileCity(const Preset& preset, const std::string& path) {
+    if (!preset.validate()) {
+        throw std::runtime_error("Invalid preset configuration");
+    }
+    
+    auto city = createGridTopology(preset.getRows(), preset.getCols());
+    applyBlockedEdges(*city, preset.getBlockedEdges());
+    
+    const std::uint64_t signature = networkSignature(preset.getRows(), preset.getCols(), preset.getBlockedEdges());
+    CompiledCity::Blob blob{kSignatureBlobId, std::vector<std::uint8_t>(sizeof(signature))};
+    std::memcpy(blob.bytes.data(), &signature, sizeof(signature));
+    CompiledCity::writeFile(path, *city->getTopology(), {blob});
+}
+
+std::uint64_t PresetLoader::networkSignature(int rows, int cols,
+                                             const std::vector<std::pair<NodeId, NodeId>>& blockedEdges) {
+    // FNV-1a over the grid size and closures in order
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](std::int64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= static_cast<std::uint64_t>(value >> (8 * i)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(rows);
+    mix(cols);
+    mix(static_cast<std::int64_t>(blockedEdges.size()));
+    for (const auto& blocked : blockedEdges) {
+        mix(blocked.first);
+        mix(blocked.second);
+    }
+    return hash;
+}
+
 std::vector<std::unique_ptr<Agent>> PresetLoader::spawnAgents(const Preset& preset, City& city) {
     std::vector<std::unique_ptr<Agent>> agents;
     
     int totalNodes = preset.getRows() * preset.getCols();
     int agentCount = preset.getAgentCount();
     
+    // Explicit origin/destination list takes precedence over random spawning
+    const auto& routes = preset.getAgentRoutes();
+    if (!routes.empty()) {
+        agents.reserve(routes.size());
+        for (size_t i = 0; i < routes.size(); ++i) {
+            agents.push_back(std::make_unique<Agent>(static_cast<int>(i), routes[i].first, routes[i].second));
+        }
+        return agents;
+    }
+    
     if (totalNodes < 2) {
         throw std::runtime_error("City must have at least 2 nodes to spawn agents");
     }
@@ -205,8 +395,6 @@ std::vector<std::unique_ptr<Agent>> PresetLoader::spawnAgents(const Preset& pres
 }
 
 std::unique_ptr<City> PresetLoader::createGridTopology(int rows, int cols) {
-    auto city = std::make_unique<City>();
-    
     // Scale capacity based on grid size
     // Smaller grids = lower capacity (traffic shows more)
     // Larger grids = higher capacity (more room for agents)
@@ -222,16 +410,25 @@ std::unique_ptr<City> PresetLoader::createGridTopology(int rows, int cols) {
         capacity = 5;
     }
     
+    // Build node and edge lists up front and hand them to the topology in
+    // one go; this keeps 1000x1000 grids (4M edges) fast to construct
+    std::vector<Node> nodes;
+    nodes.reserve(static_cast<size_t>(gridSize));
+    
     // Create nodes
     // Node ID = row * cols + col
     for (int row = 0; row < rows; ++row) {
         for (int col = 0; col < cols; ++col) {
             NodeId nodeId = row * cols + col;
-            city->addNode(Node(nodeId, row, col));
+            nodes.emplace_back(nodeId, row, col);
         }
     }
     
     // Create edges: horizontal and vertical connections
+    std::vector<Edge> edges;
+    if (rows > 0 && cols > 0) {
+        edges.reserve(static_cast<size_t>(2 * (rows * (cols - 1) + (rows - 1) * cols)));
+    }
     int edgeId = 0;
     
     // Horizontal edges (left-right)
@@ -241,14 +438,10 @@ std::unique_ptr<City> PresetLoader::createGridTopology(int rows, int cols) {
             NodeId to = row * cols + col + 1;
             
             // Create edge with scaled capacity
-            Edge edge(edgeId, from, to, 1.0, capacity);
-            city->addEdge(edge);
-            edgeId++;
+            edges.emplace_back(edgeId++, from, to, 1.0, capacity);
             
             // Create reverse edge (bidirectional)
-            Edge reverseEdge(edgeId, to, from, 1.0, capacity);
-            city->addEdge(reverseEdge);
-            edgeId++;
+            edges.emplace_back(edgeId++, to, from, 1.0, capacity);
         }
     }
     
@@ -258,69 +451,41 @@ std::unique_ptr<City> PresetLoader::createGridTopology(int rows, int cols) {
             NodeId from = row * cols + col;
             NodeId to = (row + 1) * cols + col;
             
-            Edge edge(edgeId, from, to, 1.0, capacity);
-            city->addEdge(edge);
-            edgeId++;
+            edges.emplace_back(edgeId++, from, to, 1.0, capacity);
             
             // Create reverse edge (bidirectional)
-            Edge reverseEdge(edgeId, to, from, 1.0, capacity);
-            city->addEdge(reverseEdge);
-            edgeId++;
+            edges.emplace_back(edgeId++, to, from, 1.0, capacity);
         }
     }
     
-    return city;
+    return std::make_unique<City>(std::make_shared<CityTopology>(std::move(nodes), std::move(edges)));
 }
 
 void PresetLoader::applyBlockedEdges(City& city, const std::vector<std::pair<NodeId, NodeId>>& blockedEdges) {
-    // Create a set of blocked edges for quick lookup
-    // Use a simple hash: maxNodeId * from + to
-    int maxNodeId = 1000;  // Reasonable upper bound
-    std::unordered_set<long long> blockedSet;
-    
-    for (const auto& edge : blockedEdges) {
-        long long key1 = static_cast<long long>(edge.first) * maxNodeId + edge.second;
-        long long key2 = static_cast<long long>(edge.second) * maxNodeId + edge.first;
-        blockedSet.insert(key1);
-        blockedSet.insert(key2);  // Block both directions
-    }
-    
-    // Find and block matching edges
-    // Since City doesn't expose edge iteration directly, we'll need to find edges
-    // by checking all possible node pairs. This is a simplified approach.
-    // In a full implementation, City would provide edge iteration.
-    
-    // For now, we'll iterate through edges by trying to find them
-    // This is not ideal but works for the current City interface
+    // Each pair blocks the road in both directions. Matching edges are
+    // found through the adjacency lists first and only then mutated, so a
+    // copy-on-write detach cannot invalidate the list being scanned.
+    std::vector<EdgeId> matches;
     for (const auto& blocked : blockedEdges) {
         NodeId from = blocked.first;
         NodeId to = blocked.second;
         
-        // Try to find edges connecting these nodes
-        // We'll check neighbors of 'from' node
-        std::vector<EdgeId> neighbors = city.neighbors(from);
-        for (EdgeId edgeId : neighbors) {
-            try {
-                Edge& edge = city.getEdge(edgeId);
-                if (edge.getTo() == to) {
-                    edge.setBlocked(true);
-                }
-            } catch (...) {
-                // Edge not found, skip
+        const City& view = city;
+        for (EdgeId edgeId : view.outgoingEdges(from)) {
+            if (view.getEdge(edgeId).getTo() == to) {
+                matches.push_back(edgeId);
             }
         }
         
         // Also check reverse direction
-        neighbors = city.neighbors(to);
-        for (EdgeId edgeId : neighbors) {
-            try {
-                Edge& edge = city.getEdge(edgeId);
-                if (edge.getTo() == from) {
-                    edge.setBlocked(true);
-                }
-            } catch (...) {
-                // Edge not found, skip
+        for (EdgeId edgeId : view.outgoingEdges(to)) {
+            if (view.getEdge(edgeId).getTo() == from) {
+                matches.push_back(edgeId);
             }
         }
     }
+    
+    for (EdgeId edgeId : matches) {
+        city.getEdge(edgeId).setBlocked(true);
+    }
 }
@@ -1,6 +1,7 @@
 // code/adapters/PresetLoader.h
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -17,23 +18,53 @@ class PresetLoader {
 public:
     /**
      * Load a Preset from a JSON file.
-     * For Deliverable 2, this can be a stub that returns a default preset.
+     * Single streaming pass over the document (see JsonReader), so large
+     * "blocked" and "agents" arrays are parsed without buffering the file.
+     * Unknown keys are skipped; missing keys fall back to defaults.
      * @param path Path to JSON file
      * @return Preset object loaded from JSON
      */
     Preset loadFromJson(const std::string& path);
     
+    /**
+     * Write a Preset as JSON that loadFromJson reads back unchanged.
+     * Pair arrays are streamed through a fixed-size buffer, so million-agent
+     * presets are written without building the document in memory.
+     * @param preset Preset to write
+     * @param path Destination file
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void saveToJson(const Preset& preset, const std::string& path);
+    
     /**
      * Build a City from a Preset configuration.
-     * Creates grid topology and applies blocked edges.
+     * Maps the preset's compiled city when it names one, otherwise creates
+     * the grid topology and applies blocked edges.
      * @param preset Preset configuration
      * @return Unique pointer to created City
+     * @throws std::runtime_error if the compiled city is unreadable or was
+     *         compiled from a different grid or closure list
      */
     std::unique_ptr<City> buildCity(const Preset& preset);
+
+    /**
+     * Write the preset's network (grid plus closures) as a compiled city
+     * that buildCity accepts for this preset.
+     * @throws std::runtime_error if the preset is invalid or the file cannot be written
+     */
+    void compileCity(const Preset& preset, const std::string& path);
+
+    /**
+     * Hash of the inputs that shape a preset's network, stored in compiled
+     * cities so buildCity can reject one compiled from another preset.
+     */
+    static std::uint64_t networkSignature(int rows, int cols,
+                                          const std::vector<std::pair<NodeId, NodeId>>& blockedEdges);
     
     /**
      * Spawn agents based on Preset configuration.
-     * Creates agents with random origins and destinations.
+     * Uses the preset's explicit agent routes when present, otherwise
+     * creates agents with random origins and destinations.
      * @param preset Preset configuration
      * @param city Reference to the City (needed for validation)
      * @return Vector of unique pointers to Agents
@@ -0,0 +1,514 @@
+// code/adapters/RoadNetworkImporter.cpp
+#include "RoadNetworkImporter.h"
+#include "JsonReader.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+    constexpr double kMetresPerDegreeLat = 110574.0;
+    constexpr double kMetresPerDegreeLonAtEquator = 111320.0;
+    constexpr double kPi = 3.14159265358979323846;
+    constexpr double kMinTolerance = 1e-9;
+
+    using Token = JsonReader::Token;
+
+    std::uint64_t cellKey(std::int64_t cx, std::int64_t cy) {
+        return (static_cast<std::uint64_t>(cx) << 32) ^ (static_cast<std::uint64_t>(cy) & 0xffffffffull);
+    }
+
+    std::string_view trim(std::string_view text) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '"')) {
+            text.remove_prefix(1);
+        }
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '"' ||
+                                 text.back() == '\r')) {
+            text.remove_suffix(1);
+        }
+        return text;
+    }
+
+    // Splits a CSV row into fields (no quoted commas; quotes are stripped)
+    void splitFields(std::string_view row, std::vector<std::string_view>& fields) {
+        fields.clear();
+        std::size_t start = 0;
+        while (true) {
+            std::size_t comma = row.find(',', start);
+            if (comma == std::string_view::npos) {
+                fields.push_back(trim(row.substr(start)));
+                return;
+            }
+            fields.push_back(trim(row.substr(start, comma - start)));
+            start = comma + 1;
+        }
+    }
+
+    bool parseDouble(std::string_view text, double& value) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc() && ptr == text.data() + text.size();
+    }
+
+    // 1 = one-way, -1 = one-way against the digitised direction, 0 = two-way, 2 = unknown
+    int parseOneway(std::string_view text) {
+        if (text == "1" || text == "yes" || text == "true" || text == "YES" || text == "TRUE") return 1;
+        if (text == "-1" || text == "reverse") return -1;
+        if (text == "0" || text == "no" || text == "false" || text == "NO" || text == "FALSE") return 0;
+        return 2;
+    }
+
+    int findColumn(const std::vector<std::string_view>& header, std::string_view name) {
+        for (std::size_t i = 0; i < header.size(); ++i) {
+            if (header[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+}
+
+RoadNetworkImporter::RoadNetworkImporter() : RoadNetworkImporter(Options{}) {}
+
+RoadNetworkImporter::RoadNetworkImporter(const Options& options) : options(options) {
+    if (this->options.snapTolerance < kMinTolerance) {
+        this->options.snapTolerance = kMinTolerance;
+    }
+    if (this->options.cellSize <= 0.0) {
+        throw std::runtime_error("Importer cell size must be positive");
+    }
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::importFile(const std::string& path) {
+    std::size_t dot = path.rfind('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension == "csv" || extension == "txt") {
+        return importCsv(path);
+    }
+    return importGeoJson(path);
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::importCsv(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open road network: " + path);
+    }
+    return importCsv(file);
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::importCsv(std::istream& input) {
+    reset();
+
+    std::string row;
+    std::vector<std::string_view> fields;
+    if (!std::getline(input, row)) {
+        throw std::runtime_error("CSV road network is empty");
+    }
+    std::string headerRow = row;
+    std::vector<std::string_view> header;
+    splitFields(headerRow, header);
+    const int fromX = findColumn(header, "from_x");
+    const int fromY = findColumn(header, "from_y");
+    const int toX = findColumn(header, "to_x");
+    const int toY = findColumn(header, "to_y");
+    const int lengthColumn = findColumn(header, "length");
+    const int capacityColumn = findColumn(header, "capacity");
+    const int onewayColumn = findColumn(header, "oneway");
+    if (fromX < 0 || fromY < 0 || toX < 0 || toY < 0) {
+        throw std::runtime_error("CSV header must contain from_x, from_y, to_x and to_y");
+    }
+    const std::size_t required = static_cast<std::size_t>(std::max({fromX, fromY, toX, toY})) + 1;
+
+    std::vector<int> vertices(2);
+    int lineNumber = 1;
+    while (std::getline(input, row)) {
+        ++lineNumber;
+        if (trim(row).empty()) {
+            continue;
+        }
+        splitFields(row, fields);
+        auto fail = [&](const std::string& message) {
+            throw std::runtime_error("CSV line " + std::to_string(lineNumber) + ": " + message);
+        };
+        if (fields.size() < required) {
+            fail("expected at least " + std::to_string(required) + " fields");
+        }
+        double x1, y1, x2, y2;
+        if (!parseDouble(fields[fromX], x1) || !parseDouble(fields[fromY], y1) ||
+            !parseDouble(fields[toX], x2) || !parseDouble(fields[toY], y2)) {
+            fail("invalid coordinate");
+        }
+
+        double length = -1.0;
+        if (lengthColumn >= 0 && static_cast<std::size_t>(lengthColumn) < fields.size() &&
+            !fields[lengthColumn].empty()) {
+            if (!parseDouble(fields[lengthColumn], length) || length < 0.0) {
+                fail("invalid length");
+            }
+        }
+        int capacity = options.defaultCapacity;
+        if (capacityColumn >= 0 && static_cast<std::size_t>(capacityColumn) < fields.size() &&
+            !fields[capacityColumn].empty()) {
+            double value;
+            if (!parseDouble(fields[capacityColumn], value) || value < 1.0) {
+                fail("invalid capacity");
+            }
+            capacity = static_cast<int>(value);
+        }
+        int oneway = options.defaultOneway ? 1 : 0;
+        if (onewayColumn >= 0 && static_cast<std::size_t>(onewayColumn) < fields.size() &&
+            !fields[onewayColumn].empty()) {
+            int parsed = parseOneway(fields[onewayColumn]);
+            if (parsed == 2) {
+                fail("invalid oneway value");
+            }
+            oneway = parsed;
+        }
+
+        vertices[0] = addVertex(x1, y1);
+        vertices[1] = addVertex(x2, y2);
+        if (vertices[0] == vertices[1]) {
+            ++stats.skippedFeatures;
+            continue;
+        }
+        addLine(vertices, capacity, length, oneway != 0, oneway < 0);
+    }
+    return build();
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::importGeoJson(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open road network: " + path);
+    }
+    return importGeoJson(file);
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::importGeoJson(std::istream& input) {
+    reset();
+    JsonReader reader;
+    reader.attach(input);
+    if (reader.next() != Token::BEGIN_OBJECT) {
+        throw std::runtime_error("GeoJSON root must be an object");
+    }
+    parseGeoJsonObject(reader);
+    if (reader.next() != Token::END_OF_INPUT) {
+        throw std::runtime_error("Unexpected data after GeoJSON root");
+    }
+    return build();
+}
+
+void RoadNetworkImporter::parseGeoJsonObject(JsonReader& reader) {
+    // Geometry and properties may appear in any order, so positions are
+    // buffered per feature and only snapped once the type is known
+    std::string geometryType;
+    std::vector<double> positions;          // x0, y0, x1, y1, ...
+    std::vector<std::size_t> lineEnds;      // Position count at the end of each line
+    int capacity = options.defaultCapacity;
+    int oneway = options.defaultOneway ? 1 : 0;
+    bool hasGeometry = false;
+
+    auto fail = [&](const std::string& message) {
+        throw std::runtime_error("GeoJSON error at byte " + std::to_string(reader.position()) + ": " + message);
+    };
+
+    auto readCoordinates = [&]() {
+        if (reader.next() != Token::BEGIN_ARRAY) {
+            fail("coordinates must be an array");
+        }
+        int depth = 1;
+        double position[2] = {0.0, 0.0};
+        int numbers = 0;
+        bool pendingLine = false;
+        while (depth > 0) {
+            switch (reader.next()) {
+                case Token::BEGIN_ARRAY:
+                    ++depth;
+                    numbers = 0;
+                    break;
+                case Token::NUMBER:
+                    if (numbers < 2) {
+                        position[numbers] = reader.numberValue();
+                    }
+                    ++numbers;  // Altitude and further ordinates are ignored
+                    break;
+                case Token::END_ARRAY:
+                    --depth;
+                    if (numbers > 0) {
+                        if (numbers < 2) {
+                            fail("position needs at least two numbers");
+                        }
+                        positions.push_back(position[0]);
+                        positions.push_back(position[1]);
+                        numbers = 0;
+                        pendingLine = true;
+                    } else if (pendingLine) {
+                        lineEnds.push_back(positions.size() / 2);
+                        pendingLine = false;
+                    }
+                    break;
+                default:
+                    fail("unexpected value in coordinates");
+            }
+        }
+    };
+
+    while (true) {
+        Token token = reader.next();
+        if (token == Token::END_OBJECT) {
+            break;
+        }
+        const std::string key = reader.stringValue();
+        if (key == "features") {
+            if (reader.next() != Token::BEGIN_ARRAY) {
+                fail("features must be an array");
+            }
+            while ((token = reader.next()) != Token::END_ARRAY) {
+                if (token != Token::BEGIN_OBJECT) {
+                    fail("feature must be an object");
+                }
+                parseGeoJsonObject(reader);
+            }
+        } else if (key == "geometry") {
+            token = reader.next();
+            if (token == Token::NULL_VALUE) {
+                continue;
+            }
+            if (token != Token::BEGIN_OBJECT) {
+                fail("geometry must be an object");
+            }
+            hasGeometry = true;
+            while ((token = reader.next()) != Token::END_OBJECT) {
+                const std::string member = reader.stringValue();
+                if (member == "type") {
+                    if (reader.next() != Token::STRING) {
+                        fail("geometry type must be a string");
+                    }
+                    geometryType = reader.stringValue();
+                } else if (member == "coordinates") {
+                    readCoordinates();
+                } else {
+                    reader.skipValue();
+                }
+            }
+        } else if (key == "properties") {
+            token = reader.next();
+            if (token == Token::NULL_VALUE) {
+                continue;
+            }
+            if (token != Token::BEGIN_OBJECT) {
+                fail("properties must be an object");
+            }
+            while ((token = reader.next()) != Token::END_OBJECT) {
+                const std::string member = reader.stringValue();
+                if (member == "capacity") {
+                    token = reader.next();
+                    if (token == Token::NUMBER && reader.numberValue() >= 1.0) {
+                        capacity = static_cast<int>(reader.numberValue());
+                    } else if (token == Token::BEGIN_OBJECT || token == Token::BEGIN_ARRAY) {
+                        fail("capacity must be a number");
+                    }
+                } else if (member == "oneway") {
+                    token = reader.next();
+                    if (token == Token::TRUE_VALUE) {
+                        oneway = 1;
+                    } else if (token == Token::FALSE_VALUE) {
+                        oneway = 0;
+                    } else if (token == Token::STRING || token == Token::NUMBER) {
+                        int parsed = token == Token::STRING
+                            ? parseOneway(reader.stringValue())
+                            : static_cast<int>(reader.numberValue());
+                        if (parsed >= -1 && parsed <= 1) {
+                            oneway = parsed;
+                        }
+                    } else if (token == Token::BEGIN_OBJECT || token == Token::BEGIN_ARRAY) {
+                        fail("oneway must be a scalar");
+                    }
+                } else {
+                    reader.skipValue();
+                }
+            }
+        } else {
+            reader.skipValue();
+        }
+    }
+
+    if (!hasGeometry) {
+        return;
+    }
+    if (geometryType != "LineString" && geometryType != "MultiLineString") {
+        ++stats.skippedFeatures;
+        return;
+    }
+
+    std::vector<int> vertices;
+    std::size_t start = 0;
+    for (std::size_t end : lineEnds) {
+        vertices.clear();
+        for (std::size_t i = start; i < end; ++i) {
+            int vertex = addVertex(positions[2 * i], positions[2 * i + 1]);
+            if (vertices.empty() || vertices.back() != vertex) {
+                vertices.push_back(vertex);
+            }
+        }
+        start = end;
+        if (vertices.size() < 2) {
+            ++stats.skippedFeatures;
+            continue;
+        }
+        addLine(vertices, capacity, -1.0, oneway != 0, oneway < 0);
+    }
+}
+
+void RoadNetworkImporter::reset() {
+    // Swap with empties so scratch memory is actually returned
+    stats = Stats();
+    haveOrigin = false;
+    std::vector<double>().swap(vertexX);
+    std::vector<double>().swap(vertexY);
+    std::vector<std::uint8_t>().swap(vertexUse);
+    std::vector<int>().swap(nextInCell);
+    std::unordered_map<std::uint64_t, int>().swap(cellHead);
+    std::vector<int>().swap(lineVertices);
+    std::vector<Line>().swap(lines);
+}
+
+int RoadNetworkImporter::addVertex(double x, double y) {
+    if (!std::isfinite(x) || !std::isfinite(y)) {
+        throw std::runtime_error("Road network coordinate is not finite");
+    }
+    if (options.geographic) {
+        // Equirectangular projection around the first point: good to well
+        // under 1% across a metropolitan area
+        if (!haveOrigin) {
+            originLat = y;
+            metresPerDegreeLon = kMetresPerDegreeLonAtEquator * std::cos(originLat * kPi / 180.0);
+            haveOrigin = true;
+        }
+        x *= metresPerDegreeLon;
+        y *= kMetresPerDegreeLat;
+    }
+
+    const double tolerance = options.snapTolerance;
+    const auto cx = static_cast<std::int64_t>(std::floor(x / tolerance));
+    const auto cy = static_cast<std::int64_t>(std::floor(y / tolerance));
+
+    // Anything within the tolerance lies in this cell or one of its neighbours
+    for (std::int64_t dx = -1; dx <= 1; ++dx) {
+        for (std::int64_t dy = -1; dy <= 1; ++dy) {
+            auto it = cellHead.find(cellKey(cx + dx, cy + dy));
+            if (it == cellHead.end()) continue;
+            for (int v = it->second; v >= 0; v = nextInCell[v]) {
+                double ddx = vertexX[v] - x;
+                double ddy = vertexY[v] - y;
+                if (ddx * ddx + ddy * ddy <= tolerance * tolerance) {
+                    return v;
+                }
+            }
+        }
+    }
+
+    int id = static_cast<int>(vertexX.size());
+    vertexX.push_back(x);
+    vertexY.push_back(y);
+    vertexUse.push_back(0);
+    auto [it, inserted] = cellHead.try_emplace(cellKey(cx, cy), id);
+    nextInCell.push_back(inserted ? -1 : it->second);
+    it->second = id;
+    return id;
+}
+
+void RoadNetworkImporter::addLine(const std::vector<int>& vertices, int capacity, double length,
+                                  bool oneway, bool reversed) {
+    auto bump = [this](int vertex, int amount) {
+        vertexUse[vertex] = static_cast<std::uint8_t>(std::min(255, vertexUse[vertex] + amount));
+    };
+    // Endpoints are always nodes; interior vertices become nodes when shared
+    bump(vertices.front(), 2);
+    bump(vertices.back(), 2);
+    for (std::size_t i = 1; i + 1 < vertices.size(); ++i) {
+        bump(vertices[i], 1);
+    }
+
+    lines.push_back({static_cast<std::uint32_t>(lineVertices.size()),
+                     static_cast<std::uint32_t>(vertices.size()),
+                     capacity, length, oneway, reversed});
+    lineVertices.insert(lineVertices.end(), vertices.begin(), vertices.end());
+    ++stats.lines;
+}
+
+std::shared_ptr<const CityTopology> RoadNetworkImporter::build() {
+    const std::size_t vertexCount = vertexX.size();
+    stats.vertices = static_cast<int>(vertexCount);
+
+    // Dense node ids in order of first appearance
+    std::vector<int> nodeOf(vertexCount, -1);
+    double minX = std::numeric_limits<double>::max();
+    double maxY = std::numeric_limits<double>::lowest();
+    int nodeCount = 0;
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        if (vertexUse[v] >= 2) {
+            nodeOf[v] = nodeCount++;
+            minX = std::min(minX, vertexX[v]);
+            maxY = std::max(maxY, vertexY[v]);
+        }
+    }
+
+    std::vector<Node> nodes;
+    nodes.reserve(static_cast<std::size_t>(nodeCount));
+    for (std::size_t v = 0; v < vertexCount; ++v) {
+        if (nodeOf[v] >= 0) {
+            int row = static_cast<int>(std::lround((maxY - vertexY[v]) / options.cellSize));
+            int col = static_cast<int>(std::lround((vertexX[v] - minX) / options.cellSize));
+            nodes.emplace_back(nodeOf[v], row, col);
+        }
+    }
+
+    std::vector<Edge> edges;
+    edges.reserve(lines.size() * 2);
+    auto emit = [&](int fromVertex, int toVertex, double length, const Line& line) {
+        NodeId from = nodeOf[fromVertex];
+        NodeId to = nodeOf[toVertex];
+        if (from == to) {
+            return;  // Closed loop without an intermediate intersection
+        }
+        int edgeId = static_cast<int>(edges.size());
+        if (!line.oneway || !line.reversed) {
+            edges.emplace_back(edgeId++, from, to, length, line.capacity);
+        }
+        if (!line.oneway || line.reversed) {
+            edges.emplace_back(edgeId, to, from, length, line.capacity);
+        }
+    };
+
+    for (const Line& line : lines) {
+        const int* vertices = lineVertices.data() + line.firstVertex;
+        int segmentStart = vertices[0];
+        double length = 0.0;
+        for (std::uint32_t i = 1; i < line.vertexCount; ++i) {
+            double dx = vertexX[vertices[i]] - vertexX[vertices[i - 1]];
+            double dy = vertexY[vertices[i]] - vertexY[vertices[i - 1]];
+            length += std::sqrt(dx * dx + dy * dy);
+            if (nodeOf[vertices[i]] >= 0) {
+                emit(segmentStart, vertices[i], line.length >= 0.0 ? line.length : length, line);
+                segmentStart = vertices[i];
+                length = 0.0;
+            }
+        }
+    }
+
+    stats.nodes = nodeCount;
+    stats.edges = static_cast<int>(edges.size());
+
+    // Release scratch space; the topology is all that is kept
+    Stats finished = stats;
+    reset();
+    stats = finished;
+
+    return std::make_shared<const CityTopology>(std::move(nodes), std::move(edges));
+}
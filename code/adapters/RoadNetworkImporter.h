@@ -0,0 +1,104 @@
+// code/adapters/RoadNetworkImporter.h
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/CityTopology.h"
+
+class JsonReader;
+
+/**
+ * RoadNetworkImporter - Builds a CityTopology from real road data.
+ *
+ * Supported inputs:
+ *   - CSV edge lists with a header row naming the columns
+ *     from_x, from_y, to_x, to_y and optionally length, capacity, oneway
+ *   - GeoJSON LineString / MultiLineString features (FeatureCollection);
+ *     properties "capacity" and "oneway" (true, "yes", "1" or "-1") are used
+ *
+ * Input is streamed (line by line, or token by token via JsonReader), so
+ * memory grows with the network, not with the file. Vertices closer than
+ * the snap tolerance are merged through a spatial hash; a vertex becomes a
+ * node if it ends a line or is shared by several lines, and each line is
+ * split into edges at its nodes. Node and edge ids are dense, edges of a
+ * two-way road are added as a forward/reverse pair, and lengths are derived
+ * from the coordinates unless a CSV "length" column is given.
+ *
+ * Errors are reported as std::runtime_error (with line number or byte
+ * offset where available).
+ */
+class RoadNetworkImporter {
+public:
+    struct Options {
+        bool geographic = true;         // Coordinates are lon/lat degrees; lengths in metres
+        double snapTolerance = 0.5;     // Merge distance (metres, or coordinate units if planar)
+        double cellSize = 50.0;         // Distance per Node row/col step
+        int defaultCapacity = 10;
+        bool defaultOneway = false;
+    };
+
+    struct Stats {
+        int lines = 0;              // CSV rows or GeoJSON line strings read
+        int skippedFeatures = 0;    // Non-line geometries and degenerate lines
+        int vertices = 0;           // Distinct positions after snapping
+        int nodes = 0;
+        int edges = 0;
+    };
+
+    RoadNetworkImporter();
+    explicit RoadNetworkImporter(const Options& options);
+
+    /**
+     * Import by file extension (.csv/.txt as CSV, anything else as GeoJSON).
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    std::shared_ptr<const CityTopology> importFile(const std::string& path);
+
+    std::shared_ptr<const CityTopology> importCsv(const std::string& path);
+    std::shared_ptr<const CityTopology> importCsv(std::istream& input);
+    std::shared_ptr<const CityTopology> importGeoJson(const std::string& path);
+    std::shared_ptr<const CityTopology> importGeoJson(std::istream& input);
+
+    /**
+     * Counters from the most recent import.
+     */
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Line {
+        std::uint32_t firstVertex;   // Offset into lineVertices
+        std::uint32_t vertexCount;
+        int capacity;
+        double length;               // Explicit total length, or < 0 to derive
+        bool oneway;
+        bool reversed;               // oneway = -1: traffic runs last -> first
+    };
+
+    void parseGeoJsonObject(JsonReader& reader);
+    void reset();
+    int addVertex(double x, double y);
+    void addLine(const std::vector<int>& vertices, int capacity, double length, bool oneway, bool reversed);
+    std::shared_ptr<const CityTopology> build();
+
+    Options options;
+    Stats stats;
+
+    // Projection for geographic input (equirectangular around the first point)
+    bool haveOrigin = false;
+    double originLat = 0.0;
+    double metresPerDegreeLon = 0.0;
+
+    // Snapped vertices and their spatial hash (cell -> first vertex, chained)
+    std::vector<double> vertexX;
+    std::vector<double> vertexY;
+    std::vector<std::uint8_t> vertexUse;    // Saturating use count; >= 2 means node
+    std::vector<int> nextInCell;
+    std::unordered_map<std::uint64_t, int> cellHead;
+
+    std::vector<int> lineVertices;
+    std::vector<Line> lines;
+};
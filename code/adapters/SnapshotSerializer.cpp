@@ -0,0 +1,460 @@
+// code/adapters/SnapshotSerializer.cpp
+#include "SnapshotSerializer.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    constexpr char kMagic[8] = {'G', 'L', 'S', 'N', 'A', 'P', '\0', '\0'};
+    constexpr std::uint32_t kEndianTag = 0x01020304u;
+    constexpr std::size_t kAlignment = 8;
+
+    enum SectionId : std::uint32_t {
+        OCCUPANCY = 1,
+        BLOCKED_BITS = 2,
+        AGENT_ID = 10,
+        AGENT_ORIGIN = 11,
+        AGENT_DESTINATION = 12,
+        AGENT_CURRENT_NODE = 13,
+        AGENT_CURRENT_EDGE = 14,
+        AGENT_DEPARTURE = 15,
+        AGENT_ARRIVAL = 16,
+        AGENT_STEPS = 17,
+        AGENT_ARRIVED = 18,
+        AGENT_PATH_OFFSETS = 19,
+        AGENT_PATH_EDGES = 20,
+        INITIAL_ROUTES = 30,
+        TRIP_TIMES = 40,
+        THROUGHPUT = 41,
+        LOAD_HISTORY_OFFSETS = 42,
+        LOAD_HISTORY = 43,
+        ROUTE_WAVES = 50,
+        PROFILE_HORIZON = 51,
+        OCCUPANCY_HISTORY_OFFSETS = 52,
+        OCCUPANCY_HISTORY = 53,
+        RESERVATION_HORIZON = 54,
+        CLAIM_AGENTS = 55,
+        CLAIM_OFFSETS = 56,
+        CLAIM_EDGES = 57,
+        CLAIM_TICKS = 58
+    };
+
+    struct FileHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t endianTag;
+        std::uint64_t topologyFingerprint;
+        std::int32_t nodeCount;
+        std::int32_t edgeCount;
+        std::int32_t agentCount;
+        std::int32_t policy;
+        std::int32_t tickMs;
+        std::int32_t currentTick;
+        std::int32_t maxEdgeLoad;
+        std::uint32_t sectionCount;
+        std::uint8_t reserved[8];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Snapshot header must stay 64 bytes");
+
+    struct SectionEntry {
+        std::uint32_t id;
+        std::uint32_t elementSize;
+        std::uint64_t offset;
+        std::uint64_t count;
+    };
+    static_assert(sizeof(SectionEntry) == 24, "Section entry must stay 24 bytes");
+
+    std::size_t alignUp(std::size_t value) {
+        return (value + kAlignment - 1) & ~(kAlignment - 1);
+    }
+
+    // Collects sections, then lays them out behind header and directory
+    class SectionWriter {
+    public:
+        template <typename T>
+        void add(std::uint32_t id, const std::vector<T>& values) {
+            Pending pending;
+            pending.entry = {id, static_cast<std::uint32_t>(sizeof(T)), 0,
+                             static_cast<std::uint64_t>(values.size())};
+            pending.bytes.resize(values.size() * sizeof(T));
+            if (!values.empty()) {
+                std::memcpy(pending.bytes.data(), values.data(), pending.bytes.size());
+            }
+            sections.push_back(std::move(pending));
+        }
+
+        std::vector<std::uint8_t> finish(FileHeader header) {
+            header.sectionCount = static_cast<std::uint32_t>(sections.size());
+
+            std::size_t offset = alignUp(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry));
+            for (auto& pending : sections) {
+                pending.entry.offset = offset;
+                offset = alignUp(offset + pending.bytes.size());
+            }
+
+            std::vector<std::uint8_t> out(offset, 0);
+            std::memcpy(out.data(), &header, sizeof(header));
+            std::size_t dirPos = sizeof(FileHeader);
+            for (const auto& pending : sections) {
+                std::memcpy(out.data() + dirPos, &pending.entry, sizeof(SectionEntry));
+                dirPos += sizeof(SectionEntry);
+                if (!pending.bytes.empty()) {
+                    std::memcpy(out.data() + pending.entry.offset, pending.bytes.data(), pending.bytes.size());
+                }
+            }
+            return out;
+        }
+
+    private:
+        struct Pending {
+            SectionEntry entry;
+            std::vector<std::uint8_t> bytes;
+        };
+        std::vector<Pending> sections;
+    };
+
+    // Bounds-checked view over an encoded snapshot
+    class SectionReader {
+    public:
+        SectionReader(const std::uint8_t* data, std::size_t size) : data(data), size(size) {
+            if (!data || size < sizeof(FileHeader)) {
+                throw std::runtime_error("Snapshot is truncated");
+            }
+            std::memcpy(&header, data, sizeof(header));
+            if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+                throw std::runtime_error("Not a simulation snapshot");
+            }
+            if (header.endianTag != kEndianTag) {
+                throw std::runtime_error("Snapshot was written with a different byte order");
+            }
+            if (header.version != SnapshotSerializer::kFormatVersion) {
+                throw std::runtime_error("Unsupported snapshot version: " + std::to_string(header.version));
+            }
+            std::size_t dirEnd = sizeof(FileHeader) + static_cast<std::size_t>(header.sectionCount) * sizeof(SectionEntry);
+            if (dirEnd > size) {
+                throw std::runtime_error("Snapshot directory is truncated");
+            }
+            entries.resize(header.sectionCount);
+            if (!entries.empty()) {
+                std::memcpy(entries.data(), data + sizeof(FileHeader), entries.size() * sizeof(SectionEntry));
+            }
+        }
+
+        const FileHeader& getHeader() const { return header; }
+
+        bool has(std::uint32_t id) const {
+            return std::any_of(entries.begin(), entries.end(),
+                               [id](const SectionEntry& entry) { return entry.id == id; });
+        }
+
+        template <typename T>
+        std::vector<T> read(std::uint32_t id, std::size_t expectedCount) const {
+            std::vector<T> values = read<T>(id);
+            if (values.size() != expectedCount) {
+                throw std::runtime_error("Snapshot section " + std::to_string(id) + " has wrong length");
+            }
+            return values;
+        }
+
+        template <typename T>
+        std::vector<T> read(std::uint32_t id) const {
+            for (const auto& entry : entries) {
+                if (entry.id != id) continue;
+                if (entry.elementSize != sizeof(T)) {
+                    throw std::runtime_error("Snapshot section " + std::to_string(id) + " has wrong element size");
+                }
+                if (entry.offset > size || entry.count > (size - entry.offset) / sizeof(T)) {
+                    throw std::runtime_error("Snapshot section " + std::to_string(id) + " is out of bounds");
+                }
+                std::vector<T> values(static_cast<std::size_t>(entry.count));
+                if (!values.empty()) {
+                    std::memcpy(values.data(), data + entry.offset, values.size() * sizeof(T));
+                }
+                return values;
+            }
+            throw std::runtime_error("Snapshot section missing: " + std::to_string(id));
+        }
+
+    private:
+        const std::uint8_t* data;
+        std::size_t size;
+        FileHeader header{};
+        std::vector<SectionEntry> entries;
+    };
+
+    // Offsets[i]..Offsets[i+1] delimit item i of a flattened list of lists
+    template <typename Outer>
+    std::vector<std::uint64_t> flattenOffsets(const Outer& lists) {
+        std::vector<std::uint64_t> offsets;
+        offsets.reserve(lists.size() + 1);
+        std::uint64_t total = 0;
+        offsets.push_back(0);
+        for (const auto& list : lists) {
+            total += list.size();
+            offsets.push_back(total);
+        }
+        return offsets;
+    }
+
+    // One-value section; snapshots written before it existed get the default
+    std::int32_t readSetting(const SectionReader& reader, std::uint32_t id, std::int32_t fallback) {
+        return reader.has(id) ? reader.read<std::int32_t>(id, 1)[0] : fallback;
+    }
+
+    void checkOffsets(const std::vector<std::uint64_t>& offsets, std::size_t valueCount) {
+        for (std::size_t i = 1; i < offsets.size(); ++i) {
+            if (offsets[i] < offsets[i - 1]) {
+                throw std::runtime_error("Snapshot offsets are not monotonic");
+            }
+        }
+        if (offsets.empty() || offsets.front() != 0 || offsets.back() != valueCount) {
+            throw std::runtime_error("Snapshot offsets do not match payload");
+        }
+    }
+}
+
+std::vector<std::uint8_t> SnapshotSerializer::serialize(const SimulationSnapshot& snapshot) const {
+    const Metrics& metrics = snapshot.metrics;
+    const std::size_t agentCount = snapshot.agents.size();
+
+    FileHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kFormatVersion;
+    header.endianTag = kEndianTag;
+    header.topologyFingerprint = snapshot.topologyFingerprint;
+    header.nodeCount = snapshot.nodeCount;
+    header.edgeCount = snapshot.cityState.getEdgeCount();
+    header.agentCount = static_cast<std::int32_t>(agentCount);
+    header.policy = static_cast<std::int32_t>(snapshot.policy);
+    header.tickMs = snapshot.tickMs;
+    header.currentTick = metrics.getCurrentTick();
+    header.maxEdgeLoad = metrics.getMaxEdgeLoad();
+
+    SectionWriter writer;
+    writer.add(ROUTE_WAVES, std::vector<std::int32_t>{snapshot.routeWaves});
+    writer.add(OCCUPANCY, snapshot.cityState.occupancyData());
+    writer.add(BLOCKED_BITS, snapshot.cityState.blockedWords());
+
+    // Agents are stored column-wise (one array per field)
+    std::vector<std::int32_t> ids, origins, destinations, nodes, edges;
+    std::vector<std::int32_t> departures, arrivals, steps;
+    std::vector<std::uint8_t> arrived;
+    std::vector<std::int32_t> pathEdges;
+    std::vector<std::uint64_t> pathOffsets;
+    pathOffsets.reserve(agentCount + 1);
+    pathOffsets.push_back(0);
+    for (const auto& agent : snapshot.agents) {
+        ids.push_back(agent.id);
+        origins.push_back(agent.origin);
+        destinations.push_back(agent.destination);
+        nodes.push_back(agent.currentNode);
+        edges.push_back(agent.currentEdge.value_or(INVALID_EDGE));
+        departures.push_back(agent.departureTime);
+        arrivals.push_back(agent.arrivalTime);
+        steps.push_back(agent.stepsTaken);
+        arrived.push_back(agent.arrived ? 1 : 0);
+        pathEdges.insert(pathEdges.end(), agent.path.begin(), agent.path.end());
+        pathOffsets.push_back(pathEdges.size());
+    }
+    writer.add(AGENT_ID, ids);
+    writer.add(AGENT_ORIGIN, origins);
+    writer.add(AGENT_DESTINATION, destinations);
+    writer.add(AGENT_CURRENT_NODE, nodes);
+    writer.add(AGENT_CURRENT_EDGE, edges);
+    writer.add(AGENT_DEPARTURE, departures);
+    writer.add(AGENT_ARRIVAL, arrivals);
+    writer.add(AGENT_STEPS, steps);
+    writer.add(AGENT_ARRIVED, arrived);
+    writer.add(AGENT_PATH_OFFSETS, pathOffsets);
+    writer.add(AGENT_PATH_EDGES, pathEdges);
+
+    std::vector<std::int32_t> routes;
+    routes.reserve(snapshot.initialAgentRoutes.size() * 2);
+    for (const auto& route : snapshot.initialAgentRoutes) {
+        routes.push_back(route.first);
+        routes.push_back(route.second);
+    }
+    writer.add(INITIAL_ROUTES, routes);
+
+    writer.add(TRIP_TIMES, metrics.getTripTimes());
+    writer.add(THROUGHPUT, metrics.getThroughputPerTick());
+    const auto& history = metrics.getEdgeLoadHistory();
+    std::vector<std::int32_t> loads;
+    for (const auto& tickLoads : history) {
+        loads.insert(loads.end(), tickLoads.begin(), tickLoads.end());
+    }
+    writer.add(LOAD_HISTORY_OFFSETS, flattenOffsets(history));
+    writer.add(LOAD_HISTORY, loads);
+
+    writer.add(PROFILE_HORIZON, std::vector<std::int32_t>{snapshot.profileHorizon});
+    std::vector<std::int32_t> occupancyRows;
+    for (const auto& row : snapshot.occupancyHistory) {
+        occupancyRows.insert(occupancyRows.end(), row.begin(), row.end());
+    }
+    writer.add(OCCUPANCY_HISTORY_OFFSETS, flattenOffsets(snapshot.occupancyHistory));
+    writer.add(OCCUPANCY_HISTORY, occupancyRows);
+
+    writer.add(RESERVATION_HORIZON, std::vector<std::int32_t>{snapshot.reservationHorizon});
+    std::vector<std::int32_t> claimAgents;
+    std::vector<std::uint64_t> claimOffsets{0};
+    std::vector<std::int32_t> claimEdges;
+    std::vector<std::int64_t> claimTicks;
+    for (const auto& [id, claims] : snapshot.agentClaims) {
+        claimAgents.push_back(id);
+        for (const auto& claim : claims) {
+            claimEdges.push_back(claim.edgeIndex);
+            claimTicks.push_back(claim.tick);
+        }
+        claimOffsets.push_back(claimEdges.size());
+    }
+    writer.add(CLAIM_AGENTS, claimAgents);
+    writer.add(CLAIM_OFFSETS, claimOffsets);
+    writer.add(CLAIM_EDGES, claimEdges);
+    writer.add(CLAIM_TICKS, claimTicks);
+
+    return writer.finish(header);
+}
+
+SimulationSnapshot SnapshotSerializer::deserialize(const std::uint8_t* data, std::size_t size) const {
+    SectionReader reader(data, size);
+    const FileHeader& header = reader.getHeader();
+    if (header.edgeCount < 0 || header.agentCount < 0 || header.nodeCount < 0) {
+        throw std::runtime_error("Snapshot header has negative counts");
+    }
+    const std::size_t edgeCount = static_cast<std::size_t>(header.edgeCount);
+    const std::size_t agentCount = static_cast<std::size_t>(header.agentCount);
+
+    SimulationSnapshot snapshot;
+    snapshot.topologyFingerprint = header.topologyFingerprint;
+    snapshot.nodeCount = header.nodeCount;
+    if (header.policy < 0 || header.policy > static_cast<std::int32_t>(PolicyType::CONICAL_SYSTEM_OPTIMAL)) {
+        throw std::runtime_error("Snapshot has an unknown policy: " + std::to_string(header.policy));
+    }
+    snapshot.policy = static_cast<PolicyType>(header.policy);
+    snapshot.tickMs = header.tickMs;
+    snapshot.routeWaves = readSetting(reader, ROUTE_WAVES, 1);
+    if (snapshot.routeWaves < 1) {
+        throw std::runtime_error("Snapshot has invalid route waves: " + std::to_string(snapshot.routeWaves));
+    }
+
+    snapshot.cityState.resize(header.edgeCount);
+    snapshot.cityState.occupancyData() = reader.read<std::int32_t>(OCCUPANCY, edgeCount);
+    snapshot.cityState.blockedWords() = reader.read<std::uint64_t>(BLOCKED_BITS, (edgeCount + 63) / 64);
+
+    auto ids = reader.read<std::int32_t>(AGENT_ID, agentCount);
+    auto origins = reader.read<std::int32_t>(AGENT_ORIGIN, agentCount);
+    auto destinations = reader.read<std::int32_t>(AGENT_DESTINATION, agentCount);
+    auto nodes = reader.read<std::int32_t>(AGENT_CURRENT_NODE, agentCount);
+    auto edges = reader.read<std::int32_t>(AGENT_CURRENT_EDGE, agentCount);
+    auto departures = reader.read<std::int32_t>(AGENT_DEPARTURE, agentCount);
+    auto arrivals = reader.read<std::int32_t>(AGENT_ARRIVAL, agentCount);
+    auto steps = reader.read<std::int32_t>(AGENT_STEPS, agentCount);
+    auto arrived = reader.read<std::uint8_t>(AGENT_ARRIVED, agentCount);
+    auto pathOffsets = reader.read<std::uint64_t>(AGENT_PATH_OFFSETS, agentCount + 1);
+    auto pathEdges = reader.read<std::int32_t>(AGENT_PATH_EDGES);
+    checkOffsets(pathOffsets, pathEdges.size());
+
+    snapshot.agents.resize(agentCount);
+    for (std::size_t i = 0; i < agentCount; ++i) {
+        Agent::State& agent = snapshot.agents[i];
+        agent.id = ids[i];
+        agent.origin = origins[i];
+        agent.destination = destinations[i];
+        agent.currentNode = nodes[i];
+        if (edges[i] != INVALID_EDGE) {
+            agent.currentEdge = edges[i];
+        }
+        agent.departureTime = departures[i];
+        agent.arrivalTime = arrivals[i];
+        agent.stepsTaken = steps[i];
+        agent.arrived = arrived[i] != 0;
+        agent.path.assign(pathEdges.begin() + static_cast<std::ptrdiff_t>(pathOffsets[i]),
+                          pathEdges.begin() + static_cast<std::ptrdiff_t>(pathOffsets[i + 1]));
+    }
+
+    auto routes = reader.read<std::int32_t>(INITIAL_ROUTES);
+    if (routes.size() % 2 != 0) {
+        throw std::runtime_error("Snapshot initial routes are malformed");
+    }
+    for (std::size_t i = 0; i < routes.size(); i += 2) {
+        snapshot.initialAgentRoutes.push_back({routes[i], routes[i + 1]});
+    }
+
+    auto tripTimes = reader.read<double>(TRIP_TIMES);
+    auto throughput = reader.read<std::int32_t>(THROUGHPUT);
+    auto loadOffsets = reader.read<std::uint64_t>(LOAD_HISTORY_OFFSETS);
+    auto loads = reader.read<std::int32_t>(LOAD_HISTORY);
+    checkOffsets(loadOffsets, loads.size());
+    std::vector<std::vector<int>> history;
+    history.reserve(loadOffsets.size() - 1);
+    for (std::size_t i = 0; i + 1 < loadOffsets.size(); ++i) {
+        history.emplace_back(loads.begin() + static_cast<std::ptrdiff_t>(loadOffsets[i]),
+                             loads.begin() + static_cast<std::ptrdiff_t>(loadOffsets[i + 1]));
+    }
+    snapshot.metrics.restore(header.currentTick, header.maxEdgeLoad,
+                             std::move(tripTimes), std::move(throughput), std::move(history));
+
+    snapshot.profileHorizon = readSetting(reader, PROFILE_HORIZON, 0);
+    if (snapshot.profileHorizon < 0) {
+        throw std::runtime_error("Snapshot has an invalid prediction horizon: " +
+                                 std::to_string(snapshot.profileHorizon));
+    }
+    if (reader.has(OCCUPANCY_HISTORY_OFFSETS)) {
+        auto rowOffsets = reader.read<std::uint64_t>(OCCUPANCY_HISTORY_OFFSETS);
+        auto occupancyRows = reader.read<std::int32_t>(OCCUPANCY_HISTORY);
+        checkOffsets(rowOffsets, occupancyRows.size());
+        for (std::size_t i = 0; i + 1 < rowOffsets.size(); ++i) {
+            snapshot.occupancyHistory.emplace_back(occupancyRows.begin() + static_cast<std::ptrdiff_t>(rowOffsets[i]),
+                                                   occupancyRows.begin() + static_cast<std::ptrdiff_t>(rowOffsets[i + 1]));
+        }
+    }
+
+    snapshot.reservationHorizon = readSetting(reader, RESERVATION_HORIZON, 0);
+    if (snapshot.reservationHorizon < 0) {
+        throw std::runtime_error("Snapshot has an invalid reservation horizon: " +
+                                 std::to_string(snapshot.reservationHorizon));
+    }
+    if (reader.has(CLAIM_AGENTS)) {
+        auto claimAgents = reader.read<std::int32_t>(CLAIM_AGENTS);
+        auto claimOffsets = reader.read<std::uint64_t>(CLAIM_OFFSETS);
+        auto claimEdges = reader.read<std::int32_t>(CLAIM_EDGES);
+        auto claimTicks = reader.read<std::int64_t>(CLAIM_TICKS);
+        checkOffsets(claimOffsets, claimEdges.size());
+        if (claimOffsets.size() != claimAgents.size() + 1 || claimTicks.size() != claimEdges.size()) {
+            throw std::runtime_error("Snapshot reservations are inconsistent");
+        }
+        for (std::size_t i = 0; i < claimAgents.size(); ++i) {
+            std::vector<ReservationTable::Claim> claims;
+            for (std::uint64_t c = claimOffsets[i]; c < claimOffsets[i + 1]; ++c) {
+                claims.push_back({claimEdges[c], claimTicks[c]});
+            }
+            snapshot.agentClaims.emplace_back(claimAgents[i], std::move(claims));
+        }
+    }
+
+    return snapshot;
+}
+
+void SnapshotSerializer::writeFile(const std::string& path, const SimulationSnapshot& snapshot) const {
+    std::vector<std::uint8_t> bytes = serialize(snapshot);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file for writing: " + path);
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        throw std::runtime_error("Failed to write snapshot: " + path);
+    }
+}
+
+SimulationSnapshot SnapshotSerializer::readFile(const std::string& path) const {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+    return deserialize(bytes.data(), bytes.size());
+}
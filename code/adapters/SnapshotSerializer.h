@@ -0,0 +1,60 @@
+// code/adapters/SnapshotSerializer.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../core/SimulationSnapshot.h"
+
+/**
+ * SnapshotSerializer - Binary checkpoint format for SimulationSnapshot.
+ *
+ * Layout (little-endian, all sections 8-byte aligned so the file can be
+ * memory-mapped and read in place):
+ *   - 64-byte header: magic "GLSNAP", format version, endian tag, topology
+ *     fingerprint, counts and scalar settings
+ *   - section directory: {id, element size, offset, element count} per section
+ *   - section payloads: flat arrays (occupancy, closure bitset, one column
+ *     per agent field, concatenated paths, metrics accumulators) and the
+ *     routing modes' settings and state
+ *
+ * Sections added after version 1 (the routing modes) are optional: a file
+ * without them restores with the modes off.
+ *
+ * Readers reject unknown major versions and mismatched endianness; unknown
+ * section ids are ignored so new sections can be added without a version bump.
+ */
+class SnapshotSerializer {
+public:
+    static constexpr std::uint32_t kFormatVersion = 1;
+
+    /**
+     * Encode a snapshot into a byte buffer.
+     * @param snapshot Snapshot to encode
+     * @return Encoded bytes
+     */
+    std::vector<std::uint8_t> serialize(const SimulationSnapshot& snapshot) const;
+
+    /**
+     * Decode a snapshot from a byte buffer (e.g. a mapped file).
+     * The returned snapshot has no topology pointer, only the fingerprint.
+     * @param data Pointer to encoded bytes
+     * @param size Number of bytes
+     * @return Decoded snapshot
+     * @throws std::runtime_error on malformed or incompatible data
+     */
+    SimulationSnapshot deserialize(const std::uint8_t* data, std::size_t size) const;
+
+    /**
+     * Write a snapshot to a binary file.
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writeFile(const std::string& path, const SimulationSnapshot& snapshot) const;
+
+    /**
+     * Read a snapshot from a binary file.
+     * @throws std::runtime_error if the file cannot be read or is malformed
+     */
+    SimulationSnapshot readFile(const std::string& path) const;
+};
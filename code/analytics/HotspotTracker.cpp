@@ -0,0 +1,149 @@
+// code/analytics/HotspotTracker.cpp
+#include "HotspotTracker.h"
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../core/Edge.h"
+#include <algorithm>
+#include <queue>
+
+void HotspotTracker::reset(const CityTopology& topology, const std::vector<int>& occupancy) {
+    const std::vector<Edge>& edges = topology.getEdges();
+    occ.assign(edges.size(), 0);
+    cap.resize(edges.size());
+    ids.resize(edges.size());
+    position.assign(edges.size(), -1);
+    heap.clear();
+    heap.reserve(edges.size());
+
+    for (size_t i = 0; i < edges.size(); ++i) {
+        occ[i] = i < occupancy.size() ? occupancy[i] : 0;
+        cap[i] = edges[i].getCapacity();
+        ids[i] = edges[i].getId();
+        // Zero-capacity edges never count as hotspots
+        if (cap[i] > 0) {
+            position[i] = static_cast<int>(heap.size());
+            heap.push_back(static_cast<int>(i));
+        }
+    }
+
+    // Floyd heapify
+    for (size_t pos = heap.size() / 2; pos-- > 0;) {
+        siftDown(pos);
+    }
+}
+
+void HotspotTracker::reset(const City& city) {
+    reset(*city.getTopology(), city.getState().occupancyData());
+}
+
+void HotspotTracker::clear() {
+    heap.clear();
+    position.clear();
+    occ.clear();
+    cap.clear();
+    ids.clear();
+}
+
+void HotspotTracker::update(int edgeIndex, int occupancy) {
+    int old = occ[edgeIndex];
+    if (old == occupancy) {
+        return;
+    }
+    occ[edgeIndex] = occupancy;
+    int pos = position[edgeIndex];
+    if (pos < 0) {
+        return;
+    }
+    if (occupancy > old) {
+        siftUp(static_cast<size_t>(pos));
+    } else {
+        siftDown(static_cast<size_t>(pos));
+    }
+}
+
+void HotspotTracker::update(const std::vector<int>& edgeIndices, const std::vector<int>& occupancy) {
+    for (int edgeIndex : edgeIndices) {
+        update(edgeIndex, occupancy[edgeIndex]);
+    }
+}
+
+std::vector<HotspotTracker::Hotspot> HotspotTracker::top(int k) const {
+    std::vector<Hotspot> result;
+    if (k <= 0 || heap.empty()) {
+        return result;
+    }
+    result.reserve(std::min(static_cast<size_t>(k), heap.size()));
+
+    // Best-first walk: the next best edge is always a child of one already
+    // taken, so a frontier of at most K + 1 heap slots suffices
+    auto worse = [this](size_t a, size_t b) { return ranksAbove(heap[b], heap[a]); };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(worse)> frontier(worse);
+    frontier.push(0);
+    while (!frontier.empty() && static_cast<int>(result.size()) < k) {
+        size_t pos = frontier.top();
+        frontier.pop();
+        result.push_back(makeHotspot(heap[pos]));
+        for (size_t child = 2 * pos + 1; child <= 2 * pos + 2 && child < heap.size(); ++child) {
+            frontier.push(child);
+        }
+    }
+    return result;
+}
+
+bool HotspotTracker::ranksAbove(int a, int b) const {
+    // occ[a] / cap[a] > occ[b] / cap[b] without rounding (capacities > 0)
+    long long lhs = static_cast<long long>(occ[a]) * cap[b];
+    long long rhs = static_cast<long long>(occ[b]) * cap[a];
+    if (lhs != rhs) {
+        return lhs > rhs;
+    }
+    return a < b;
+}
+
+void HotspotTracker::place(size_t pos, int edgeIndex) {
+    heap[pos] = edgeIndex;
+    position[edgeIndex] = static_cast<int>(pos);
+}
+
+void HotspotTracker::siftUp(size_t pos) {
+    int edgeIndex = heap[pos];
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!ranksAbove(edgeIndex, heap[parent])) {
+            break;
+        }
+        place(pos, heap[parent]);
+        pos = parent;
+    }
+    place(pos, edgeIndex);
+}
+
+void HotspotTracker::siftDown(size_t pos) {
+    int edgeIndex = heap[pos];
+    size_t count = heap.size();
+    while (true) {
+        size_t best = 2 * pos + 1;
+        if (best >= count) {
+            break;
+        }
+        if (best + 1 < count && ranksAbove(heap[best + 1], heap[best])) {
+            ++best;
+        }
+        if (!ranksAbove(heap[best], edgeIndex)) {
+            break;
+        }
+        place(pos, heap[best]);
+        pos = best;
+    }
+    place(pos, edgeIndex);
+}
+
+HotspotTracker::Hotspot HotspotTracker::makeHotspot(int edgeIndex) const {
+    Hotspot hotspot;
+    hotspot.edgeId = ids[edgeIndex];
+    hotspot.currentOccupancy = occ[edgeIndex];
+    hotspot.capacity = cap[edgeIndex];
+    hotspot.utilization = static_cast<double>(occ[edgeIndex]) / cap[edgeIndex];
+    hotspot.congestionLevel = TrafficFlowAnalyzer::calculateCongestionLevel(occ[edgeIndex], cap[edgeIndex]);
+    return hotspot;
+}
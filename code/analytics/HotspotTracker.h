@@ -0,0 +1,69 @@
+// code/analytics/HotspotTracker.h
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "TrafficFlowAnalyzer.h"
+
+class City;
+class CityTopology;
+
+/**
+ * HotspotTracker: Incrementally maintained bottleneck ranking
+ *
+ * Keeps every edge (with non-zero capacity) in an indexed max-heap keyed by
+ * utilization, which orders edges exactly like
+ * TrafficFlowAnalyzer::calculateCongestionLevel. An occupancy change moves
+ * one heap entry in O(log E); top(K) walks the heap best-first in
+ * O(K log K) without touching the other edges. Ties go to the lower edge
+ * index, so rankings are deterministic.
+ *
+ * The tracker does not observe the city itself: feed it the changed edge
+ * indices after each tick (SimulationFrame::changedEdges, or
+ * SimulationController::takeChanges) and reset() whenever the change list
+ * is incomplete.
+ */
+class HotspotTracker {
+public:
+    using Hotspot = TrafficFlowAnalyzer::Hotspot;
+
+    HotspotTracker() = default;
+
+    /**
+     * Rebuild from scratch in O(E).
+     * @param occupancy Occupancy by edge index (missing entries count as 0)
+     */
+    void reset(const CityTopology& topology, const std::vector<int>& occupancy);
+    void reset(const City& city);
+    void clear();
+
+    /**
+     * Record a new occupancy for one edge index.
+     */
+    void update(int edgeIndex, int occupancy);
+
+    /**
+     * Record the listed edge indices' values from an occupancy array.
+     */
+    void update(const std::vector<int>& edgeIndices, const std::vector<int>& occupancy);
+
+    /**
+     * The K most congested edges, most congested first.
+     */
+    std::vector<Hotspot> top(int k) const;
+
+    std::size_t trackedEdges() const { return heap.size(); }
+    int occupancy(int edgeIndex) const { return occ[edgeIndex]; }
+
+private:
+    bool ranksAbove(int a, int b) const;
+    void place(std::size_t pos, int edgeIndex);
+    void siftUp(std::size_t pos);
+    void siftDown(std::size_t pos);
+    Hotspot makeHotspot(int edgeIndex) const;
+
+    std::vector<int> heap;          // Edge indices; heap[0] is the most congested
+    std::vector<int> position;      // Heap slot by edge index, -1 if not tracked
+    std::vector<int> occ;           // By edge index
+    std::vector<int> cap;
+    std::vector<EdgeId> ids;
+};
@@ -132,6 +132,19 @@ double PolicyEffectivenessAnalyzer::calculatePValue(
     }
 }
 
+double PolicyEffectivenessAnalyzer::priceOfAnarchy(
+    const PolicyMetrics& selfish, const PolicyMetrics& systemOptimal) {
+    
+    auto totalTime = [](const PolicyMetrics& run) {
+        return run.averageTripTime * run.totalThroughput + run.enRouteTime;
+    };
+    double optimalTotal = totalTime(systemOptimal);
+    if (!(optimalTotal > 0.0)) {
+        return 1.0;
+    }
+    return totalTime(selfish) / optimalTotal;
+}
+
 double PolicyEffectivenessAnalyzer::calculateEfficiencyScore(
     double avgTripTime, int throughput, int maxLoad) {
     
@@ -25,6 +25,7 @@ public:
         double efficiencyScore;
         std::vector<double> tripTimeSamples;
         int sampleCount;
+        double enRouteTime = 0.0;  // Ticks so far of agents still travelling (Agent::getTravelTime)
     };
     
     struct ComparisonResult {
@@ -80,6 +81,18 @@ public:
      */
     double calculatePValue(const std::vector<double>& sampleA, const std::vector<double>& sampleB);
     
+    /**
+     * Price of anarchy observed in simulation: total travel time of a
+     * selfish run over that of a system-optimal run of the same preset.
+     * Total travel time is the arrived agents' trips (averageTripTime *
+     * totalThroughput) plus enRouteTime, so a run stopped while many
+     * agents are still travelling is not scored as if they had no cost.
+     * 1 when the system-optimal run has no travel time.
+     * TrafficAssignment::priceOfAnarchy gives the static-assignment
+     * counterpart.
+     */
+    static double priceOfAnarchy(const PolicyMetrics& selfish, const PolicyMetrics& systemOptimal);
+    
     /**
      * Calculate efficiency score (0.0 to 1.0)
      */
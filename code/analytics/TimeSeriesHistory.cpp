@@ -0,0 +1,213 @@
+// code/analytics/TimeSeriesHistory.cpp
+#include "TimeSeriesHistory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Buckets fetched per output point before LTTB picks among them
+constexpr std::size_t kOversample = 4;
+// Bucket budget when only the value range is needed
+constexpr std::size_t kRangeBuckets = 1024;
+}
+
+TimeSeriesHistory::TimeSeriesHistory(std::size_t capacityPerLevel, std::size_t fanout, std::size_t levelCount)
+    : capacity(std::max<std::size_t>(capacityPerLevel, 1)) {
+    fanout = std::max<std::size_t>(fanout, 2);
+    levels.resize(std::max<std::size_t>(levelCount, 1));
+    std::size_t samples = 1;
+    for (Level& level : levels) {
+        level.samplesPerBucket = samples;
+        samples *= fanout;
+    }
+}
+
+void TimeSeriesHistory::append(double x, double y) {
+    if (totalSamples == 0) {
+        earliestX = x;
+    }
+    latestX = x;
+    ++totalSamples;
+
+    for (Level& level : levels) {
+        add(level.pending, x, y);
+        if (level.pending.count < level.samplesPerBucket) {
+            continue;
+        }
+        level.buckets.push_back(level.pending);
+        level.pending = Bucket();
+        if (level.buckets.size() > capacity) {
+            level.buckets.pop_front();
+            level.dropped = true;
+        }
+    }
+}
+
+void TimeSeriesHistory::clear() {
+    for (Level& level : levels) {
+        level.buckets.clear();
+        level.pending = Bucket();
+        level.dropped = false;
+    }
+    totalSamples = 0;
+    earliestX = 0.0;
+    latestX = 0.0;
+}
+
+std::size_t TimeSeriesHistory::retainedBuckets() const {
+    std::size_t total = 0;
+    for (const Level& level : levels) {
+        total += level.buckets.size() + (level.pending.count > 0 ? 1 : 0);
+    }
+    return total;
+}
+
+std::vector<TimeSeriesHistory::Bucket> TimeSeriesHistory::buckets(double x0, double x1, std::size_t maxBuckets) const {
+    std::vector<Bucket> result;
+    if (totalSamples == 0 || x1 < x0) {
+        return result;
+    }
+
+    // Finest level that still reaches back to x0 without too many buckets;
+    // the coarsest level is the fallback
+    const Level* chosen = &levels.back();
+    for (const Level& level : levels) {
+        if (!covers(level, x0)) {
+            continue;
+        }
+        auto [lo, hi] = overlap(level, x0, x1);
+        std::size_t count = hi - lo + (pendingOverlaps(level, x0, x1) ? 1 : 0);
+        if (count <= maxBuckets) {
+            chosen = &level;
+            break;
+        }
+    }
+
+    auto [lo, hi] = overlap(*chosen, x0, x1);
+    result.assign(chosen->buckets.begin() + static_cast<std::ptrdiff_t>(lo),
+                  chosen->buckets.begin() + static_cast<std::ptrdiff_t>(hi));
+    if (pendingOverlaps(*chosen, x0, x1)) {
+        result.push_back(chosen->pending);
+    }
+    return result;
+}
+
+std::vector<TimeSeriesHistory::Point> TimeSeriesHistory::downsample(double x0, double x1, std::size_t maxPoints) const {
+    std::vector<Point> points;
+    if (maxPoints == 0) {
+        return points;
+    }
+    std::vector<Bucket> selected = buckets(x0, x1, maxPoints * kOversample);
+    points.reserve(selected.size());
+    for (const Bucket& bucket : selected) {
+        points.push_back({bucket.count == 1 ? bucket.firstX : bucket.midX(), bucket.mean()});
+    }
+    return lttb(points, maxPoints);
+}
+
+std::pair<double, double> TimeSeriesHistory::valueRange(double x0, double x1) const {
+    std::vector<Bucket> selected = buckets(x0, x1, kRangeBuckets);
+    if (selected.empty()) {
+        return {0.0, 0.0};
+    }
+    double low = selected.front().min;
+    double high = selected.front().max;
+    for (const Bucket& bucket : selected) {
+        low = std::min(low, bucket.min);
+        high = std::max(high, bucket.max);
+    }
+    return {low, high};
+}
+
+std::vector<TimeSeriesHistory::Point> TimeSeriesHistory::lttb(const std::vector<Point>& points, std::size_t threshold) {
+    std::size_t n = points.size();
+    if (threshold >= n || threshold == 0) {
+        return threshold == 0 ? std::vector<Point>() : points;
+    }
+    if (threshold < 3) {
+        std::vector<Point> ends{points.front()};
+        if (threshold == 2) {
+            ends.push_back(points.back());
+        }
+        return ends;
+    }
+
+    std::vector<Point> sampled;
+    sampled.reserve(threshold);
+    sampled.push_back(points.front());
+
+    // Interior points split into threshold - 2 buckets; from each keep the
+    // point forming the largest triangle with the previously kept point and
+    // the average of the next bucket
+    double every = static_cast<double>(n - 2) / (threshold - 2);
+    std::size_t previous = 0;
+    for (std::size_t i = 0; i < threshold - 2; ++i) {
+        std::size_t nextStart = static_cast<std::size_t>(std::floor((i + 1) * every)) + 1;
+        std::size_t nextEnd = std::min(static_cast<std::size_t>(std::floor((i + 2) * every)) + 1, n);
+        double avgX = 0.0;
+        double avgY = 0.0;
+        for (std::size_t j = nextStart; j < nextEnd; ++j) {
+            avgX += points[j].x;
+            avgY += points[j].y;
+        }
+        std::size_t nextCount = nextEnd > nextStart ? nextEnd - nextStart : 0;
+        if (nextCount > 0) {
+            avgX /= nextCount;
+            avgY /= nextCount;
+        } else {
+            avgX = points.back().x;
+            avgY = points.back().y;
+        }
+
+        std::size_t start = static_cast<std::size_t>(std::floor(i * every)) + 1;
+        std::size_t end = std::min(static_cast<std::size_t>(std::floor((i + 1) * every)) + 1, n - 1);
+        const Point& a = points[previous];
+        double bestArea = -1.0;
+        std::size_t best = start;
+        for (std::size_t j = start; j < end; ++j) {
+            double area = std::abs((a.x - avgX) * (points[j].y - a.y) - (a.x - points[j].x) * (avgY - a.y));
+            if (area > bestArea) {
+                bestArea = area;
+                best = j;
+            }
+        }
+        sampled.push_back(points[best]);
+        previous = best;
+    }
+
+    sampled.push_back(points.back());
+    return sampled;
+}
+
+void TimeSeriesHistory::add(Bucket& bucket, double x, double y) {
+    if (bucket.count == 0) {
+        bucket.firstX = x;
+        bucket.min = y;
+        bucket.max = y;
+    } else {
+        bucket.min = std::min(bucket.min, y);
+        bucket.max = std::max(bucket.max, y);
+    }
+    bucket.lastX = x;
+    bucket.sum += y;
+    ++bucket.count;
+}
+
+bool TimeSeriesHistory::covers(const Level& level, double x0) const {
+    if (!level.dropped) {
+        return true;
+    }
+    return level.buckets.empty() || level.buckets.front().firstX <= x0;
+}
+
+std::pair<std::size_t, std::size_t> TimeSeriesHistory::overlap(const Level& level, double x0, double x1) const {
+    const auto& all = level.buckets;
+    auto first = std::lower_bound(all.begin(), all.end(), x0,
+                                  [](const Bucket& bucket, double x) { return bucket.lastX < x; });
+    auto last = std::upper_bound(first, all.end(), x1,
+                                 [](double x, const Bucket& bucket) { return x < bucket.firstX; });
+    return {static_cast<std::size_t>(first - all.begin()), static_cast<std::size_t>(last - all.begin())};
+}
+
+bool TimeSeriesHistory::pendingOverlaps(const Level& level, double x0, double x1) {
+    return level.pending.count > 0 && level.pending.lastX >= x0 && level.pending.firstX <= x1;
+}
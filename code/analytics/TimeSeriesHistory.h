@@ -0,0 +1,107 @@
+// code/analytics/TimeSeriesHistory.h
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+/**
+ * TimeSeriesHistory: Bounded, multi-resolution history of one metric
+ *
+ * Samples (x = tick, y = value) are kept at several resolutions. Level 0
+ * holds raw samples; each level above aggregates fanout times as many
+ * samples per bucket (min / max / mean). Every level keeps only its newest
+ * capacityPerLevel buckets, so memory stays bounded however long the run
+ * goes, while the coarse levels still cover all of it.
+ *
+ * A query picks the finest level that covers the requested x range at a
+ * sensible bucket count and reduces it to a point budget (typically the
+ * chart's pixel width) with Largest-Triangle-Three-Buckets downsampling.
+ */
+class TimeSeriesHistory {
+public:
+    struct Bucket {
+        double firstX = 0.0;
+        double lastX = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double sum = 0.0;
+        std::size_t count = 0;
+
+        double mean() const { return count > 0 ? sum / count : 0.0; }
+        double midX() const { return (firstX + lastX) / 2.0; }
+    };
+
+    struct Point {
+        double x;
+        double y;
+    };
+
+    /**
+     * @param capacityPerLevel Buckets kept per level
+     * @param fanout Samples per bucket grow by this factor per level (>= 2)
+     * @param levelCount Number of resolutions (the coarsest covers
+     *               capacityPerLevel * fanout^(levels-1) samples)
+     */
+    explicit TimeSeriesHistory(std::size_t capacityPerLevel = 1024, std::size_t fanout = 4,
+                               std::size_t levelCount = 8);
+
+    /**
+     * Add a sample; x must not be smaller than the previous sample's.
+     */
+    void append(double x, double y);
+    void clear();
+
+    bool empty() const { return totalSamples == 0; }
+    std::size_t sampleCount() const { return totalSamples; }
+    double firstX() const { return earliestX; }
+    double lastX() const { return latestX; }
+
+    /**
+     * Buckets retained across all levels (the memory bound).
+     */
+    std::size_t retainedBuckets() const;
+
+    /**
+     * Buckets overlapping [x0, x1] from the finest level that covers the
+     * range with at most maxBuckets buckets (or the coarsest level if none
+     * does). The newest, still filling bucket is included.
+     */
+    std::vector<Bucket> buckets(double x0, double x1, std::size_t maxBuckets) const;
+
+    /**
+     * At most maxPoints points (bucket means) tracing [x0, x1].
+     */
+    std::vector<Point> downsample(double x0, double x1, std::size_t maxPoints) const;
+
+    /**
+     * Smallest and largest sample value within [x0, x1]; {0, 0} if empty.
+     */
+    std::pair<double, double> valueRange(double x0, double x1) const;
+
+    /**
+     * Largest-Triangle-Three-Buckets: keep threshold points (the first and
+     * last always) that best preserve the visual shape of the series.
+     */
+    static std::vector<Point> lttb(const std::vector<Point>& points, std::size_t threshold);
+
+private:
+    struct Level {
+        std::deque<Bucket> buckets;     // Completed buckets, oldest first
+        Bucket pending;                 // Filling; complete at samplesPerBucket
+        std::size_t samplesPerBucket = 1;
+        bool dropped = false;           // Buckets were evicted (no longer covers the start)
+    };
+
+    static void add(Bucket& bucket, double x, double y);
+    bool covers(const Level& level, double x0) const;
+    // Index range of completed buckets overlapping [x0, x1]
+    std::pair<std::size_t, std::size_t> overlap(const Level& level, double x0, double x1) const;
+    static bool pendingOverlaps(const Level& level, double x0, double x1);
+
+    std::size_t capacity;
+    std::vector<Level> levels;
+    std::size_t totalSamples = 0;
+    double earliestX = 0.0;
+    double latestX = 0.0;
+};
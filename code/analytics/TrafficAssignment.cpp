@@ -0,0 +1,681 @@
+// code/analytics/TrafficAssignment.cpp
+#include "TrafficAssignment.h"
+#include "../core/Agent.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace {
+    // Bisection steps of the line search (interval 2^-40 of a unit step)
+    constexpr int kLineSearchSteps = 40;
+
+    // Overshooting Newton steps are halved at most this often
+    constexpr int kMaxHalvings = 8;
+
+    // Flow shifting passes over the bushes per iteration
+    constexpr int kEquilibrationSweeps = 16;
+    // Share of the relative gap below which a node's routes count as balanced
+    constexpr double kToleranceShare = 0.5;
+
+    int threadsFor(int workItems, int maxThreads) {
+        int threadCount = maxThreads > 0 ? maxThreads
+                                         : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        return std::max(1, std::min(threadCount, workItems));
+    }
+
+    /**
+     * Run work(thread, begin, end) over contiguous chunks of [0, count) on
+     * threadCount threads; the calling thread takes chunk 0.
+     */
+    template <typename Work>
+    void runChunks(int count, int threadCount, Work work) {
+        std::vector<std::exception_ptr> errors(threadCount);
+        auto run = [&](int t) {
+            try {
+                work(t, static_cast<int>(static_cast<long long>(count) * t / threadCount),
+                     static_cast<int>(static_cast<long long>(count) * (t + 1) / threadCount));
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < threadCount; ++t) {
+            threads.emplace_back(run, t);
+        }
+        run(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+std::vector<TrafficAssignment::OdDemand> TrafficAssignment::demandFromAgents(const std::vector<Agent*>& agents) {
+    std::map<std::pair<NodeId, NodeId>, double> trips;
+    for (const Agent* agent : agents) {
+        if (agent) {
+            trips[{agent->getOrigin(), agent->getDestination()}] += 1.0;
+        }
+    }
+    std::vector<OdDemand> demand;
+    demand.reserve(trips.size());
+    for (const auto& [od, count] : trips) {
+        demand.push_back({od.first, od.second, count});
+    }
+    return demand;
+}
+
+TrafficAssignment::TrafficAssignment(const City& source, VolumeDelayPolicy function)
+    : city(source), costFunction(std::move(function)) {
+    costFunction.setPricing(VolumeDelayPolicy::Pricing::AVERAGE);
+    const auto topology = city.getTopology();
+    const std::vector<Edge>& edges = topology->getEdges();
+    lengths = topology->lengthData();
+    capacities = topology->capacityData();
+
+    for (const Node& node : topology->getNodes()) {
+        nodeSlots = std::max(nodeSlots, node.getId() + 1);
+    }
+    const int edgeCount = static_cast<int>(edges.size());
+    tail.resize(edgeCount);
+    head.resize(edgeCount);
+    std::vector<int> open;
+    for (int e = 0; e < edgeCount; ++e) {
+        tail[e] = edges[e].getFrom();
+        head[e] = edges[e].getTo();
+        nodeSlots = std::max({nodeSlots, tail[e] + 1, head[e] + 1});
+        // Closures are fixed for a solve
+        if (tail[e] >= 0 && head[e] >= 0 && !edges[e].isBlocked() && !city.getState().isBlocked(e)) {
+            open.push_back(e);
+        }
+    }
+
+    // Forward and backward star over the open edges
+    firstOut.assign(static_cast<size_t>(nodeSlots) + 1, 0);
+    firstIn.assign(static_cast<size_t>(nodeSlots) + 1, 0);
+    for (int e : open) {
+        ++firstOut[tail[e] + 1];
+        ++firstIn[head[e] + 1];
+    }
+    for (int node = 0; node < nodeSlots; ++node) {
+        firstOut[node + 1] += firstOut[node];
+        firstIn[node + 1] += firstIn[node];
+    }
+    outEdges.resize(open.size());
+    inEdges.resize(open.size());
+    std::vector<int> nextOut(firstOut.begin(), firstOut.end() - 1);
+    std::vector<int> nextIn(firstIn.begin(), firstIn.end() - 1);
+    for (int e : open) {
+        outEdges[nextOut[tail[e]]++] = e;
+        inEdges[nextIn[head[e]]++] = e;
+    }
+}
+
+TrafficAssignment::TreeScratch::TreeScratch(int nodeSlots)
+    : dist(nodeSlots, 0.0), predEdge(nodeSlots, -1), predNode(nodeSlots, INVALID_NODE),
+      settledIn(nodeSlots, -1), reachedIn(nodeSlots, -1), wanted(nodeSlots, 0) {
+}
+
+double TrafficAssignment::linkCost(int edgeIndex, double flow) const {
+    const int capacity = capacities[edgeIndex];
+    if (capacity <= 0) {
+        return flow > 0.0 ? std::numeric_limits<double>::infinity() : lengths[edgeIndex];
+    }
+    return lengths[edgeIndex] * costFunction.delayFactor(edgeIndex, flow / capacity);
+}
+
+double TrafficAssignment::linkCostSlope(int edgeIndex, double flow) const {
+    const int capacity = capacities[edgeIndex];
+    if (capacity <= 0) {
+        return 0.0;
+    }
+    return lengths[edgeIndex] * costFunction.delayFactorSlope(edgeIndex, flow / capacity) / capacity;
+}
+
+double TrafficAssignment::linkPrice(int edgeIndex, double flow) const {
+    const int capacity = capacities[edgeIndex];
+    if (capacity <= 0) {
+        return flow > 0.0 ? std::numeric_limits<double>::infinity() : lengths[edgeIndex];
+    }
+    return lengths[edgeIndex] * costFunction.priceFactor(edgeIndex, flow / capacity);
+}
+
+double TrafficAssignment::linkPriceSlope(int edgeIndex, double flow) const {
+    const int capacity = capacities[edgeIndex];
+    if (capacity <= 0) {
+        return 0.0;
+    }
+    return lengths[edgeIndex] * costFunction.priceFactorSlope(edgeIndex, flow / capacity) / capacity;
+}
+
+std::vector<TrafficAssignment::Origin> TrafficAssignment::groupByOrigin(const std::vector<OdDemand>& demand) const {
+    const auto topology = city.getTopology();
+    std::map<NodeId, std::map<NodeId, double>> grouped;
+    for (const OdDemand& od : demand) {
+        if (!(od.trips >= 0.0)) {
+            throw std::runtime_error("Negative demand from node " + std::to_string(od.origin));
+        }
+        if (topology->nodeIndex(od.origin) < 0 || topology->nodeIndex(od.destination) < 0) {
+            throw std::runtime_error("Demand references an unknown node: " + std::to_string(od.origin) +
+                                     " -> " + std::to_string(od.destination));
+        }
+        if (od.origin != od.destination && od.trips > 0.0) {
+            grouped[od.origin][od.destination] += od.trips;
+        }
+    }
+    std::vector<Origin> origins;
+    origins.reserve(grouped.size());
+    for (const auto& [node, destinations] : grouped) {
+        origins.push_back({node, {destinations.begin(), destinations.end()}});
+    }
+    return origins;
+}
+
+void TrafficAssignment::growTree(const std::vector<Origin>& origins, int o, const std::vector<double>& costs,
+                                 TreeScratch& scratch, bool complete) const {
+    const Origin& origin = origins[o];
+    const auto later = std::greater<std::pair<double, NodeId>>();
+    int remaining = 0;
+    for (const auto& destination : origin.destinations) {
+        scratch.wanted[destination.first] = 1;
+        ++remaining;
+    }
+
+    auto& heap = scratch.heap;
+    heap.clear();
+    scratch.dist[origin.node] = 0.0;
+    scratch.predEdge[origin.node] = -1;
+    scratch.reachedIn[origin.node] = o;
+    heap.push_back({0.0, origin.node});
+    while (!heap.empty() && (complete || remaining > 0)) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto [d, node] = heap.back();
+        heap.pop_back();
+        if (scratch.settledIn[node] == o || d > scratch.dist[node]) continue;
+        scratch.settledIn[node] = o;
+        if (scratch.wanted[node]) {
+            --remaining;
+        }
+        for (int slot = firstOut[node]; slot < firstOut[node + 1]; ++slot) {
+            const int e = outEdges[slot];
+            const NodeId next = head[e];
+            const double candidate = d + costs[e];
+            if (scratch.reachedIn[next] != o || candidate < scratch.dist[next]) {
+                scratch.reachedIn[next] = o;
+                scratch.dist[next] = candidate;
+                scratch.predEdge[next] = e;
+                scratch.predNode[next] = node;
+                heap.push_back({candidate, next});
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+
+    for (const auto& destination : origin.destinations) {
+        scratch.wanted[destination.first] = 0;
+    }
+}
+
+double TrafficAssignment::allOrNothing(const std::vector<Origin>& origins, const std::vector<double>& costs,
+                                       std::vector<double>& flows, double& unrouted, int maxThreads) const {
+    const int threadCount = threadsFor(static_cast<int>(origins.size()), maxThreads);
+
+    // Each thread owns a contiguous range of origins and its own flow
+    // buffer; buffers are summed in thread order, so a solve is
+    // deterministic for a given thread count
+    std::vector<std::vector<double>> partialFlows(threadCount, std::vector<double>(costs.size(), 0.0));
+    std::vector<double> partialCost(threadCount, 0.0);
+    std::vector<double> partialUnrouted(threadCount, 0.0);
+
+    runChunks(static_cast<int>(origins.size()), threadCount, [&](int t, int begin, int end) {
+        TreeScratch scratch(nodeSlots);
+        std::vector<double>& local = partialFlows[t];
+        for (int o = begin; o < end; ++o) {
+            growTree(origins, o, costs, scratch);
+            const Origin& origin = origins[o];
+            for (const auto& [destination, trips] : origin.destinations) {
+                if (scratch.settledIn[destination] != o) {
+                    partialUnrouted[t] += trips;
+                    continue;
+                }
+                partialCost[t] += trips * scratch.dist[destination];
+                for (NodeId node = destination; node != origin.node; node = scratch.predNode[node]) {
+                    local[scratch.predEdge[node]] += trips;
+                }
+            }
+        }
+    });
+
+    flows.assign(costs.size(), 0.0);
+    double shortestCost = 0.0;
+    unrouted = 0.0;
+    for (int t = 0; t < threadCount; ++t) {
+        for (size_t e = 0; e < flows.size(); ++e) {
+            flows[e] += partialFlows[t][e];
+        }
+        shortestCost += partialCost[t];
+        unrouted += partialUnrouted[t];
+    }
+    return shortestCost;
+}
+
+TrafficAssignment::Result TrafficAssignment::solveUserEquilibrium(const std::vector<OdDemand>& demand,
+                                                                  const Options& options) const {
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Origin> origins = groupByOrigin(demand);
+    Result result = options.method == Method::BUSH_BASED ? solveBushBased(origins, options)
+                                                                  : solveFrankWolfe(origins, options);
+
+    result.edgeCosts.resize(lengths.size());
+    result.totalCost = 0.0;
+    for (size_t e = 0; e < lengths.size(); ++e) {
+        result.edgeCosts[e] = linkCost(static_cast<int>(e), result.edgeFlows[e]);
+        result.totalCost += result.edgeFlows[e] * result.edgeCosts[e];
+    }
+    result.wallSeconds = secondsSince(start);
+    return result;
+}
+
+TrafficAssignment::Result TrafficAssignment::solveSystemOptimum(const std::vector<OdDemand>& demand,
+                                                                const Options& options) const {
+    TrafficAssignment marginal(*this);
+    marginal.costFunction.setPricing(VolumeDelayPolicy::Pricing::MARGINAL);
+    return marginal.solveUserEquilibrium(demand, options);
+}
+
+double TrafficAssignment::priceOfAnarchy(const Result& userEquilibrium, const Result& systemOptimum) {
+    if (!(systemOptimum.totalCost > 0.0)) {
+        return 1.0;
+    }
+    return userEquilibrium.totalCost / systemOptimum.totalCost;
+}
+
+TrafficAssignment::Result TrafficAssignment::solveFrankWolfe(const std::vector<Origin>& origins,
+                                                             const Options& options) const {
+    const auto start = std::chrono::steady_clock::now();
+    const size_t edgeCount = lengths.size();
+
+    Result result;
+    std::vector<double> costs(edgeCount);
+    std::vector<double> target;
+    auto updateCosts = [&](const std::vector<double>& flows) {
+        for (size_t e = 0; e < edgeCount; ++e) {
+            costs[e] = linkPrice(static_cast<int>(e), flows[e]);
+        }
+    };
+
+    // Start from an all-or-nothing assignment at free-flow costs
+    std::vector<double>& flows = result.edgeFlows;
+    flows.assign(edgeCount, 0.0);
+    updateCosts(flows);
+    allOrNothing(origins, costs, flows, result.unroutedTrips, options.maxThreads);
+
+    for (int iteration = 1; iteration <= options.maxIterations; ++iteration) {
+        updateCosts(flows);
+        double unrouted = 0.0;
+        const double shortestCost = allOrNothing(origins, costs, target, unrouted, options.maxThreads);
+
+        double currentCost = 0.0;
+        for (size_t e = 0; e < edgeCount; ++e) {
+            currentCost += flows[e] * costs[e];
+        }
+        result.relativeGap = currentCost > 0.0 ? (currentCost - shortestCost) / currentCost : 0.0;
+        result.gapHistory.push_back(result.relativeGap);
+        result.timeHistory.push_back(secondsSince(start));
+        result.iterations = iteration;
+        if (result.relativeGap <= options.relativeGapTarget) {
+            result.converged = true;
+            break;
+        }
+
+        // Line search: the Beckmann objective along flows -> target is
+        // convex, so find where its derivative changes sign
+        auto slope = [&](double step) {
+            double sum = 0.0;
+            for (size_t e = 0; e < edgeCount; ++e) {
+                const double direction = target[e] - flows[e];
+                if (direction != 0.0) {
+                    sum += direction * linkPrice(static_cast<int>(e), flows[e] + step * direction);
+                }
+            }
+            return sum;
+        };
+        double step = 1.0;
+        if (slope(1.0) > 0.0) {
+            double low = 0.0;
+            double high = 1.0;
+            for (int i = 0; i < kLineSearchSteps; ++i) {
+                const double middle = (low + high) / 2.0;
+                (slope(middle) > 0.0 ? high : low) = middle;
+            }
+            step = (low + high) / 2.0;
+        }
+        for (size_t e = 0; e < edgeCount; ++e) {
+            flows[e] += step * (target[e] - flows[e]);
+        }
+    }
+    return result;
+}
+
+struct TrafficAssignment::Bush {
+    std::vector<char> contains;     // By edge index
+    std::vector<double> flow;       // This origin's flow by edge index
+    std::vector<NodeId> order;      // Bush nodes in topological order, origin first
+};
+
+struct TrafficAssignment::BushScratch {
+    explicit BushScratch(int nodeSlots)
+        : minLabel(nodeSlots, 0.0), maxLabel(nodeSlots, 0.0), minPred(nodeSlots, -1), maxPred(nodeSlots, -1),
+          position(nodeSlots, 0), indegree(nodeSlots, 0), mark(nodeSlots, 0) {
+    }
+    std::vector<double> minLabel;   // Cheapest route cost within the bush
+    std::vector<double> maxLabel;   // Costliest route cost over edges carrying flow
+    std::vector<int> minPred;
+    std::vector<int> maxPred;
+    std::vector<int> position;      // Index in the bush's topological order
+    std::vector<int> indegree;
+    std::vector<unsigned> mark;
+    unsigned stamp = 0;
+    std::vector<int> cheapSegment;
+    std::vector<int> costlySegment;
+};
+
+void TrafficAssignment::sortBush(Bush& bush, NodeId origin, BushScratch& scratch) const {
+    for (size_t e = 0; e < bush.contains.size(); ++e) {
+        if (bush.contains[e]) {
+            ++scratch.indegree[head[e]];
+        }
+    }
+    bush.order.clear();
+    bush.order.push_back(origin);
+    for (size_t i = 0; i < bush.order.size(); ++i) {
+        const NodeId node = bush.order[i];
+        for (int slot = firstOut[node]; slot < firstOut[node + 1]; ++slot) {
+            const int e = outEdges[slot];
+            if (bush.contains[e] && --scratch.indegree[head[e]] == 0) {
+                bush.order.push_back(head[e]);
+            }
+        }
+    }
+}
+
+void TrafficAssignment::updateBush(Bush& bush, NodeId origin, const std::vector<double>& costs,
+                                   BushScratch& scratch) const {
+    // Drop unused edges. A node no flow reaches keeps one way in, the
+    // cheapest, so its label below follows the cheapest route there.
+    auto& cheapest = scratch.minLabel;
+    for (NodeId node : bush.order) {
+        if (node == origin) {
+            cheapest[node] = 0.0;
+            continue;
+        }
+        bool used = false;
+        int keep = -1;
+        cheapest[node] = std::numeric_limits<double>::infinity();
+        for (int slot = firstIn[node]; slot < firstIn[node + 1]; ++slot) {
+            const int e = inEdges[slot];
+            if (!bush.contains[e]) continue;
+            used = used || bush.flow[e] > 0.0;
+            if (cheapest[tail[e]] + costs[e] < cheapest[node]) {
+                cheapest[node] = cheapest[tail[e]] + costs[e];
+                keep = e;
+            }
+        }
+        for (int slot = firstIn[node]; slot < firstIn[node + 1]; ++slot) {
+            const int e = inEdges[slot];
+            if (bush.contains[e] && bush.flow[e] <= 0.0 && (used || e != keep)) {
+                bush.contains[e] = 0;
+            }
+        }
+    }
+
+    // Cheapest and costliest route to each node over the remaining bush
+    // edges. Every bush edge runs from a lower to a strictly higher
+    // costliest label, so adding only edges that keep that property
+    // leaves the bush acyclic (Nie's relaxation of Dial's rule: the edge
+    // must shorten the cheapest route, not the costliest one).
+    auto& costliest = scratch.maxLabel;
+    const unsigned inBush = ++scratch.stamp;
+    for (NodeId node : bush.order) {
+        scratch.mark[node] = inBush;
+        if (node == origin) {
+            costliest[node] = 0.0;
+            continue;
+        }
+        cheapest[node] = std::numeric_limits<double>::infinity();
+        costliest[node] = 0.0;
+        for (int slot = firstIn[node]; slot < firstIn[node + 1]; ++slot) {
+            const int e = inEdges[slot];
+            if (bush.contains[e]) {
+                cheapest[node] = std::min(cheapest[node], cheapest[tail[e]] + costs[e]);
+                costliest[node] = std::max(costliest[node], costliest[tail[e]] + costs[e]);
+            }
+        }
+    }
+
+    for (NodeId node : bush.order) {
+        for (int slot = firstOut[node]; slot < firstOut[node + 1]; ++slot) {
+            const int e = outEdges[slot];
+            const NodeId next = head[e];
+            if (!bush.contains[e] && next != origin && scratch.mark[next] == inBush &&
+                costliest[node] < costliest[next] && cheapest[node] + costs[e] < cheapest[next]) {
+                bush.contains[e] = 1;
+                bush.flow[e] = 0.0;
+            }
+        }
+    }
+    sortBush(bush, origin, scratch);
+}
+
+bool TrafficAssignment::equilibrateBush(Bush& bush, NodeId origin, std::vector<double>& flows,
+                                        std::vector<double>& costs, double tolerance, BushScratch& scratch) const {
+    const double infinity = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < bush.order.size(); ++i) {
+        const NodeId node = bush.order[i];
+        scratch.position[node] = static_cast<int>(i);
+        scratch.minPred[node] = -1;
+        scratch.maxPred[node] = -1;
+        if (node == origin) {
+            scratch.minLabel[node] = 0.0;
+            scratch.maxLabel[node] = 0.0;
+            continue;
+        }
+        scratch.minLabel[node] = infinity;
+        scratch.maxLabel[node] = -infinity;
+        for (int slot = firstIn[node]; slot < firstIn[node + 1]; ++slot) {
+            const int e = inEdges[slot];
+            if (!bush.contains[e]) continue;
+            const NodeId from = tail[e];
+            if (scratch.minLabel[from] + costs[e] < scratch.minLabel[node]) {
+                scratch.minLabel[node] = scratch.minLabel[from] + costs[e];
+                scratch.minPred[node] = e;
+            }
+            if (bush.flow[e] > 0.0 && scratch.maxLabel[from] + costs[e] > scratch.maxLabel[node]) {
+                scratch.maxLabel[node] = scratch.maxLabel[from] + costs[e];
+                scratch.maxPred[node] = e;
+            }
+        }
+    }
+
+    bool moved = false;
+    // Furthest nodes first: each shift moves flow between the cheapest and
+    // the costliest route into a node, from where the two diverge
+    for (size_t i = bush.order.size(); i-- > 1;) {
+        const NodeId node = bush.order[i];
+        if (scratch.maxPred[node] < 0 || scratch.maxPred[node] == scratch.minPred[node] ||
+            scratch.maxLabel[node] - scratch.minLabel[node] <= tolerance * scratch.maxLabel[node]) {
+            continue;
+        }
+
+        // Step back along whichever route is further down the topological
+        // order until both reach the same node
+        scratch.cheapSegment.assign(1, scratch.minPred[node]);
+        scratch.costlySegment.assign(1, scratch.maxPred[node]);
+        NodeId cheapAt = tail[scratch.minPred[node]];
+        NodeId costlyAt = tail[scratch.maxPred[node]];
+        while (cheapAt != costlyAt) {
+            if (scratch.position[cheapAt] > scratch.position[costlyAt]) {
+                scratch.cheapSegment.push_back(scratch.minPred[cheapAt]);
+                cheapAt = tail[scratch.minPred[cheapAt]];
+            } else {
+                scratch.costlySegment.push_back(scratch.maxPred[costlyAt]);
+                costlyAt = tail[scratch.maxPred[costlyAt]];
+            }
+        }
+
+        double difference = 0.0;
+        double curvature = 0.0;
+        double movable = infinity;
+        for (int e : scratch.costlySegment) {
+            difference += costs[e];
+            curvature += linkPriceSlope(e, flows[e]);
+            movable = std::min(movable, bush.flow[e]);
+        }
+        for (int e : scratch.cheapSegment) {
+            difference -= costs[e];
+            curvature += linkPriceSlope(e, flows[e]);
+        }
+        if (!(difference > 0.0) || !(movable > 0.0)) continue;
+
+        // Cost of the costly segment minus the cheap one after shifting
+        // amount; decreasing, zero where the two balance
+        auto excess = [&](double amount) {
+            double sum = 0.0;
+            for (int e : scratch.costlySegment) sum += linkPrice(e, flows[e] - amount);
+            for (int e : scratch.cheapSegment) sum -= linkPrice(e, flows[e] + amount);
+            return sum;
+        };
+
+        // Newton step, halved while it overshoots (steep delay curves
+        // make the cheap side stiffer than its slope says)
+        double shift = curvature > 0.0 ? std::min(movable, difference / curvature) : movable;
+        for (int halving = 0; halving < kMaxHalvings && excess(shift) < 0.0; ++halving) {
+            shift /= 2.0;
+        }
+        if (!(shift > 0.0)) continue;
+
+        for (int e : scratch.costlySegment) {
+            bush.flow[e] = bush.flow[e] - shift > 0.0 ? bush.flow[e] - shift : 0.0;
+            flows[e] = std::max(flows[e] - shift, 0.0);
+            costs[e] = linkPrice(e, flows[e]);
+        }
+        for (int e : scratch.cheapSegment) {
+            bush.flow[e] += shift;
+            flows[e] += shift;
+            costs[e] = linkPrice(e, flows[e]);
+        }
+        moved = true;
+    }
+    return moved;
+}
+
+TrafficAssignment::Result TrafficAssignment::solveBushBased(const std::vector<Origin>& origins,
+                                                            const Options& options) const {
+    const auto start = std::chrono::steady_clock::now();
+    const size_t edgeCount = lengths.size();
+    const int originCount = static_cast<int>(origins.size());
+    const int threadCount = threadsFor(originCount, options.maxThreads);
+
+    Result result;
+    std::vector<double>& flows = result.edgeFlows;
+    flows.assign(edgeCount, 0.0);
+    std::vector<double> costs(edgeCount);
+    for (size_t e = 0; e < edgeCount; ++e) {
+        costs[e] = linkPrice(static_cast<int>(e), 0.0);
+    }
+
+    // Initial bushes: each origin's free-flow shortest-path tree over every
+    // reachable node, loaded all-or-nothing
+    std::vector<Bush> bushes(originCount);
+    std::vector<double> originUnrouted(originCount, 0.0);
+    runChunks(originCount, threadCount, [&](int, int begin, int end) {
+        TreeScratch tree(nodeSlots);
+        BushScratch scratch(nodeSlots);
+        for (int o = begin; o < end; ++o) {
+            Bush& bush = bushes[o];
+            bush.contains.assign(edgeCount, 0);
+            bush.flow.assign(edgeCount, 0.0);
+            growTree(origins, o, costs, tree, true);
+            const Origin& origin = origins[o];
+            for (NodeId node = 0; node < nodeSlots; ++node) {
+                if (tree.settledIn[node] == o && node != origin.node) {
+                    bush.contains[tree.predEdge[node]] = 1;
+                }
+            }
+            for (const auto& [destination, trips] : origin.destinations) {
+                if (tree.settledIn[destination] != o) {
+                    originUnrouted[o] += trips;
+                    continue;
+                }
+                for (NodeId node = destination; node != origin.node; node = tree.predNode[node]) {
+                    bush.flow[tree.predEdge[node]] += trips;
+                }
+            }
+            sortBush(bush, origin.node, scratch);
+        }
+    });
+    for (int o = 0; o < originCount; ++o) {
+        result.unroutedTrips += originUnrouted[o];
+        for (size_t e = 0; e < edgeCount; ++e) {
+            flows[e] += bushes[o].flow[e];
+        }
+    }
+
+    std::vector<double> target;
+    BushScratch scratch(nodeSlots);
+    for (int iteration = 1; iteration <= options.maxIterations; ++iteration) {
+        double currentCost = 0.0;
+        for (size_t e = 0; e < edgeCount; ++e) {
+            costs[e] = linkPrice(static_cast<int>(e), flows[e]);
+            currentCost += flows[e] * costs[e];
+        }
+        double unrouted = 0.0;
+        const double shortestCost = allOrNothing(origins, costs, target, unrouted, options.maxThreads);
+        result.relativeGap = currentCost > 0.0 ? (currentCost - shortestCost) / currentCost : 0.0;
+        result.gapHistory.push_back(result.relativeGap);
+        result.timeHistory.push_back(secondsSince(start));
+        result.iterations = iteration;
+        if (result.relativeGap <= options.relativeGapTarget) {
+            result.converged = true;
+            break;
+        }
+
+        // Bush updates read only the costs, so origins run in parallel
+        runChunks(originCount, threadCount, [&](int, int begin, int end) {
+            BushScratch local(nodeSlots);
+            for (int o = begin; o < end; ++o) {
+                updateBush(bushes[o], origins[o].node, costs, local);
+            }
+        });
+
+        // Shifts change the shared flows; origins take turns, each seeing
+        // the flows left by the previous ones. Interleaving the origins
+        // sweep by sweep converges faster than settling one at a time.
+        // Routes closer than a fraction of the current gap are left alone
+        const double tolerance = kToleranceShare * result.relativeGap;
+        for (int sweep = 0; sweep < kEquilibrationSweeps; ++sweep) {
+            bool moved = false;
+            for (int o = 0; o < originCount; ++o) {
+                moved = equilibrateBush(bushes[o], origins[o].node, flows, costs, tolerance, scratch) || moved;
+            }
+            if (!moved) break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,191 @@
+// code/analytics/TrafficAssignment.h
+#pragma once
+#include <utility>
+#include <vector>
+#include "../core/Types.h"
+#include "../core/City.h"
+#include "../core/VolumeDelayPolicy.h"
+
+class Agent;
+
+/**
+ * TrafficAssignment: static traffic assignment over a City's road graph
+ *
+ * Where the simulation routes agents one at a time, this solves for the
+ * steady state of a whole demand matrix at once. Link travel cost is the
+ * edge length scaled by a volume-delay function of flow / capacity
+ * (VolumeDelayPolicy, BPR by default).
+ *
+ * solveUserEquilibrium offers two methods:
+ * - FRANK_WOLFE: all-or-nothing assignments on the current costs, combined
+ *   with the running flows by a line search on the Beckmann objective.
+ *   Cheap per iteration but slow near equilibrium.
+ * - BUSH_BASED: origin-based (Dial's Algorithm B). Every origin keeps an
+ *   acyclic subnetwork (its bush) and its own flows on it across
+ *   iterations. Each iteration extends the bushes with shortcuts and
+ *   shifts flow from the costliest onto the cheapest route into every
+ *   node by a Newton step. A bush holds all its routes implicitly, so
+ *   grids with many equal-length paths are no harder than other
+ *   networks; gaps of 1e-6 and below take tens of iterations.
+ * Both stop once the relative gap drops below the target. Shortest-path
+ * trees and bush updates run in parallel over origins; flow shifts run
+ * origin by origin, so results do not depend on the thread count.
+ *
+ * solveSystemOptimum minimizes the total cost instead: it is the user
+ * equilibrium on marginal link costs (VolumeDelayPolicy::Pricing::MARGINAL)
+ * and reports the resulting flows at their actual costs, so
+ * priceOfAnarchy can compare the two totals directly.
+ *
+ * Flows are indexed by edge index (CityTopology::edgeIndex), like
+ * CityState occupancy and SimulationFrame::edgeOccupancy, so they can be
+ * laid directly next to what the simulation observed.
+ */
+class TrafficAssignment {
+public:
+    struct OdDemand {
+        NodeId origin;
+        NodeId destination;
+        double trips;
+    };
+
+    enum class Method { FRANK_WOLFE, BUSH_BASED };
+
+    struct Options {
+        Method method = Method::FRANK_WOLFE;
+        int maxIterations = 200;
+        double relativeGapTarget = 1e-4;
+        int maxThreads = 0;             // 0 = hardware concurrency
+    };
+
+    struct Result {
+        std::vector<double> edgeFlows;  // Trips per edge index
+        std::vector<double> edgeCosts;  // Link cost at the final flows
+        std::vector<double> gapHistory; // Relative gap seen by each iteration
+        std::vector<double> timeHistory;// Seconds since the solve started, per iteration
+        double relativeGap = 1.0;
+        int iterations = 0;
+        bool converged = false;
+        double totalCost = 0.0;         // Sum of flow * linkCost
+        double unroutedTrips = 0.0;     // Demand whose destination is unreachable
+        double wallSeconds = 0.0;
+    };
+
+    /**
+     * OD matrix implied by spawned agents: one trip per agent from its
+     * origin to its destination, merged per OD pair.
+     */
+    static std::vector<OdDemand> demandFromAgents(const std::vector<Agent*>& agents);
+
+    /**
+     * @param city Network to assign on (copied: shares the topology, keeps
+     *             its closures; occupancy is ignored)
+     * @param costFunction Link performance function (its pricing is ignored)
+     */
+    explicit TrafficAssignment(const City& city,
+                               VolumeDelayPolicy costFunction = VolumeDelayPolicy(VolumeDelayPolicy::Function::BPR));
+
+    /**
+     * Link cost of an edge index carrying the given flow.
+     */
+    double linkCost(int edgeIndex, double flow) const;
+
+    /**
+     * Derivative of linkCost with respect to flow.
+     */
+    double linkCostSlope(int edgeIndex, double flow) const;
+
+    /**
+     * User equilibrium: no traveller can lower their cost by switching
+     * routes.
+     * @throws std::runtime_error on negative demand or unknown nodes
+     */
+    Result solveUserEquilibrium(const std::vector<OdDemand>& demand, const Options& options) const;
+    Result solveUserEquilibrium(const std::vector<OdDemand>& demand) const {
+        return solveUserEquilibrium(demand, Options());
+    }
+
+    /**
+     * System optimum: the flows with the lowest total cost. Gaps and
+     * convergence refer to the marginal costs; edgeCosts and totalCost to
+     * the actual ones.
+     * @throws std::runtime_error on negative demand or unknown nodes
+     */
+    Result solveSystemOptimum(const std::vector<OdDemand>& demand, const Options& options) const;
+    Result solveSystemOptimum(const std::vector<OdDemand>& demand) const {
+        return solveSystemOptimum(demand, Options());
+    }
+
+    /**
+     * Price of anarchy: user equilibrium total cost over system optimum
+     * total cost (1 when the optimum costs nothing).
+     */
+    static double priceOfAnarchy(const Result& userEquilibrium, const Result& systemOptimum);
+
+private:
+    // Cost and slope the solvers equilibrate: linkCost, or the marginal
+    // cost when the cost function prices marginally
+    double linkPrice(int edgeIndex, double flow) const;
+    double linkPriceSlope(int edgeIndex, double flow) const;
+
+    struct Origin {
+        NodeId node;
+        std::vector<std::pair<NodeId, double>> destinations;
+    };
+
+    struct Bush;
+    struct BushScratch;
+
+    // Per-thread Dijkstra state, stamped by origin so it is never cleared
+    struct TreeScratch {
+        explicit TreeScratch(int nodeSlots);
+        std::vector<double> dist;
+        std::vector<int> predEdge;
+        std::vector<NodeId> predNode;
+        std::vector<int> settledIn;     // Origin whose tree settled the node
+        std::vector<int> reachedIn;     // Origin whose tree labelled the node
+        std::vector<char> wanted;
+        std::vector<std::pair<double, NodeId>> heap;
+    };
+
+    /**
+     * Shortest-path tree from origins[o], grown until all of its
+     * destinations are settled (or, if complete, every reachable node).
+     */
+    void growTree(const std::vector<Origin>& origins, int o, const std::vector<double>& costs,
+                  TreeScratch& scratch, bool complete = false) const;
+
+    Result solveFrankWolfe(const std::vector<Origin>& origins, const Options& options) const;
+    Result solveBushBased(const std::vector<Origin>& origins, const Options& options) const;
+
+    // Topological order of the bush's nodes, origin first
+    void sortBush(Bush& bush, NodeId origin, BushScratch& scratch) const;
+    // Drop unused edges, add edges that shorten the cheapest routes
+    void updateBush(Bush& bush, NodeId origin, const std::vector<double>& costs, BushScratch& scratch) const;
+    // Shift this origin's flow from costliest to cheapest routes into
+    // nodes where they differ by more than tolerance (relative); keeps
+    // flows and costs current. Returns whether any flow moved.
+    bool equilibrateBush(Bush& bush, NodeId origin, std::vector<double>& flows, std::vector<double>& costs,
+                         double tolerance, BushScratch& scratch) const;
+
+    /**
+     * All-or-nothing: send every trip down its shortest path for the given
+     * costs, in parallel over origins.
+     * @return Sum over OD pairs of trips * shortest path cost
+     */
+    double allOrNothing(const std::vector<Origin>& origins, const std::vector<double>& costs,
+                        std::vector<double>& flows, double& unrouted, int maxThreads) const;
+
+    std::vector<Origin> groupByOrigin(const std::vector<OdDemand>& demand) const;
+
+    City city;
+    VolumeDelayPolicy costFunction;
+    int nodeSlots = 0;
+    std::vector<int> firstOut;          // Node id -> first slot in outEdges
+    std::vector<int> outEdges;          // Open edge indices grouped by source node
+    std::vector<int> firstIn;           // Node id -> first slot in inEdges
+    std::vector<int> inEdges;           // Open edge indices grouped by target node
+    std::vector<NodeId> tail;           // Edge index -> source node
+    std::vector<NodeId> head;           // Edge index -> target node
+    std::vector<double> lengths;        // Edge index -> length
+    std::vector<int> capacities;        // Edge index -> capacity
+};
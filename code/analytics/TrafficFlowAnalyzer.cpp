@@ -127,18 +127,35 @@ std::vector<TrafficFlowAnalyzer::TimePattern> TrafficFlowAnalyzer::analyzeTimePa
 std::vector<TrafficFlowAnalyzer::Hotspot> TrafficFlowAnalyzer::getTopBottlenecks(
     const City& city, int topN) const {
     
-    auto hotspots = detectHotspots(city, 0.0);  // Get all edges
+    std::vector<Hotspot> hotspots;
+    if (topN <= 0) {
+        return hotspots;
+    }
     
-    // Sort by congestion
-    std::sort(hotspots.begin(), hotspots.end(),
+    int edgeCount = city.getEdgeCount();
+    hotspots.reserve(edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        EdgeId edgeId = city.getEdgeIdByIndex(i);
+        int occupancy = city.occupancy(edgeId);
+        int capacity = city.edgeCapacity(edgeId);
+        if (capacity == 0) continue;
+        
+        Hotspot hotspot;
+        hotspot.edgeId = edgeId;
+        hotspot.congestionLevel = calculateCongestionLevel(occupancy, capacity);
+        hotspot.currentOccupancy = occupancy;
+        hotspot.capacity = capacity;
+        hotspot.utilization = static_cast<double>(occupancy) / capacity;
+        hotspots.push_back(hotspot);
+    }
+    
+    // Only the first N need to be in order
+    size_t keep = std::min(hotspots.size(), static_cast<size_t>(topN));
+    std::partial_sort(hotspots.begin(), hotspots.begin() + keep, hotspots.end(),
         [](const Hotspot& a, const Hotspot& b) {
             return a.congestionLevel > b.congestionLevel;
         });
-    
-    // Return top N
-    if (static_cast<int>(hotspots.size()) > topN) {
-        hotspots.resize(topN);
-    }
+    hotspots.resize(keep);
     
     return hotspots;
 }
@@ -152,7 +169,7 @@ double TrafficFlowAnalyzer::calculateUtilization(const City& city, EdgeId edgeId
     return static_cast<double>(occupancy) / capacity;
 }
 
-double TrafficFlowAnalyzer::calculateCongestionLevel(int occupancy, int capacity) const {
+double TrafficFlowAnalyzer::calculateCongestionLevel(int occupancy, int capacity) {
     if (capacity == 0) return 0.0;
     
     double utilization = static_cast<double>(occupancy) / capacity;
@@ -80,7 +80,8 @@ public:
     std::vector<TimePattern> analyzeTimePatterns(const std::vector<std::pair<int, double>>& history) const;
 
     /**
-     * Get top N bottlenecks
+     * Get top N bottlenecks (full scan; see HotspotTracker for an
+     * incrementally maintained ranking)
      */
     std::vector<Hotspot> getTopBottlenecks(const City& city, int topN = 10) const;
 
@@ -89,9 +90,8 @@ public:
      */
     double calculateUtilization(const City& city, EdgeId edgeId) const;
 
-private:
     /**
-     * Calculate congestion level (0.0 to 1.0)
+     * Calculate congestion level (0.0 to 1.0); increases with utilization
      */
-    double calculateCongestionLevel(int occupancy, int capacity) const;
+    static double calculateCongestionLevel(int occupancy, int capacity);
 };
\ No newline at end of file
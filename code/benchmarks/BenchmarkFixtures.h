@@ -0,0 +1,91 @@
+// code/benchmarks/BenchmarkFixtures.h
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+#include "../adapters/PresetLoader.h"
+#include "../core/City.h"
+#include "../core/Preset.h"
+#include "../core/Types.h"
+
+/**
+ * Shared setup for gridlock_bench.
+ * Everything random is drawn from kBenchmarkSeed so runs are comparable
+ * across machines and over time.
+ */
+namespace bench {
+
+constexpr unsigned int kBenchmarkSeed = 20240611;
+
+/**
+ * Origin/destination selection for routing benchmarks.
+ */
+enum class OdPattern {
+    SHORT,   // Neighbouring intersections
+    LONG,    // Opposite corners
+    RANDOM   // Uniform random pairs
+};
+
+inline std::unique_ptr<City> makeGrid(int side) {
+    PresetLoader loader;
+    return loader.createGridTopology(side, side);
+}
+
+inline std::vector<std::pair<NodeId, NodeId>> makeOdPairs(int side, OdPattern pattern, int count) {
+    std::mt19937 rng(kBenchmarkSeed);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::vector<std::pair<NodeId, NodeId>> pairs;
+    pairs.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        switch (pattern) {
+            case OdPattern::SHORT: {
+                int row = coord(rng);
+                int col = std::min(coord(rng), side - 2);
+                pairs.push_back({row * side + col, row * side + col + 1});
+                break;
+            }
+            case OdPattern::LONG:
+                pairs.push_back(i % 2 == 0 ? std::make_pair(0, side * side - 1)
+                                           : std::make_pair(side - 1, (side - 1) * side));
+                break;
+            case OdPattern::RANDOM: {
+                NodeId origin = coord(rng) * side + coord(rng);
+                NodeId destination = coord(rng) * side + coord(rng);
+                if (destination == origin) {
+                    destination = (origin + 1) % (side * side);
+                }
+                pairs.push_back({origin, destination});
+                break;
+            }
+        }
+    }
+    return pairs;
+}
+
+/**
+ * Load every edge to a random fraction of its capacity.
+ */
+inline void fillOccupancy(City& city, double meanLoad) {
+    std::mt19937 rng(kBenchmarkSeed);
+    std::uniform_real_distribution<double> load(0.0, 2.0 * meanLoad);
+    for (int i = 0; i < city.getEdgeCount(); ++i) {
+        EdgeId id = city.getEdgeIdByIndex(i);
+        city.setOccupancy(id, static_cast<int>(load(rng) * city.edgeCapacity(id)));
+    }
+}
+
+inline Preset makePreset(int side, int agents, PolicyType policy) {
+    Preset preset;
+    preset.setName("bench");
+    preset.setRows(side);
+    preset.setCols(side);
+    preset.setAgentCount(agents);
+    preset.setTickMs(100);
+    preset.setPolicy(policy);
+    return preset;
+}
+
+}  // namespace bench
@@ -0,0 +1,69 @@
+// code/benchmarks/bench_city.cpp
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "BenchmarkFixtures.h"
+
+/**
+ * City lookup and occupancy update costs on a grid of the given side.
+ */
+
+namespace {
+    std::vector<EdgeId> randomEdges(const City& city, int count) {
+        std::mt19937 rng(bench::kBenchmarkSeed);
+        std::uniform_int_distribution<int> index(0, city.getEdgeCount() - 1);
+        std::vector<EdgeId> edges;
+        for (int i = 0; i < count; ++i) {
+            edges.push_back(city.getEdgeIdByIndex(index(rng)));
+        }
+        return edges;
+    }
+}
+
+static void BM_CityGetEdge(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    const City& view = *city;
+    auto edges = randomEdges(view, 4096);
+    size_t next = 0;
+    for (auto _ : state) {
+        const Edge& edge = view.getEdge(edges[next++ & 4095]);
+        benchmark::DoNotOptimize(edge.getLength());
+    }
+}
+BENCHMARK(BM_CityGetEdge)->Arg(10)->Arg(100);
+
+static void BM_CityOutgoingEdges(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    const City& view = *city;
+    const int nodes = view.getNodeCount();
+    int node = 0;
+    for (auto _ : state) {
+        const auto& outgoing = view.outgoingEdges(node);
+        benchmark::DoNotOptimize(outgoing.data());
+        node = node + 1 == nodes ? 0 : node + 1;
+    }
+}
+BENCHMARK(BM_CityOutgoingEdges)->Arg(10)->Arg(100);
+
+static void BM_CityOccupancyUpdate(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    auto edges = randomEdges(*city, 4096);
+    size_t next = 0;
+    for (auto _ : state) {
+        EdgeId edge = edges[next++ & 4095];
+        city->incrementOccupancy(edge);
+        city->decrementOccupancy(edge);
+        benchmark::DoNotOptimize(city->occupancy(edge));
+    }
+}
+BENCHMARK(BM_CityOccupancyUpdate)->Arg(10)->Arg(100);
+
+static void BM_CityIsEdgeBlocked(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    auto edges = randomEdges(*city, 4096);
+    size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(city->isEdgeBlocked(edges[next++ & 4095]));
+    }
+}
+BENCHMARK(BM_CityIsEdgeBlocked)->Arg(10)->Arg(100);
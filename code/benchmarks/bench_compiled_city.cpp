@@ -0,0 +1,59 @@
+// code/benchmarks/bench_compiled_city.cpp
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include "../adapters/CompiledCity.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/City.h"
+
+/**
+ * Startup benchmarks for large networks.
+ * Compares building a grid edge by edge (PresetLoader::createGridTopology)
+ * with loading the same grid from a memory-mapped compiled city file.
+ * A 500x500 grid has roughly one million directed edges.
+ */
+
+static void BM_CreateGridTopology(benchmark::State& state) {
+    int side = static_cast<int>(state.range(0));
+    PresetLoader loader;
+    for (auto _ : state) {
+        auto city = loader.createGridTopology(side, side);
+        benchmark::DoNotOptimize(city.get());
+    }
+    state.counters["edges"] = 4.0 * side * (side - 1);
+}
+BENCHMARK(BM_CreateGridTopology)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadCompiledCity(benchmark::State& state) {
+    int side = static_cast<int>(state.range(0));
+    std::string path = "/tmp/gridlock_bench_city_" + std::to_string(side) + ".glcity";
+    {
+        PresetLoader loader;
+        CompiledCity::writeFile(path, *loader.createGridTopology(side, side)->getTopology());
+    }
+    for (auto _ : state) {
+        CompiledCity compiled(path);
+        auto city = compiled.createCity();
+        benchmark::DoNotOptimize(city.get());
+    }
+    state.counters["edges"] = 4.0 * side * (side - 1);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_LoadCompiledCity)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+static void BM_MapCompiledCity(benchmark::State& state) {
+    int side = static_cast<int>(state.range(0));
+    std::string path = "/tmp/gridlock_bench_map_" + std::to_string(side) + ".glcity";
+    {
+        PresetLoader loader;
+        CompiledCity::writeFile(path, *loader.createGridTopology(side, side)->getTopology());
+    }
+    // Mapping alone: what in-place consumers of the CSR arrays pay
+    for (auto _ : state) {
+        CompiledCity compiled(path);
+        benchmark::DoNotOptimize(compiled.adjacencyOffsets());
+    }
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_MapCompiledCity)->Arg(500)->Unit(benchmark::kMillisecond);
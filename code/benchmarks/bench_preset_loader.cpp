@@ -0,0 +1,78 @@
+// code/benchmarks/bench_preset_loader.cpp
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include "../adapters/JsonReader.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/Preset.h"
+#include "BenchmarkFixtures.h"
+
+/**
+ * Parse-time benchmarks for preset JSON.
+ * Generates multi-megabyte presets (large "blocked" and "agents" arrays)
+ * with the shared benchmark seed and reports bytes/second for the
+ * tokenizer alone and for the full PresetLoader parse.
+ */
+
+namespace {
+    // Writes a preset with `pairs` blocked edges and `pairs` agent routes
+    std::string writeLargePreset(int pairs) {
+        std::string path = "/tmp/gridlock_bench_preset_" + std::to_string(pairs) + ".json";
+        std::mt19937 rng(bench::kBenchmarkSeed);
+        std::uniform_int_distribution<int> node(0, 100 * 100 - 1);
+
+        std::ofstream out(path);
+        out << "{\n  \"name\": \"bench\",\n  \"rows\": 100,\n  \"cols\": 100,\n"
+            << "  \"agentCount\": " << pairs << ",\n  \"tickMs\": 100,\n"
+            << "  \"policy\": \"CONGESTION_AWARE\",\n  \"blocked\": [";
+        for (int i = 0; i < pairs; ++i) {
+            out << (i ? ", " : "") << "[" << node(rng) << ", " << node(rng) << "]";
+        }
+        out << "],\n  \"agents\": [";
+        for (int i = 0; i < pairs; ++i) {
+            out << (i ? ", " : "") << "[" << node(rng) << ", " << node(rng) << "]";
+        }
+        out << "]\n}\n";
+        return path;
+    }
+
+    std::size_t fileSize(const std::string& path) {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return static_cast<std::size_t>(in.tellg());
+    }
+}
+
+static void BM_JsonReaderTokenize(benchmark::State& state) {
+    std::string path = writeLargePreset(static_cast<int>(state.range(0)));
+    std::size_t bytes = fileSize(path);
+
+    for (auto _ : state) {
+        JsonReader reader;
+        reader.open(path);
+        std::size_t tokens = 0;
+        while (reader.next() != JsonReader::Token::END_OF_INPUT) {
+            ++tokens;
+        }
+        benchmark::DoNotOptimize(tokens);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_JsonReaderTokenize)->Arg(50000)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+static void BM_PresetLoaderParse(benchmark::State& state) {
+    std::string path = writeLargePreset(static_cast<int>(state.range(0)));
+    std::size_t bytes = fileSize(path);
+    PresetLoader loader;
+
+    for (auto _ : state) {
+        Preset preset = loader.loadFromJson(path);
+        benchmark::DoNotOptimize(preset.getBlockedEdges().data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_PresetLoaderParse)->Arg(50000)->Arg(200000)->Unit(benchmark::kMillisecond);
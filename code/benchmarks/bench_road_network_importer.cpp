@@ -0,0 +1,88 @@
+// code/benchmarks/bench_road_network_importer.cpp
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include "../adapters/RoadNetworkImporter.h"
+
+/**
+ * Import benchmarks on a generated London-sized road network.
+ * The network is a jittered lon/lat lattice around central London written
+ * as GeoJSON line strings (several shape points per road) and as a CSV edge
+ * list; side 280 gives roughly 300k directed edges.
+ */
+
+namespace {
+    constexpr double kStep = 0.0009;   // ~100 m in latitude
+
+    double lon(int c) { return -0.25 + c * kStep * 1.6; }
+    double lat(int r) { return 51.40 + r * kStep; }
+
+    std::string writeGeoJson(int side) {
+        std::string path = "/tmp/gridlock_bench_roads_" + std::to_string(side) + ".geojson";
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> jitter(-kStep * 0.1, kStep * 0.1);
+        std::ofstream out(path);
+        out.precision(9);
+        out << "{\"type\": \"FeatureCollection\", \"features\": [\n";
+        bool first = true;
+        auto road = [&](double x1, double y1, double x2, double y2) {
+            out << (first ? "" : ",\n")
+                << "{\"type\": \"Feature\", \"properties\": {\"capacity\": 12}, "
+                << "\"geometry\": {\"type\": \"LineString\", \"coordinates\": [[" << x1 << ", " << y1 << "]";
+            for (int k = 1; k < 4; ++k) {
+                double t = k / 4.0;
+                out << ", [" << x1 + (x2 - x1) * t + jitter(rng) << ", " << y1 + (y2 - y1) * t + jitter(rng) << "]";
+            }
+            out << ", [" << x2 << ", " << y2 << "]]}}";
+            first = false;
+        };
+        for (int r = 0; r < side; ++r) {
+            for (int c = 0; c < side; ++c) {
+                if (c + 1 < side) road(lon(c), lat(r), lon(c + 1), lat(r));
+                if (r + 1 < side) road(lon(c), lat(r), lon(c), lat(r + 1));
+            }
+        }
+        out << "\n]}\n";
+        return path;
+    }
+
+    std::string writeCsv(int side) {
+        std::string path = "/tmp/gridlock_bench_roads_" + std::to_string(side) + ".csv";
+        std::ofstream out(path);
+        out.precision(9);
+        out << "from_x,from_y,to_x,to_y,capacity\n";
+        for (int r = 0; r < side; ++r) {
+            for (int c = 0; c < side; ++c) {
+                if (c + 1 < side) out << lon(c) << "," << lat(r) << "," << lon(c + 1) << "," << lat(r) << ",12\n";
+                if (r + 1 < side) out << lon(c) << "," << lat(r) << "," << lon(c) << "," << lat(r + 1) << ",12\n";
+            }
+        }
+        return path;
+    }
+}
+
+static void BM_ImportGeoJson(benchmark::State& state) {
+    std::string path = writeGeoJson(static_cast<int>(state.range(0)));
+    RoadNetworkImporter importer;
+    for (auto _ : state) {
+        auto topology = importer.importGeoJson(path);
+        benchmark::DoNotOptimize(topology.get());
+    }
+    state.counters["edges"] = importer.getStats().edges;
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_ImportGeoJson)->Arg(280)->Unit(benchmark::kMillisecond);
+
+static void BM_ImportCsv(benchmark::State& state) {
+    std::string path = writeCsv(static_cast<int>(state.range(0)));
+    RoadNetworkImporter importer;
+    for (auto _ : state) {
+        auto topology = importer.importCsv(path);
+        benchmark::DoNotOptimize(topology.get());
+    }
+    state.counters["edges"] = importer.getStats().edges;
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_ImportCsv)->Arg(280)->Unit(benchmark::kMillisecond);
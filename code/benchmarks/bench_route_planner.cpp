@@ -0,0 +1,253 @@
+// code/benchmarks/bench_route_planner.cpp
+#include <benchmark/benchmark.h>
+#include "BenchmarkFixtures.h"
+#include "../core/Agent.h"
+#include "../core/CongestionAwarePolicy.h"
+#include "../core/EdgeCostProfiles.h"
+#include "../core/EdgeCostTable.h"
+#include "../core/ReservationTable.h"
+#include "../core/RoutePlanner.h"
+#include "../core/ShortestPathPolicy.h"
+#include <vector>
+
+/**
+ * RoutePlanner::computePath throughput.
+ * Arguments: grid side, OD pattern (0 short, 1 long, 2 random).
+ * Congestion-aware runs use a loaded network so costs differ per edge.
+ */
+
+namespace {
+    constexpr int kPairsPerRun = 64;
+
+    template <typename Policy>
+    void runComputePath(benchmark::State& state) {
+        const int side = static_cast<int>(state.range(0));
+        const auto pattern = static_cast<bench::OdPattern>(state.range(1));
+        auto city = bench::makeGrid(side);
+        bench::fillOccupancy(*city, 0.4);
+        auto pairs = bench::makeOdPairs(side, pattern, kPairsPerRun);
+
+        Policy policy;
+        RoutePlanner planner(&policy);
+        size_t next = 0;
+        for (auto _ : state) {
+            const auto& od = pairs[next++ % pairs.size()];
+            Agent agent(0, od.first, od.second);
+            auto path = planner.computePath(*city, agent);
+            benchmark::DoNotOptimize(path.size());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    }
+
+    // Eight ticks of occupancy drifting up or down by edge, ending at the
+    // city's current occupancy
+    std::vector<std::vector<int>> driftingHistory(const City& city) {
+        const std::vector<int>& now = city.getState().occupancyData();
+        std::vector<std::vector<int>> history(8, now);
+        for (int tick = 0; tick < 8; ++tick) {
+            for (size_t e = 0; e < now.size(); ++e) {
+                int drift = (e % 3 == 0) ? tick - 7 : (e % 3 == 1 ? 7 - tick : 0);
+                history[tick][e] = std::max(now[e] + drift, 0);
+            }
+        }
+        return history;
+    }
+
+    void gridAndPatternArgs(benchmark::internal::Benchmark* b) {
+        for (int side : {10, 50, 100}) {
+            for (int pattern : {0, 1, 2}) {
+                b->Args({side, pattern});
+            }
+        }
+        b->ArgNames({"side", "od"});
+        b->Unit(benchmark::kMicrosecond);
+    }
+}
+
+static void BM_ComputePath_ShortestPath(benchmark::State& state) {
+    runComputePath<ShortestPathPolicy>(state);
+}
+BENCHMARK(BM_ComputePath_ShortestPath)->Apply(gridAndPatternArgs);
+
+static void BM_ComputePath_CongestionAware(benchmark::State& state) {
+    runComputePath<CongestionAwarePolicy>(state);
+}
+BENCHMARK(BM_ComputePath_CongestionAware)->Apply(gridAndPatternArgs);
+
+static void BM_ComputePath_CostTable(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    const auto pattern = static_cast<bench::OdPattern>(state.range(1));
+    auto city = bench::makeGrid(side);
+    bench::fillOccupancy(*city, 0.4);
+    auto pairs = bench::makeOdPairs(side, pattern, kPairsPerRun);
+
+    CongestionAwarePolicy policy;
+    RoutePlanner planner(&policy);
+    EdgeCostTable table;
+    table.rebuild(*city, policy);
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto& od = pairs[next++ % pairs.size()];
+        auto path = planner.computePath(*city, od.first, od.second, table.costs());
+        benchmark::DoNotOptimize(path.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ComputePath_CostTable)->Apply(gridAndPatternArgs);
+
+/**
+ * Whole-network recost, as done after the city or policy is replaced.
+ * Argument: grid side.
+ */
+static void BM_EdgeCostTable_Rebuild(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.4);
+    CongestionAwarePolicy policy;
+    EdgeCostTable table;
+    for (auto _ : state) {
+        table.rebuild(*city, policy);
+        benchmark::DoNotOptimize(table.costs().data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_EdgeCostTable_Rebuild)->Arg(100)->Arg(500)->ArgName("side")->Unit(benchmark::kMicrosecond);
+
+static void BM_ComputePath_TimeDependent(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    const auto pattern = static_cast<bench::OdPattern>(state.range(1));
+    auto city = bench::makeGrid(side);
+    bench::fillOccupancy(*city, 0.4);
+    auto pairs = bench::makeOdPairs(side, pattern, kPairsPerRun);
+
+    CongestionAwarePolicy policy;
+    RoutePlanner planner(&policy);
+    auto profiles = EdgeCostProfiles::fromHistory(*city, policy, driftingHistory(*city), 0.0, 2.0, 16, 2.0);
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto& od = pairs[next++ % pairs.size()];
+        auto path = planner.computePath(*city, od.first, od.second, profiles, 0.0);
+        benchmark::DoNotOptimize(path.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ComputePath_TimeDependent)->Apply(gridAndPatternArgs);
+
+/**
+ * Profile prediction from eight ticks of history, 16 breakpoints, into a
+ * new profile set. Argument: grid side.
+ */
+static void BM_EdgeCostProfiles_FromHistory(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.4);
+    CongestionAwarePolicy policy;
+    auto history = driftingHistory(*city);
+    for (auto _ : state) {
+        auto profiles = EdgeCostProfiles::fromHistory(*city, policy, history, 0.0, 2.0, 16, 2.0);
+        benchmark::DoNotOptimize(profiles.storedSamples());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_EdgeCostProfiles_FromHistory)->Arg(100)->Arg(500)->ArgName("side")->Unit(benchmark::kMicrosecond);
+
+/**
+ * The same prediction rebuilt in place, as done by the first
+ * time-dependent search of each profile slot. Argument: grid side.
+ */
+static void BM_EdgeCostProfiles_Rebuild(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.4);
+    CongestionAwarePolicy policy;
+    auto history = driftingHistory(*city);
+    EdgeCostProfiles profiles;
+    for (auto _ : state) {
+        profiles.rebuild(*city, policy, history, 0.0, 2.0, 16, 2.0);
+        benchmark::DoNotOptimize(profiles.storedSamples());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_EdgeCostProfiles_Rebuild)->Arg(100)->Arg(500)->ArgName("side")->Unit(benchmark::kMicrosecond);
+
+/**
+ * Moving the profiles one slot on when 1 edge in 32 changed its trend, as
+ * done by the first time-dependent search of each later slot. Argument:
+ * grid side.
+ */
+static void BM_EdgeCostProfiles_Update(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.4);
+    CongestionAwarePolicy policy;
+    auto history = driftingHistory(*city);
+    auto moved = history;
+    for (size_t e = 0; e < moved.back().size(); e += 32) {
+        ++moved.back()[e];
+    }
+    EdgeCostProfiles profiles;
+    profiles.rebuild(*city, policy, history, 0.0, 2.0, 16, 2.0);
+    double start = 0.0;
+    for (auto _ : state) {
+        start += 2.0;
+        profiles.update(*city, policy, (static_cast<int>(start) & 2) ? moved : history, start);
+        benchmark::DoNotOptimize(profiles.storedSamples());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_EdgeCostProfiles_Update)->Arg(100)->Arg(500)->ArgName("side")->Unit(benchmark::kMicrosecond);
+
+/**
+ * Latency of one k-shortest-paths query over a cost table (random OD).
+ * Arguments: grid side, k.
+ */
+static void BM_AlternativePaths(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    const int k = static_cast<int>(state.range(1));
+    auto city = bench::makeGrid(side);
+    bench::fillOccupancy(*city, 0.4);
+    auto pairs = bench::makeOdPairs(side, bench::OdPattern::RANDOM, kPairsPerRun);
+
+    CongestionAwarePolicy policy;
+    RoutePlanner planner(&policy);
+    EdgeCostTable table;
+    table.rebuild(*city, policy);
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto& od = pairs[next++ % pairs.size()];
+        auto routes = planner.alternativePaths(*city, od.first, od.second, table.costs(), k);
+        benchmark::DoNotOptimize(routes.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_AlternativePaths)
+    ->ArgsProduct({{10, 50, 100}, {1, 4, 8}})
+    ->ArgNames({"side", "k"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Space-time search around reserved capacity, with every OD pair's route
+ * already claimed on a 64-tick table.
+ */
+static void BM_ComputePath_Reserved(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    const auto pattern = static_cast<bench::OdPattern>(state.range(1));
+    auto city = bench::makeGrid(side);
+    bench::fillOccupancy(*city, 0.4);
+    auto pairs = bench::makeOdPairs(side, pattern, kPairsPerRun);
+
+    CongestionAwarePolicy policy;
+    RoutePlanner planner(&policy);
+    EdgeCostTable table;
+    table.rebuild(*city, policy);
+    ReservationTable reservations(city->getEdgeCount(), 64);
+    std::vector<ReservationTable::Claim> claims;
+    for (const auto& od : pairs) {
+        planner.computePath(*city, od.first, od.second, table.costs(), reservations, 0, 0.5, &claims);
+        reservations.claimRoute(claims, city->getTopology()->capacityData(), city->getState().occupancyData(), 0);
+    }
+    size_t next = 0;
+    for (auto _ : state) {
+        const auto& od = pairs[next++ % pairs.size()];
+        auto path = planner.computePath(*city, od.first, od.second, table.costs(), reservations, 0, 0.5, &claims);
+        benchmark::DoNotOptimize(path.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ComputePath_Reserved)->Apply(gridAndPatternArgs);
@@ -0,0 +1,46 @@
+// code/benchmarks/bench_simulation.cpp
+#include <benchmark/benchmark.h>
+#include "BenchmarkFixtures.h"
+#include "../core/SimulationController.h"
+
+/**
+ * SimulationController::tick cost at varying agent densities.
+ * Arguments: grid side, agent count, policy (0 shortest, 1 congestion-aware).
+ * The controller is reloaded outside the timed region every `side` ticks.
+ * An average trip crosses about two thirds of the side in edges at two
+ * ticks each, so most agents are still travelling when the reload happens
+ * and every measured tick does comparable work.
+ */
+
+static void BM_SimulationTick(benchmark::State& state) {
+    const int side = static_cast<int>(state.range(0));
+    const int agents = static_cast<int>(state.range(1));
+    const auto policy = state.range(2) == 0 ? PolicyType::SHORTEST_PATH : PolicyType::CONGESTION_AWARE;
+    const Preset preset = bench::makePreset(side, agents, policy);
+    const int ticksPerLoad = side;  // Shorter than the average trip (~1.3 * side ticks)
+
+    SimulationController controller;
+    controller.loadPreset(preset);
+    int ticks = 0;
+    for (auto _ : state) {
+        if (ticks == ticksPerLoad) {
+            state.PauseTiming();
+            controller.loadPreset(preset);
+            ticks = 0;
+            state.ResumeTiming();
+        }
+        controller.tick();
+        ++ticks;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * agents);
+}
+BENCHMARK(BM_SimulationTick)
+    ->ArgNames({"side", "agents", "policy"})
+    ->Args({20, 50, 0})
+    ->Args({20, 500, 0})
+    ->Args({50, 500, 0})
+    ->Args({50, 1000, 0})
+    ->Args({20, 50, 1})
+    ->Args({20, 500, 1})
+    ->Args({50, 500, 1})
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,53 @@
+// code/benchmarks/bench_traffic_assignment.cpp
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "BenchmarkFixtures.h"
+#include "../analytics/TrafficAssignment.h"
+
+/**
+ * Static user equilibrium on a 20 x 20 grid with random OD demand, solved
+ * to a relative gap of 10^-range(0) by each method.
+ */
+
+namespace {
+    std::vector<TrafficAssignment::OdDemand> randomDemand(int side, int pairs, double trips) {
+        std::vector<TrafficAssignment::OdDemand> demand;
+        for (const auto& [origin, destination] : bench::makeOdPairs(side, bench::OdPattern::RANDOM, pairs)) {
+            demand.push_back({origin, destination, trips});
+        }
+        return demand;
+    }
+
+    void solve(benchmark::State& state, TrafficAssignment::Method method) {
+        const int side = 20;
+        auto city = bench::makeGrid(side);
+        TrafficAssignment assignment(*city);
+        auto demand = randomDemand(side, 200, 4.0);
+
+        TrafficAssignment::Options options;
+        options.method = method;
+        options.maxIterations = 500;
+        options.relativeGapTarget = 1.0;
+        for (int i = 0; i < state.range(0); ++i) {
+            options.relativeGapTarget /= 10.0;
+        }
+
+        TrafficAssignment::Result result;
+        for (auto _ : state) {
+            result = assignment.solveUserEquilibrium(demand, options);
+            benchmark::DoNotOptimize(result.edgeFlows.data());
+        }
+        state.counters["iterations"] = result.iterations;
+        state.counters["gap"] = result.relativeGap;
+    }
+}
+
+static void BM_UserEquilibrium_FrankWolfe(benchmark::State& state) {
+    solve(state, TrafficAssignment::Method::FRANK_WOLFE);
+}
+BENCHMARK(BM_UserEquilibrium_FrankWolfe)->Arg(3)->Unit(benchmark::kMillisecond);
+
+static void BM_UserEquilibrium_BushBased(benchmark::State& state) {
+    solve(state, TrafficAssignment::Method::BUSH_BASED);
+}
+BENCHMARK(BM_UserEquilibrium_BushBased)->Arg(3)->Arg(4)->Arg(5)->Unit(benchmark::kMillisecond);
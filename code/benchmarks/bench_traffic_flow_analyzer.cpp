@@ -0,0 +1,82 @@
+// code/benchmarks/bench_traffic_flow_analyzer.cpp
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+#include "BenchmarkFixtures.h"
+#include "../analytics/TrafficFlowAnalyzer.h"
+#include "../core/Agent.h"
+
+/**
+ * TrafficFlowAnalyzer functions on loaded grids of the given side.
+ */
+
+static void BM_DetectHotspots(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.5);
+    TrafficFlowAnalyzer analyzer;
+    for (auto _ : state) {
+        auto hotspots = analyzer.detectHotspots(*city, 0.8);
+        benchmark::DoNotOptimize(hotspots.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_DetectHotspots)->Arg(20)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+static void BM_TopBottlenecks(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.5);
+    TrafficFlowAnalyzer analyzer;
+    for (auto _ : state) {
+        auto top = analyzer.getTopBottlenecks(*city, 10);
+        benchmark::DoNotOptimize(top.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_TopBottlenecks)->Arg(20)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+static void BM_UtilizationHeatmap(benchmark::State& state) {
+    auto city = bench::makeGrid(static_cast<int>(state.range(0)));
+    bench::fillOccupancy(*city, 0.5);
+    TrafficFlowAnalyzer analyzer;
+    for (auto _ : state) {
+        auto heatmap = analyzer.getUtilizationHeatmap(*city);
+        benchmark::DoNotOptimize(heatmap.size());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * city->getEdgeCount());
+}
+BENCHMARK(BM_UtilizationHeatmap)->Arg(20)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+static void BM_FlowData(benchmark::State& state) {
+    const int side = 50;
+    auto pairs = bench::makeOdPairs(side, bench::OdPattern::RANDOM, static_cast<int>(state.range(0)));
+    std::vector<std::unique_ptr<Agent>> agents;
+    std::vector<Agent*> pointers;
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        agents.push_back(std::make_unique<Agent>(static_cast<int>(i), pairs[i].first, pairs[i].second));
+        pointers.push_back(agents.back().get());
+    }
+    TrafficFlowAnalyzer analyzer;
+    for (auto _ : state) {
+        auto flows = analyzer.getFlowData(pointers);
+        benchmark::DoNotOptimize(flows.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_FlowData)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_TimePatterns(benchmark::State& state) {
+    std::mt19937 rng(bench::kBenchmarkSeed);
+    std::uniform_real_distribution<double> congestion(0.0, 1.0);
+    std::vector<std::pair<int, double>> history;
+    for (int tick = 0; tick < state.range(0); ++tick) {
+        history.push_back({tick, congestion(rng)});
+    }
+    TrafficFlowAnalyzer analyzer;
+    for (auto _ : state) {
+        auto patterns = analyzer.analyzeTimePatterns(history);
+        benchmark::DoNotOptimize(patterns.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_TimePatterns)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
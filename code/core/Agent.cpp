@@ -1,7 +1,9 @@
 // code/core/Agent.cpp
 #include "Agent.h"
 #include "City.h"
+#include "TickProfiler.h"
 #include <stdexcept>
+#include <utility>
 
 Agent::Agent(int id, NodeId origin, NodeId destination)
     : id(id), 
@@ -18,6 +20,11 @@ Agent::Agent(int id, NodeId origin, NodeId destination)
     }
 }
 
+Agent::Agent(const State& state)
+    : Agent(state.id, state.origin, state.destination) {
+    setState(state);
+}
+
 bool Agent::needsRoute() const {
     return path.empty() && !arrived;
 }
@@ -42,7 +49,7 @@ void Agent::step(City& city) {
     // If currently on an edge, finish traversing it
     if (currentEdge.has_value()) {
         EdgeId edgeId = currentEdge.value();
-        Edge& edge = city.getEdge(edgeId);
+        const Edge& edge = std::as_const(city).getEdge(edgeId);
         
         // Decrement occupancy of the edge we're leaving
         city.decrementOccupancy(edgeId);
@@ -69,10 +76,9 @@ void Agent::step(City& city) {
     
     // Try to move onto the next edge in the path
     EdgeId nextEdge = path.front();
-    Edge& edge = city.getEdge(nextEdge);
     
     // Check if edge is blocked
-    if (edge.isBlocked()) {
+    if (city.isEdgeBlocked(nextEdge)) {
         // Agent needs to reroute (handled by SimulationController)
         path.clear();
         return;
@@ -87,11 +93,19 @@ void Agent::step(City& city) {
         path.pop_front();
         currentEdge = nextEdge;
         city.incrementOccupancy(nextEdge);
+    } else {
+        // Wait at current node (capacity full)
+        GRIDLOCK_PROFILE_COUNT(TickCounter::CAPACITY_WAITS, 1);
     }
-    // else: wait at current node (capacity full)
     // Note: stepsTaken still increments even if waiting (time passes)
 }
 
+void Agent::wait() {
+    if (!arrived) {
+        stepsTaken++;
+    }
+}
+
 int Agent::getId() const {
     return id;
 }
@@ -122,4 +136,32 @@ std::optional<EdgeId> Agent::getCurrentEdge() const {
 
 const std::deque<EdgeId>& Agent::getPath() const {
     return path;
-}
\ No newline at end of file
+}
+
+Agent::State Agent::getState() const {
+    State state;
+    state.id = id;
+    state.origin = origin;
+    state.destination = destination;
+    state.currentNode = currentNode;
+    state.currentEdge = currentEdge;
+    state.path = path;
+    state.departureTime = departureTime;
+    state.arrivalTime = arrivalTime;
+    state.arrived = arrived;
+    state.stepsTaken = stepsTaken;
+    return state;
+}
+
+void Agent::setState(const State& state) {
+    id = state.id;
+    origin = state.origin;
+    destination = state.destination;
+    currentNode = state.currentNode;
+    currentEdge = state.currentEdge;
+    path = state.path;
+    departureTime = state.departureTime;
+    arrivalTime = state.arrivalTime;
+    arrived = state.arrived;
+    stepsTaken = state.stepsTaken;
+}
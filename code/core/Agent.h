@@ -9,7 +9,24 @@ class City;
 
 class Agent {
 public:
+    /**
+     * Complete mutable state of an agent (for checkpoint/restore and forking).
+     */
+    struct State {
+        int id = 0;
+        NodeId origin = INVALID_NODE;
+        NodeId destination = INVALID_NODE;
+        NodeId currentNode = INVALID_NODE;
+        std::optional<EdgeId> currentEdge;
+        std::deque<EdgeId> path;
+        int departureTime = 0;
+        int arrivalTime = -1;
+        bool arrived = false;
+        int stepsTaken = 0;
+    };
+
     Agent(int id, NodeId origin, NodeId destination);
+    explicit Agent(const State& state);
     
     // Route management
     bool needsRoute() const;
@@ -18,6 +35,7 @@ public:
     
     // Movement
     void step(City& city);
+    void wait();  // Spend a tick at the current node without trying to move
     
     // Getters
     int getId() const;
@@ -28,6 +46,10 @@ public:
     std::optional<EdgeId> getCurrentEdge() const;
     const std::deque<EdgeId>& getPath() const;
     
+    // Checkpoint support
+    State getState() const;
+    void setState(const State& state);
+    
 private:
     int id;
     NodeId origin;
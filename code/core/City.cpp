@@ -1,65 +1,80 @@
 // code/core/City.cpp
 #include "City.h"
 #include <stdexcept>
-#include <algorithm>
 #include <string>
 
+City::City() {
+    auto created = std::make_shared<CityTopology>();
+    ownedTopology = created.get();
+    topology = std::move(created);
+}
+
+City::City(std::shared_ptr<const CityTopology> topology)
+    : topology(std::move(topology)) {
+    if (!this->topology) {
+        throw std::runtime_error("City requires a topology");
+    }
+    state.resize(this->topology->getEdgeCount());
+}
+
+City::City(std::shared_ptr<CityTopology> topology)
+    : City(std::shared_ptr<const CityTopology>(topology)) {
+    ownedTopology = topology.get();
+}
+
+CityTopology& City::mutableTopology() {
+    // Copy-on-write: never mutate a topology other runs can see
+    if (!ownedTopology || topology.use_count() > 1) {
+        auto copy = std::make_shared<CityTopology>(*topology);
+        ownedTopology = copy.get();
+        topology = std::move(copy);
+    }
+    return *ownedTopology;
+}
+
+int City::requireEdgeIndex(EdgeId edgeId) const {
+    int index = topology->edgeIndex(edgeId);
+    if (index < 0) {
+        throw std::runtime_error("Edge not found: " + std::to_string(edgeId));
+    }
+    return index;
+}
+
 void City::addNode(const Node& node) {
-    nodes.push_back(node);
-    // Initialize adjacency list for this node
-    adjacency[node.getId()] = std::vector<EdgeId>();
+    mutableTopology().addNode(node);
 }
 
 void City::addEdge(const Edge& edge) {
-    edges.push_back(edge);
-    // Initialize occupancy to 0
-    occ[edge.getId()] = 0;
-    // Add edge to adjacency list of the 'from' node
-    adjacency[edge.getFrom()].push_back(edge.getId());
+    mutableTopology().addEdge(edge);
+    // New edges start with zero occupancy
+    state.resize(topology->getEdgeCount());
 }
 
 Node& City::getNode(NodeId id) {
-    auto it = std::find_if(nodes.begin(), nodes.end(),
-                          [id](const Node& n) { return n.getId() == id; });
-    if (it == nodes.end()) {
-        throw std::runtime_error("Node not found: " + std::to_string(id));
-    }
-    return *it;
+    // Validate first so a failed lookup never triggers a copy
+    topology->getNode(id);
+    return mutableTopology().getNode(id);
 }
 
 Edge& City::getEdge(EdgeId id) {
-    auto it = std::find_if(edges.begin(), edges.end(),
-                          [id](const Edge& e) { return e.getId() == id; });
-    if (it == edges.end()) {
-        throw std::runtime_error("Edge not found: " + std::to_string(id));
-    }
-    return *it;
+    topology->getEdge(id);
+    return mutableTopology().getEdge(id);
 }
 
 const Node& City::getNode(NodeId id) const {
-    auto it = std::find_if(nodes.begin(), nodes.end(),
-                          [id](const Node& n) { return n.getId() == id; });
-    if (it == nodes.end()) {
-        throw std::runtime_error("Node not found: " + std::to_string(id));
-    }
-    return *it;
+    return topology->getNode(id);
 }
 
 const Edge& City::getEdge(EdgeId id) const {
-    auto it = std::find_if(edges.begin(), edges.end(),
-                          [id](const Edge& e) { return e.getId() == id; });
-    if (it == edges.end()) {
-        throw std::runtime_error("Edge not found: " + std::to_string(id));
-    }
-    return *it;
+    return topology->getEdge(id);
 }
 
 std::vector<EdgeId> City::neighbors(NodeId nodeId) const {
-    auto it = adjacency.find(nodeId);
-    if (it == adjacency.end()) {
-        return std::vector<EdgeId>();  // Return empty vector if node has no neighbors
-    }
-    return it->second;
+    return topology->outgoing(nodeId);
+}
+
+const std::vector<EdgeId>& City::outgoingEdges(NodeId nodeId) const {
+    return topology->outgoing(nodeId);
 }
 
 int City::edgeCapacity(EdgeId edgeId) const {
@@ -71,59 +86,86 @@ double City::edgeLength(EdgeId edgeId) const {
 }
 
 int City::occupancy(EdgeId edgeId) const {
-    auto it = occ.find(edgeId);
-    if (it == occ.end()) {
+    int index = topology->edgeIndex(edgeId);
+    if (index < 0) {
         return 0;  // Default to 0 if not found
     }
-    return it->second;
+    return state.occupancy(index);
 }
 
 void City::setOccupancy(EdgeId edgeId, int occupancy) {
-    int capacity = edgeCapacity(edgeId);
+    int index = requireEdgeIndex(edgeId);
+    int capacity = topology->getEdges()[index].getCapacity();
     // Clamp occupancy to valid range [0, capacity]
     if (occupancy < 0) {
         occupancy = 0;
     } else if (occupancy > capacity) {
         occupancy = capacity;
     }
-    occ[edgeId] = occupancy;
+    state.setOccupancy(index, occupancy);
 }
 
 void City::incrementOccupancy(EdgeId edgeId) {
-    int current = occupancy(edgeId);
-    int capacity = edgeCapacity(edgeId);
+    int index = requireEdgeIndex(edgeId);
+    int current = state.occupancy(index);
+    int capacity = topology->getEdges()[index].getCapacity();
     // Only increment if below capacity
     if (current < capacity) {
-        occ[edgeId] = current + 1;
+        state.setOccupancy(index, current + 1);
     }
 }
 
 void City::decrementOccupancy(EdgeId edgeId) {
-    int current = occupancy(edgeId);
+    int index = topology->edgeIndex(edgeId);
+    if (index < 0) {
+        return;
+    }
+    int current = state.occupancy(index);
     // Only decrement if above 0
     if (current > 0) {
-        occ[edgeId] = current - 1;
+        state.setOccupancy(index, current - 1);
     }
 }
 
+bool City::isEdgeBlocked(EdgeId edgeId) const {
+    int index = requireEdgeIndex(edgeId);
+    return topology->getEdges()[index].isBlocked() || state.isBlocked(index);
+}
+
+void City::setEdgeBlocked(EdgeId edgeId, bool blocked) {
+    state.setBlocked(requireEdgeIndex(edgeId), blocked);
+}
+
 int City::getNodeCount() const {
-    return static_cast<int>(nodes.size());
+    return topology->getNodeCount();
 }
 
 int City::getEdgeCount() const {
-    return static_cast<int>(edges.size());
+    return topology->getEdgeCount();
 }
 
 NodeId City::getNodeIdByIndex(int index) const {
-    if (index < 0 || index >= static_cast<int>(nodes.size())) {
+    if (index < 0 || index >= topology->getNodeCount()) {
         throw std::runtime_error("Node index out of range: " + std::to_string(index));
     }
-    return nodes[index].getId();
+    return topology->getNodes()[index].getId();
 }
 
 EdgeId City::getEdgeIdByIndex(int index) const {
-    if (index < 0 || index >= static_cast<int>(edges.size())) {
+    if (index < 0 || index >= topology->getEdgeCount()) {
         throw std::runtime_error("Edge index out of range: " + std::to_string(index));
     }
-    return edges[index].getId();
-}
\ No newline at end of file
+    return topology->getEdges()[index].getId();
+}
+
+std::shared_ptr<const CityTopology> City::getTopology() const {
+    return topology;
+}
+
+const CityState& City::getState() const {
+    return state;
+}
+
+CityState& City::getState() {
+    return state;
+}
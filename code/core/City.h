@@ -1,49 +1,93 @@
 // code/core/City.h
 #pragma once
 #include <vector>
-#include <unordered_map>
+#include <memory>
 #include "Types.h"
 #include "Node.h"
 #include "Edge.h"
+#include "CityTopology.h"
+#include "CityState.h"
 
+/**
+ * City is a view of one simulation run over a road network.
+ *
+ * It pairs a shared, immutable CityTopology with a private CityState
+ * (occupancy and run-time closures). Copying a City is cheap: the copy
+ * shares the topology and only duplicates the state arrays. Mutating the
+ * topology (addNode, addEdge, non-const getNode/getEdge) is copy-on-write:
+ * a City whose topology is shared detaches a private copy first.
+ */
 class City {
 public:
-    City() = default;
-    
+    City();
+
+    /**
+     * Create a run over an existing topology with empty state.
+     * @param topology Shared topology (must not be null)
+     */
+    explicit City(std::shared_ptr<const CityTopology> topology);
+
+    /**
+     * Take over a freshly built topology. While no other City shares it, it
+     * is mutated in place (bulk loaders use this to avoid a copy-on-write).
+     * @param topology Topology (must not be null)
+     */
+    explicit City(std::shared_ptr<CityTopology> topology);
+
     // Add nodes and edges
     void addNode(const Node& node);
     void addEdge(const Edge& edge);
-    
-    // Get nodes and edges (returns references for modification)
+
+    // Get nodes and edges (returns references for modification; copy-on-write)
     Node& getNode(NodeId id);
     Edge& getEdge(EdgeId id);
-    
+
     // Get nodes and edges (const versions)
     const Node& getNode(NodeId id) const;
     const Edge& getEdge(EdgeId id) const;
-    
+
     // Get neighbors (outgoing edges from a node)
     std::vector<EdgeId> neighbors(NodeId nodeId) const;
-    
+    const std::vector<EdgeId>& outgoingEdges(NodeId nodeId) const;
+
     // Edge properties
     int edgeCapacity(EdgeId edgeId) const;
     double edgeLength(EdgeId edgeId) const;
-    
+
     // Occupancy management
     int occupancy(EdgeId edgeId) const;
     void setOccupancy(EdgeId edgeId, int occ);
     void incrementOccupancy(EdgeId edgeId);
     void decrementOccupancy(EdgeId edgeId);
-    
+
+    /**
+     * Closure check used by routing and movement.
+     * An edge is blocked if it is closed in the topology (Edge::isBlocked)
+     * or closed for this run only (setEdgeBlocked).
+     */
+    bool isEdgeBlocked(EdgeId edgeId) const;
+
+    /**
+     * Close or reopen an edge for this run only; the shared topology is untouched.
+     */
+    void setEdgeBlocked(EdgeId edgeId, bool blocked);
+
     // Iteration helpers (for UI)
     int getNodeCount() const;
     int getEdgeCount() const;
     NodeId getNodeIdByIndex(int index) const;
     EdgeId getEdgeIdByIndex(int index) const;
-    
+
+    // Topology / state access
+    std::shared_ptr<const CityTopology> getTopology() const;
+    const CityState& getState() const;
+    CityState& getState();
+
 private:
-    std::vector<Node> nodes;
-    std::vector<Edge> edges;
-    std::unordered_map<EdgeId, int> occ;  // Edge occupancy
-    std::unordered_map<NodeId, std::vector<EdgeId>> adjacency;  // Node -> outgoing edges
-};
\ No newline at end of file
+    CityTopology& mutableTopology();  // Detach a private copy if shared
+    int requireEdgeIndex(EdgeId edgeId) const;
+
+    std::shared_ptr<const CityTopology> topology;
+    CityTopology* ownedTopology = nullptr;  // Non-null while this City created the topology
+    CityState state;
+};
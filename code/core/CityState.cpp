@@ -0,0 +1,40 @@
+// code/core/CityState.cpp
+#include "CityState.h"
+#include <algorithm>
+
+CityState::CityState(int edgeCount) {
+    resize(edgeCount);
+}
+
+void CityState::resize(int edgeCount) {
+    if (edgeCount < 0) {
+        edgeCount = 0;
+    }
+    occ.resize(static_cast<size_t>(edgeCount), 0);
+    blockedBits.resize((static_cast<size_t>(edgeCount) + 63) / 64, 0);
+
+    // Clear bits past the end so shrinking then growing starts open
+    if (edgeCount % 64 != 0 && !blockedBits.empty()) {
+        blockedBits.back() &= (std::uint64_t{1} << (edgeCount % 64)) - 1;
+    }
+}
+
+void CityState::clear() {
+    std::fill(occ.begin(), occ.end(), 0);
+    std::fill(blockedBits.begin(), blockedBits.end(), 0);
+}
+
+void CityState::setBlocked(int edgeIndex, bool blocked) {
+    std::uint64_t mask = std::uint64_t{1} << (edgeIndex & 63);
+    if (blocked) {
+        blockedBits[edgeIndex >> 6] |= mask;
+    } else {
+        blockedBits[edgeIndex >> 6] &= ~mask;
+    }
+}
+
+std::size_t CityState::memoryUsage() const {
+    return sizeof(*this)
+         + occ.capacity() * sizeof(int)
+         + blockedBits.capacity() * sizeof(std::uint64_t);
+}
@@ -0,0 +1,55 @@
+// code/core/CityState.h
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * CityState holds the mutable, per-run part of a City: edge occupancy and
+ * run-time edge closures.
+ *
+ * All accessors take a dense edge index (see CityTopology::edgeIndex), so a
+ * state is just two flat arrays and is cheap to copy when forking a run.
+ */
+class CityState {
+public:
+    CityState() = default;
+    explicit CityState(int edgeCount);
+
+    /**
+     * Grow or shrink to the given number of edges (new edges start empty and open).
+     */
+    void resize(int edgeCount);
+
+    /**
+     * Zero all occupancy and reopen all run-time closures.
+     */
+    void clear();
+
+    int getEdgeCount() const { return static_cast<int>(occ.size()); }
+
+    // Occupancy by edge index
+    int occupancy(int edgeIndex) const { return occ[edgeIndex]; }
+    void setOccupancy(int edgeIndex, int value) { occ[edgeIndex] = value; }
+
+    // Run-time closures by edge index
+    bool isBlocked(int edgeIndex) const {
+        return (blockedBits[edgeIndex >> 6] >> (edgeIndex & 63)) & 1u;
+    }
+    void setBlocked(int edgeIndex, bool blocked);
+
+    // Raw storage (for bulk readers and serialization)
+    const std::vector<int>& occupancyData() const { return occ; }
+    const std::vector<std::uint64_t>& blockedWords() const { return blockedBits; }
+    std::vector<int>& occupancyData() { return occ; }
+    std::vector<std::uint64_t>& blockedWords() { return blockedBits; }
+
+    /**
+     * Approximate heap footprint in bytes (for memory reporting).
+     */
+    std::size_t memoryUsage() const;
+
+private:
+    std::vector<int> occ;                    // Occupancy per edge index
+    std::vector<std::uint64_t> blockedBits;  // One bit per edge index
+};
@@ -0,0 +1,234 @@
+// code/core/CityTopology.cpp
+#include "CityTopology.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+    // Grow a dense id table so that `id` is a valid slot
+    void ensureSlot(std::vector<int>& table, int id) {
+        if (id >= static_cast<int>(table.size())) {
+            table.resize(static_cast<size_t>(id) + 1, -1);
+        }
+    }
+
+    const std::vector<EdgeId> kNoEdges;
+
+    // FNV-1a over raw bytes
+    void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+}
+
+CityTopology::CityTopology(std::vector<Node> nodeList, std::vector<Edge> edgeList)
+    : nodes(std::move(nodeList)), edges(std::move(edgeList)) {
+    const int slots = indexBulk();
+
+    // Counting pass so each adjacency list is allocated once at its final size
+    std::vector<int> degree(static_cast<size_t>(slots), 0);
+    for (const Edge& edge : edges) {
+        ++degree[edge.getFrom()];
+    }
+    adjacency.resize(degree.size());
+    for (size_t id = 0; id < degree.size(); ++id) {
+        adjacency[id].reserve(static_cast<size_t>(degree[id]));
+    }
+    for (const Edge& edge : edges) {
+        adjacency[edge.getFrom()].push_back(edge.getId());
+    }
+}
+
+CityTopology::CityTopology(std::vector<Node> nodeList, std::vector<Edge> edgeList,
+                           std::span<const std::uint32_t> adjacencyOffsets,
+                           std::span<const std::int32_t> adjacencyEdges)
+    : nodes(std::move(nodeList)), edges(std::move(edgeList)) {
+    const int slots = indexBulk();
+    if (adjacencyOffsets.size() != static_cast<size_t>(slots) + 1 || adjacencyOffsets.front() != 0 ||
+        adjacencyOffsets.back() != adjacencyEdges.size() || adjacencyEdges.size() != edges.size()) {
+        throw std::runtime_error("Adjacency does not match the edges");
+    }
+
+    // Sizes match, so listing no edge twice means listing every edge once
+    std::vector<char> listed(edges.size(), 0);
+    adjacency.resize(static_cast<size_t>(slots));
+    for (int id = 0; id < slots; ++id) {
+        const std::uint32_t first = adjacencyOffsets[id];
+        const std::uint32_t last = adjacencyOffsets[id + 1];
+        if (last < first || last > adjacencyEdges.size()) {
+            throw std::runtime_error("Adjacency offsets are not monotonic");
+        }
+        // Every entry must be an edge leaving this node
+        for (std::uint32_t i = first; i < last; ++i) {
+            const int index = edgeIndex(adjacencyEdges[i]);
+            if (index < 0 || edges[index].getFrom() != id || listed[index]) {
+                throw std::runtime_error("Adjacency does not match the edges at node " + std::to_string(id));
+            }
+            listed[index] = 1;
+        }
+        adjacency[id].assign(adjacencyEdges.begin() + first, adjacencyEdges.begin() + last);
+    }
+}
+
+int CityTopology::indexBulk() {
+    int maxNodeId = -1;
+    for (const Node& node : nodes) {
+        if (node.getId() < 0) {
+            throw std::runtime_error("Invalid node id: " + std::to_string(node.getId()));
+        }
+        maxNodeId = std::max(maxNodeId, node.getId());
+    }
+    int maxEdgeId = -1;
+    for (const Edge& edge : edges) {
+        if (edge.getId() < 0 || edge.getFrom() < 0) {
+            throw std::runtime_error("Invalid edge id: " + std::to_string(edge.getId()));
+        }
+        maxEdgeId = std::max(maxEdgeId, edge.getId());
+        maxNodeId = std::max(maxNodeId, edge.getFrom());
+    }
+    lengths.reserve(edges.size());
+    capacities.reserve(edges.size());
+    for (const Edge& edge : edges) {
+        lengths.push_back(edge.getLength());
+        capacities.push_back(edge.getCapacity());
+    }
+
+    // First occurrence wins, as with addNode/addEdge
+    nodeIndexById.assign(static_cast<size_t>(maxNodeId) + 1, -1);
+    for (size_t i = nodes.size(); i-- > 0;) {
+        nodeIndexById[nodes[i].getId()] = static_cast<int>(i);
+    }
+    edgeIndexById.assign(static_cast<size_t>(maxEdgeId) + 1, -1);
+    for (size_t i = edges.size(); i-- > 0;) {
+        edgeIndexById[edges[i].getId()] = static_cast<int>(i);
+    }
+    return maxNodeId + 1;
+}
+
+void CityTopology::addNode(const Node& node) {
+    int id = node.getId();
+    if (id < 0) {
+        throw std::runtime_error("Invalid node id: " + std::to_string(id));
+    }
+    ++revision;
+    ensureSlot(nodeIndexById, id);
+    if (nodeIndexById[id] < 0) {
+        nodeIndexById[id] = static_cast<int>(nodes.size());
+    }
+    nodes.push_back(node);
+
+    if (id >= static_cast<int>(adjacency.size())) {
+        adjacency.resize(static_cast<size_t>(id) + 1);
+    }
+}
+
+void CityTopology::addEdge(const Edge& edge) {
+    int id = edge.getId();
+    if (id < 0 || edge.getFrom() < 0) {
+        throw std::runtime_error("Invalid edge id: " + std::to_string(id));
+    }
+    ++revision;
+    ensureSlot(edgeIndexById, id);
+    if (edgeIndexById[id] < 0) {
+        edgeIndexById[id] = static_cast<int>(edges.size());
+    }
+    edges.push_back(edge);
+    lengths.push_back(edge.getLength());
+    capacities.push_back(edge.getCapacity());
+
+    // Add edge to adjacency list of the 'from' node
+    if (edge.getFrom() >= static_cast<int>(adjacency.size())) {
+        adjacency.resize(static_cast<size_t>(edge.getFrom()) + 1);
+    }
+    adjacency[edge.getFrom()].push_back(id);
+}
+
+int CityTopology::edgeIndex(EdgeId id) const {
+    if (id < 0 || id >= static_cast<int>(edgeIndexById.size())) {
+        return -1;
+    }
+    return edgeIndexById[id];
+}
+
+int CityTopology::nodeIndex(NodeId id) const {
+    if (id < 0 || id >= static_cast<int>(nodeIndexById.size())) {
+        return -1;
+    }
+    return nodeIndexById[id];
+}
+
+const Node& CityTopology::getNode(NodeId id) const {
+    int index = nodeIndex(id);
+    if (index < 0) {
+        throw std::runtime_error("Node not found: " + std::to_string(id));
+    }
+    return nodes[index];
+}
+
+const Edge& CityTopology::getEdge(EdgeId id) const {
+    int index = edgeIndex(id);
+    if (index < 0) {
+        throw std::runtime_error("Edge not found: " + std::to_string(id));
+    }
+    return edges[index];
+}
+
+Node& CityTopology::getNode(NodeId id) {
+    ++revision;
+    return const_cast<Node&>(static_cast<const CityTopology&>(*this).getNode(id));
+}
+
+Edge& CityTopology::getEdge(EdgeId id) {
+    ++revision;
+    return const_cast<Edge&>(static_cast<const CityTopology&>(*this).getEdge(id));
+}
+
+const std::vector<EdgeId>& CityTopology::outgoing(NodeId nodeId) const {
+    if (nodeId < 0 || nodeId >= static_cast<int>(adjacency.size())) {
+        return kNoEdges;
+    }
+    return adjacency[nodeId];
+}
+
+int CityTopology::getNodeCount() const {
+    return static_cast<int>(nodes.size());
+}
+
+int CityTopology::getEdgeCount() const {
+    return static_cast<int>(edges.size());
+}
+
+std::size_t CityTopology::memoryUsage() const {
+    std::size_t bytes = sizeof(*this);
+    bytes += nodes.capacity() * sizeof(Node);
+    bytes += edges.capacity() * sizeof(Edge);
+    bytes += lengths.capacity() * sizeof(double);
+    bytes += capacities.capacity() * sizeof(int);
+    bytes += nodeIndexById.capacity() * sizeof(int);
+    bytes += edgeIndexById.capacity() * sizeof(int);
+    bytes += adjacency.capacity() * sizeof(std::vector<EdgeId>);
+    for (const auto& list : adjacency) {
+        bytes += list.capacity() * sizeof(EdgeId);
+    }
+    return bytes;
+}
+
+std::uint64_t CityTopology::fingerprint() const {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const Node& node : nodes) {
+        std::int32_t fields[3] = {node.getId(), node.getRow(), node.getCol()};
+        hashBytes(hash, fields, sizeof(fields));
+    }
+    for (const Edge& edge : edges) {
+        std::int32_t fields[5] = {edge.getId(), edge.getFrom(), edge.getTo(),
+                                  edge.getCapacity(), edge.isBlocked() ? 1 : 0};
+        hashBytes(hash, fields, sizeof(fields));
+        double length = edge.getLength();
+        hashBytes(hash, &length, sizeof(length));
+    }
+    return hash;
+}
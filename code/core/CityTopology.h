@@ -0,0 +1,120 @@
+// code/core/CityTopology.h
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Types.h"
+#include "Node.h"
+#include "Edge.h"
+
+/**
+ * CityTopology holds the static part of a road network: nodes, edges,
+ * lengths, capacities and adjacency.
+ *
+ * A topology is built once and then shared read-only (via
+ * std::shared_ptr<const CityTopology>) by every City, simulation run and
+ * analyzer working on the same network. Per-run data such as occupancy
+ * lives in CityState instead.
+ *
+ * Node and edge ids are expected to be non-negative; lookups by id are
+ * O(1) through dense id -> index tables.
+ */
+class CityTopology {
+public:
+    CityTopology() = default;
+
+    /**
+     * Bulk construction from complete node and edge lists.
+     * Equivalent to calling addNode/addEdge in list order, but sizes every
+     * table (including each adjacency list) exactly once, so loading a
+     * million-edge network does not pay for incremental growth.
+     * @throws std::runtime_error on negative ids
+     */
+    CityTopology(std::vector<Node> nodes, std::vector<Edge> edges);
+
+    /**
+     * Bulk construction with a precomputed adjacency in CSR form, as stored
+     * by CompiledCity: the outgoing edge ids of node id n are
+     * adjacencyEdges[adjacencyOffsets[n] .. adjacencyOffsets[n + 1]).
+     * Skips the degree counting pass; every entry is checked against its
+     * edge, so the result equals the constructor above.
+     * @throws std::runtime_error on negative ids or an adjacency that does
+     *         not match the edges
+     */
+    CityTopology(std::vector<Node> nodes, std::vector<Edge> edges,
+                 std::span<const std::uint32_t> adjacencyOffsets, std::span<const std::int32_t> adjacencyEdges);
+
+    // Construction (only used while the topology is still private to one City)
+    void addNode(const Node& node);
+    void addEdge(const Edge& edge);
+
+    // Lookups by id (throw std::runtime_error if not found)
+    const Node& getNode(NodeId id) const;
+    const Edge& getEdge(EdgeId id) const;
+    Node& getNode(NodeId id);
+    Edge& getEdge(EdgeId id);
+
+    /**
+     * Dense index of an edge (position in insertion order).
+     * @return Index in [0, getEdgeCount()), or -1 if the id is unknown
+     */
+    int edgeIndex(EdgeId id) const;
+
+    /**
+     * Dense index of a node (position in insertion order).
+     * @return Index in [0, getNodeCount()), or -1 if the id is unknown
+     */
+    int nodeIndex(NodeId id) const;
+
+    /**
+     * Outgoing edges of a node.
+     * @return Reference to the edge id list (empty list for unknown nodes)
+     */
+    const std::vector<EdgeId>& outgoing(NodeId nodeId) const;
+
+    int getNodeCount() const;
+    int getEdgeCount() const;
+    const std::vector<Node>& getNodes() const { return nodes; }
+    const std::vector<Edge>& getEdges() const { return edges; }
+
+    // Edge lengths and capacities by edge index, as flat arrays for bulk
+    // (vectorized) readers; they mirror getEdges()
+    const std::vector<double>& lengthData() const { return lengths; }
+    const std::vector<int>& capacityData() const { return capacities; }
+
+    /**
+     * Approximate heap footprint in bytes (for memory reporting).
+     */
+    std::size_t memoryUsage() const;
+
+    /**
+     * Stable 64-bit hash of nodes and edges (ids, endpoints, lengths,
+     * capacities, closures). Used to check that saved state matches a network.
+     */
+    std::uint64_t fingerprint() const;
+
+    /**
+     * Bumped by every mutating call (addNode, addEdge, non-const getNode /
+     * getEdge). Readers that cache data derived from the topology compare
+     * it to detect in-place edits.
+     */
+    std::uint64_t getRevision() const { return revision; }
+
+private:
+    /**
+     * Validate ids and fill the flat arrays and id tables of the bulk
+     * constructors.
+     * @return Adjacency slots needed (largest node or edge source id + 1)
+     */
+    int indexBulk();
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+    std::vector<double> lengths;                    // Edge index -> length
+    std::vector<int> capacities;                    // Edge index -> capacity
+    std::vector<int> nodeIndexById;                 // NodeId -> index, -1 if absent
+    std::vector<int> edgeIndexById;                 // EdgeId -> index, -1 if absent
+    std::vector<std::vector<EdgeId>> adjacency;     // NodeId -> outgoing edges
+    std::uint64_t revision = 0;
+};
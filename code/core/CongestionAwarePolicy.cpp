@@ -2,6 +2,11 @@
 #include "CongestionAwarePolicy.h"
 #include "City.h"
 #include "Agent.h"
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 double CongestionAwarePolicy::edgeCost(const City& city, EdgeId edgeId) const {
     // Get basic edge properties
@@ -9,11 +14,66 @@ double CongestionAwarePolicy::edgeCost(const City& city, EdgeId edgeId) const {
     int capacity = city.edgeCapacity(edgeId);
     int occupancy = city.occupancy(edgeId);
     
-    // Calculate congestion factor: occupancy / capacity
-    double congestionFactor = static_cast<double>(occupancy) / static_cast<double>(capacity);
-    
     // Apply formula: length + alpha * (occupancy / capacity)
-    return length + alpha * congestionFactor;
+    return cost(length, capacity, occupancy);
+}
+
+double CongestionAwarePolicy::loadedEdgeCost(const City& city, EdgeId edgeId, int extraLoad) const {
+    return cost(city.edgeLength(edgeId), city.edgeCapacity(edgeId), city.occupancy(edgeId) + extraLoad);
+}
+
+void CongestionAwarePolicy::edgeCosts(const City& city, std::span<const EdgeId> edgeIds,
+                                      std::span<float> out) const {
+    if (out.size() < edgeIds.size()) {
+        throw std::runtime_error("Edge cost output is shorter than the edge list");
+    }
+    const auto topology = city.getTopology();
+    const double* length = topology->lengthData().data();
+    const int* capacity = topology->capacityData().data();
+    const int* occupancy = city.getState().occupancyData().data();
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        int index = topology->edgeIndex(edgeIds[i]);
+        // Unknown ids take the scalar path, which reports them
+        out[i] = static_cast<float>(index >= 0 ? cost(length[index], capacity[index], occupancy[index])
+                                               : edgeCost(city, edgeIds[i]));
+    }
+}
+
+void CongestionAwarePolicy::allEdgeCosts(const City& city, std::span<float> out) const {
+    costsFor(city, city.getState().occupancyData().data(), out);
+}
+
+void CongestionAwarePolicy::loadedEdgeCosts(const City& city, std::span<const int> occupancy,
+                                            std::span<float> out) const {
+    if (occupancy.size() < city.getTopology()->lengthData().size()) {
+        throw std::runtime_error("Occupancy is shorter than the edge count");
+    }
+    costsFor(city, occupancy.data(), out);
+}
+
+void CongestionAwarePolicy::costsFor(const City& city, const int* occupancy, std::span<float> out) const {
+    const auto topology = city.getTopology();
+    const double* length = topology->lengthData().data();
+    const int* capacity = topology->capacityData().data();
+    const size_t count = topology->lengthData().size();
+    if (out.size() < count) {
+        throw std::runtime_error("Edge cost output is shorter than the edge count");
+    }
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Two edges per step in double precision, so every edge gets exactly
+    // the value edgeCost would return, rounded once to float
+    const __m128d a = _mm_set1_pd(alpha);
+    for (; i + 2 <= count; i += 2) {
+        __m128d occ = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(occupancy + i)));
+        __m128d cap = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(capacity + i)));
+        __m128d sum = _mm_add_pd(_mm_loadu_pd(length + i), _mm_mul_pd(a, _mm_div_pd(occ, cap)));
+        _mm_storel_pi(reinterpret_cast<__m64*>(out.data() + i), _mm_cvtpd_ps(sum));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<float>(cost(length[i], capacity[i], occupancy[i]));
+    }
 }
 
 bool CongestionAwarePolicy::shouldRerouteOnNode(const Agent& agent) const {
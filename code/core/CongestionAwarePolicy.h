@@ -21,6 +21,24 @@ public:
      */
     double edgeCost(const City& city, EdgeId edgeId) const override;
     
+    /**
+     * Batch edgeCost over the topology's flat arrays. The whole-network
+     * form is vectorized (SSE2 where available).
+     */
+    void edgeCosts(const City& city, std::span<const EdgeId> edgeIds, std::span<float> out) const override;
+    void allEdgeCosts(const City& city, std::span<float> out) const override;
+    double loadedEdgeCost(const City& city, EdgeId edgeId, int extraLoad) const override;
+    void loadedEdgeCosts(const City& city, std::span<const int> occupancy, std::span<float> out) const override;
+    
+    /**
+     * Cost from raw edge data (same formula as edgeCost). Inline so
+     * RoutePlanner's search specialized for this policy needs no virtual
+     * call or City lookup per relaxation.
+     */
+    double cost(double length, int capacity, int occupancy) const {
+        return length + alpha * (static_cast<double>(occupancy) / static_cast<double>(capacity));
+    }
+    
     /**
      * Determine if an agent should reroute when reaching a node.
      * CongestionAwarePolicy always reroutes to adapt to changing traffic.
@@ -28,8 +46,13 @@ public:
      * @return true (always reroute to adapt to congestion changes)
      */
     bool shouldRerouteOnNode(const Agent& agent) const override;
+    
+    double getAlpha() const { return alpha; }
 
 private:
+    // Whole-network costs for an occupancy array by edge index
+    void costsFor(const City& city, const int* occupancy, std::span<float> out) const;
+    
     /**
      * Congestion weight factor.
      * Higher values make congestion have more impact on routing decisions.
@@ -0,0 +1,257 @@
+// code/core/EdgeCostProfiles.cpp
+#include "EdgeCostProfiles.h"
+#include "City.h"
+#include "Edge.h"
+#include "IRoutePolicy.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Load at a tick offset along an edge's trend, clamped to
+    // [0, capacity]; clamped to be non-negative, so adding one half rounds
+    inline int predictLoad(double level, double trend, double offset, int capacity) {
+        const double upper = capacity > 0 ? capacity : 0;
+        const double value = std::clamp(level + trend * offset, 0.0, upper);
+        return static_cast<int>(value + 0.5);
+    }
+}
+
+EdgeCostProfiles::EdgeCostProfiles(double startTime, double slotWidth, int slotCount, double timePerCost) {
+    setAxis(startTime, slotWidth, slotCount, timePerCost);
+}
+
+void EdgeCostProfiles::setAxis(double start, double width, int count, double perCost) {
+    if (!(width > 0.0) || count < 1 || !(perCost > 0.0)) {
+        throw std::runtime_error("Invalid cost profile axis");
+    }
+    startTime = start;
+    slotWidth = width;
+    inverseWidth = 1.0 / width;
+    slotCount = count;
+    timePerCost = perCost;
+}
+
+void EdgeCostProfiles::addEdge(std::span<const float> profile) {
+    if (profile.size() != static_cast<size_t>(slotCount)) {
+        throw std::runtime_error("Cost profile needs " + std::to_string(slotCount) + " samples, got " +
+                                 std::to_string(profile.size()));
+    }
+    const bool flat = std::all_of(profile.begin(), profile.end(), [&](float c) { return c == profile[0]; });
+    if (flat) {
+        samples.push_back(profile[0]);
+    } else {
+        samples.insert(samples.end(), profile.begin(), profile.end());
+    }
+    first.push_back(static_cast<std::uint32_t>(samples.size()));
+}
+
+void EdgeCostProfiles::pack(std::size_t edgeCount, const int* firstLoad, const int* lastLoad) {
+    const std::size_t slots = static_cast<std::size_t>(slotCount);
+    const float* costs = priced.data();
+    samples.clear();
+    samples.reserve(edgeCount);
+    first.resize(edgeCount + 1);
+    first[0] = 0;
+    for (std::size_t e = 0; e < edgeCount; ++e) {
+        const float base = costs[e];
+        // Same load at both ends of a monotone prediction: same load, and
+        // so the same cost, at every breakpoint
+        bool flat = firstLoad && firstLoad[e] == lastLoad[e];
+        if (!flat) {
+            flat = true;
+            for (std::size_t s = 1; s < slots && flat; ++s) {
+                flat = costs[s * edgeCount + e] == base;
+            }
+        }
+        if (flat) {
+            samples.push_back(base);
+        } else {
+            for (std::size_t s = 0; s < slots; ++s) {
+                samples.push_back(costs[s * edgeCount + e]);
+            }
+        }
+        first[e + 1] = static_cast<std::uint32_t>(samples.size());
+    }
+}
+
+EdgeCostProfiles EdgeCostProfiles::fromOccupancy(const City& city, const IRoutePolicy& policy,
+                                                 const std::vector<std::vector<int>>& occupancy,
+                                                 double startTime, double slotWidth, double timePerCost) {
+    const size_t edgeCount = static_cast<size_t>(city.getEdgeCount());
+    for (const auto& row : occupancy) {
+        if (row.size() < edgeCount) {
+            throw std::runtime_error("Predicted occupancy does not cover the network");
+        }
+    }
+    EdgeCostProfiles profiles(startTime, slotWidth, static_cast<int>(occupancy.size()), timePerCost);
+
+    // Price whole breakpoints through the policy's batch path, then
+    // regroup the costs by edge
+    const size_t slots = occupancy.size();
+    profiles.priced.resize(slots * edgeCount);
+    for (size_t s = 0; s < slots; ++s) {
+        policy.loadedEdgeCosts(city, occupancy[s],
+                               std::span<float>(profiles.priced.data() + s * edgeCount, edgeCount));
+    }
+    profiles.pack(edgeCount);
+    profiles.priced = {};
+    return profiles;
+}
+
+EdgeCostProfiles EdgeCostProfiles::fromHistory(const City& city, const IRoutePolicy& policy,
+                                               std::span<const std::vector<int>> history,
+                                               double startTime, double slotWidth, int slotCount,
+                                               double timePerCost) {
+    EdgeCostProfiles profiles;
+    profiles.rebuild(city, policy, history, startTime, slotWidth, slotCount, timePerCost);
+    // A one-off set keeps only its profiles
+    profiles.fittedMean = {};
+    profiles.fittedSlope = {};
+    profiles.mean = {};
+    profiles.slope = {};
+    profiles.predicted = {};
+    profiles.priced = {};
+    return profiles;
+}
+
+void EdgeCostProfiles::rebuild(const City& city, const IRoutePolicy& policy,
+                               std::span<const std::vector<int>> history,
+                               double start, double width, int count, double perCost) {
+    first.assign(1, 0);
+    samples.clear();
+    fittedMean.clear();
+    fittedSlope.clear();
+    if (history.empty()) {
+        throw std::runtime_error("Occupancy history is empty");
+    }
+    setAxis(start, width, count, perCost);
+    fit(city, history);
+    priceAll(city, policy);
+    std::swap(fittedMean, mean);
+    std::swap(fittedSlope, slope);
+}
+
+void EdgeCostProfiles::update(const City& city, const IRoutePolicy& policy,
+                              std::span<const std::vector<int>> history, double start) {
+    const int edgeCount = city.getEdgeCount();
+    if (fittedMean.size() != static_cast<size_t>(edgeCount) || history.empty()) {
+        rebuild(city, policy, history, start, slotWidth, slotCount, timePerCost);
+        return;
+    }
+    const double fittedCenter = historyCenter;
+    fit(city, history);
+    startTime = start;
+
+    // Breakpoints sit at fixed offsets from the start, so an edge with the
+    // same trend through a history of the same length has the same profile
+    int changed = edgeCount;
+    if (historyCenter == fittedCenter) {
+        changed = 0;
+        for (int e = 0; e < edgeCount; ++e) {
+            changed += (mean[e] != fittedMean[e]) | (slope[e] != fittedSlope[e]);
+        }
+    }
+    if (changed > edgeCount / 4) {
+        // The batch path beats pricing edge by edge
+        priceAll(city, policy);
+    } else if (changed > 0) {
+        const auto topology = city.getTopology();
+        const std::vector<Edge>& edges = topology->getEdges();
+        const int* capacity = topology->capacityData().data();
+        const int* current = city.getState().occupancyData().data();
+        const size_t slots = static_cast<size_t>(slotCount);
+        std::vector<float>& costs = priced;
+        costs.resize(slots);
+
+        spare.clear();
+        std::uint32_t begin = first[0];
+        for (int e = 0; e < edgeCount; ++e) {
+            const std::uint32_t end = first[e + 1];
+            if (mean[e] == fittedMean[e] && slope[e] == fittedSlope[e]) {
+                spare.insert(spare.end(), samples.begin() + begin, samples.begin() + end);
+            } else {
+                // Same flatness tests as pack: equal end loads first, then equal costs
+                auto loadAt = [&](size_t s) {
+                    return predictLoad(mean[e], slope[e], s * slotWidth - historyCenter, capacity[e]);
+                };
+                auto costOf = [&](int load) {
+                    return static_cast<float>(policy.loadedEdgeCost(city, edges[e].getId(), load - current[e]));
+                };
+                const int firstLoad = loadAt(0);
+                if (firstLoad == loadAt(slots - 1)) {
+                    spare.push_back(costOf(firstLoad));
+                } else {
+                    for (size_t s = 0; s < slots; ++s) {
+                        costs[s] = costOf(loadAt(s));
+                    }
+                    if (std::all_of(costs.begin(), costs.end(), [&](float c) { return c == costs[0]; })) {
+                        spare.push_back(costs[0]);
+                    } else {
+                        spare.insert(spare.end(), costs.begin(), costs.end());
+                    }
+                }
+            }
+            begin = end;
+            first[e + 1] = static_cast<std::uint32_t>(spare.size());
+        }
+        std::swap(samples, spare);
+    }
+    std::swap(fittedMean, mean);
+    std::swap(fittedSlope, slope);
+}
+
+void EdgeCostProfiles::fit(const City& city, std::span<const std::vector<int>> history) {
+    const int edgeCount = city.getEdgeCount();
+    for (const auto& row : history) {
+        if (row.size() < static_cast<size_t>(edgeCount)) {
+            throw std::runtime_error("Occupancy history does not cover the network");
+        }
+    }
+
+    // Least-squares line through (tick offset, occupancy); the last row is
+    // at offset 0, breakpoint s at s * slotWidth. The sums run row by row
+    // so every pass over the edges is contiguous.
+    const int rows = static_cast<int>(history.size());
+    const double meanX = -(rows - 1) / 2.0;
+    historyCenter = meanX;
+    double sumSquares = 0.0;
+    mean.assign(edgeCount, 0.0);
+    slope.assign(edgeCount, 0.0);
+    for (int i = 0; i < rows; ++i) {
+        const double dx = (i - (rows - 1)) - meanX;
+        sumSquares += dx * dx;
+        const int* row = history[i].data();
+        for (int e = 0; e < edgeCount; ++e) {
+            mean[e] += row[e];
+            slope[e] += dx * row[e];    // Sum of dx * y; the dx sum is zero
+        }
+    }
+    const double inverseCount = 1.0 / rows;
+    const double inverseSquares = sumSquares > 0.0 ? 1.0 / sumSquares : 0.0;
+    for (int e = 0; e < edgeCount; ++e) {
+        mean[e] *= inverseCount;
+        slope[e] *= inverseSquares;
+    }
+}
+
+void EdgeCostProfiles::priceAll(const City& city, const IRoutePolicy& policy) {
+    // Predict and price one breakpoint at a time through the policy's
+    // batch path; only the first breakpoint's load is kept for pack
+    const int* capacity = city.getTopology()->capacityData().data();
+    const size_t edges = mean.size();
+    predicted.resize(2 * edges);
+    priced.resize(static_cast<size_t>(slotCount) * edges);
+    for (int s = 0; s < slotCount; ++s) {
+        const double offset = s * slotWidth - historyCenter;
+        int* row = predicted.data() + (s == 0 ? 0 : edges);
+        for (size_t e = 0; e < edges; ++e) {
+            row[e] = predictLoad(mean[e], slope[e], offset, capacity[e]);
+        }
+        policy.loadedEdgeCosts(city, std::span<const int>(row, edges),
+                               std::span<float>(priced.data() + s * edges, edges));
+    }
+    // A line clamped and rounded stays monotone, so equal ends mean a flat load
+    const int* lastLoad = predicted.data() + (slotCount > 1 ? edges : 0);
+    pack(edges, predicted.data(), lastLoad);
+}
@@ -0,0 +1,153 @@
+// code/core/EdgeCostProfiles.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class City;
+class IRoutePolicy;
+
+/**
+ * EdgeCostProfiles: time-dependent route costs, one piecewise-linear
+ * profile per edge index.
+ *
+ * All profiles share one time axis: slotCount breakpoints, slotWidth
+ * apart, starting at startTime (in ticks). Between breakpoints a cost is
+ * interpolated linearly; before the first and after the last it stays
+ * flat. Storage is compact: samples are floats packed back to back, and
+ * an edge whose profile does not change (every load-blind policy, idle
+ * edges) keeps a single sample.
+ *
+ * Costs are in policy units; timePerCost converts accumulated cost into
+ * elapsed ticks, so a time-dependent search (RoutePlanner::computePath
+ * with profiles) can look up every edge at the time it would be reached.
+ */
+class EdgeCostProfiles {
+public:
+    EdgeCostProfiles() = default;
+
+    /**
+     * Empty profile set on the given time axis; add one profile per edge
+     * index with addEdge.
+     * @throws std::runtime_error unless slotWidth > 0, slotCount >= 1 and
+     *         timePerCost > 0
+     */
+    EdgeCostProfiles(double startTime, double slotWidth, int slotCount, double timePerCost = 1.0);
+
+    /**
+     * Append the profile of the next edge index.
+     * @param samples Cost at each breakpoint (slotCount values)
+     * @throws std::runtime_error if samples has the wrong length
+     */
+    void addEdge(std::span<const float> samples);
+
+    /**
+     * Profiles of predicted occupancy under a policy: the cost of edge e
+     * at breakpoint s is the policy's cost with occupancy[s][e] vehicles
+     * on it (IRoutePolicy::loadedEdgeCosts).
+     * @param occupancy Predicted occupancy per breakpoint, by edge index;
+     *        its size is the slot count
+     * @throws std::runtime_error if a row does not cover every edge
+     */
+    static EdgeCostProfiles fromOccupancy(const City& city, const IRoutePolicy& policy,
+                                          const std::vector<std::vector<int>>& occupancy,
+                                          double startTime, double slotWidth, double timePerCost = 1.0);
+
+    /**
+     * Profiles predicted from recorded occupancy: each edge's occupancy
+     * over history (oldest first, one row per tick, ending at startTime)
+     * is extended by its least-squares trend for slotCount breakpoints,
+     * clamped to [0, capacity], then priced as in fromOccupancy.
+     * @throws std::runtime_error if history is empty or a row does not
+     *         cover every edge
+     */
+    static EdgeCostProfiles fromHistory(const City& city, const IRoutePolicy& policy,
+                                        std::span<const std::vector<int>> history,
+                                        double startTime, double slotWidth, int slotCount,
+                                        double timePerCost = 1.0);
+
+    /**
+     * Replace these profiles with fromHistory's, reusing their storage:
+     * after the first call on a network a rebuild allocates nothing.
+     * @throws std::runtime_error as fromHistory and the constructor; the
+     *         profiles are left empty
+     */
+    void rebuild(const City& city, const IRoutePolicy& policy,
+                 std::span<const std::vector<int>> history,
+                 double startTime, double slotWidth, int slotCount, double timePerCost = 1.0);
+
+    /**
+     * Move the profiles to a new start and history on the same axis, with
+     * the same result as rebuild. Only edges whose fitted trend changed
+     * are priced again (with IRoutePolicy::loadedEdgeCost), so idle and
+     * steady edges cost one comparison; when over a quarter changed it falls
+     * back to a full rebuild. The city's network and the policy must be
+     * the ones of the last rebuild.
+     * @throws std::runtime_error as rebuild
+     */
+    void update(const City& city, const IRoutePolicy& policy,
+                std::span<const std::vector<int>> history, double startTime);
+
+    /**
+     * Cost of an edge index entered at the given time.
+     */
+    float cost(int edgeIndex, double time) const {
+        const std::uint32_t begin = first[edgeIndex];
+        const std::uint32_t count = first[edgeIndex + 1] - begin;
+        const float* profile = samples.data() + begin;
+        double position = (time - startTime) * inverseWidth;
+        if (count == 1 || position <= 0.0) {
+            return profile[0];
+        }
+        if (position >= count - 1) {
+            return profile[count - 1];
+        }
+        int slot = static_cast<int>(position);
+        float fraction = static_cast<float>(position - slot);
+        return profile[slot] + (profile[slot + 1] - profile[slot]) * fraction;
+    }
+
+    int edgeCount() const { return static_cast<int>(first.size()) - 1; }
+    int getSlotCount() const { return slotCount; }
+    double getStartTime() const { return startTime; }
+    double getSlotWidth() const { return slotWidth; }
+    double getTimePerCost() const { return timePerCost; }
+
+    /**
+     * Samples held across all edges (the memory footprint in floats).
+     */
+    size_t storedSamples() const { return samples.size(); }
+
+private:
+    void setAxis(double startTime, double slotWidth, int slotCount, double timePerCost);
+    void fit(const City& city, std::span<const std::vector<int>> history);
+    void priceAll(const City& city, const IRoutePolicy& policy);
+    /**
+     * Regroup the slot-major costs in priced into per-edge profiles. Given
+     * the first and last breakpoint's loads of an occupancy that is
+     * monotone in time per edge, an edge whose two loads match is flat
+     * without reading its other costs.
+     */
+    void pack(std::size_t edgeCount, const int* firstLoad = nullptr, const int* lastLoad = nullptr);
+
+    double startTime = 0.0;
+    double slotWidth = 1.0;
+    double inverseWidth = 1.0;
+    int slotCount = 1;
+    double timePerCost = 1.0;
+    std::vector<std::uint32_t> first{0};    // Edge index -> first sample (edges + 1 entries)
+    std::vector<float> samples;
+
+    // Trend behind the current profiles (by edge index), for update
+    std::vector<double> fittedMean;
+    std::vector<double> fittedSlope;
+    double historyCenter = 0.0;     // Tick offset of the last fit's mean row (the newest is 0)
+
+    // Scratch kept between rebuilds so their buffers are reused
+    std::vector<double> mean;
+    std::vector<double> slope;
+    std::vector<int> predicted;     // First and current breakpoint's load, by edge index
+    std::vector<float> priced;      // Slot-major: breakpoint, then edge index
+    std::vector<float> spare;       // Samples being written by update
+};
@@ -0,0 +1,67 @@
+// code/core/EdgeCostTable.cpp
+#include "EdgeCostTable.h"
+#include "City.h"
+#include "IRoutePolicy.h"
+
+void EdgeCostTable::rebuild(const City& city, const IRoutePolicy& policy) {
+    values.resize(static_cast<size_t>(city.getEdgeCount()));
+    policy.allEdgeCosts(city, values);
+    planned.assign(values.size(), 0);
+    plannedIds.clear();
+    valid = true;
+}
+
+void EdgeCostTable::update(const City& city, const IRoutePolicy& policy, int edgeIndex) {
+    if (!valid || edgeIndex < 0 || edgeIndex >= static_cast<int>(values.size())) {
+        return;
+    }
+    const EdgeId id = city.getEdgeIdByIndex(edgeIndex);
+    if (planned[edgeIndex] > 0) {
+        values[edgeIndex] = static_cast<float>(policy.loadedEdgeCost(city, id, planned[edgeIndex]));
+        return;
+    }
+    policy.edgeCosts(city, std::span<const EdgeId>(&id, 1), std::span<float>(&values[edgeIndex], 1));
+}
+
+int EdgeCostTable::clearPlanned(const City& city, const IRoutePolicy& policy) {
+    if (!valid) {
+        return 0;
+    }
+    const auto topology = city.getTopology();
+    for (EdgeId id : plannedIds) {
+        planned[topology->edgeIndex(id)] = 0;
+    }
+    plannedCosts.resize(plannedIds.size());
+    policy.edgeCosts(city, plannedIds, plannedCosts);
+    for (size_t i = 0; i < plannedIds.size(); ++i) {
+        values[topology->edgeIndex(plannedIds[i])] = plannedCosts[i];
+    }
+    const int count = static_cast<int>(plannedIds.size());
+    plannedIds.clear();
+    return count;
+}
+
+void EdgeCostTable::addRoute(const City& city, const IRoutePolicy& policy, const std::deque<EdgeId>& route) {
+    if (!valid) {
+        return;
+    }
+    const auto topology = city.getTopology();
+    for (EdgeId id : route) {
+        int index = topology->edgeIndex(id);
+        if (index < 0 || index >= static_cast<int>(values.size())) {
+            continue;
+        }
+        if (planned[index]++ == 0) {
+            plannedIds.push_back(id);
+        }
+        values[index] = static_cast<float>(policy.loadedEdgeCost(city, id, planned[index]));
+    }
+}
+
+void EdgeCostTable::removePlanned(const City& city, const IRoutePolicy& policy, int edgeIndex) {
+    if (!valid || plannedLoad(edgeIndex) == 0) {
+        return;
+    }
+    --planned[edgeIndex];
+    update(city, policy, edgeIndex);
+}
@@ -0,0 +1,86 @@
+// code/core/EdgeCostTable.h
+#pragma once
+#include <deque>
+#include <vector>
+#include "Types.h"
+
+class City;
+class IRoutePolicy;
+
+/**
+ * EdgeCostTable: dense per-edge-index route costs for one policy.
+ *
+ * Within a tick every search asks for the same edge costs many times over.
+ * The table evaluates them once (rebuild), keeps them current as single
+ * edges change occupancy (update), and lets any number of searches read
+ * the flat float array (RoutePlanner::computePath with external costs).
+ * Since every occupancy change reaches update(), the table stays valid
+ * from tick to tick and is rebuilt only when the city or policy changes.
+ *
+ * Both fills go through the policy's batch API (IRoutePolicy::allEdgeCosts
+ * and edgeCosts), so built-in policies recost the network in a vectorized
+ * loop and plug-in policies fall back to edgeCost per edge.
+ *
+ * For wave route assignment the table also carries a planned load per
+ * edge: routes handed out earlier in the tick count as extra vehicles on
+ * every edge they use (addRoute), so later waves see them coming.
+ */
+class EdgeCostTable {
+public:
+    /**
+     * Recompute every edge's cost for the city's current occupancy and
+     * drop the planned load.
+     */
+    void rebuild(const City& city, const IRoutePolicy& policy);
+
+    /**
+     * Recompute one edge's cost (after its occupancy changed).
+     * Does nothing if the table has not been built.
+     */
+    void update(const City& city, const IRoutePolicy& policy, int edgeIndex);
+
+    /**
+     * Drop the planned load and recost the edges that carried it.
+     * @return Number of edges recosted
+     */
+    int clearPlanned(const City& city, const IRoutePolicy& policy);
+
+    /**
+     * Add one planned vehicle to every edge of a route and recost those
+     * edges with IRoutePolicy::loadedEdgeCost. The load lasts until
+     * clearPlanned or rebuild. Does nothing if the table has not been built.
+     */
+    void addRoute(const City& city, const IRoutePolicy& policy, const std::deque<EdgeId>& route);
+
+    /**
+     * Take one planned vehicle off an edge (it has entered the edge and
+     * now counts as occupancy) and recost it. Does nothing if the table
+     * has not been built or the edge has no planned load.
+     */
+    void removePlanned(const City& city, const IRoutePolicy& policy, int edgeIndex);
+
+    /**
+     * Planned vehicles on an edge index (0 outside the table).
+     */
+    int plannedLoad(int edgeIndex) const {
+        return edgeIndex >= 0 && edgeIndex < static_cast<int>(planned.size()) ? planned[edgeIndex] : 0;
+    }
+
+    /**
+     * Drop the costs; the next reader must rebuild.
+     */
+    void invalidate() { valid = false; }
+    bool isValid() const { return valid; }
+
+    /**
+     * Costs by edge index (see CityTopology::edgeIndex).
+     */
+    const std::vector<float>& costs() const { return values; }
+
+private:
+    std::vector<float> values;
+    std::vector<int> planned;   // Planned vehicles by edge index
+    std::vector<EdgeId> plannedIds;     // Edges with planned load, for clearPlanned
+    std::vector<float> plannedCosts;
+    bool valid = false;
+};
@@ -0,0 +1,43 @@
+// code/core/IRoutePolicy.cpp
+#include "IRoutePolicy.h"
+#include "City.h"
+#include <stdexcept>
+
+void IRoutePolicy::edgeCosts(const City& city, std::span<const EdgeId> edgeIds, std::span<float> out) const {
+    if (out.size() < edgeIds.size()) {
+        throw std::runtime_error("Edge cost output is shorter than the edge list");
+    }
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        out[i] = static_cast<float>(edgeCost(city, edgeIds[i]));
+    }
+}
+
+double IRoutePolicy::loadedEdgeCost(const City& city, EdgeId edgeId, int /*extraLoad*/) const {
+    return edgeCost(city, edgeId);
+}
+
+void IRoutePolicy::loadedEdgeCosts(const City& city, std::span<const int> occupancy,
+                                   std::span<float> out) const {
+    const std::vector<Edge>& edges = city.getTopology()->getEdges();
+    if (occupancy.size() < edges.size() || out.size() < edges.size()) {
+        throw std::runtime_error("Occupancy or cost output is shorter than the edge count");
+    }
+    const int* current = city.getState().occupancyData().data();
+    for (size_t i = 0; i < edges.size(); ++i) {
+        out[i] = static_cast<float>(loadedEdgeCost(city, edges[i].getId(), occupancy[i] - current[i]));
+    }
+}
+
+void IRoutePolicy::allEdgeCosts(const City& city, std::span<float> out) const {
+    const std::vector<Edge>& edges = city.getTopology()->getEdges();
+    if (out.size() < edges.size()) {
+        throw std::runtime_error("Edge cost output is shorter than the edge count");
+    }
+    for (size_t i = 0; i < edges.size(); ++i) {
+        out[i] = static_cast<float>(edgeCost(city, edges[i].getId()));
+    }
+}
+
+size_t IRoutePolicy::chooseRoute(const Agent& /*agent*/, std::span<const double> /*routeCosts*/) const {
+    return 0;
+}
@@ -1,6 +1,8 @@
 // code/core/IRoutePolicy.h
 #pragma once
 #include "Types.h"
+#include <cstddef>
+#include <span>
 
 // Forward declarations
 class City;
@@ -20,6 +22,52 @@ public:
      */
     virtual double edgeCost(const City& city, EdgeId edgeId) const = 0;
     
+    /**
+     * Batch form of edgeCost for a list of edges.
+     * The default calls edgeCost once per edge; policies override it with
+     * a loop over the city's flat arrays.
+     * @param city Reference to the city containing the edges
+     * @param edgeIds Edges to evaluate
+     * @param out Receives edgeCost for edgeIds[i] at out[i]
+     * @throws std::runtime_error if out is shorter than edgeIds
+     */
+    virtual void edgeCosts(const City& city, std::span<const EdgeId> edgeIds, std::span<float> out) const;
+    
+    /**
+     * Batch form of edgeCost for the whole network, by edge index
+     * (see CityTopology::edgeIndex). Default: edgeCost once per edge.
+     * @param city Reference to the city containing the edges
+     * @param out Receives the cost of edge index i at out[i]
+     * @throws std::runtime_error if out is shorter than the edge count
+     */
+    virtual void allEdgeCosts(const City& city, std::span<float> out) const;
+    
+    /**
+     * Cost of an edge as if extraLoad more vehicles were on it, for
+     * projected loads during wave route assignment (see
+     * SimulationController::setRouteWaves) and predicted occupancy in
+     * time-dependent profiles (EdgeCostProfiles). Default: edgeCost, i.e.
+     * the policy ignores load.
+     * @param city Reference to the city containing the edge
+     * @param edgeId ID of the edge to evaluate
+     * @param extraLoad Vehicles to add to the edge's occupancy (negative
+     *        for a predicted occupancy below the current one)
+     * @return Cost of traversing the edge under the projected load
+     */
+    virtual double loadedEdgeCost(const City& city, EdgeId edgeId, int extraLoad) const;
+    
+    /**
+     * Batch form of loadedEdgeCost for the whole network under a given
+     * occupancy instead of the city's. Default: loadedEdgeCost once per
+     * edge.
+     * @param city Reference to the city containing the edges
+     * @param occupancy Occupancy by edge index, at least one per edge
+     * @param out Receives the cost of edge index i at out[i]
+     * @throws std::runtime_error if occupancy or out is shorter than the
+     *         edge count
+     */
+    virtual void loadedEdgeCosts(const City& city, std::span<const int> occupancy, std::span<float> out) const;
+    
     /**
      * Determine if an agent should reroute when reaching a node.
      * @param agent Reference to the agent to evaluate
@@ -27,6 +75,21 @@ public:
      */
     virtual bool shouldRerouteOnNode(const Agent& agent) const = 0;
     
+    /**
+     * Routes to consider per trip. Above 1, routers search this many
+     * near-shortest alternatives (RoutePlanner::alternativePaths) and let
+     * chooseRoute pick the agent's. Default: 1, the cheapest route only.
+     */
+    virtual int alternativeCount() const { return 1; }
+    
+    /**
+     * Pick an agent's route among alternatives.
+     * @param agent Agent being routed
+     * @param routeCosts Cost of each alternative, cheapest first
+     * @return Index into routeCosts. Default: 0, the cheapest
+     */
+    virtual size_t chooseRoute(const Agent& agent, std::span<const double> routeCosts) const;
+    
     /**
      * Virtual destructor to ensure proper cleanup of derived classes.
      */
@@ -4,6 +4,7 @@
 #include "Agent.h"
 #include <algorithm>
 #include <numeric>
+#include <utility>
 
 void Metrics::recordDeparture(const Agent& a) {
     // Record when an agent departs
@@ -77,3 +78,14 @@ void Metrics::reset() {
     maxEdgeLoad_ = 0;
     currentTick_ = 0;
 }
+
+void Metrics::restore(int currentTick, int maxEdgeLoad,
+                      std::vector<double> tripTimes,
+                      std::vector<int> throughputPerTick,
+                      std::vector<std::vector<int>> edgeLoadHistory) {
+    currentTick_ = currentTick;
+    maxEdgeLoad_ = maxEdgeLoad;
+    tripTimes_ = std::move(tripTimes);
+    throughputPerTick_ = std::move(throughputPerTick);
+    edgeLoadHistory_ = std::move(edgeLoadHistory);
+}
@@ -62,6 +62,14 @@ public:
      */
     void reset();
     
+    /**
+     * Replace all accumulators (used when restoring a checkpoint).
+     */
+    void restore(int currentTick, int maxEdgeLoad,
+                 std::vector<double> tripTimes,
+                 std::vector<int> throughputPerTick,
+                 std::vector<std::vector<int>> edgeLoadHistory);
+    
     // Getters for testing
     int getCurrentTick() const { return currentTick_; }
     const std::vector<double>& getTripTimes() const { return tripTimes_; }
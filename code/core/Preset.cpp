@@ -1,5 +1,6 @@
 // code/core/Preset.cpp
 #include "Preset.h"
+#include <utility>
 
 Preset::Preset()
     : name(""),
@@ -17,12 +18,12 @@ bool Preset::validate() const {
     }
     
     // Check for reasonable grid size (not too large)
-    if (rows > 100 || cols > 100) {
+    if (rows > kMaxGridDimension || cols > kMaxGridDimension) {
         return false;
     }
     
-    // Check agent count is non-negative
-    if (agentCount < 0) {
+    // Check agent count is non-negative and bounded
+    if (agentCount < 0 || agentCount > kMaxAgentCount) {
         return false;
     }
     
@@ -40,6 +41,14 @@ bool Preset::validate() const {
         }
     }
     
+    // Validate explicit agent routes reference valid nodes
+    for (const auto& route : agentRoutes) {
+        if (route.first < 0 || route.first >= totalNodes ||
+            route.second < 0 || route.second >= totalNodes) {
+            return false;
+        }
+    }
+    
     return true;
 }
 
@@ -59,6 +68,10 @@ const std::vector<std::pair<NodeId, NodeId>>& Preset::getBlockedEdges() const {
     return blockedEdges;
 }
 
+const std::vector<std::pair<NodeId, NodeId>>& Preset::getAgentRoutes() const {
+    return agentRoutes;
+}
+
 int Preset::getAgentCount() const {
     return agentCount;
 }
@@ -71,6 +84,10 @@ PolicyType Preset::getPolicy() const {
     return policy;
 }
 
+const std::string& Preset::getCompiledCity() const {
+    return compiledCity;
+}
+
 void Preset::setName(const std::string& name) {
     this->name = name;
 }
@@ -87,6 +104,13 @@ void Preset::setBlockedEdges(const std::vector<std::pair<NodeId, NodeId>>& block
     this->blockedEdges = blocked;
 }
 
+void Preset::setAgentRoutes(std::vector<std::pair<NodeId, NodeId>> routes) {
+    this->agentRoutes = std::move(routes);
+    if (!agentRoutes.empty()) {
+        this->agentCount = static_cast<int>(agentRoutes.size());
+    }
+}
+
 void Preset::setAgentCount(int count) {
     this->agentCount = count;
 }
@@ -97,4 +121,8 @@ void Preset::setTickMs(int ms) {
 
 void Preset::setPolicy(PolicyType policy) {
     this->policy = policy;
-}
\ No newline at end of file
+}
+
+void Preset::setCompiledCity(const std::string& path) {
+    this->compiledCity = path;
+}
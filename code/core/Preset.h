@@ -7,11 +7,20 @@
 
 enum class PolicyType {
     SHORTEST_PATH,
-    CONGESTION_AWARE
+    CONGESTION_AWARE,
+    BPR,            // Volume-delay: Bureau of Public Roads function
+    CONICAL,        // Volume-delay: conical function
+    SYSTEM_OPTIMAL, // Volume-delay (BPR) priced at marginal social cost
+    ROUTE_DIVERSITY,        // Shortest-path costs, agents spread over alternative routes
+    CONICAL_SYSTEM_OPTIMAL  // Volume-delay (conical) priced at marginal social cost
 };
 
 class Preset {
 public:
+    // Largest supported grid side and agent count (stress-test scale)
+    static constexpr int kMaxGridDimension = 1000;
+    static constexpr int kMaxAgentCount = 1000000;
+    
     Preset();
     
     // Validation
@@ -22,25 +31,43 @@ public:
     int getRows() const;
     int getCols() const;
     const std::vector<std::pair<NodeId, NodeId>>& getBlockedEdges() const;
+    const std::vector<std::pair<NodeId, NodeId>>& getAgentRoutes() const;
     int getAgentCount() const;
     int getTickMs() const;
     PolicyType getPolicy() const;
+    const std::string& getCompiledCity() const;
     
     // Setters
     void setName(const std::string& name);
     void setRows(int rows);
     void setCols(int cols);
     void setBlockedEdges(const std::vector<std::pair<NodeId, NodeId>>& blocked);
+    
+    /**
+     * Explicit agent origin/destination pairs. When non-empty, agents are
+     * spawned from this list instead of at random and the agent count
+     * follows its size.
+     */
+    void setAgentRoutes(std::vector<std::pair<NodeId, NodeId>> routes);
     void setAgentCount(int count);
     void setTickMs(int ms);
     void setPolicy(PolicyType policy);
+
+    /**
+     * Compiled city (.glcity) holding this preset's network, written by
+     * PresetLoader::compileCity. When set, PresetLoader::buildCity maps it
+     * instead of building the grid; empty (the default) builds the grid.
+     */
+    void setCompiledCity(const std::string& path);
     
 private:
     std::string name;
     int rows;
     int cols;
     std::vector<std::pair<NodeId, NodeId>> blockedEdges;
+    std::vector<std::pair<NodeId, NodeId>> agentRoutes;
     int agentCount;
     int tickMs;
     PolicyType policy;
+    std::string compiledCity;
 };
\ No newline at end of file
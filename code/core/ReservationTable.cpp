@@ -0,0 +1,88 @@
+// code/core/ReservationTable.cpp
+#include "ReservationTable.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+ReservationTable::ReservationTable(int edgeCount, int slotCount) : edges(edgeCount), slots(slotCount) {
+    if (edgeCount < 0 || slotCount < 1) {
+        throw std::runtime_error("Invalid reservation table size");
+    }
+    const std::size_t size = static_cast<std::size_t>(edgeCount) * static_cast<std::size_t>(slotCount);
+    counts = std::make_unique<std::atomic<std::uint16_t>[]>(size);
+    clear();
+}
+
+bool ReservationTable::tryReserve(int edgeIndex, std::int64_t tick, int capacity, int present) {
+    if (!covers(tick)) {
+        return true;
+    }
+    // Counters saturate at their width
+    const int limit = std::min(capacity - present, static_cast<int>(std::numeric_limits<std::uint16_t>::max()));
+    std::atomic<std::uint16_t>& count = slot(edgeIndex, tick);
+    std::uint16_t current = count.load(std::memory_order_relaxed);
+    do {
+        if (current >= limit) {
+            return false;
+        }
+    } while (!count.compare_exchange_weak(current, static_cast<std::uint16_t>(current + 1),
+                                          std::memory_order_relaxed));
+    return true;
+}
+
+void ReservationTable::release(int edgeIndex, std::int64_t tick) {
+    if (!covers(tick)) {
+        return;
+    }
+    std::atomic<std::uint16_t>& count = slot(edgeIndex, tick);
+    std::uint16_t current = count.load(std::memory_order_relaxed);
+    do {
+        if (current == 0) {
+            return;
+        }
+    } while (!count.compare_exchange_weak(current, static_cast<std::uint16_t>(current - 1),
+                                          std::memory_order_relaxed));
+}
+
+bool ReservationTable::claimRoute(std::span<const Claim> claims, std::span<const int> capacity,
+                                  std::span<const int> occupancy, std::int64_t nowTick) {
+    for (std::size_t i = 0; i < claims.size(); ++i) {
+        const int e = claims[i].edgeIndex;
+        if (!tryReserve(e, claims[i].tick, capacity[e], claims[i].tick == nowTick ? occupancy[e] : 0)) {
+            releaseRoute(claims.first(i));
+            return false;
+        }
+    }
+    return true;
+}
+
+void ReservationTable::releaseRoute(std::span<const Claim> claims) {
+    for (const Claim& claim : claims) {
+        release(claim.edgeIndex, claim.tick);
+    }
+}
+
+void ReservationTable::advance(std::int64_t tick) {
+    if (tick < base || tick - base >= slots) {
+        clear();
+    } else {
+        for (std::int64_t t = base; t < tick; ++t) {
+            clearRow(t);
+        }
+    }
+    base = tick;
+}
+
+void ReservationTable::clear() {
+    const std::size_t size = static_cast<std::size_t>(edges) * static_cast<std::size_t>(slots);
+    for (std::size_t i = 0; i < size; ++i) {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void ReservationTable::clearRow(std::int64_t tick) {
+    std::atomic<std::uint16_t>* row = counts.get() + static_cast<std::size_t>(tick % slots) * edges;
+    for (int e = 0; e < edges; ++e) {
+        row[e].store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,133 @@
+// code/core/ReservationTable.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+/**
+ * ReservationTable: capacity claimed on each edge for the next few ticks.
+ *
+ * Routes claim the tick at which they will enter each edge, so a
+ * space-time search (RoutePlanner::computePath with reservations) can see
+ * an edge filling up before any vehicle is on it and route around it or
+ * wait. The table is a ring of slotCount ticks starting at the base tick;
+ * advance() moves the window forward and clears the ticks it leaves.
+ * Storage is one 16-bit counter per edge and slot, slot-major so a tick
+ * clears in one contiguous pass.
+ *
+ * Reservations are lock-free: parallel routing threads (one RoutePlanner
+ * each) may reserve and release concurrently, and tryReserve never lets a
+ * slot exceed the capacity it is given. advance() and clear() must not run
+ * concurrently with anything else.
+ */
+class ReservationTable {
+public:
+    /**
+     * A route's use of one edge: the edge index and the tick it enters it.
+     */
+    struct Claim {
+        int edgeIndex;
+        std::int64_t tick;
+
+        bool operator==(const Claim&) const = default;
+    };
+
+    /**
+     * Ticks from entering an edge to entering the next one: one on the
+     * edge, one at its head node (see Agent::step).
+     */
+    static constexpr int kTicksPerEdge = 2;
+
+    ReservationTable() = default;
+
+    /**
+     * Empty table for edgeCount edge indices and a window of slotCount
+     * ticks starting at tick 0.
+     * @throws std::runtime_error if edgeCount < 0 or slotCount < 1
+     */
+    ReservationTable(int edgeCount, int slotCount);
+
+    int edgeCount() const { return edges; }
+    int getSlotCount() const { return slots; }
+    std::int64_t getBaseTick() const { return base; }
+
+    /**
+     * True if the window holds the tick.
+     */
+    bool covers(std::int64_t tick) const { return tick >= base && tick < base + slots; }
+
+    /**
+     * Vehicles that claimed an edge index at a tick (0 outside the window).
+     */
+    int reserved(int edgeIndex, std::int64_t tick) const {
+        return covers(tick) ? slot(edgeIndex, tick).load(std::memory_order_relaxed) : 0;
+    }
+
+    /**
+     * Admission rule shared by the space-time search and claimRoute: one
+     * more vehicle fits on an edge at a tick if the claims there plus the
+     * vehicles already on it stay below capacity. Occupancy only counts at
+     * nowTick, the tick routes depart from; the vehicles on the edge then
+     * have moved on by the next tick. Ticks outside the window always have
+     * room.
+     */
+    bool hasRoom(int edgeIndex, std::int64_t tick, int capacity, int occupancy, std::int64_t nowTick) const {
+        return !covers(tick) || reserved(edgeIndex, tick) + (tick == nowTick ? occupancy : 0) < capacity;
+    }
+
+    /**
+     * Claim one place on an edge at a tick if the claims plus present
+     * vehicles stay below capacity. Ticks outside the window are not
+     * stored and always succeed.
+     * @param present Vehicles already using the slot (see hasRoom)
+     * @return false if the slot is full
+     */
+    bool tryReserve(int edgeIndex, std::int64_t tick, int capacity, int present = 0);
+
+    /**
+     * Give back a place taken by tryReserve (ignored outside the window
+     * or on an empty slot).
+     */
+    void release(int edgeIndex, std::int64_t tick);
+
+    /**
+     * Claim every edge of a route, or none: if any slot is full by the
+     * hasRoom rule, the claims already made are released again.
+     * @param capacity Capacity by edge index
+     * @param occupancy Vehicles on each edge index at nowTick
+     * @param nowTick Tick the route departs from
+     * @return false if the route could not be claimed
+     */
+    bool claimRoute(std::span<const Claim> claims, std::span<const int> capacity,
+                    std::span<const int> occupancy, std::int64_t nowTick);
+
+    /**
+     * Release every claim of a route (see release).
+     */
+    void releaseRoute(std::span<const Claim> claims);
+
+    /**
+     * Move the window to start at tick, clearing the ticks before it.
+     * Moving backwards clears the whole table.
+     */
+    void advance(std::int64_t tick);
+
+    /**
+     * Drop every reservation (the window stays where it is).
+     */
+    void clear();
+
+private:
+    std::atomic<std::uint16_t>& slot(int edgeIndex, std::int64_t tick) const {
+        const std::size_t row = static_cast<std::size_t>(tick % slots);
+        return counts[row * static_cast<std::size_t>(edges) + static_cast<std::size_t>(edgeIndex)];
+    }
+    void clearRow(std::int64_t tick);
+
+    int edges = 0;
+    int slots = 0;
+    std::int64_t base = 0;
+    std::unique_ptr<std::atomic<std::uint16_t>[]> counts;   // Slot-major: tick % slots, then edge index
+};
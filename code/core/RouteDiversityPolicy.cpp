@@ -0,0 +1,25 @@
+// code/core/RouteDiversityPolicy.cpp
+#include "RouteDiversityPolicy.h"
+#include "Agent.h"
+#include <stdexcept>
+
+RouteDiversityPolicy::RouteDiversityPolicy(int alternatives, double maxStretch)
+    : alternatives(alternatives), maxStretch(maxStretch) {
+    if (alternatives < 1 || !(maxStretch >= 1.0)) {
+        throw std::runtime_error("Invalid route diversity parameters");
+    }
+}
+
+size_t RouteDiversityPolicy::chooseRoute(const Agent& agent, std::span<const double> routeCosts) const {
+    if (routeCosts.empty()) {
+        return 0;
+    }
+    // Costs are sorted, so the acceptable routes are a prefix
+    const double longest = routeCosts[0] * maxStretch;
+    size_t acceptable = 1;
+    while (acceptable < routeCosts.size() && routeCosts[acceptable] <= longest) {
+        ++acceptable;
+    }
+    const int id = agent.getId();
+    return static_cast<size_t>(id < 0 ? -(id + 1) : id) % acceptable;
+}
@@ -0,0 +1,45 @@
+// code/core/RouteDiversityPolicy.h
+#pragma once
+#include "ShortestPathPolicy.h"
+#include <cstddef>
+#include <span>
+
+/**
+ * Route policy that spreads agents over near-shortest routes.
+ *
+ * Edges cost their length, as in ShortestPathPolicy, but instead of every
+ * agent with the same origin and destination taking the one shortest
+ * path, routers ask RoutePlanner::alternativePaths for alternativeCount
+ * loopless alternatives and chooseRoute assigns each agent one of those
+ * within maxStretch of the shortest. Agents are dealt out by id, so equal
+ * trips split evenly and runs stay reproducible.
+ */
+class RouteDiversityPolicy : public ShortestPathPolicy {
+public:
+    static constexpr int kDefaultAlternatives = 4;
+    static constexpr double kDefaultMaxStretch = 1.25;
+
+    RouteDiversityPolicy() = default;
+
+    /**
+     * @param alternatives Most routes to consider per trip (1 behaves like
+     *        ShortestPathPolicy)
+     * @param maxStretch Longest acceptable route as a multiple of the
+     *        shortest
+     * @throws std::runtime_error if alternatives < 1 or maxStretch < 1
+     */
+    RouteDiversityPolicy(int alternatives, double maxStretch);
+
+    int alternativeCount() const override { return alternatives; }
+    double getMaxStretch() const { return maxStretch; }
+
+    /**
+     * Deal the agent, by id, one of the routes within maxStretch of the
+     * cheapest (0 if routeCosts is empty).
+     */
+    size_t chooseRoute(const Agent& agent, std::span<const double> routeCosts) const override;
+
+private:
+    int alternatives = kDefaultAlternatives;
+    double maxStretch = kDefaultMaxStretch;
+};
@@ -2,31 +2,38 @@
 #include "City.h"
 #include "Agent.h"
 #include "Types.h"
+#include "TickProfiler.h"
+#include "ShortestPathPolicy.h"
+#include "CongestionAwarePolicy.h"
+#include "VolumeDelayPolicy.h"
+#include "EdgeCostProfiles.h"
 #include <algorithm>
-#include <climits>
-#include <unordered_map>
-#include <queue>
-#include <utility>
-
-// Custom hash for pair<NodeId, NodeId>
-namespace std {
-    template <>
-    struct hash<std::pair<NodeId, NodeId>> {
-        size_t operator()(const std::pair<NodeId, NodeId>& p) const noexcept {
-            auto h1 = std::hash<NodeId>{}(p.first);
-            auto h2 = std::hash<NodeId>{}(p.second);
-            // Combine the two hashes safely
-            return h1 ^ (h2 << 1);
-        }
-    };
-}
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
 
-RoutePlanner::RoutePlanner(IRoutePolicy* p) : policy(p) {
+RoutePlanner::RoutePlanner(IRoutePolicy* p) : policy(p), kernel(selectKernel(p)) {
     // Constructor initializes the policy pointer
 }
 
 void RoutePlanner::setPolicy(IRoutePolicy* p) {
     policy = p;
+    kernel = selectKernel(p);
+}
+
+RoutePlanner::Kernel RoutePlanner::selectKernel(const IRoutePolicy* p) {
+    // Exact type match: a subclass may override edgeCost
+    if (p && typeid(*p) == typeid(ShortestPathPolicy)) {
+        return Kernel::SHORTEST_PATH;
+    }
+    if (p && typeid(*p) == typeid(CongestionAwarePolicy)) {
+        return Kernel::CONGESTION_AWARE;
+    }
+    if (p && typeid(*p) == typeid(VolumeDelayPolicy)) {
+        return Kernel::VOLUME_DELAY;
+    }
+    return Kernel::GENERIC;
 }
 
 std::deque<EdgeId> RoutePlanner::computePath(City& city, Agent& agent) {
@@ -41,87 +48,530 @@ std::deque<EdgeId> RoutePlanner::computePath(City& city, Agent& agent) {
         return std::deque<EdgeId>();
     }
 
+    if (policy->alternativeCount() > 1) {
+        agentCosts.resize(static_cast<size_t>(city.getEdgeCount()));
+        policy->allEdgeCosts(city, agentCosts);
+        return computePath(city, agent, agentCosts);
+    }
     return dijkstra(city, start, goal);
 }
 
-std::deque<EdgeId> RoutePlanner::dijkstra(City& city, NodeId start, NodeId goal) {
-    if (!policy) {
+std::deque<EdgeId> RoutePlanner::computePath(const City& city, const Agent& agent,
+                                             const std::vector<float>& edgeCosts) {
+    const NodeId start = agent.getCurrentNode();
+    const NodeId goal = agent.getDestination();
+    const int count = policy ? policy->alternativeCount() : 1;
+    if (count <= 1) {
+        return computePath(city, start, goal, edgeCosts);
+    }
+
+    auto routes = alternativePaths(city, start, goal, edgeCosts, count);
+    if (routes.empty()) {
         return std::deque<EdgeId>();
     }
+    std::vector<double> routeCosts;
+    routeCosts.reserve(routes.size());
+    for (const auto& route : routes) {
+        routeCosts.push_back(route.cost);
+    }
+    const size_t chosen = policy->chooseRoute(agent, routeCosts);
+    return std::move(routes[chosen < routes.size() ? chosen : 0].path);
+}
 
-    // Distance map: node -> shortest distance from start
-    std::unordered_map<NodeId, double> distances;
+std::deque<EdgeId> RoutePlanner::computePath(const City& city, NodeId start, NodeId goal,
+                                             const std::vector<float>& edgeCosts) {
+    if (edgeCosts.size() < static_cast<size_t>(city.getEdgeCount())) {
+        throw std::runtime_error("Edge cost array does not cover the network");
+    }
+    if (start == goal) {
+        return std::deque<EdgeId>();
+    }
+
+    syncGraph(city);
+    const float* costs = edgeCosts.data();
+    return search(city, start, goal, [costs](int e, double) { return static_cast<double>(costs[e]); });
+}
+
+std::deque<EdgeId> RoutePlanner::computePath(const City& city, NodeId start, NodeId goal,
+                                             const EdgeCostProfiles& profiles, double departureTime) {
+    if (profiles.edgeCount() < city.getEdgeCount()) {
+        throw std::runtime_error("Edge cost profiles do not cover the network");
+    }
+    if (start == goal) {
+        return std::deque<EdgeId>();
+    }
 
-    // Predecessor map: node -> previous node
-    std::unordered_map<NodeId, NodeId> predecessors;
+    syncGraph(city);
+    const double timePerCost = profiles.getTimePerCost();
+    return search(city, start, goal, [&](int e, double costSoFar) {
+        return static_cast<double>(profiles.cost(e, departureTime + costSoFar * timePerCost));
+    });
+}
 
-    // Edge map: (from, to) -> edgeId for path reconstruction
-    std::unordered_map<std::pair<NodeId, NodeId>, EdgeId, std::hash<std::pair<NodeId, NodeId>>> edgeMap;
+std::deque<EdgeId> RoutePlanner::computePath(const City& city, NodeId start, NodeId goal,
+                                             const std::vector<float>& edgeCosts,
+                                             const ReservationTable& reservations, std::int64_t departureTick,
+                                             double waitCost, std::vector<ReservationTable::Claim>* claims) {
+    if (edgeCosts.size() < static_cast<size_t>(city.getEdgeCount())) {
+        throw std::runtime_error("Edge cost array does not cover the network");
+    }
+    if (reservations.edgeCount() < city.getEdgeCount()) {
+        throw std::runtime_error("Reservation table does not cover the network");
+    }
+    if (claims) {
+        claims->clear();
+    }
+    if (start == goal) {
+        return std::deque<EdgeId>();
+    }
 
-    // Priority queue for Dijkstra: (distance, node)
-    std::priority_queue<std::pair<double, NodeId>,
-                        std::vector<std::pair<double, NodeId>>,
-                        std::greater<std::pair<double, NodeId>>> pq;
+    syncGraph(city);
+    const int nodeSlots = static_cast<int>(graph.firstOut.size()) - 1;
+    if (start < 0 || start >= nodeSlots || goal < 0 || goal >= nodeSlots) {
+        return std::deque<EdgeId>();
+    }
+    if (++stamp == 0) {
+        std::fill(visited.begin(), visited.end(), 0u);
+        stamp = 1;
+    }
 
-    distances[start] = 0.0;
-    pq.push({0.0, start});
+    const CityState& state = city.getState();
+    const float* costs = edgeCosts.data();
+    const int* capacity = graph.topology->capacityData().data();
+    const int* occupancy = state.occupancyData().data();
+    const auto later = std::greater<std::pair<double, NodeId>>();
+    heap.clear();
 
-    while (!pq.empty()) {
-        auto [currentDist, currentNode] = pq.top();
-        pq.pop();
+    dist[start] = 0.0;
+    predEdge[start] = -1;
+    predNode[start] = start;
+    readyTick[start] = departureTick;
+    visited[start] = stamp;
+    heap.push_back({0.0, start});
 
-        if (currentDist > distances[currentNode]) continue;
-        if (currentNode == goal) break;
+    std::uint64_t pops = 0;
+    std::uint64_t relaxations = 0;
+    bool reached = false;
 
-        std::vector<EdgeId> outgoingEdges = city.neighbors(currentNode);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto [currentDist, currentNode] = heap.back();
+        heap.pop_back();
+        ++pops;
 
-        for (EdgeId edgeId : outgoingEdges) {
-            const Edge& edge = city.getEdge(edgeId);
-            NodeId neighbor = edge.getTo();
+        if (currentDist > dist[currentNode]) continue;
+        if (currentNode == goal) {
+            reached = true;
+            break;
+        }
 
-            if (edge.isBlocked()) continue;
+        const std::int64_t ready = readyTick[currentNode];
+        const int end = graph.firstOut[currentNode + 1];
+        for (int slot = graph.firstOut[currentNode]; slot < end; ++slot) {
+            const int e = graph.outEdges[slot];
+            if (graph.closed[e] || state.isBlocked(e) || capacity[e] <= 0) continue;
+            ++relaxations;
 
-            double edgeCost = policy->edgeCost(city, edgeId);
-            double newDist = currentDist + edgeCost;
+            // First tick with room on the edge
+            std::int64_t enter = ready;
+            while (!reservations.hasRoom(e, enter, capacity[e], occupancy[e], departureTick)) {
+                ++enter;
+            }
 
-            if (distances.find(neighbor) == distances.end() || newDist < distances[neighbor]) {
-                distances[neighbor] = newDist;
-                predecessors[neighbor] = currentNode;
-                edgeMap[{currentNode, neighbor}] = edgeId;
-                pq.push({newDist, neighbor});
+            const NodeId neighbor = graph.head[e];
+            const double newDist = currentDist + costs[e] + waitCost * static_cast<double>(enter - ready);
+            if (visited[neighbor] != stamp || newDist < dist[neighbor]) {
+                visited[neighbor] = stamp;
+                dist[neighbor] = newDist;
+                predEdge[neighbor] = e;
+                predNode[neighbor] = currentNode;
+                readyTick[neighbor] = enter + ReservationTable::kTicksPerEdge;
+                entryTick[neighbor] = enter;
+                heap.push_back({newDist, neighbor});
+                std::push_heap(heap.begin(), heap.end(), later);
             }
         }
     }
 
-    if (distances.find(goal) == distances.end()) {
-        return std::deque<EdgeId>(); // No path
+    GRIDLOCK_PROFILE_COUNT(TickCounter::DIJKSTRA_POPS, pops);
+    GRIDLOCK_PROFILE_COUNT(TickCounter::EDGE_RELAXATIONS, relaxations);
+
+    if (!reached) {
+        return std::deque<EdgeId>();
+    }
+    std::deque<EdgeId> path;
+    for (NodeId node = goal; node != start; node = predNode[node]) {
+        path.push_front(graph.ids[predEdge[node]]);
+        if (claims && reservations.covers(entryTick[node])) {
+            claims->push_back({predEdge[node], entryTick[node]});
+        }
+    }
+    if (claims) {
+        std::reverse(claims->begin(), claims->end());
+    }
+    return path;
+}
+
+std::vector<RoutePlanner::Alternative> RoutePlanner::alternativePaths(const City& city, NodeId start, NodeId goal,
+                                                                      const std::vector<float>& edgeCosts, int k) {
+    if (edgeCosts.size() < static_cast<size_t>(city.getEdgeCount())) {
+        throw std::runtime_error("Edge cost array does not cover the network");
+    }
+    if (k < 1) {
+        throw std::runtime_error("Alternative path count must be at least 1");
+    }
+    std::vector<Alternative> alternatives;
+    if (start == goal) {
+        return alternatives;
+    }
+
+    syncGraph(city);
+    const float* costs = edgeCosts.data();
+    const auto cost = [costs](int e, double) { return static_cast<double>(costs[e]); };
+
+    // A path as edge indices; nodes[i] is the tail of edges[i] and
+    // nodes.back() the goal. deviation is the edge where the path left the
+    // one it was spurred from.
+    struct Path {
+        std::vector<int> edges;
+        std::vector<NodeId> nodes;
+        double cost = 0.0;
+        size_t deviation = 0;
+    };
+    // Append the searched route from node `from` to the goal
+    const auto appendTrace = [&](Path& path, NodeId from) {
+        const size_t first = path.edges.size();
+        for (NodeId node = goal; node != from; node = predNode[node]) {
+            path.edges.push_back(predEdge[node]);
+        }
+        std::reverse(path.edges.begin() + first, path.edges.end());
+        for (size_t i = first; i < path.edges.size(); ++i) {
+            path.nodes.push_back(graph.head[path.edges[i]]);
+        }
+    };
+
+    const auto noSkip = [](int) { return false; };
+    const double unlimited = std::numeric_limits<double>::infinity();
+    std::vector<Path> accepted;
+    if (k == 1) {
+        if (!searchTree(city, start, goal, cost, noSkip, [](NodeId) { return 0.0; }, unlimited)) {
+            return alternatives;
+        }
+    } else {
+        // Exact distances to the goal steer every search below straight at it
+        reverseTree(city, goal, costs);
+        const auto estimate = [this](NodeId node) { return toGoal[node]; };
+        if (!searchTree(city, start, goal, cost, noSkip, estimate, unlimited)) {
+            return alternatives;
+        }
+    }
+    accepted.emplace_back();
+    accepted.back().nodes.push_back(start);
+    accepted.back().cost = dist[goal];
+    appendTrace(accepted.back(), start);
+
+    // Candidates sorted by cost, never more than the paths still wanted:
+    // anything past that cannot be returned, nor can the routes that would
+    // spur from it
+    std::vector<Path> candidates;
+    const auto skip = [this](int e) {
+        const NodeId head = graph.head[e];
+        return bannedEdge[e] == banStamp || bannedNode[head] == banStamp ||
+               toGoal[head] == std::numeric_limits<double>::infinity();
+    };
+    const auto estimate = [this](NodeId node) { return toGoal[node]; };
+
+    while (static_cast<int>(accepted.size()) < k) {
+        const Path& previous = accepted.back();
+        const size_t wanted = static_cast<size_t>(k) - accepted.size();
+        double rootCost = 0.0;
+        for (size_t j = 0; j < previous.edges.size(); rootCost += costs[previous.edges[j]], ++j) {
+            if (j < previous.deviation) continue;   // Spurs before the deviation belong to the parent
+
+            const double limit = candidates.size() >= wanted ? candidates[wanted - 1].cost - rootCost : unlimited;
+            if (++banStamp == 0) {
+                std::fill(bannedNode.begin(), bannedNode.end(), 0u);
+                std::fill(bannedEdge.begin(), bannedEdge.end(), 0u);
+                banStamp = 1;
+            }
+            // Keep the spur loopless and off every accepted route with this root
+            for (size_t i = 0; i < j; ++i) {
+                bannedNode[previous.nodes[i]] = banStamp;
+            }
+            for (const Path& path : accepted) {
+                if (path.edges.size() > j && std::equal(path.edges.begin(), path.edges.begin() + j,
+                                                        previous.edges.begin())) {
+                    bannedEdge[path.edges[j]] = banStamp;
+                }
+            }
+
+            const NodeId spurNode = previous.nodes[j];
+            if (!searchTree(city, spurNode, goal, cost, skip, estimate, limit)) continue;
+
+            Path candidate;
+            candidate.edges.assign(previous.edges.begin(), previous.edges.begin() + j);
+            candidate.nodes.assign(previous.nodes.begin(), previous.nodes.begin() + j + 1);
+            candidate.cost = rootCost + dist[goal];
+            candidate.deviation = j;
+            appendTrace(candidate, spurNode);
+            if (std::any_of(candidates.begin(), candidates.end(),
+                            [&](const Path& other) { return other.edges == candidate.edges; })) {
+                continue;
+            }
+            auto at = std::upper_bound(candidates.begin(), candidates.end(), candidate.cost,
+                                       [](double value, const Path& other) { return value < other.cost; });
+            candidates.insert(at, std::move(candidate));
+            if (candidates.size() > wanted) {
+                candidates.resize(wanted);
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+        accepted.push_back(std::move(candidates.front()));
+        candidates.erase(candidates.begin());
     }
 
-    return reconstructPath(predecessors, edgeMap, start, goal);
+    alternatives.reserve(accepted.size());
+    for (const Path& path : accepted) {
+        Alternative alternative;
+        for (int e : path.edges) {
+            alternative.path.push_back(graph.ids[e]);
+        }
+        alternative.cost = path.cost;
+        alternatives.push_back(std::move(alternative));
+    }
+    return alternatives;
 }
 
-std::deque<EdgeId> RoutePlanner::reconstructPath(
-    const std::unordered_map<NodeId, NodeId>& predecessors,
-    const std::unordered_map<std::pair<NodeId, NodeId>, EdgeId,
-                             std::hash<std::pair<NodeId, NodeId>>>& edgeMap,
-    NodeId start, NodeId goal) {
+void RoutePlanner::reverseTree(const City& city, NodeId goal, const float* costs) {
+    std::fill(toGoal.begin(), toGoal.end(), std::numeric_limits<double>::infinity());
+    const int nodeSlots = static_cast<int>(graph.firstIn.size()) - 1;
+    if (goal < 0 || goal >= nodeSlots) {
+        return;
+    }
 
-    std::deque<EdgeId> path;
-    NodeId current = goal;
+    const CityState& state = city.getState();
+    const auto later = std::greater<std::pair<double, NodeId>>();
+    heap.clear();
+    toGoal[goal] = 0.0;
+    heap.push_back({0.0, goal});
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto [currentDist, currentNode] = heap.back();
+        heap.pop_back();
+        if (currentDist > toGoal[currentNode]) continue;
 
-    while (current != start) {
-        auto predIt = predecessors.find(current);
-        if (predIt == predecessors.end()) return std::deque<EdgeId>();
+        const int end = graph.firstIn[currentNode + 1];
+        for (int slot = graph.firstIn[currentNode]; slot < end; ++slot) {
+            const int e = graph.inEdges[slot];
+            if (graph.closed[e] || state.isBlocked(e)) continue;
+            const NodeId neighbor = graph.tail[e];
+            const double newDist = currentDist + costs[e];
+            if (newDist < toGoal[neighbor]) {
+                toGoal[neighbor] = newDist;
+                heap.push_back({newDist, neighbor});
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+}
 
-        NodeId previous = predIt->second;
+std::deque<EdgeId> RoutePlanner::dijkstra(const City& city, NodeId start, NodeId goal) {
+    if (!policy) {
+        return std::deque<EdgeId>();
+    }
+
+    syncGraph(city);
+    const double* length = graph.topology->lengthData().data();
+    const int* capacity = graph.topology->capacityData().data();
+    const int* occupancy = city.getState().occupancyData().data();
 
-        auto edgeIt = edgeMap.find({previous, current});
-        if (edgeIt == edgeMap.end()) return std::deque<EdgeId>();
+    switch (kernel) {
+        case Kernel::SHORTEST_PATH: {
+            const auto& p = static_cast<const ShortestPathPolicy&>(*policy);
+            return search(city, start, goal, [&](int e, double) {
+                return p.cost(length[e], capacity[e], occupancy[e]);
+            });
+        }
+        case Kernel::CONGESTION_AWARE: {
+            const auto& p = static_cast<const CongestionAwarePolicy&>(*policy);
+            return search(city, start, goal, [&](int e, double) {
+                return p.cost(length[e], capacity[e], occupancy[e]);
+            });
+        }
+        case Kernel::VOLUME_DELAY: {
+            const auto& p = static_cast<const VolumeDelayPolicy&>(*policy);
+            return search(city, start, goal, [&](int e, double) {
+                return p.cost(e, length[e], capacity[e], occupancy[e]);
+            });
+        }
+        case Kernel::GENERIC:
+            break;
+    }
+    return search(city, start, goal, [&](int e, double) {
+        return policy->edgeCost(city, graph.ids[e]);
+    });
+}
 
-        EdgeId edgeId = edgeIt->second;
-        path.push_front(edgeId);
-        current = previous;
+template <typename CostFn>
+std::deque<EdgeId> RoutePlanner::search(const City& city, NodeId start, NodeId goal, CostFn cost) {
+    if (!searchTree(city, start, goal, cost, [](int) { return false; }, [](NodeId) { return 0.0; },
+                    std::numeric_limits<double>::infinity())) {
+        return std::deque<EdgeId>(); // No path
     }
 
+    // Walk predecessor edges back from the goal
+    std::deque<EdgeId> path;
+    for (NodeId node = goal; node != start; node = predNode[node]) {
+        path.push_front(graph.ids[predEdge[node]]);
+    }
     return path;
 }
+
+template <typename CostFn, typename SkipFn, typename EstimateFn>
+bool RoutePlanner::searchTree(const City& city, NodeId start, NodeId goal, CostFn cost, SkipFn skip,
+                              EstimateFn estimate, double limit) {
+    const int nodeSlots = static_cast<int>(graph.firstOut.size()) - 1;
+    if (start < 0 || start >= nodeSlots || goal < 0 || goal >= nodeSlots) {
+        return false;
+    }
+
+    if (++stamp == 0) {
+        // Stamp wrapped: forget every old mark once
+        std::fill(visited.begin(), visited.end(), 0u);
+        stamp = 1;
+    }
+
+    const CityState& state = city.getState();
+    // Min-heap on (distance + estimate, node), matching std::priority_queue with std::greater
+    const auto later = std::greater<std::pair<double, NodeId>>();
+    heap.clear();
+
+    dist[start] = 0.0;
+    predEdge[start] = -1;
+    predNode[start] = start;
+    visited[start] = stamp;
+    heap.push_back({estimate(start), start});
+
+    // Search effort, reported once per search to the tick profiler
+    std::uint64_t pops = 0;
+    std::uint64_t relaxations = 0;
+    bool reached = false;
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        auto [key, currentNode] = heap.back();
+        heap.pop_back();
+        ++pops;
+
+        const double currentDist = dist[currentNode];
+        if (key > currentDist + estimate(currentNode)) continue;
+        if (key > limit) break;
+        if (currentNode == goal) {
+            reached = true;
+            break;
+        }
+
+        const int end = graph.firstOut[currentNode + 1];
+        for (int slot = graph.firstOut[currentNode]; slot < end; ++slot) {
+            const int e = graph.outEdges[slot];
+            if (graph.closed[e] || state.isBlocked(e) || skip(e)) continue;
+            ++relaxations;
+
+            const NodeId neighbor = graph.head[e];
+            const double newDist = currentDist + cost(e, currentDist);
+
+            if (visited[neighbor] != stamp || newDist < dist[neighbor]) {
+                visited[neighbor] = stamp;
+                dist[neighbor] = newDist;
+                predEdge[neighbor] = e;
+                predNode[neighbor] = currentNode;
+                heap.push_back({newDist + estimate(neighbor), neighbor});
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+    }
+
+    GRIDLOCK_PROFILE_COUNT(TickCounter::DIJKSTRA_POPS, pops);
+    GRIDLOCK_PROFILE_COUNT(TickCounter::EDGE_RELAXATIONS, relaxations);
+    return reached;
+}
+
+void RoutePlanner::syncGraph(const City& city) {
+    std::shared_ptr<const CityTopology> topology = city.getTopology();
+    if (topology == graph.topology && topology->getRevision() == graph.revision) {
+        return;
+    }
+
+    const std::vector<Edge>& edges = topology->getEdges();
+    const int edgeCount = static_cast<int>(edges.size());
+
+    int nodeSlots = 0;
+    for (const Node& node : topology->getNodes()) {
+        nodeSlots = std::max(nodeSlots, node.getId() + 1);
+    }
+    graph.head.resize(edgeCount);
+    graph.tail.assign(edgeCount, INVALID_NODE);
+    graph.closed.resize(edgeCount);
+    graph.ids.resize(edgeCount);
+    for (int e = 0; e < edgeCount; ++e) {
+        const Edge& edge = edges[e];
+        graph.head[e] = edge.getTo();
+        graph.closed[e] = edge.isBlocked() ? 1 : 0;
+        graph.ids[e] = edge.getId();
+        nodeSlots = std::max({nodeSlots, edge.getFrom() + 1, edge.getTo() + 1});
+    }
+
+    // Adjacency holds edge ids; resolve each through the id table so
+    // duplicate ids route over the same edge City::getEdge would return
+    graph.firstOut.assign(static_cast<size_t>(nodeSlots) + 1, 0);
+    graph.outEdges.clear();
+    graph.outEdges.reserve(edges.size());
+    for (NodeId node = 0; node < nodeSlots; ++node) {
+        graph.firstOut[node] = static_cast<int>(graph.outEdges.size());
+        for (EdgeId id : topology->outgoing(node)) {
+            const int e = topology->edgeIndex(id);
+            if (e >= 0 && graph.head[e] >= 0) {
+                graph.outEdges.push_back(e);
+            }
+        }
+    }
+    graph.firstOut[nodeSlots] = static_cast<int>(graph.outEdges.size());
+
+    // Reverse star over the same routed edges, grouped by target node
+    graph.firstIn.assign(static_cast<size_t>(nodeSlots) + 1, 0);
+    for (NodeId node = 0; node < nodeSlots; ++node) {
+        for (int slot = graph.firstOut[node]; slot < graph.firstOut[node + 1]; ++slot) {
+            const int e = graph.outEdges[slot];
+            graph.tail[e] = node;
+            ++graph.firstIn[graph.head[e] + 1];
+        }
+    }
+    for (NodeId node = 0; node < nodeSlots; ++node) {
+        graph.firstIn[node + 1] += graph.firstIn[node];
+    }
+    graph.inEdges.resize(graph.outEdges.size());
+    std::vector<int> fill(graph.firstIn.begin(), graph.firstIn.end() - 1);
+    for (NodeId node = 0; node < nodeSlots; ++node) {
+        for (int slot = graph.firstOut[node]; slot < graph.firstOut[node + 1]; ++slot) {
+            const int e = graph.outEdges[slot];
+            graph.inEdges[fill[graph.head[e]]++] = e;
+        }
+    }
+
+    dist.assign(nodeSlots, 0.0);
+    predEdge.assign(nodeSlots, -1);
+    predNode.assign(nodeSlots, INVALID_NODE);
+    visited.assign(nodeSlots, 0u);
+    stamp = 0;
+    bannedNode.assign(nodeSlots, 0u);
+    bannedEdge.assign(edgeCount, 0u);
+    banStamp = 0;
+    toGoal.assign(nodeSlots, 0.0);
+    readyTick.assign(nodeSlots, 0);
+    entryTick.assign(nodeSlots, 0);
+
+    graph.revision = topology->getRevision();
+    graph.topology = std::move(topology);
+}
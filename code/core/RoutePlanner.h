@@ -1,20 +1,26 @@
 // code/core/RoutePlanner.h
 #pragma once
 #include "IRoutePolicy.h"
+#include "ReservationTable.h"
 #include "Types.h"
+#include <cstdint>
 #include <deque>
+#include <memory>
+#include <utility>
 #include <vector>
-#include <unordered_map>
-#include <queue>
-#include <limits>
 
 // Forward declarations
 class City;
+class CityTopology;
 class Agent;
+class EdgeCostProfiles;
 
 /**
  * RoutePlanner provides pathfinding functionality using Dijkstra's algorithm.
  * Acts as a façade that can work with different routing policies.
+ *
+ * Searches run over a dense copy of the topology kept by the planner, so
+ * one planner should not be shared between threads.
  */
 class RoutePlanner {
 public:
@@ -32,38 +38,212 @@ public:
     
     /**
      * Compute the optimal path for an agent using the current policy.
+     * Policies with alternatives (IRoutePolicy::alternativeCount above 1)
+     * get the route their chooseRoute picks, as in the overload below.
      * @param city Reference to the city containing the network
      * @param agent Reference to the agent needing a path
      * @return Deque of EdgeIds representing the path, empty if no path exists
      */
     std::deque<EdgeId> computePath(City& city, Agent& agent);
 
-private:
     /**
-     * Dijkstra's algorithm implementation.
-     * Finds the shortest path from start to goal using the current policy's edge costs.
+     * Route an agent from its current node with precomputed edge costs.
+     * If the policy asks for alternatives, searches that many
+     * (alternativePaths) and returns the one IRoutePolicy::chooseRoute
+     * picks; otherwise the cheapest path.
+     * @param city Reference to the city containing the network
+     * @param agent Agent to route (current node to destination)
+     * @param edgeCosts Cost per edge index, at least one per edge
+     * @return Deque of EdgeIds representing the path, empty if no path exists
+     * @throws std::runtime_error if edgeCosts does not cover every edge
+     */
+    std::deque<EdgeId> computePath(const City& city, const Agent& agent, const std::vector<float>& edgeCosts);
+    
+    /**
+     * Compute a path with precomputed edge costs instead of asking the
+     * policy (see EdgeCostTable). Closures are still taken from the city.
      * @param city Reference to the city containing the network
      * @param start Starting node ID
      * @param goal Destination node ID
+     * @param edgeCosts Cost per edge index, at least one per edge
      * @return Deque of EdgeIds representing the path, empty if no path exists
+     * @throws std::runtime_error if edgeCosts does not cover every edge
      */
-    std::deque<EdgeId> dijkstra(City& city, NodeId start, NodeId goal);
+    std::deque<EdgeId> computePath(const City& city, NodeId start, NodeId goal,
+                                   const std::vector<float>& edgeCosts);
     
     /**
-     * Reconstruct the path from the predecessor map.
-     * @param predecessors Map of node to previous node
-     * @param edgeMap Map of (from, to) -> edgeId
+     * Time-dependent search: every edge costs what its profile predicts
+     * for the time the search reaches it (departure plus the cost so far,
+     * scaled by the profiles' timePerCost). Exact when profiles are FIFO,
+     * i.e. entering an edge later never gets one out earlier; otherwise a
+     * good path, not necessarily the best. Closures are taken from the
+     * city.
+     * @param city Reference to the city containing the network
+     * @param start Starting node ID
+     * @param goal Destination node ID
+     * @param profiles Cost profile per edge index
+     * @param departureTime Tick the route starts at
+     * @return Deque of EdgeIds representing the path, empty if no path exists
+     * @throws std::runtime_error if profiles do not cover every edge
+     */
+    std::deque<EdgeId> computePath(const City& city, NodeId start, NodeId goal,
+                                   const EdgeCostProfiles& profiles, double departureTime);
+
+    /**
+     * Space-time search around reserved capacity: an edge without room
+     * (ReservationTable::hasRoom: claims plus, at the departure tick, its
+     * current occupancy reach its capacity) at the tick the search would
+     * enter it is entered at the first tick with room instead, so the
+     * route can be claimed with claimRoute. Each tick of waiting costs
+     * waitCost. Ticks beyond the table's window count as free. Each node
+     * keeps its cheapest arrival, so a later but cheaper arrival can hide
+     * an earlier one: a good route around predicted saturation, not
+     * necessarily the cheapest one in space-time. Closures are taken from
+     * the city.
+     * @param city Reference to the city containing the network
+     * @param start Starting node ID
+     * @param goal Destination node ID
+     * @param edgeCosts Cost per edge index, at least one per edge
+     * @param reservations Capacity already claimed by other routes
+     * @param departureTick Tick the route enters its first edge (at the earliest)
+     * @param waitCost Cost of one tick spent waiting at a node
+     * @param claims If given, receives the (edge index, entry tick) of
+     *        every edge of the path inside the table's window, for
+     *        ReservationTable::claimRoute
+     * @return Deque of EdgeIds representing the path, empty if no path exists
+     * @throws std::runtime_error if edgeCosts or reservations do not cover
+     *         every edge
+     */
+    std::deque<EdgeId> computePath(const City& city, NodeId start, NodeId goal,
+                                   const std::vector<float>& edgeCosts, const ReservationTable& reservations,
+                                   std::int64_t departureTick, double waitCost,
+                                   std::vector<ReservationTable::Claim>* claims = nullptr);
+
+    /**
+     * A route returned by alternativePaths, with its total cost.
+     */
+    struct Alternative {
+        std::deque<EdgeId> path;
+        double cost = 0.0;
+    };
+
+    /**
+     * Up to k loopless paths in order of increasing cost: the shortest path
+     * first, then the next cheapest routes that differ from it (Yen's
+     * algorithm). Spur searches are A* guided by exact distances to the
+     * goal from one reverse search, and are pruned two ways. Each path only
+     * spurs from the node where it left its parent (Lawler), and a spur
+     * search stops once it cannot beat the candidates already good enough
+     * to fill the remaining slots. Closures are taken from the city.
+     * @param city Reference to the city containing the network
      * @param start Starting node ID
      * @param goal Destination node ID
-     * @return Deque of EdgeIds representing the path
+     * @param edgeCosts Cost per edge index, at least one per edge
+     * @param k Most paths to return
+     * @return Paths in order of cost; empty if none exists or start == goal
+     * @throws std::runtime_error if edgeCosts does not cover every edge or k < 1
+     */
+    std::vector<Alternative> alternativePaths(const City& city, NodeId start, NodeId goal,
+                                              const std::vector<float>& edgeCosts, int k);
+
+private:
+    /**
+     * Dense forward-star copy of the routed topology: outgoing edges grouped
+     * by source node id, plus per-edge-index target and closure (lengths and
+     * capacities are read from the topology's flat arrays). Rebuilt when the
+     * city's topology or its revision changes.
      */
-    std::deque<EdgeId> reconstructPath(const std::unordered_map<NodeId, NodeId>& predecessors,
-                                     const std::unordered_map<std::pair<NodeId, NodeId>, EdgeId, 
-                                                             std::hash<std::pair<NodeId, NodeId>>>& edgeMap,
-                                     NodeId start, NodeId goal);
+    struct SearchGraph {
+        std::shared_ptr<const CityTopology> topology;
+        std::uint64_t revision = 0;
+        std::vector<int> firstOut;          // Node id -> first slot in outEdges (nodes + 1 entries)
+        std::vector<int> outEdges;          // Edge indices grouped by source node id
+        std::vector<int> firstIn;           // Node id -> first slot in inEdges (nodes + 1 entries)
+        std::vector<int> inEdges;           // Edge indices grouped by target node id
+        std::vector<NodeId> head;           // Edge index -> target node
+        std::vector<NodeId> tail;           // Edge index -> source node
+        std::vector<std::uint8_t> closed;   // Edge index -> closed in the topology
+        std::vector<EdgeId> ids;            // Edge index -> edge id
+    };
+    
+    /**
+     * Search kernel instantiated for the policy in use. Built-in policies
+     * get a kernel whose cost inlines into the relaxation loop; anything
+     * else (PolicyRegistry plug-ins, mocks) goes through IRoutePolicy.
+     */
+    enum class Kernel { GENERIC, SHORTEST_PATH, CONGESTION_AWARE, VOLUME_DELAY };
+    
+    static Kernel selectKernel(const IRoutePolicy* p);
+    
+    /**
+     * Dijkstra's algorithm dispatched to the kernel for the current policy.
+     * @param city Reference to the city containing the network
+     * @param start Starting node ID
+     * @param goal Destination node ID
+     * @return Deque of EdgeIds representing the path, empty if no path exists
+     */
+    std::deque<EdgeId> dijkstra(const City& city, NodeId start, NodeId goal);
+    
+    /**
+     * Dijkstra over the search graph.
+     * @param cost Callable returning the cost of an edge index left with
+     *        the given distance label (time-independent kernels ignore it)
+     */
+    template <typename CostFn>
+    std::deque<EdgeId> search(const City& city, NodeId start, NodeId goal, CostFn cost);
+    
+    /**
+     * Search core behind search(): fills dist / predEdge / predNode.
+     * @param skip Callable returning true for an edge index to leave out
+     * @param estimate Callable returning a consistent lower bound on a
+     *        node's remaining distance to goal (A*; 0 for Dijkstra)
+     * @param limit Give up once no open node can reach goal within this
+     * @return true if goal was reached within limit
+     */
+    template <typename CostFn, typename SkipFn, typename EstimateFn>
+    bool searchTree(const City& city, NodeId start, NodeId goal, CostFn cost, SkipFn skip,
+                    EstimateFn estimate, double limit);
+    
+    /**
+     * Distances to goal from every node over fixed edge costs, into
+     * toGoal (infinity where goal cannot be reached).
+     */
+    void reverseTree(const City& city, NodeId goal, const float* costs);
+    
+    /**
+     * Rebuild the search graph if the city's topology changed.
+     */
+    void syncGraph(const City& city);
     
     /**
      * Current routing policy.
      */
     IRoutePolicy* policy{nullptr};
-};
\ No newline at end of file
+    Kernel kernel{Kernel::GENERIC};
+    
+    SearchGraph graph;
+    
+    // Per-search scratch, reused across searches. A node's distance and
+    // predecessor are valid only while visited[node] == stamp, so starting
+    // a search does not clear the arrays.
+    std::vector<double> dist;
+    std::vector<int> predEdge;                  // Edge index that reached the node
+    std::vector<NodeId> predNode;               // Node that edge was relaxed from
+    std::vector<std::uint32_t> visited;
+    std::uint32_t stamp = 0;
+    std::vector<std::pair<double, NodeId>> heap;
+    
+    // Yen's spur searches: nodes and edge indices left out of the current
+    // search are marked with banStamp
+    std::vector<std::uint32_t> bannedNode;
+    std::vector<std::uint32_t> bannedEdge;
+    std::uint32_t banStamp = 0;
+    std::vector<double> toGoal;
+    std::vector<float> agentCosts;              // Policy costs for computePath(city, agent) with alternatives
+    
+    // Space-time search: tick a node's label can leave it, and the tick
+    // its predecessor edge was entered
+    std::vector<std::int64_t> readyTick;
+    std::vector<std::int64_t> entryTick;
+};
@@ -0,0 +1,92 @@
+// code/core/ScenarioBrancher.cpp
+#include "ScenarioBrancher.h"
+#include "SimulationController.h"
+#include "City.h"
+#include "Agent.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+ScenarioBrancher::ScenarioBrancher(const SimulationController& source)
+    : base(source.captureSnapshot()) {
+}
+
+std::unique_ptr<SimulationController> ScenarioBrancher::createBranch(const Intervention& intervention) const {
+    auto branch = std::make_unique<SimulationController>();
+    branch->restoreSnapshot(base);
+
+    City* city = branch->getCity();
+    for (EdgeId edgeId : intervention.closeEdges) {
+        city->setEdgeBlocked(edgeId, true);
+    }
+    for (EdgeId edgeId : intervention.reopenEdges) {
+        city->setEdgeBlocked(edgeId, false);
+        // Preset closures live on the topology: clear them on the branch's
+        // own copy (City::getEdge detaches it), never on the shared one
+        if (city->getTopology()->getEdge(edgeId).isBlocked()) {
+            city->getEdge(edgeId).setBlocked(false);
+        }
+    }
+    if (intervention.policy.has_value()) {
+        branch->setPolicy(intervention.policy.value());
+    }
+    return branch;
+}
+
+std::vector<ScenarioBrancher::BranchResult> ScenarioBrancher::run(
+    const std::vector<Intervention>& interventions, int ticks, int maxThreads) const {
+
+    std::vector<BranchResult> results(interventions.size());
+    std::vector<std::exception_ptr> errors(interventions.size());
+    std::atomic<size_t> next{0};
+
+    auto worker = [&]() {
+        for (size_t i = next++; i < interventions.size(); i = next++) {
+            try {
+                auto branch = createBranch(interventions[i]);
+                for (int t = 0; t < ticks; ++t) {
+                    branch->tick();
+                }
+
+                const Metrics& metrics = *branch->getMetrics();
+                BranchResult& result = results[i];
+                result.name = interventions[i].name;
+                result.metrics = metrics;
+                result.averageTripTime = metrics.averageTripTime();
+                result.totalThroughput = metrics.totalThroughput();
+                result.maxEdgeLoad = metrics.getMaxEdgeLoad();
+                result.activeAgents = static_cast<int>(std::count_if(
+                    branch->getAgents().begin(), branch->getAgents().end(),
+                    [](const Agent* agent) { return !agent->hasArrived(); }));
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    // Branches only share the read-only topology, so they can run concurrently
+    int threadCount = maxThreads > 0 ? maxThreads
+                                     : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    threadCount = std::min<int>(threadCount, static_cast<int>(interventions.size()));
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return results;
+}
+
+int ScenarioBrancher::getForkTick() const {
+    return base.metrics.getCurrentTick();
+}
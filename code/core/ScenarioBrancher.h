@@ -0,0 +1,79 @@
+// code/core/ScenarioBrancher.h
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Types.h"
+#include "Preset.h"
+#include "Metrics.h"
+#include "SimulationSnapshot.h"
+
+class SimulationController;
+
+/**
+ * ScenarioBrancher answers "what if?" questions mid-run.
+ *
+ * It forks the current state of a SimulationController into N in-process
+ * branches (each shares the topology and copies only the mutable state,
+ * including the routing modes and their waves, history and reservations),
+ * applies one intervention per branch and runs all branches forward in
+ * parallel. The source controller is never modified.
+ */
+class ScenarioBrancher {
+public:
+    /**
+     * Changes applied to a branch at the fork point.
+     * Closures are per-branch (City::setEdgeBlocked), never written to the
+     * shared topology. Reopening an edge closed in the topology itself
+     * (a preset closure) gives the branch a private copy of the topology.
+     */
+    struct Intervention {
+        std::string name;
+        std::vector<EdgeId> closeEdges;
+        std::vector<EdgeId> reopenEdges;
+        std::optional<PolicyType> policy;
+    };
+
+    /**
+     * Outcome of one branch after running forward.
+     */
+    struct BranchResult {
+        std::string name;
+        Metrics metrics;          // Full accumulators (includes pre-fork history)
+        double averageTripTime = 0.0;
+        int totalThroughput = 0;
+        int maxEdgeLoad = 0;
+        int activeAgents = 0;     // Agents still travelling at the end
+    };
+
+    /**
+     * Fork from the controller's current tick.
+     * @param source Controller to fork (must have a city loaded)
+     */
+    explicit ScenarioBrancher(const SimulationController& source);
+
+    /**
+     * Run every intervention forward for the given number of ticks.
+     * @param interventions One entry per branch
+     * @param ticks Number of ticks to simulate in each branch
+     * @param maxThreads Worker thread limit (0 = hardware concurrency)
+     * @return Results in the same order as interventions
+     */
+    std::vector<BranchResult> run(const std::vector<Intervention>& interventions,
+                                  int ticks, int maxThreads = 0) const;
+
+    /**
+     * Create a paused controller for one branch (for interactive stepping).
+     */
+    std::unique_ptr<SimulationController> createBranch(const Intervention& intervention) const;
+
+    /**
+     * Tick at which the branches were forked.
+     */
+    int getForkTick() const;
+
+private:
+    SimulationSnapshot base;
+};
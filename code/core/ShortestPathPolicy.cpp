@@ -2,11 +2,57 @@
 #include "ShortestPathPolicy.h"
 #include "City.h"
 #include "Agent.h"
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 double ShortestPathPolicy::edgeCost(const City& city, EdgeId edgeId) const {
     return city.edgeLength(edgeId);
 }
 
+void ShortestPathPolicy::edgeCosts(const City& city, std::span<const EdgeId> edgeIds,
+                                   std::span<float> out) const {
+    if (out.size() < edgeIds.size()) {
+        throw std::runtime_error("Edge cost output is shorter than the edge list");
+    }
+    const auto topology = city.getTopology();
+    const std::vector<double>& lengths = topology->lengthData();
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        int index = topology->edgeIndex(edgeIds[i]);
+        // Unknown ids take the scalar path, which reports them
+        out[i] = static_cast<float>(index >= 0 ? lengths[index] : edgeCost(city, edgeIds[i]));
+    }
+}
+
+void ShortestPathPolicy::loadedEdgeCosts(const City& city, std::span<const int> occupancy,
+                                         std::span<float> out) const {
+    if (occupancy.size() < city.getTopology()->lengthData().size()) {
+        throw std::runtime_error("Occupancy is shorter than the edge count");
+    }
+    allEdgeCosts(city, out);
+}
+
+void ShortestPathPolicy::allEdgeCosts(const City& city, std::span<float> out) const {
+    const std::vector<double>& lengths = city.getTopology()->lengthData();
+    const size_t count = lengths.size();
+    if (out.size() < count) {
+        throw std::runtime_error("Edge cost output is shorter than the edge count");
+    }
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= count; i += 4) {
+        __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(lengths.data() + i));
+        __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(lengths.data() + i + 2));
+        _mm_storeu_ps(out.data() + i, _mm_movelh_ps(low, high));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<float>(lengths[i]);
+    }
+}
+
 bool ShortestPathPolicy::shouldRerouteOnNode(const Agent& agent) const {
     // Only reroute if the agent has no path (needs initial route)
     return agent.getPath().empty();
@@ -16,6 +16,22 @@ public:
      */
     double edgeCost(const City& city, EdgeId edgeId) const override;
     
+    /**
+     * Batch edgeCost over the topology's flat arrays. The whole-network
+     * form is vectorized (SSE2 where available).
+     */
+    void edgeCosts(const City& city, std::span<const EdgeId> edgeIds, std::span<float> out) const override;
+    void allEdgeCosts(const City& city, std::span<float> out) const override;
+    void loadedEdgeCosts(const City& city, std::span<const int> occupancy, std::span<float> out) const override;
+    
+    /**
+     * Cost from raw edge data. Inline so RoutePlanner's search specialized
+     * for this policy needs no virtual call per relaxation.
+     */
+    double cost(double length, int /*capacity*/, int /*occupancy*/) const {
+        return length;
+    }
+    
     /**
      * Determine if an agent should reroute when reaching a node.
      * Returns false unless the path is empty (agent needs initial route).
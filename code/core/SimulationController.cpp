@@ -8,10 +8,35 @@
 #include "Edge.h"
 #include "ShortestPathPolicy.h"
 #include "CongestionAwarePolicy.h"
+#include "VolumeDelayPolicy.h"
+#include "RouteDiversityPolicy.h"
+#include "TickProfiler.h"
 #include "../adapters/PresetLoader.h"
+#include "../adapters/SnapshotSerializer.h"
+#include <optional>
 #include <random>
 #include <algorithm>
 #include <unordered_set>
+#include <stdexcept>
+
+namespace {
+    // Time-dependent routing: ticks of occupancy the trend is fitted to,
+    // and the spacing of profile breakpoints (an agent crosses an edge in
+    // two ticks: one to enter, one to leave). Profiles are rebuilt once per
+    // slot, so the history also keeps the rows recorded since the last
+    // slot boundary.
+    constexpr size_t kHistoryTicks = 8;
+    constexpr int kProfileSlotTicks = 2;
+    constexpr size_t kHistoryRows = kHistoryTicks + kProfileSlotTicks - 1;
+
+    // A free-flow edge costs about the mean length under every built-in policy
+    double meanEdgeLength(const City& city) {
+        const std::vector<double>& lengths = city.getTopology()->lengthData();
+        double total = 0.0;
+        for (double length : lengths) total += length;
+        return lengths.empty() ? 1.0 : total / lengths.size();
+    }
+}
 
 // Singleton instance
 std::unique_ptr<SimulationController> SimulationController::instance_ = nullptr;
@@ -64,6 +89,8 @@ void SimulationController::loadPreset(const Preset& preset) {
 
     // Save initial state for reset
     saveInitialState();
+    edgeCosts.invalidate();
+    invalidateChanges();
 }
 
 void SimulationController::buildGridCity(int rows, int cols, 
@@ -72,6 +99,7 @@ void SimulationController::buildGridCity(int rows, int cols,
     PresetLoader loader;
     city = loader.createGridTopology(rows, cols);
     loader.applyBlockedEdges(*city, blockedEdges);
+    edgeCosts.invalidate();
 }
 
 void SimulationController::createAgents(int count, int totalNodes) {
@@ -103,6 +131,22 @@ std::unique_ptr<IRoutePolicy> SimulationController::createPolicy(PolicyType poli
             return std::make_unique<ShortestPathPolicy>();
         case PolicyType::CONGESTION_AWARE:
             return std::make_unique<CongestionAwarePolicy>();
+        case PolicyType::BPR:
+            return std::make_unique<VolumeDelayPolicy>(VolumeDelayPolicy::Function::BPR);
+        case PolicyType::CONICAL:
+            return std::make_unique<VolumeDelayPolicy>(VolumeDelayPolicy::Function::CONICAL);
+        case PolicyType::SYSTEM_OPTIMAL:
+            return std::make_unique<VolumeDelayPolicy>(
+                VolumeDelayPolicy::Function::BPR,
+                VolumeDelayPolicy::defaultParameters(VolumeDelayPolicy::Function::BPR),
+                VolumeDelayPolicy::Pricing::MARGINAL);
+        case PolicyType::CONICAL_SYSTEM_OPTIMAL:
+            return std::make_unique<VolumeDelayPolicy>(
+                VolumeDelayPolicy::Function::CONICAL,
+                VolumeDelayPolicy::defaultParameters(VolumeDelayPolicy::Function::CONICAL),
+                VolumeDelayPolicy::Pricing::MARGINAL);
+        case PolicyType::ROUTE_DIVERSITY:
+            return std::make_unique<RouteDiversityPolicy>();
         default:
             return std::make_unique<ShortestPathPolicy>();
     }
@@ -125,6 +169,9 @@ void SimulationController::pause() {
 
 void SimulationController::reset() {
     running = false;
+    occupancyHistory.clear();
+    profilesValid = false;
+    dropReservations();
     
     // Reset metrics
     if (metrics) {
@@ -142,12 +189,12 @@ void SimulationController::reset() {
         }
     }
     
-    // Reset city occupancy
+    // Reset city occupancy and run-time closures
     if (city) {
-        // Reset all edge occupancies to 0
-        // We need to iterate through all edges - this is a simplified approach
-        // In a full implementation, City would have a method to reset all occupancies
+        city->getState().clear();
     }
+    edgeCosts.invalidate();
+    invalidateChanges();
 }
 
 void SimulationController::tick() {
@@ -155,74 +202,296 @@ void SimulationController::tick() {
         return;
     }
 
+    // Compiled out unless GRIDLOCK_PROFILING is enabled (see TickProfiler)
+    GRIDLOCK_PROFILE_TICK(profiler, metrics->getCurrentTick() + 1);
+
     // Update metrics for this tick
-    metrics->tick();
+    {
+        GRIDLOCK_PROFILE_PHASE(TickPhase::METRICS);
+        metrics->tick();
+    }
+    // Agent moves keep the cost table current (markEdgeChanged); only the
+    // previous tick's planned load has to go
+    if (currentPolicy) {
+        edgeCosts.clearPlanned(*city, *currentPolicy);
+    }
+    if (reservationHorizon > 0) {
+        reservations.advance(metrics->getCurrentTick());
+    }
 
-    // Process each agent
-    for (auto& agent : agents) {
-        // Skip if agent has already arrived
-        if (agent->hasArrived()) {
-            continue;
+    // Process each agent; routing time is carved out of STEP by the
+    // nested ROUTE/REROUTE timers
+    {
+        GRIDLOCK_PROFILE_PHASE(TickPhase::STEP);
+        // Reserved and time-dependent searches do not read the cost table,
+        // so planned load would not steer them
+        if (routeWaves > 1 && reservationHorizon == 0 && profileHorizon == 0) {
+            GRIDLOCK_PROFILE_PHASE(TickPhase::ROUTE);
+            routeInWaves();
+        } else {
+            wavePlanned.clear();
         }
+        for (size_t index = 0; index < agents.size(); ++index) {
+            auto& agent = agents[index];
+            // Skip if agent has already arrived
+            if (agent->hasArrived()) {
+                continue;
+            }
 
-        // Check if agent needs a route or should reroute
-        bool needsReroute = false;
+            // Check if agent needs a route or should reroute
+            bool needsReroute = false;
         
-        // If agent needs initial route
-        if (agent->needsRoute()) {
-            // Compute path from origin to destination
-            std::deque<EdgeId> path = planner->computePath(*city, *agent);
-            if (!path.empty()) {
-                agent->setPath(path);
-            }
-        } else {
-            // Check if agent should reroute based on policy
-            // Agents reroute when they reach a node (not on an edge)
-            // and the policy says to reroute
-            if (!agent->getCurrentEdge().has_value() && currentPolicy) {
-                // Agent is at a node, check if it should reroute
-                if (currentPolicy->shouldRerouteOnNode(*agent)) {
-                    needsReroute = true;
+            // If agent needs initial route
+            if (agent->needsRoute()) {
+                GRIDLOCK_PROFILE_PHASE(TickPhase::ROUTE);
+                // Compute path from origin to destination
+                std::deque<EdgeId> path = routeAgent(*agent);
+                if (!path.empty()) {
+                    agent->setPath(path);
+                }
+            } else {
+                // Check if agent should reroute based on policy
+                // Agents reroute when they reach a node (not on an edge)
+                // and the policy says to reroute
+                if (!agent->getCurrentEdge().has_value() && currentPolicy) {
+                    // Agent is at a node, check if it should reroute
+                    if (currentPolicy->shouldRerouteOnNode(*agent)) {
+                        needsReroute = true;
+                    }
+                    // A reserved agent whose next edge is unclaimed, or whose
+                    // claimed tick has passed, claims a fresh schedule
+                    if (reservationHorizon > 0 && !agent->getPath().empty() &&
+                        claimedEntry(*agent) < metrics->getCurrentTick()) {
+                        needsReroute = true;
+                    }
                 }
             }
-        }
 
-        // If rerouting is needed, compute new path from current node
-        if (needsReroute) {
-            std::deque<EdgeId> newPath = planner->computePath(*city, *agent);
-            if (!newPath.empty()) {
-                agent->setPath(newPath);
+            // If rerouting is needed, compute new path from current node
+            if (needsReroute) {
+                GRIDLOCK_PROFILE_PHASE(TickPhase::REROUTE);
+                GRIDLOCK_PROFILE_COUNT(TickCounter::REROUTES, 1);
+                std::deque<EdgeId> newPath = routeAgent(*agent);
+                if (!newPath.empty()) {
+                    agent->setPath(newPath);
+                }
             }
-        }
 
-        // Record departure if this is the first tick for this agent
-        // (in a more complete implementation, we'd track this better)
+            // Record departure if this is the first tick for this agent
+            // (in a more complete implementation, we'd track this better)
         
-        // Move the agent one step
-        agent->step(*city);
-
-        // Check if agent just arrived
-        if (agent->hasArrived()) {
-            // Record arrival in metrics
-            int travelTime = agent->getTravelTime();
-            metrics->recordArrival(*agent, travelTime);
-        }
+            // Move the agent one step; reserved agents wait at the node
+            // until the tick their next edge is claimed for
+            std::optional<EdgeId> edgeBefore = agent->getCurrentEdge();
+            NodeId nodeBefore = agent->getCurrentNode();
+            if (reservationHorizon > 0 && !edgeBefore && !agent->getPath().empty() &&
+                claimedEntry(*agent) > metrics->getCurrentTick()) {
+                agent->wait();
+            } else {
+                agent->step(*city);
+            }
+
+            // Check if agent just arrived
+            if (agent->hasArrived()) {
+                // Record arrival in metrics
+                int travelTime = agent->getTravelTime();
+                metrics->recordArrival(*agent, travelTime);
+                agentClaims.erase(agent->getId());
+            }
+
+            // A wave-routed agent on its first edge is now occupancy, no
+            // longer planned load there; a reserved one has used its claim
+            std::optional<EdgeId> edgeAfter = agent->getCurrentEdge();
+            if (edgeAfter && edgeAfter != edgeBefore && reservationHorizon > 0) {
+                auto claims = agentClaims.find(agent->getId());
+                if (claims != agentClaims.end() && !claims->second.empty() &&
+                    claims->second.front().edgeIndex == city->getTopology()->edgeIndex(*edgeAfter)) {
+                    claims->second.erase(claims->second.begin());
+                }
+            }
+            if (edgeAfter && edgeAfter != edgeBefore && index < wavePlanned.size() && wavePlanned[index]) {
+                wavePlanned[index] = 0;
+                edgeCosts.removePlanned(*city, *currentPolicy, city->getTopology()->edgeIndex(*edgeAfter));
+            }
+
+            // Record what a display has to redraw (see takeChanges)
+            if (edgeAfter != edgeBefore || agent->getCurrentNode() != nodeBefore || agent->hasArrived()) {
+                markAgentChanged(index);
+                if (edgeBefore) markEdgeChanged(*edgeBefore);
+                if (edgeAfter) markEdgeChanged(*edgeAfter);
+            }
         
-        // Track max edge load by checking agent's current edge
-        if (agent->getCurrentEdge().has_value()) {
-            EdgeId edgeId = agent->getCurrentEdge().value();
-            int load = city->occupancy(edgeId);
-            metrics->updateMaxEdgeLoad(load);
+            // Track max edge load by checking agent's current edge
+            if (agent->getCurrentEdge().has_value()) {
+                EdgeId edgeId = agent->getCurrentEdge().value();
+                int load = city->occupancy(edgeId);
+                metrics->updateMaxEdgeLoad(load);
+            }
         }
     }
 
     // Update metrics with current city state
+    GRIDLOCK_PROFILE_PHASE(TickPhase::METRICS);
     metrics->snapshotEdgeLoads(*city);
+    if (profileHorizon > 0) {
+        recordOccupancy();
+    }
+}
+
+void SimulationController::recordOccupancy() {
+    if (occupancyHistory.size() >= kHistoryRows) {
+        // Reuse the oldest row's storage for the newest
+        std::rotate(occupancyHistory.begin(), occupancyHistory.begin() + 1, occupancyHistory.end());
+        occupancyHistory.back() = city->getState().occupancyData();
+    } else {
+        occupancyHistory.push_back(city->getState().occupancyData());
+    }
+}
+
+std::deque<EdgeId> SimulationController::routeAgent(const Agent& agent) {
+    if (!currentPolicy) {
+        return std::deque<EdgeId>();
+    }
+    if (reservationHorizon > 0) {
+        return routeReserved(agent);
+    }
+    // Profiles start on the last slot boundary and are predicted from the
+    // history as it stood then (the rows recorded since are left out), so
+    // a run restored mid-slot rebuilds exactly the profiles it had. After
+    // a load, restore or policy change they are rebuilt; otherwise each
+    // slot only reprices the edges whose trend moved.
+    const int now = metrics->getCurrentTick();
+    const int slotStart = now - now % kProfileSlotTicks;
+    const size_t sinceBoundary = static_cast<size_t>(now - slotStart);
+    if (profileHorizon > 0 && occupancyHistory.size() > sinceBoundary) {
+        const size_t end = occupancyHistory.size() - sinceBoundary;
+        const size_t begin = end > kHistoryTicks ? end - kHistoryTicks : 0;
+        const auto window = std::span<const std::vector<int>>(occupancyHistory).subspan(begin, end - begin);
+        if (!profilesValid) {
+            // Convert cost to ticks: a free-flow edge takes kProfileSlotTicks
+            const double meanLength = meanEdgeLength(*city);
+            const double timePerCost = meanLength > 0.0 ? kProfileSlotTicks / meanLength : 1.0;
+            profiles.rebuild(*city, *currentPolicy, window, slotStart, kProfileSlotTicks,
+                             profileHorizon / kProfileSlotTicks + 1, timePerCost);
+            profilesValid = true;
+        } else if (profiles.getStartTime() != slotStart) {
+            profiles.update(*city, *currentPolicy, window, slotStart);
+        }
+        return planner->computePath(*city, agent.getCurrentNode(), agent.getDestination(), profiles, now);
+    }
+    if (!edgeCosts.isValid()) {
+        edgeCosts.rebuild(*city, *currentPolicy);
+    }
+    // The planner honours policies that spread trips over alternatives
+    return planner->computePath(*city, agent, edgeCosts.costs());
+}
+
+std::deque<EdgeId> SimulationController::routeReserved(const Agent& agent) {
+    if (!edgeCosts.isValid()) {
+        edgeCosts.rebuild(*city, *currentPolicy);
+    }
+    const std::int64_t now = metrics->getCurrentTick();
+    if (reservations.edgeCount() != city->getEdgeCount() || reservations.getSlotCount() != reservationHorizon) {
+        reservations = ReservationTable(city->getEdgeCount(), reservationHorizon);
+        reservations.advance(now);
+        agentClaims.clear();
+    }
+
+    // The agent's old route no longer holds capacity while it searches
+    std::vector<ReservationTable::Claim>& claims = agentClaims[agent.getId()];
+    reservations.releaseRoute(claims);
+    // Waiting a tick costs what half a free-flow edge does (an edge takes two ticks)
+    const double waitCost = meanEdgeLength(*city) / ReservationTable::kTicksPerEdge;
+    std::deque<EdgeId> path = planner->computePath(*city, agent.getCurrentNode(), agent.getDestination(),
+                                                   edgeCosts.costs(), reservations, now, waitCost, &claims);
+    if (path.empty() || !reservations.claimRoute(claims, city->getTopology()->capacityData(),
+                                                 city->getState().occupancyData(), now)) {
+        claims.clear();
+    }
+    return path;
+}
+
+std::int64_t SimulationController::claimedEntry(const Agent& agent) const {
+    auto claims = agentClaims.find(agent.getId());
+    if (claims == agentClaims.end() || claims->second.empty() || agent.getPath().empty()) {
+        return -1;
+    }
+    const ReservationTable::Claim& next = claims->second.front();
+    if (next.edgeIndex != city->getTopology()->edgeIndex(agent.getPath().front())) {
+        return -1;
+    }
+    return next.tick;
+}
+
+void SimulationController::dropReservations() {
+    reservations = ReservationTable();
+    agentClaims.clear();
+}
+
+void SimulationController::routeInWaves() {
+    wavePlanned.assign(agents.size(), 0);
+    std::vector<size_t> pending;
+    for (size_t index = 0; index < agents.size(); ++index) {
+        if (agents[index]->needsRoute()) {
+            pending.push_back(index);
+        }
+    }
+    if (pending.empty() || !currentPolicy) {
+        return;
+    }
+
+    // Every agent of a wave sees the same costs; its routes then count as
+    // planned load for the waves after it
+    const size_t waveSize = (pending.size() + routeWaves - 1) / routeWaves;
+    std::vector<std::deque<EdgeId>> paths;
+    for (size_t begin = 0; begin < pending.size(); begin += waveSize) {
+        const size_t end = std::min(begin + waveSize, pending.size());
+        paths.clear();
+        for (size_t i = begin; i < end; ++i) {
+            paths.push_back(routeAgent(*agents[pending[i]]));
+        }
+        for (size_t i = begin; i < end; ++i) {
+            std::deque<EdgeId>& path = paths[i - begin];
+            if (!path.empty()) {
+                edgeCosts.addRoute(*city, *currentPolicy, path);
+                agents[pending[i]]->setPath(std::move(path));
+                wavePlanned[pending[i]] = 1;
+            }
+        }
+    }
+}
+
+void SimulationController::setRouteWaves(int waves) {
+    if (waves < 1) {
+        throw std::runtime_error("Route waves must be at least 1, got " + std::to_string(waves));
+    }
+    routeWaves = waves;
+}
+
+void SimulationController::setTimeDependentRouting(int horizonTicks) {
+    if (horizonTicks < 0) {
+        throw std::runtime_error("Prediction horizon must not be negative, got " + std::to_string(horizonTicks));
+    }
+    profileHorizon = horizonTicks;
+    profilesValid = false;
+    if (horizonTicks == 0) {
+        occupancyHistory.clear();
+    }
+}
+
+void SimulationController::setReservationRouting(int horizonTicks) {
+    if (horizonTicks < 0) {
+        throw std::runtime_error("Reservation horizon must not be negative, got " + std::to_string(horizonTicks));
+    }
+    reservationHorizon = horizonTicks;
+    dropReservations();
 }
 
 void SimulationController::setPolicy(PolicyType policy) {
     currentPolicyType = policy;
     currentPolicy = createPolicy(policy);
+    edgeCosts.invalidate();
+    profilesValid = false;
     if (planner) {
         planner->setPolicy(currentPolicy.get());
     }
@@ -232,6 +501,207 @@ PolicyType SimulationController::getPolicy() const {
     return currentPolicyType;
 }
 
+SimulationSnapshot SimulationController::captureSnapshot() const {
+    if (!city) {
+        throw std::runtime_error("No city loaded");
+    }
+
+    SimulationSnapshot snapshot;
+    snapshot.topology = city->getTopology();
+    snapshot.topologyFingerprint = snapshot.topology->fingerprint();
+    snapshot.nodeCount = city->getNodeCount();
+    snapshot.policy = currentPolicyType;
+    snapshot.tickMs = tickMs;
+    snapshot.routeWaves = routeWaves;
+    snapshot.profileHorizon = profileHorizon;
+    snapshot.occupancyHistory = occupancyHistory;
+    snapshot.reservationHorizon = reservationHorizon;
+    for (const auto& [id, claims] : agentClaims) {
+        if (!claims.empty()) {
+            snapshot.agentClaims.emplace_back(id, claims);
+        }
+    }
+    std::sort(snapshot.agentClaims.begin(), snapshot.agentClaims.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    snapshot.cityState = city->getState();
+    snapshot.agents.reserve(agents.size());
+    for (const auto& agent : agents) {
+        snapshot.agents.push_back(agent->getState());
+    }
+    snapshot.initialAgentRoutes = initialAgentRoutes;
+    snapshot.metrics = *metrics;
+    return snapshot;
+}
+
+void SimulationController::captureFrame(SimulationFrame& frame) const {
+    frame.tick = metrics ? metrics->getCurrentTick() : 0;
+    frame.policy = currentPolicyType;
+    frame.maxEdgeLoad = metrics ? metrics->getMaxEdgeLoad() : 0;
+
+    if (city) {
+        frame.topology = city->getTopology();
+        const std::vector<int>& occupancy = city->getState().occupancyData();
+        frame.edgeOccupancy.assign(occupancy.begin(), occupancy.end());
+    } else {
+        frame.topology.reset();
+        frame.edgeOccupancy.clear();
+    }
+
+    frame.agents.resize(agents.size());
+    int arrived = 0;
+    long long totalTravelTime = 0;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        const Agent& agent = *agents[i];
+        AgentFrame& out = frame.agents[i];
+        out.id = agent.getId();
+        out.origin = agent.getOrigin();
+        out.destination = agent.getDestination();
+        out.currentNode = agent.getCurrentNode();
+        out.currentEdge = agent.getCurrentEdge().value_or(-1);
+        out.travelTime = agent.getTravelTime();
+        out.arrived = agent.hasArrived();
+        if (out.arrived) {
+            ++arrived;
+            totalTravelTime += out.travelTime;
+        }
+    }
+    frame.arrivedAgents = arrived;
+    frame.activeAgents = static_cast<int>(agents.size()) - arrived;
+    frame.averageTravelTime = arrived > 0 ? static_cast<double>(totalTravelTime) / arrived : 0.0;
+    frame.finished = !agents.empty() && arrived == static_cast<int>(agents.size());
+}
+
+bool SimulationController::takeChanges(std::vector<int>& edgeIndices, std::vector<int>& agentIndices) {
+    edgeIndices.insert(edgeIndices.end(), changedEdges.begin(), changedEdges.end());
+    agentIndices.insert(agentIndices.end(), changedAgents.begin(), changedAgents.end());
+    for (int index : changedEdges) {
+        edgeChanged[index] = 0;
+    }
+    for (int index : changedAgents) {
+        agentChanged[index] = 0;
+    }
+    changedEdges.clear();
+    changedAgents.clear();
+
+    bool complete = changesComplete;
+    changesComplete = true;
+    return complete;
+}
+
+void SimulationController::markEdgeChanged(EdgeId edgeId) {
+    int index = city->getTopology()->edgeIndex(edgeId);
+    if (index < 0) {
+        return;
+    }
+    if (static_cast<size_t>(index) >= edgeChanged.size()) {
+        edgeChanged.resize(static_cast<size_t>(index) + 1, 0);
+    }
+    if (!edgeChanged[index]) {
+        edgeChanged[index] = 1;
+        changedEdges.push_back(index);
+    }
+    // Its occupancy changed, so later searches this tick need a new cost
+    if (currentPolicy) {
+        edgeCosts.update(*city, *currentPolicy, index);
+    }
+}
+
+void SimulationController::markAgentChanged(size_t agentIndex) {
+    if (agentIndex >= agentChanged.size()) {
+        agentChanged.resize(agentIndex + 1, 0);
+    }
+    if (!agentChanged[agentIndex]) {
+        agentChanged[agentIndex] = 1;
+        changedAgents.push_back(static_cast<int>(agentIndex));
+    }
+}
+
+void SimulationController::invalidateChanges() {
+    edgeChanged.assign(city ? static_cast<size_t>(city->getEdgeCount()) : 0, 0);
+    agentChanged.assign(agents.size(), 0);
+    changedEdges.clear();
+    changedAgents.clear();
+    changesComplete = false;
+}
+
+void SimulationController::restoreSnapshot(const SimulationSnapshot& snapshot) {
+    std::shared_ptr<const CityTopology> topology = snapshot.topology;
+    if (!topology) {
+        if (!city || city->getTopology()->fingerprint() != snapshot.topologyFingerprint) {
+            throw std::runtime_error("Snapshot does not match the loaded city");
+        }
+        topology = city->getTopology();
+    }
+    if (snapshot.cityState.getEdgeCount() != topology->getEdgeCount()) {
+        throw std::runtime_error("Snapshot edge count does not match the city");
+    }
+    for (const auto& row : snapshot.occupancyHistory) {
+        if (row.size() != static_cast<size_t>(topology->getEdgeCount())) {
+            throw std::runtime_error("Snapshot occupancy history does not match the city");
+        }
+    }
+    for (const auto& entry : snapshot.agentClaims) {
+        for (const ReservationTable::Claim& claim : entry.second) {
+            if (claim.edgeIndex < 0 || claim.edgeIndex >= topology->getEdgeCount()) {
+                throw std::runtime_error("Snapshot reservation does not match the city");
+            }
+        }
+    }
+
+    setRouteWaves(snapshot.routeWaves);
+    setTimeDependentRouting(snapshot.profileHorizon);
+    setReservationRouting(snapshot.reservationHorizon);
+    running = false;
+    tickMs = snapshot.tickMs;
+    occupancyHistory = snapshot.profileHorizon > 0 ? snapshot.occupancyHistory : std::vector<std::vector<int>>();
+
+    city = std::make_unique<City>(topology);
+    city->getState() = snapshot.cityState;
+
+    agents.clear();
+    agents.reserve(snapshot.agents.size());
+    for (const auto& state : snapshot.agents) {
+        agents.push_back(std::make_unique<Agent>(state));
+    }
+    agentsPtrs.clear();
+    for (auto& agent : agents) {
+        agentsPtrs.push_back(agent.get());
+    }
+    initialAgentRoutes = snapshot.initialAgentRoutes;
+
+    *metrics = snapshot.metrics;   // In place: getMetrics() pointers stay valid
+
+    currentPolicyType = snapshot.policy;
+    currentPolicy = createPolicy(currentPolicyType);
+    planner = std::make_unique<RoutePlanner>(currentPolicy.get());
+    edgeCosts.invalidate();
+
+    // Rebuild the reservation table from the claims still ahead
+    if (reservationHorizon > 0 && !snapshot.agentClaims.empty()) {
+        reservations = ReservationTable(city->getEdgeCount(), reservationHorizon);
+        reservations.advance(metrics->getCurrentTick());
+        const auto& capacity = city->getTopology()->capacityData();
+        for (const auto& [id, claims] : snapshot.agentClaims) {
+            // Replayed as counts: each claim passed admission when it was made
+            for (const ReservationTable::Claim& claim : claims) {
+                reservations.tryReserve(claim.edgeIndex, claim.tick, capacity[claim.edgeIndex]);
+            }
+            agentClaims[id] = claims;
+        }
+    }
+    invalidateChanges();
+}
+
+void SimulationController::saveCheckpoint(const std::string& path) const {
+    SnapshotSerializer serializer;
+    serializer.writeFile(path, captureSnapshot());
+}
+
+void SimulationController::loadCheckpoint(const std::string& path) {
+    SnapshotSerializer serializer;
+    restoreSnapshot(serializer.readFile(path));
+}
+
 City* SimulationController::getCity() const {
     return city.get();
 }
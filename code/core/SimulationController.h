@@ -1,10 +1,20 @@
 // code/core/SimulationController.h
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
+#include "EdgeCostProfiles.h"
+#include "EdgeCostTable.h"
 #include "Preset.h"
 #include "IRoutePolicy.h"
+#include "ReservationTable.h"
+#include "SimulationFrame.h"
+#include "SimulationSnapshot.h"
+#include "TickProfiler.h"
 
 class City;
 class RoutePlanner;
@@ -36,7 +46,106 @@ public:
     void setPolicy(PolicyType policy);
     PolicyType getPolicy() const;
 
+    /**
+     * Wave route assignment: agents that need a route at the start of a
+     * tick are routed in this many waves instead of one by one on the same
+     * costs. Each wave's routes are charged to the tick's edge costs as
+     * planned load before the next wave routes, which spreads a burst of
+     * departures the way incremental assignment does; with
+     * PolicyType::SYSTEM_OPTIMAL it approximates the system optimum.
+     * When an agent enters the first edge of its route, that edge's planned
+     * vehicle becomes real occupancy instead. 1 (the default) turns waves
+     * off; waves are also skipped while reservation or time-dependent
+     * routing is on, whose searches do not read the planned load.
+     * @throws std::runtime_error if waves < 1
+     */
+    void setRouteWaves(int waves);
+    int getRouteWaves() const { return routeWaves; }
+
+    /**
+     * Time-dependent routing: route on each edge's predicted cost at the
+     * tick an agent would reach it instead of on the current snapshot.
+     * The controller records the last few ticks of occupancy, extends each
+     * edge's trend over the horizon (EdgeCostProfiles::fromHistory) and
+     * searches with RoutePlanner's time-dependent Dijkstra. Planned load
+     * from route waves is not part of the prediction.
+     * @param horizonTicks How far ahead to predict; 0 (the default) turns
+     *        time-dependent routing off
+     * @throws std::runtime_error if horizonTicks < 0
+     */
+    void setTimeDependentRouting(int horizonTicks);
+    int getTimeDependentHorizon() const { return profileHorizon; }
+
+    /**
+     * Reservation-based routing: every route claims the tick at which it
+     * will enter each edge in a ReservationTable covering the next
+     * horizonTicks, and routes come from RoutePlanner's space-time search,
+     * which waits for or avoids edges whose claims have reached capacity.
+     * Agents keep to their schedule: they wait at a node until the tick
+     * their next edge is claimed for, and claim a new route from where
+     * they stand once they fall behind it (an edge was full, the claims
+     * ran out at the end of the window, or the claim failed). An agent's
+     * claims are released when it reroutes. Takes precedence over
+     * time-dependent routing and route diversity.
+     * @param horizonTicks Ticks ahead to reserve; 0 (the default) turns
+     *        reservations off
+     * @throws std::runtime_error if horizonTicks < 0
+     */
+    void setReservationRouting(int horizonTicks);
+    int getReservationHorizon() const { return reservationHorizon; }
+
+    // Checkpoint / restore
+    /**
+     * Capture the full mutable state at the current tick boundary.
+     * The snapshot shares this run's topology.
+     */
+    SimulationSnapshot captureSnapshot() const;
+
+    /**
+     * Replace the current state with a snapshot (simulation is paused).
+     * Snapshots without a topology pointer are restored onto the currently
+     * loaded city, whose fingerprint must match. Metrics are restored in
+     * place, so pointers from getMetrics() stay valid.
+     * @throws std::runtime_error if the snapshot does not fit the network
+     */
+    void restoreSnapshot(const SimulationSnapshot& snapshot);
+
+    /**
+     * Fill a display frame with the current tick (see SimulationFrame).
+     * Reuses the frame's storage, so publishing every tick does not allocate.
+     * @param frame Frame to overwrite (sequence is left to the caller)
+     */
+    void captureFrame(SimulationFrame& frame) const;
+
+    /**
+     * Append the edge indices and agent indices changed since the previous
+     * call, then start a new change set. Ticks record every agent that
+     * moved or arrived and the edges it left or entered.
+     * @return false if the lists are not complete (first call, or after a
+     *         load, reset or restore); readers must then compare all state
+     */
+    bool takeChanges(std::vector<int>& edgeIndices, std::vector<int>& agentIndices);
+
+    /**
+     * Write a binary checkpoint (see SnapshotSerializer for the format).
+     */
+    void saveCheckpoint(const std::string& path) const;
+
+    /**
+     * Restore from a binary checkpoint written for the currently loaded preset.
+     */
+    void loadCheckpoint(const std::string& path);
+
+    /**
+     * Per-tick phase timings and counters. Only filled when the build
+     * defines GRIDLOCK_PROFILING; otherwise it stays empty.
+     */
+    TickProfiler& getProfiler() { return profiler; }
+    const TickProfiler& getProfiler() const { return profiler; }
+
     // Getters
+    // Closures may be edited through the city between ticks; occupancy
+    // belongs to the agents (routing caches track it through their moves)
     City* getCity() const;
     std::vector<Agent*>& getAgents();
     Metrics* getMetrics() const;
@@ -47,6 +156,15 @@ private:
     void createAgents(int count, int totalNodes);
     std::unique_ptr<IRoutePolicy> createPolicy(PolicyType policy);
     void saveInitialState();  // For reset functionality
+    std::deque<EdgeId> routeAgent(const Agent& agent);
+    std::deque<EdgeId> routeReserved(const Agent& agent);
+    std::int64_t claimedEntry(const Agent& agent) const;   // Claimed tick for the next edge, -1 if none
+    void dropReservations();
+    void routeInWaves();
+    void recordOccupancy();
+    void markEdgeChanged(EdgeId edgeId);
+    void markAgentChanged(size_t agentIndex);
+    void invalidateChanges();
 
     // Data members (as per requirements)
     std::unique_ptr<City> city;
@@ -60,6 +178,34 @@ private:
     std::vector<std::pair<NodeId, NodeId>> initialAgentRoutes;
     std::unique_ptr<IRoutePolicy> currentPolicy;
     PolicyType currentPolicyType = PolicyType::SHORTEST_PATH;
+    int routeWaves = 1;
+    std::vector<std::uint8_t> wavePlanned;     // Agents routed by this tick's waves, by index
+    TickProfiler profiler;
+    
+    // Route costs: built by the first search after a load, restore or
+    // policy change, then kept current edge by edge as agents move
+    EdgeCostTable edgeCosts;
+    
+    // Time-dependent routing: recent occupancy (oldest first) and the
+    // profiles predicted from it, rebuilt in place by the first search of
+    // each profile slot
+    int profileHorizon = 0;
+    std::vector<std::vector<int>> occupancyHistory;
+    EdgeCostProfiles profiles;
+    bool profilesValid = false;
+    
+    // Reservation-based routing: claimed capacity (sized by the first
+    // reserved search) and each agent's claims, by agent id
+    int reservationHorizon = 0;
+    ReservationTable reservations;
+    std::unordered_map<int, std::vector<ReservationTable::Claim>> agentClaims;
+    
+    // Change set since the last takeChanges() (flags dedupe the lists)
+    std::vector<std::uint8_t> edgeChanged;
+    std::vector<std::uint8_t> agentChanged;
+    std::vector<int> changedEdges;
+    std::vector<int> changedAgents;
+    bool changesComplete = false;
     
     // Helper for getAgents() - return vector of raw pointers
     mutable std::vector<Agent*> agentsPtrs;
@@ -0,0 +1,60 @@
+// code/core/SimulationFrame.h
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "CityTopology.h"
+#include "Preset.h"
+#include "Types.h"
+
+/**
+ * What the display needs to know about one agent.
+ */
+struct AgentFrame {
+    int id = 0;
+    NodeId origin = 0;
+    NodeId destination = 0;
+    NodeId currentNode = 0;
+    EdgeId currentEdge = -1;    // -1 while waiting at a node
+    int travelTime = 0;         // Steps taken so far (trip time once arrived)
+    bool arrived = false;
+};
+
+/**
+ * SimulationFrame - Immutable picture of one tick for the display.
+ *
+ * Produced by SimulationController::captureFrame on the simulation thread
+ * and handed to the UI through SimulationRunner's triple buffer, so views
+ * never touch the live City or Agents. The topology is shared with the
+ * running simulation (it is immutable while shared); everything else is a
+ * copy. Frames are overwritten in place, so vectors keep their capacity
+ * from tick to tick.
+ *
+ * changedEdges/changedAgents list what differs from the previous frame the
+ * display took, so views can update just those items. When fullRefresh is
+ * set the lists are empty and everything has to be compared.
+ */
+struct SimulationFrame {
+    std::uint64_t sequence = 0;     // Increases with every published frame
+    int tick = 0;
+    PolicyType policy = PolicyType::SHORTEST_PATH;
+
+    std::shared_ptr<const CityTopology> topology;   // Null before a preset is loaded
+    std::vector<int> edgeOccupancy;                 // By edge index
+    std::vector<AgentFrame> agents;
+
+    // Summary metrics
+    int activeAgents = 0;
+    int arrivedAgents = 0;
+    double averageTravelTime = 0.0;     // Mean over arrived agents
+    int maxEdgeLoad = 0;
+    bool finished = false;              // Every agent has arrived
+
+    // Dirty tracking (filled by SimulationRunner)
+    std::vector<int> changedEdges;      // Edge indices whose occupancy may have changed
+    std::vector<int> changedAgents;     // Agent indices that moved or arrived
+    bool fullRefresh = true;
+
+    int totalAgents() const { return static_cast<int>(agents.size()); }
+};
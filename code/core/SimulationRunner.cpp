@@ -0,0 +1,160 @@
+// code/core/SimulationRunner.cpp
+#include "SimulationRunner.h"
+#include "SimulationController.h"
+#include <algorithm>
+
+SimulationRunner::SimulationRunner(SimulationController& controller)
+    : controller(controller) {
+    {
+        std::lock_guard<std::mutex> lock(controllerMutex);
+        publishLocked();
+    }
+    worker = std::thread(&SimulationRunner::run, this);
+}
+
+SimulationRunner::~SimulationRunner() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void SimulationRunner::start() {
+    withController([](SimulationController& c) { c.start(); });
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        running = true;
+    }
+    wake.notify_all();
+}
+
+void SimulationRunner::pause() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        running = false;
+    }
+    wake.notify_all();
+    withController([](SimulationController& c) { c.pause(); });
+}
+
+bool SimulationRunner::isRunning() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return running;
+}
+
+void SimulationRunner::step() {
+    withController([this](SimulationController& c) {
+        c.tick();
+        ticksRun.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+void SimulationRunner::setTickInterval(std::chrono::microseconds interval) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        this->interval = interval.count() > 0 ? interval : std::chrono::microseconds(0);
+    }
+    wake.notify_all();
+}
+
+std::chrono::microseconds SimulationRunner::getTickInterval() const {
+    std::lock_guard<std::mutex> lock(stateMutex);
+    return interval;
+}
+
+void SimulationRunner::publishLocked() {
+    // Once the display has taken the previous frame, pending changes start
+    // over; otherwise that frame may be dropped and its changes go out again
+    bool carried = frames.hasFresh();
+    if (!carried) {
+        pendingEdges.clear();
+        pendingAgents.clear();
+        pendingComplete = true;
+    }
+    if (!controller.takeChanges(pendingEdges, pendingAgents)) {
+        pendingComplete = false;
+    }
+    if (carried) {
+        std::sort(pendingEdges.begin(), pendingEdges.end());
+        pendingEdges.erase(std::unique(pendingEdges.begin(), pendingEdges.end()), pendingEdges.end());
+        std::sort(pendingAgents.begin(), pendingAgents.end());
+        pendingAgents.erase(std::unique(pendingAgents.begin(), pendingAgents.end()), pendingAgents.end());
+    }
+
+    SimulationFrame& frame = frames.writeBuffer();
+    controller.captureFrame(frame);
+    frame.fullRefresh = !pendingComplete;
+    if (pendingComplete) {
+        frame.changedEdges.assign(pendingEdges.begin(), pendingEdges.end());
+        frame.changedAgents.assign(pendingAgents.begin(), pendingAgents.end());
+    } else {
+        frame.changedEdges.clear();
+        frame.changedAgents.clear();
+        pendingEdges.clear();
+        pendingAgents.clear();
+    }
+    frame.sequence = ++sequence;
+    lastFrameFinished = frame.finished;
+    frames.publish();
+}
+
+void SimulationRunner::run() {
+    using Clock = std::chrono::steady_clock;
+    std::unique_lock<std::mutex> state(stateMutex);
+    Clock::time_point nextTick = Clock::now();
+
+    while (true) {
+        wake.wait(state, [this] { return stopping || running; });
+        if (stopping) {
+            break;
+        }
+        std::chrono::microseconds period = interval;
+        state.unlock();
+
+        bool finished = false;
+        bool ticked = false;
+        {
+            std::lock_guard<std::mutex> lock(controllerMutex);
+            // A pause() that landed while we waited for the controller
+            // wins, so no tick runs after pause() returns
+            bool stillRunning;
+            {
+                std::lock_guard<std::mutex> recheck(stateMutex);
+                stillRunning = running && !stopping;
+            }
+            if (stillRunning) {
+                controller.tick();
+                publishLocked();
+                // Counted under the lock so pause() returns with it settled
+                ticksRun.fetch_add(1, std::memory_order_relaxed);
+                ticked = true;
+                finished = lastFrameFinished;
+                if (finished) {
+                    controller.pause();
+                }
+            }
+        }
+
+        state.lock();
+        if (!ticked) {
+            continue;
+        }
+        if (finished) {
+            running = false;
+            continue;
+        }
+        if (period.count() > 0) {
+            // Fixed-rate pacing; after a slow tick, restart from now
+            // rather than bursting to catch up
+            Clock::time_point now = Clock::now();
+            nextTick = std::max(nextTick + period, now);
+            wake.wait_until(state, nextTick, [this] { return stopping || !running; });
+        } else {
+            nextTick = Clock::now();
+        }
+    }
+}
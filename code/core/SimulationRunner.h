@@ -0,0 +1,128 @@
+// code/core/SimulationRunner.h
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "SimulationFrame.h"
+#include "TripleBuffer.h"
+
+class SimulationController;
+
+/**
+ * SimulationRunner - Runs a SimulationController on a dedicated thread.
+ *
+ * The worker ticks at the configured interval (or as fast as it can with
+ * an interval of zero) and publishes a SimulationFrame after every tick
+ * through a lock-free TripleBuffer. The display polls pollFrame() at its
+ * own rate and renders currentFrame(); a slow tick never blocks painting
+ * and slow painting never holds back the simulation.
+ *
+ * All other access to the controller goes through withController(), which
+ * runs on the calling thread between two ticks and publishes a fresh frame
+ * afterwards (so loading a preset or switching policy shows up at once).
+ * The worker pauses itself when a frame reports every agent arrived.
+ *
+ * Frames carry the controller's change lists relative to the last frame
+ * the display took; changes from frames it never saw are folded into the
+ * next one, so applying changedEdges/changedAgents is always enough.
+ *
+ * Thread roles: one display thread calls pollFrame()/currentFrame(); any
+ * thread may call the control methods.
+ */
+class SimulationRunner {
+public:
+    explicit SimulationRunner(SimulationController& controller);
+    ~SimulationRunner();
+
+    SimulationRunner(const SimulationRunner&) = delete;
+    SimulationRunner& operator=(const SimulationRunner&) = delete;
+
+    // Simulation control
+    void start();
+    void pause();
+    bool isRunning() const;
+
+    /**
+     * Run exactly one tick now (on the calling thread) and publish it.
+     */
+    void step();
+
+    /**
+     * Delay between tick starts; zero runs unthrottled.
+     */
+    void setTickInterval(std::chrono::microseconds interval);
+    std::chrono::microseconds getTickInterval() const;
+
+    /**
+     * Run fn(controller) while the worker is between ticks, then publish a
+     * frame of the resulting state.
+     * @return Whatever fn returns
+     */
+    template <typename Fn>
+    decltype(auto) withController(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(controllerMutex);
+        PublishOnExit publish{*this};
+        return std::forward<Fn>(fn)(controller);
+    }
+
+    /**
+     * Like withController() but without publishing a frame; for reads and
+     * bookkeeping that do not change what the display shows (analytics,
+     * exports, profiler annotations).
+     */
+    template <typename Fn>
+    decltype(auto) withControllerNoPublish(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(controllerMutex);
+        return std::forward<Fn>(fn)(controller);
+    }
+
+    // --- Display side ---
+
+    /**
+     * Take the newest published frame, if any.
+     * @return true if currentFrame() changed
+     */
+    bool pollFrame() { return frames.update(); }
+    const SimulationFrame& currentFrame() const { return frames.read(); }
+
+    /**
+     * Ticks executed by the worker and step() since construction.
+     */
+    std::uint64_t getTicksRun() const { return ticksRun.load(std::memory_order_relaxed); }
+
+private:
+    struct PublishOnExit {
+        SimulationRunner& runner;
+        ~PublishOnExit() { runner.publishLocked(); }
+    };
+
+    void run();
+    void publishLocked();   // Caller holds controllerMutex
+
+    SimulationController& controller;
+    TripleBuffer<SimulationFrame> frames;
+    std::uint64_t sequence = 0;                 // Guarded by controllerMutex
+    bool lastFrameFinished = false;             // Guarded by controllerMutex
+    std::vector<int> pendingEdges;              // Changes not yet seen by the display
+    std::vector<int> pendingAgents;             //   (guarded by controllerMutex)
+    bool pendingComplete = false;
+    std::atomic<std::uint64_t> ticksRun{0};
+
+    // Held for each tick and for withController()
+    std::mutex controllerMutex;
+
+    // Worker state
+    mutable std::mutex stateMutex;
+    std::condition_variable wake;
+    bool running = false;
+    bool stopping = false;
+    std::chrono::microseconds interval{100000};
+
+    std::thread worker;     // Last: started after everything above exists
+};
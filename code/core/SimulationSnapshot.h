@@ -0,0 +1,47 @@
+// code/core/SimulationSnapshot.h
+#pragma once
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include "Types.h"
+#include "Preset.h"
+#include "CityTopology.h"
+#include "CityState.h"
+#include "Agent.h"
+#include "Metrics.h"
+#include "ReservationTable.h"
+
+/**
+ * SimulationSnapshot is the complete mutable state of a SimulationController
+ * at a tick boundary: city state, agents, metrics accumulators, settings and
+ * the routing modes' settings and state.
+ *
+ * The topology is referenced, not copied. Snapshots taken in-process keep a
+ * pointer to the shared topology; snapshots read from disk only carry the
+ * topology fingerprint and must be restored onto a matching network.
+ */
+struct SimulationSnapshot {
+    std::shared_ptr<const CityTopology> topology;  // Null when read from disk
+    std::uint64_t topologyFingerprint = 0;
+    int nodeCount = 0;
+
+    PolicyType policy = PolicyType::SHORTEST_PATH;
+    int tickMs = 100;
+    int routeWaves = 1;         // SimulationController::setRouteWaves
+    int profileHorizon = 0;     // SimulationController::setTimeDependentRouting
+    int reservationHorizon = 0; // SimulationController::setReservationRouting
+
+    CityState cityState;
+    std::vector<Agent::State> agents;
+    std::vector<std::pair<NodeId, NodeId>> initialAgentRoutes;
+    Metrics metrics;
+
+    // Time-dependent routing: recent occupancy by edge index, oldest first
+    std::vector<std::vector<int>> occupancyHistory;
+
+    // Reservation routing: each agent's claims not yet used, by agent id in
+    // ascending order. The reservation table is rebuilt from them; the
+    // claims already used lie before the next tick and are not needed.
+    std::vector<std::pair<int, std::vector<ReservationTable::Claim>>> agentClaims;
+};
@@ -0,0 +1,181 @@
+// code/core/TickProfiler.cpp
+#include "TickProfiler.h"
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+thread_local TickProfiler* TickProfiler::activeProfiler = nullptr;
+
+TickProfiler::TickProfiler(std::size_t capacity)
+    : epoch(Clock::now()),
+      capacity(capacity == 0 ? 1 : capacity) {
+}
+
+void TickProfiler::setCapacity(std::size_t capacity) {
+    this->capacity = capacity == 0 ? 1 : capacity;
+    ring.clear();
+    ring.shrink_to_fit();
+    next = 0;
+    recordCount = 0;
+}
+
+std::int64_t TickProfiler::sinceEpoch(Clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - epoch).count();
+}
+
+void TickProfiler::beginTick(int tick) {
+    if (!enabled) {
+        return;
+    }
+    current = TickRecord{};
+    current.tick = tick;
+    openChildNs = nullptr;
+    open = true;
+    tickStart = Clock::now();
+    current.startNs = sinceEpoch(tickStart);
+}
+
+void TickProfiler::endTick() {
+    if (!open) {
+        return;
+    }
+    current.totalNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - tickStart).count();
+    open = false;
+
+    if (ring.empty()) {
+        ring.resize(capacity);
+    }
+    ring[next] = current;
+    next = (next + 1) % ring.size();
+    if (recordCount < ring.size()) {
+        ++recordCount;
+    }
+}
+
+void TickProfiler::addPhaseTime(TickPhase phase, std::int64_t ns) {
+    if (open) {
+        current.phaseNs[static_cast<std::size_t>(phase)] += ns;
+    }
+}
+
+void TickProfiler::addToLastTick(TickPhase phase, std::int64_t ns) {
+    if (!enabled || recordCount == 0) {
+        return;
+    }
+    std::size_t last = (next + ring.size() - 1) % ring.size();
+    ring[last].phaseNs[static_cast<std::size_t>(phase)] += ns;
+}
+
+std::vector<TickRecord> TickProfiler::getRecords() const {
+    std::vector<TickRecord> records;
+    if (recordCount == 0) {
+        return records;
+    }
+    records.reserve(recordCount);
+    std::size_t first = (next + ring.size() - recordCount) % ring.size();
+    for (std::size_t i = 0; i < recordCount; ++i) {
+        records.push_back(ring[(first + i) % ring.size()]);
+    }
+    return records;
+}
+
+const TickRecord* TickProfiler::getLastRecord() const {
+    if (recordCount == 0) {
+        return nullptr;
+    }
+    return &ring[(next + ring.size() - 1) % ring.size()];
+}
+
+void TickProfiler::clear() {
+    next = 0;
+    recordCount = 0;
+    open = false;
+    openChildNs = nullptr;
+}
+
+const char* TickProfiler::phaseName(TickPhase phase) {
+    switch (phase) {
+        case TickPhase::ROUTE: return "route";
+        case TickPhase::REROUTE: return "reroute";
+        case TickPhase::STEP: return "step";
+        case TickPhase::METRICS: return "metrics";
+        case TickPhase::UI: return "ui";
+        default: return "unknown";
+    }
+}
+
+const char* TickProfiler::counterName(TickCounter counter) {
+    switch (counter) {
+        case TickCounter::DIJKSTRA_POPS: return "dijkstra_pops";
+        case TickCounter::EDGE_RELAXATIONS: return "edge_relaxations";
+        case TickCounter::REROUTES: return "reroutes";
+        case TickCounter::CAPACITY_WAITS: return "capacity_waits";
+        default: return "unknown";
+    }
+}
+
+void TickProfiler::exportChromeTrace(std::ostream& out) const {
+    // Trace timestamps are microseconds; pid/tid are fixed (one simulation)
+    auto micros = [](std::int64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    bool first = true;
+    auto beginEvent = [&]() -> std::ostream& {
+        out << (first ? "\n  " : ",\n  ");
+        first = false;
+        return out;
+    };
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    beginEvent() << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, "
+                 << "\"args\": {\"name\": \"simulation\"}}";
+
+    for (const TickRecord& record : getRecords()) {
+        // The tick slice covers the tick plus any UI time added afterwards
+        std::int64_t uiNs = record.phase(TickPhase::UI);
+        beginEvent() << "{\"name\": \"tick " << record.tick << "\", \"cat\": \"tick\", \"ph\": \"X\", "
+                     << "\"pid\": 1, \"tid\": 1, \"ts\": " << micros(record.startNs)
+                     << ", \"dur\": " << micros(record.totalNs + uiNs)
+                     << ", \"args\": {\"tick\": " << record.tick << "}}";
+
+        std::int64_t offset = record.startNs;
+        for (std::size_t p = 0; p < TickRecord::kPhaseCount; ++p) {
+            std::int64_t ns = record.phaseNs[p];
+            if (ns <= 0) {
+                continue;
+            }
+            if (static_cast<TickPhase>(p) == TickPhase::UI) {
+                offset = record.startNs + record.totalNs;
+            }
+            beginEvent() << "{\"name\": \"" << phaseName(static_cast<TickPhase>(p))
+                         << "\", \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1, "
+                         << "\"ts\": " << micros(offset) << ", \"dur\": " << micros(ns) << "}";
+            offset += ns;
+        }
+
+        beginEvent() << "{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"ts\": "
+                     << micros(record.startNs) << ", \"args\": {";
+        for (std::size_t c = 0; c < TickRecord::kCounterCount; ++c) {
+            out << (c ? ", " : "") << "\"" << counterName(static_cast<TickCounter>(c))
+                << "\": " << record.counters[c];
+        }
+        out << "}}";
+    }
+    out << "\n]}\n";
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void TickProfiler::exportChromeTrace(const std::string& path) const {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+    exportChromeTrace(out);
+    if (!out) {
+        throw std::runtime_error("Failed to write trace file: " + path);
+    }
+}
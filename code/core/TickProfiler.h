@@ -0,0 +1,236 @@
+// code/core/TickProfiler.h
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Phases of SimulationController::tick (plus the UI work that follows it).
+ * Phase times are exclusive: a phase nested inside another is subtracted
+ * from the enclosing one, so the phases of a tick add up to its total.
+ */
+enum class TickPhase {
+    ROUTE,      // Initial route computation
+    REROUTE,    // Policy-driven rerouting at nodes
+    STEP,       // Agent movement and arrival bookkeeping
+    METRICS,    // Metrics tick and edge-load snapshot
+    UI,         // Rendering after the tick (reported by the UI)
+    COUNT
+};
+
+/**
+ * Event counters accumulated per tick.
+ */
+enum class TickCounter {
+    DIJKSTRA_POPS,      // Priority-queue pops across all searches
+    EDGE_RELAXATIONS,   // Edges examined by the searches
+    REROUTES,           // Reroutes performed
+    CAPACITY_WAITS,     // Agents held at a node by a full edge
+    COUNT
+};
+
+/**
+ * Per-tick profile record.
+ */
+struct TickRecord {
+    static constexpr std::size_t kPhaseCount = static_cast<std::size_t>(TickPhase::COUNT);
+    static constexpr std::size_t kCounterCount = static_cast<std::size_t>(TickCounter::COUNT);
+
+    int tick = 0;
+    std::int64_t startNs = 0;   // Tick start, relative to the profiler's epoch
+    std::int64_t totalNs = 0;   // Wall time of SimulationController::tick
+    std::array<std::int64_t, kPhaseCount> phaseNs{};
+    std::array<std::uint64_t, kCounterCount> counters{};
+
+    std::int64_t phase(TickPhase p) const { return phaseNs[static_cast<std::size_t>(p)]; }
+    std::uint64_t counter(TickCounter c) const { return counters[static_cast<std::size_t>(c)]; }
+};
+
+/**
+ * TickProfiler - Low-overhead per-phase instrumentation for the tick loop.
+ *
+ * Keeps the most recent ticks in a fixed-size ring buffer, allocated by the
+ * first record (so an idle profiler costs no memory) and reused after that. The owning SimulationController opens a record at the
+ * start of each tick and makes the profiler active on the calling thread,
+ * so code deeper in the loop (RoutePlanner, Agent) reports through the
+ * GRIDLOCK_PROFILE_* macros without holding a pointer to it.
+ *
+ * The macros compile to nothing unless GRIDLOCK_PROFILING is defined to 1
+ * (CMake option GRIDLOCK_ENABLE_PROFILING); the class itself is always
+ * available so callers need no #ifdefs. When compiled in, a profiler can
+ * still be switched off at runtime with setEnabled(false).
+ *
+ * Not thread-safe: one profiler per simulation thread.
+ */
+class TickProfiler {
+public:
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+    explicit TickProfiler(std::size_t capacity = kDefaultCapacity);
+
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+
+    /**
+     * Resize the ring buffer (drops all records).
+     */
+    void setCapacity(std::size_t capacity);
+    std::size_t getCapacity() const { return capacity; }
+
+    // Record lifecycle (called by SimulationController::tick)
+    void beginTick(int tick);
+    void endTick();
+    bool inTick() const { return open; }
+
+    /**
+     * Add time to a phase of the open tick (ignored outside a tick).
+     */
+    void addPhaseTime(TickPhase phase, std::int64_t ns);
+
+    /**
+     * Add time to a phase of the most recently closed tick; used for work
+     * that follows the tick, such as the UI repaint.
+     */
+    void addToLastTick(TickPhase phase, std::int64_t ns);
+
+    void addCount(TickCounter counter, std::uint64_t n = 1) {
+        if (open) current.counters[static_cast<std::size_t>(counter)] += n;
+    }
+
+    /**
+     * Closed records, oldest first.
+     */
+    std::vector<TickRecord> getRecords() const;
+    std::size_t getRecordCount() const { return recordCount; }
+    const TickRecord* getLastRecord() const;
+    void clear();
+
+    /**
+     * Write the buffered ticks in Chrome trace event format (load in
+     * chrome://tracing or Perfetto). Each tick is a slice with its phases
+     * laid out back to back inside it; counters become counter tracks.
+     */
+    void exportChromeTrace(std::ostream& out) const;
+
+    /**
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void exportChromeTrace(const std::string& path) const;
+
+    static const char* phaseName(TickPhase phase);
+    static const char* counterName(TickCounter counter);
+
+    // Profiler receiving GRIDLOCK_PROFILE_* reports on this thread
+    static TickProfiler* active() { return activeProfiler; }
+
+    /**
+     * Makes a profiler active on this thread for the scope (restores the
+     * previous one on exit, so nested controllers behave).
+     */
+    class Activation {
+    public:
+        explicit Activation(TickProfiler* profiler)
+            : previous(activeProfiler) { activeProfiler = profiler; }
+        ~Activation() { activeProfiler = previous; }
+        Activation(const Activation&) = delete;
+        Activation& operator=(const Activation&) = delete;
+    private:
+        TickProfiler* previous;
+    };
+
+    /**
+     * Opens a tick record and activates the profiler for the scope.
+     */
+    class TickScope {
+    public:
+        TickScope(TickProfiler& profiler, int tick)
+            : profiler(profiler), activation(&profiler) { profiler.beginTick(tick); }
+        ~TickScope() { profiler.endTick(); }
+        TickScope(const TickScope&) = delete;
+        TickScope& operator=(const TickScope&) = delete;
+    private:
+        TickProfiler& profiler;
+        Activation activation;
+    };
+
+    /**
+     * Times a phase of the active profiler's open tick (exclusive of
+     * nested ScopedPhase timers).
+     */
+    class ScopedPhase {
+    public:
+        explicit ScopedPhase(TickPhase phase)
+            : profiler(activeProfiler), phase(phase) {
+            if (profiler && profiler->open) {
+                parentChildNs = profiler->openChildNs;
+                profiler->openChildNs = &childNs;
+                start = Clock::now();
+            } else {
+                profiler = nullptr;
+            }
+        }
+        ~ScopedPhase() {
+            if (!profiler) return;
+            std::int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start).count();
+            profiler->addPhaseTime(phase, elapsed - childNs);
+            profiler->openChildNs = parentChildNs;
+            if (parentChildNs) *parentChildNs += elapsed;
+        }
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+    private:
+        TickProfiler* profiler;
+        TickPhase phase;
+        std::int64_t childNs = 0;
+        std::int64_t* parentChildNs = nullptr;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    static void count(TickCounter counter, std::uint64_t n = 1) {
+        if (activeProfiler) activeProfiler->addCount(counter, n);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::int64_t sinceEpoch(Clock::time_point time) const;
+
+    bool enabled = true;
+    bool open = false;
+    TickRecord current;
+    Clock::time_point tickStart;
+    Clock::time_point epoch;
+    std::int64_t* openChildNs = nullptr;
+
+    std::size_t capacity;
+    std::vector<TickRecord> ring; // Empty until the first closed record
+    std::size_t next = 0;         // Slot for the next closed record
+    std::size_t recordCount = 0;  // Valid records (<= capacity)
+
+    static thread_local TickProfiler* activeProfiler;
+};
+
+#ifndef GRIDLOCK_PROFILING
+#define GRIDLOCK_PROFILING 0
+#endif
+
+#define GRIDLOCK_PROFILE_CONCAT_INNER(a, b) a##b
+#define GRIDLOCK_PROFILE_CONCAT(a, b) GRIDLOCK_PROFILE_CONCAT_INNER(a, b)
+
+#if GRIDLOCK_PROFILING
+#define GRIDLOCK_PROFILE_TICK(profiler, tick) \
+    TickProfiler::TickScope GRIDLOCK_PROFILE_CONCAT(gridlockTick, __LINE__)((profiler), (tick))
+#define GRIDLOCK_PROFILE_PHASE(phase) \
+    TickProfiler::ScopedPhase GRIDLOCK_PROFILE_CONCAT(gridlockPhase, __LINE__)(phase)
+#define GRIDLOCK_PROFILE_COUNT(counter, n) TickProfiler::count((counter), (n))
+#else
+#define GRIDLOCK_PROFILE_TICK(profiler, tick) ((void)0)
+#define GRIDLOCK_PROFILE_PHASE(phase) ((void)0)
+#define GRIDLOCK_PROFILE_COUNT(counter, n) ((void)0)
+#endif
@@ -0,0 +1,83 @@
+// code/core/TripleBuffer.h
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * TripleBuffer - Lock-free single-producer / single-consumer hand-off of
+ * the latest value.
+ *
+ * The producer fills writeBuffer() and publish()es it; the consumer calls
+ * update() whenever it wants to look and then reads read(). Neither side
+ * ever blocks or waits for the other: the three slots rotate through one
+ * atomic "middle" index, so the producer always has a private slot to
+ * write into and the consumer always holds a complete value. Values the
+ * consumer never looked at are simply overwritten (latest wins).
+ *
+ * Slots are reused, so T should keep its allocations across overwrites
+ * (e.g. vectors that are resized rather than rebuilt).
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // --- Producer side ---
+
+    /**
+     * Slot owned by the producer until the next publish().
+     */
+    T& writeBuffer() { return slots[writeIndex].value; }
+
+    /**
+     * Hand the write slot to the consumer and take the old middle slot.
+     */
+    void publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(writeIndex | kFresh),
+                                                std::memory_order_acq_rel);
+        writeIndex = previous & kIndexMask;
+    }
+
+    // --- Consumer side ---
+
+    /**
+     * Swap in the most recently published value, if there is a new one.
+     * @return true if read() changed
+     */
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & kFresh)) {
+            return false;
+        }
+        std::uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & kIndexMask;
+        return true;
+    }
+
+    /**
+     * Value held by the consumer (stable until its next update()).
+     */
+    const T& read() const { return slots[readIndex].value; }
+
+    /**
+     * Whether a value was published that the consumer has not taken yet.
+     */
+    bool hasFresh() const { return (middle.load(std::memory_order_acquire) & kFresh) != 0; }
+
+private:
+    static constexpr std::uint8_t kIndexMask = 0x3;
+    static constexpr std::uint8_t kFresh = 0x4;
+
+    // One cache line per slot so producer and consumer never false-share
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    std::array<Slot, 3> slots;
+    alignas(64) std::atomic<std::uint8_t> middle{1};
+    alignas(64) std::uint8_t writeIndex = 0;    // Producer only
+    alignas(64) std::uint8_t readIndex = 2;     // Consumer only
+};
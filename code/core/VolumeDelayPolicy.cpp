@@ -0,0 +1,142 @@
+// code/core/VolumeDelayPolicy.cpp
+#include "VolumeDelayPolicy.h"
+#include "City.h"
+#include "Agent.h"
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Integer BPR exponents up to this are evaluated by multiplication
+    constexpr double kMaxIntegerExponent = 16.0;
+}
+
+VolumeDelayPolicy::Parameters VolumeDelayPolicy::defaultParameters(Function function) {
+    if (function == Function::CONICAL) {
+        return {4.0, 0.0};
+    }
+    return {0.15, 4.0};
+}
+
+VolumeDelayPolicy::VolumeDelayPolicy(Function function)
+    : VolumeDelayPolicy(function, defaultParameters(function)) {
+}
+
+VolumeDelayPolicy::VolumeDelayPolicy(Function function, Parameters defaultValues)
+    : function(function), defaultParams(defaultValues) {
+    defaults = prepare(defaultValues);
+}
+
+VolumeDelayPolicy::VolumeDelayPolicy(Function function, Parameters defaultValues, Pricing pricing)
+    : VolumeDelayPolicy(function, defaultValues) {
+    this->pricing = pricing;
+}
+
+VolumeDelayPolicy::Coefficients VolumeDelayPolicy::prepare(Parameters parameters) {
+    Coefficients c;
+    c.alpha = parameters.alpha;
+    if (function == Function::CONICAL) {
+        if (!(parameters.alpha > 1.0)) {
+            throw std::runtime_error("Conical delay needs alpha > 1, got " + std::to_string(parameters.alpha));
+        }
+        c.alphaSquared = parameters.alpha * parameters.alpha;
+        c.beta = (2.0 * parameters.alpha - 1.0) / (2.0 * parameters.alpha - 2.0);
+        return c;
+    }
+
+    if (!(parameters.alpha >= 0.0) || !(parameters.beta >= 0.0)) {
+        throw std::runtime_error("BPR parameters must be non-negative");
+    }
+    c.beta = parameters.beta;
+    if (parameters.beta <= kMaxIntegerExponent && parameters.beta == std::floor(parameters.beta)) {
+        c.exponent = static_cast<int>(parameters.beta);
+        return c;
+    }
+
+    // Fractional exponent: share one table per distinct exponent
+    for (size_t i = 0; i < tableExponents.size(); ++i) {
+        if (tableExponents[i] == parameters.beta) {
+            c.table = static_cast<int>(i);
+            return c;
+        }
+    }
+    c.table = static_cast<int>(tableExponents.size());
+    tableExponents.push_back(parameters.beta);
+    for (int step = 0; step <= kTableSteps; ++step) {
+        tables.push_back(std::pow(step * (kTableMaxRatio / kTableSteps), parameters.beta));
+    }
+    return c;
+}
+
+void VolumeDelayPolicy::setEdgeParameters(int edgeIndex, Parameters parameters) {
+    if (edgeIndex < 0) {
+        throw std::runtime_error("Invalid edge index: " + std::to_string(edgeIndex));
+    }
+    Coefficients c = prepare(parameters);
+    if (edgeIndex >= static_cast<int>(edges.size())) {
+        edges.resize(static_cast<size_t>(edgeIndex) + 1);
+    }
+    edges[edgeIndex] = {parameters, c, true};
+}
+
+VolumeDelayPolicy::Parameters VolumeDelayPolicy::getEdgeParameters(int edgeIndex) const {
+    if (edgeIndex >= 0 && edgeIndex < static_cast<int>(edges.size()) && edges[edgeIndex].overridden) {
+        return edges[edgeIndex].parameters;
+    }
+    return defaultParams;
+}
+
+double VolumeDelayPolicy::edgeCost(const City& city, EdgeId edgeId) const {
+    int index = city.getTopology()->edgeIndex(edgeId);
+    return cost(index, city.edgeLength(edgeId), city.edgeCapacity(edgeId), city.occupancy(edgeId));
+}
+
+double VolumeDelayPolicy::loadedEdgeCost(const City& city, EdgeId edgeId, int extraLoad) const {
+    int index = city.getTopology()->edgeIndex(edgeId);
+    return cost(index, city.edgeLength(edgeId), city.edgeCapacity(edgeId), city.occupancy(edgeId) + extraLoad);
+}
+
+void VolumeDelayPolicy::edgeCosts(const City& city, std::span<const EdgeId> edgeIds,
+                                  std::span<float> out) const {
+    if (out.size() < edgeIds.size()) {
+        throw std::runtime_error("Edge cost output is shorter than the edge list");
+    }
+    const auto topology = city.getTopology();
+    const double* length = topology->lengthData().data();
+    const int* capacity = topology->capacityData().data();
+    const int* occupancy = city.getState().occupancyData().data();
+    for (size_t i = 0; i < edgeIds.size(); ++i) {
+        int index = topology->edgeIndex(edgeIds[i]);
+        // Unknown ids take the scalar path, which reports them
+        out[i] = static_cast<float>(index >= 0 ? cost(index, length[index], capacity[index], occupancy[index])
+                                               : edgeCost(city, edgeIds[i]));
+    }
+}
+
+void VolumeDelayPolicy::allEdgeCosts(const City& city, std::span<float> out) const {
+    costsFor(city, city.getState().occupancyData().data(), out);
+}
+
+void VolumeDelayPolicy::loadedEdgeCosts(const City& city, std::span<const int> occupancy,
+                                        std::span<float> out) const {
+    if (occupancy.size() < static_cast<size_t>(city.getTopology()->getEdgeCount())) {
+        throw std::runtime_error("Occupancy is shorter than the edge count");
+    }
+    costsFor(city, occupancy.data(), out);
+}
+
+void VolumeDelayPolicy::costsFor(const City& city, const int* occupancy, std::span<float> out) const {
+    const auto topology = city.getTopology();
+    const double* length = topology->lengthData().data();
+    const int* capacity = topology->capacityData().data();
+    const int count = topology->getEdgeCount();
+    if (out.size() < static_cast<size_t>(count)) {
+        throw std::runtime_error("Edge cost output is shorter than the edge count");
+    }
+    for (int i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(cost(i, length[i], capacity[i], occupancy[i]));
+    }
+}
+
+bool VolumeDelayPolicy::shouldRerouteOnNode(const Agent& /*agent*/) const {
+    return true;
+}
@@ -0,0 +1,204 @@
+// code/core/VolumeDelayPolicy.h
+#pragma once
+#include "IRoutePolicy.h"
+#include <cmath>
+#include <limits>
+#include <vector>
+
+/**
+ * Route policy family built on volume-delay functions: an edge's cost is
+ * its free-flow cost (the length) scaled by a delay factor of the
+ * volume / capacity ratio x = occupancy / capacity.
+ *
+ * - BPR:     f(x) = 1 + alpha * x^beta  (Bureau of Public Roads; defaults 0.15, 4)
+ * - CONICAL: f(x) = 2 + sqrt(alpha^2 (1 - x)^2 + b^2) - alpha (1 - x) - b,
+ *            b = (2 alpha - 1) / (2 alpha - 2)  (Spiess; alpha > 1, default 4)
+ *
+ * With MARGINAL pricing an edge costs its marginal social cost instead:
+ * the delay one more vehicle suffers plus the delay it adds to everyone
+ * already on the edge, length * (f(x) + x f'(x)). Agents routed on these
+ * costs approach the system optimum rather than the user equilibrium.
+ *
+ * Parameters can be set per edge index; edges without their own use the
+ * policy defaults. Each edge keeps precomputed coefficients so no pow()
+ * runs while routing: integer BPR exponents are evaluated by repeated
+ * multiplication and fractional ones by a shared, linearly interpolated
+ * lookup table (pow() only beyond kTableMaxRatio).
+ */
+class VolumeDelayPolicy : public IRoutePolicy {
+public:
+    enum class Function { BPR, CONICAL };
+    enum class Pricing { AVERAGE, MARGINAL };
+
+    struct Parameters {
+        double alpha;
+        double beta;    // BPR exponent (unused by CONICAL)
+    };
+
+    // Lookup tables cover x in [0, kTableMaxRatio] with kTableSteps intervals
+    static constexpr double kTableMaxRatio = 4.0;
+    static constexpr int kTableSteps = 1024;
+
+    static Parameters defaultParameters(Function function);
+
+    /**
+     * @throws std::runtime_error if the defaults are invalid for the function
+     */
+    explicit VolumeDelayPolicy(Function function);
+    VolumeDelayPolicy(Function function, Parameters defaults);
+    VolumeDelayPolicy(Function function, Parameters defaults, Pricing pricing);
+
+    Function getFunction() const { return function; }
+    Pricing getPricing() const { return pricing; }
+    void setPricing(Pricing value) { pricing = value; }
+
+    /**
+     * Override the parameters of one edge (by CityTopology::edgeIndex).
+     * @throws std::runtime_error on a negative index or invalid parameters
+     *         (negative BPR alpha / beta, CONICAL alpha <= 1)
+     */
+    void setEdgeParameters(int edgeIndex, Parameters parameters);
+    Parameters getEdgeParameters(int edgeIndex) const;
+
+    double edgeCost(const City& city, EdgeId edgeId) const override;
+    void edgeCosts(const City& city, std::span<const EdgeId> edgeIds, std::span<float> out) const override;
+    void allEdgeCosts(const City& city, std::span<float> out) const override;
+    double loadedEdgeCost(const City& city, EdgeId edgeId, int extraLoad) const override;
+    void loadedEdgeCosts(const City& city, std::span<const int> occupancy, std::span<float> out) const override;
+
+    /**
+     * Volume-delay policies reroute at every node, like CongestionAwarePolicy.
+     */
+    bool shouldRerouteOnNode(const Agent& agent) const override;
+
+    /**
+     * Delay factor f(x) of one edge.
+     */
+    double delayFactor(int edgeIndex, double ratio) const {
+        const Coefficients& c = coefficientsFor(edgeIndex);
+        if (function == Function::CONICAL) {
+            double slack = 1.0 - ratio;
+            return 2.0 + std::sqrt(c.alphaSquared * slack * slack + c.beta * c.beta) - c.alpha * slack - c.beta;
+        }
+        return 1.0 + c.alpha * power(c, ratio);
+    }
+
+    /**
+     * Derivative f'(x) of one edge's delay factor (for equilibrium solvers;
+     * uses pow(), not meant for per-relaxation use).
+     */
+    double delayFactorSlope(int edgeIndex, double ratio) const {
+        const Coefficients& c = coefficientsFor(edgeIndex);
+        if (function == Function::CONICAL) {
+            double slack = 1.0 - ratio;
+            return c.alpha - c.alphaSquared * slack / std::sqrt(c.alphaSquared * slack * slack + c.beta * c.beta);
+        }
+        if (c.beta == 0.0) {
+            return 0.0;
+        }
+        double x = ratio > 0.0 ? ratio : 0.0;
+        return c.alpha * c.beta * (c.beta == 1.0 ? 1.0 : std::pow(x, c.beta - 1.0));
+    }
+
+    /**
+     * Marginal delay factor f(x) + x f'(x) of one edge (no pow() for BPR:
+     * it is 1 + alpha (beta + 1) x^beta).
+     */
+    double marginalDelayFactor(int edgeIndex, double ratio) const {
+        const Coefficients& c = coefficientsFor(edgeIndex);
+        if (function == Function::CONICAL) {
+            double slack = 1.0 - ratio;
+            double root = std::sqrt(c.alphaSquared * slack * slack + c.beta * c.beta);
+            return 2.0 + root - c.alpha * slack - c.beta + ratio * (c.alpha - c.alphaSquared * slack / root);
+        }
+        return 1.0 + c.alpha * (c.beta + 1.0) * power(c, ratio);
+    }
+
+    /**
+     * Factor the policy prices an edge at: delayFactor, or
+     * marginalDelayFactor under MARGINAL pricing.
+     */
+    double priceFactor(int edgeIndex, double ratio) const {
+        return pricing == Pricing::MARGINAL ? marginalDelayFactor(edgeIndex, ratio) : delayFactor(edgeIndex, ratio);
+    }
+
+    /**
+     * Derivative of priceFactor (uses pow(), like delayFactorSlope).
+     */
+    double priceFactorSlope(int edgeIndex, double ratio) const {
+        if (pricing == Pricing::AVERAGE) {
+            return delayFactorSlope(edgeIndex, ratio);
+        }
+        const Coefficients& c = coefficientsFor(edgeIndex);
+        if (function == Function::CONICAL) {
+            // 2 f'(x) + x f''(x)
+            double slack = 1.0 - ratio;
+            double squared = c.alphaSquared * slack * slack + c.beta * c.beta;
+            double curvature = c.alphaSquared * c.beta * c.beta / (squared * std::sqrt(squared));
+            return 2.0 * delayFactorSlope(edgeIndex, ratio) + ratio * curvature;
+        }
+        return (c.beta + 1.0) * delayFactorSlope(edgeIndex, ratio);
+    }
+
+    /**
+     * Cost from raw edge data. Inline so RoutePlanner's search specialized
+     * for this policy needs no virtual call per relaxation.
+     */
+    double cost(int edgeIndex, double length, int capacity, int occupancy) const {
+        if (capacity <= 0) {
+            return occupancy > 0 ? std::numeric_limits<double>::infinity() : length;
+        }
+        return length * priceFactor(edgeIndex, static_cast<double>(occupancy) / capacity);
+    }
+
+private:
+    struct Coefficients {
+        double alpha = 0.0;
+        double beta = 0.0;
+        double alphaSquared = 0.0;
+        int exponent = 0;       // BPR: integer exponent when table < 0
+        int table = -1;         // BPR: lookup table for a fractional exponent
+    };
+
+    Coefficients prepare(Parameters parameters);
+    // Whole-network costs for an occupancy array by edge index
+    void costsFor(const City& city, const int* occupancy, std::span<float> out) const;
+    const Coefficients& coefficientsFor(int edgeIndex) const {
+        return edgeIndex >= 0 && edgeIndex < static_cast<int>(edges.size()) && edges[edgeIndex].overridden
+                   ? edges[edgeIndex].coefficients : defaults;
+    }
+
+    // x^beta without pow() inside the table range
+    double power(const Coefficients& c, double x) const {
+        if (c.table < 0) {
+            double result = 1.0;
+            double base = x;
+            for (int e = c.exponent; e > 0; e >>= 1) {
+                if (e & 1) result *= base;
+                base *= base;
+            }
+            return result;
+        }
+        if (x >= kTableMaxRatio) {
+            return std::pow(x, c.beta);
+        }
+        double position = (x > 0.0 ? x : 0.0) * (kTableSteps / kTableMaxRatio);
+        int slot = static_cast<int>(position);
+        const double* row = tables.data() + static_cast<size_t>(c.table) * (kTableSteps + 1);
+        return row[slot] + (row[slot + 1] - row[slot]) * (position - slot);
+    }
+
+    struct EdgeEntry {
+        Parameters parameters{0.0, 0.0};
+        Coefficients coefficients;
+        bool overridden = false;
+    };
+
+    Function function;
+    Pricing pricing = Pricing::AVERAGE;
+    Parameters defaultParams;
+    Coefficients defaults;
+    std::vector<EdgeEntry> edges;           // By edge index; grows on demand
+    std::vector<double> tables;             // One row of kTableSteps + 1 samples per fractional exponent
+    std::vector<double> tableExponents;     // Exponent of each row
+};
@@ -2,6 +2,8 @@
 #include "PolicyRegistry.h"
 #include "ShortestPathFactory.h"
 #include "CongestionAwareFactory.h"
+#include "VolumeDelayFactory.h"
+#include "RouteDiversityFactory.h"
 #include <stdexcept>
 
 PolicyRegistry* PolicyRegistry::instance = nullptr;
@@ -67,5 +69,12 @@ void PolicyRegistry::initializeDefaults() {
     // Register default policies
     registerFactory("ShortestPath", std::make_unique<ShortestPathFactory>());
     registerFactory("CongestionAware", std::make_unique<CongestionAwareFactory>());
+    registerFactory("BPR", std::make_unique<VolumeDelayFactory>(VolumeDelayPolicy::Function::BPR));
+    registerFactory("Conical", std::make_unique<VolumeDelayFactory>(VolumeDelayPolicy::Function::CONICAL));
+    registerFactory("SystemOptimal", std::make_unique<VolumeDelayFactory>(VolumeDelayPolicy::Function::BPR,
+                                                                          VolumeDelayPolicy::Pricing::MARGINAL));
+    registerFactory("ConicalSystemOptimal", std::make_unique<VolumeDelayFactory>(VolumeDelayPolicy::Function::CONICAL,
+                                                                                 VolumeDelayPolicy::Pricing::MARGINAL));
+    registerFactory("RouteDiversity", std::make_unique<RouteDiversityFactory>());
 }
 
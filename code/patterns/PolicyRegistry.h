@@ -70,7 +70,8 @@ public:
     bool isRegistered(const std::string& name) const;
     
     /**
-     * Initialize with default policies (ShortestPath, CongestionAware).
+     * Initialize with default policies (ShortestPath, CongestionAware, BPR, Conical,
+     * SystemOptimal, RouteDiversity).
      */
     void initializeDefaults();
     
@@ -2,6 +2,7 @@
 #include "PresetBuilder.h"
 #include "../core/Preset.h"
 #include <stdexcept>
+#include <utility>
 
 PresetBuilder::PresetBuilder()
     : name(""),
@@ -43,6 +44,16 @@ PresetBuilder& PresetBuilder::addBlockedEdges(const std::vector<std::pair<NodeId
     return *this;
 }
 
+PresetBuilder& PresetBuilder::addAgentRoute(NodeId origin, NodeId destination) {
+    agentRoutes.push_back({origin, destination});
+    return *this;
+}
+
+PresetBuilder& PresetBuilder::setAgentRoutes(std::vector<std::pair<NodeId, NodeId>> routes) {
+    agentRoutes = std::move(routes);
+    return *this;
+}
+
 PresetBuilder& PresetBuilder::setTickInterval(int ms) {
     this->tickMs = ms;
     return *this;
@@ -55,6 +66,7 @@ PresetBuilder& PresetBuilder::reset() {
     agentCount = 0;
     policy = PolicyType::SHORTEST_PATH;
     blockedEdges.clear();
+    agentRoutes.clear();
     tickMs = 100;
     return *this;
 }
@@ -82,6 +94,7 @@ Preset PresetBuilder::createPreset() const {
     preset.setAgentCount(agentCount);
     preset.setPolicy(policy);
     preset.setBlockedEdges(blockedEdges);
+    preset.setAgentRoutes(agentRoutes);
     preset.setTickMs(tickMs);
     return preset;
 }
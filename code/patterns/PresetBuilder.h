@@ -67,6 +67,21 @@ public:
      */
     PresetBuilder& addBlockedEdges(const std::vector<std::pair<NodeId, NodeId>>& edges);
     
+    /**
+     * Add an explicit origin/destination route for one agent.
+     * @param origin Start node ID
+     * @param destination Goal node ID
+     * @return Reference to this builder for method chaining
+     */
+    PresetBuilder& addAgentRoute(NodeId origin, NodeId destination);
+    
+    /**
+     * Replace all explicit agent routes (spawned agents use these in order).
+     * @param routes Vector of (origin, destination) pairs
+     * @return Reference to this builder for method chaining
+     */
+    PresetBuilder& setAgentRoutes(std::vector<std::pair<NodeId, NodeId>> routes);
+    
     /**
      * Set the tick interval (simulation speed).
      * @param ms Milliseconds per tick
@@ -100,6 +115,7 @@ private:
     int agentCount;
     PolicyType policy;
     std::vector<std::pair<NodeId, NodeId>> blockedEdges;
+    std::vector<std::pair<NodeId, NodeId>> agentRoutes;
     int tickMs;
     
     /**
@@ -3,8 +3,13 @@
 #include "../core/City.h"
 #include "../core/Node.h"
 #include "../core/Edge.h"
+#include "../adapters/RoadNetworkImporter.h"
 
 std::unique_ptr<City> RealWorldGridFactory::createGrid(int rows, int cols) {
+    if (loadedNetwork) {
+        return std::make_unique<City>(loadedNetwork);
+    }
+    
     auto city = std::make_unique<City>();
     
     // Create nodes
@@ -95,7 +100,7 @@ std::string RealWorldGridFactory::getFactoryType() const {
 }
 
 void RealWorldGridFactory::loadFromFile(const std::string& filepath) {
-    // Stub for future implementation
-    // Would parse GeoJSON or similar format
+    RoadNetworkImporter importer;
+    loadedNetwork = importer.importFile(filepath);
 }
 
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "IGridFactory.h"
+#include "../core/CityTopology.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,8 +15,9 @@
  * - Supports custom node positions and edge configurations
  * - Useful for simulating actual city layouts
  * 
- * For this implementation, we create a highway-style network
- * with major roads (high capacity) and local roads (low capacity).
+ * Without a loaded file we create a highway-style network with major
+ * roads (high capacity) and local roads (low capacity). After
+ * loadFromFile, createGrid returns Cities over the imported network.
  */
 class RealWorldGridFactory : public IGridFactory {
 public:
@@ -25,11 +28,18 @@ public:
     std::string getFactoryType() const override;
     
     /**
-     * Load grid from external data source (stub for future implementation).
-     * In a full implementation, this would parse GeoJSON or similar.
+     * Load a real road network (CSV edge list or GeoJSON line strings, see
+     * RoadNetworkImporter). Subsequent createGrid calls ignore rows/cols and
+     * return Cities sharing the imported topology.
+     * @throws std::runtime_error if the file cannot be read or is malformed
      */
     void loadFromFile(const std::string& filepath);
     
+    /**
+     * Whether loadFromFile has supplied a network.
+     */
+    bool hasLoadedNetwork() const { return loadedNetwork != nullptr; }
+    
 private:
     /**
      * Create a highway-style network with major arteries.
@@ -43,5 +53,7 @@ private:
     
     void addBidirectionalEdge(City& city, int& edgeId, NodeId from, NodeId to,
                                double length, int capacity);
+    
+    std::shared_ptr<const CityTopology> loadedNetwork;  // Set by loadFromFile
 };
 
@@ -0,0 +1,21 @@
+// code/patterns/RouteDiversityFactory.cpp
+#include "RouteDiversityFactory.h"
+#include "../core/RouteDiversityPolicy.h"
+
+std::unique_ptr<IRoutePolicy> RouteDiversityFactory::createPolicy() {
+    return std::make_unique<RouteDiversityPolicy>();
+}
+
+std::string RouteDiversityFactory::getPolicyName() const {
+    return "RouteDiversity";
+}
+
+std::string RouteDiversityFactory::getDescription() const {
+    return "Spreads agents over the shortest few loopless routes (up to 4, at most 25% longer "
+           "than the shortest) instead of sending equal trips down one path. "
+           "Agents do not reroute unless their path becomes invalid.";
+}
+
+PolicyType RouteDiversityFactory::getPolicyType() const {
+    return PolicyType::ROUTE_DIVERSITY;
+}
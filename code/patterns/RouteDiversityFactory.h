@@ -0,0 +1,18 @@
+// code/patterns/RouteDiversityFactory.h
+#pragma once
+
+#include "IPolicyFactory.h"
+
+/**
+ * Abstract Factory Pattern: Concrete Factory - Route Diversity Policy
+ */
+class RouteDiversityFactory : public IPolicyFactory {
+public:
+    RouteDiversityFactory() = default;
+    ~RouteDiversityFactory() override = default;
+    
+    std::unique_ptr<IRoutePolicy> createPolicy() override;
+    std::string getPolicyName() const override;
+    std::string getDescription() const override;
+    PolicyType getPolicyType() const override;
+};
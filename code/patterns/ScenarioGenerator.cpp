@@ -0,0 +1,242 @@
+// code/patterns/ScenarioGenerator.cpp
+#include "ScenarioGenerator.h"
+#include "IGridFactory.h"
+#include "PresetBuilder.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../core/Edge.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    // Separate streams so blocked roads and routes vary independently
+    constexpr std::uint32_t kBlockedStream = 0x9E3779B9u;
+    constexpr std::uint32_t kRouteStream = 0x7F4A7C15u;
+
+    struct Hotspot {
+        double row;
+        double col;
+    };
+
+    // Samples grid nodes around hotspots with a clamped normal offset
+    class HotspotSampler {
+    public:
+        HotspotSampler(int rows, int cols, double spread)
+            : rows(rows), cols(cols),
+              offset(0.0, std::max(1.0, spread * std::max(rows, cols))) {}
+
+        NodeId sample(const Hotspot& center, std::mt19937& rng) {
+            int row = clamp(std::lround(center.row + offset(rng)), rows);
+            int col = clamp(std::lround(center.col + offset(rng)), cols);
+            return row * cols + col;
+        }
+
+    private:
+        static int clamp(long value, int size) {
+            return static_cast<int>(std::clamp<long>(value, 0, size - 1));
+        }
+
+        int rows;
+        int cols;
+        std::normal_distribution<double> offset;
+    };
+}
+
+ScenarioGenerator::ScenarioGenerator()
+    : config() {
+}
+
+ScenarioGenerator::ScenarioGenerator(const Config& config)
+    : config(config) {
+}
+
+void ScenarioGenerator::validateConfig() const {
+    if (config.rows <= 0 || config.cols <= 0 ||
+        config.rows > Preset::kMaxGridDimension || config.cols > Preset::kMaxGridDimension) {
+        throw std::runtime_error("Scenario grid must be between 1x1 and " +
+                                 std::to_string(Preset::kMaxGridDimension) + "x" +
+                                 std::to_string(Preset::kMaxGridDimension));
+    }
+    if (config.agentCount < 0 || config.agentCount > Preset::kMaxAgentCount) {
+        throw std::runtime_error("Scenario agent count out of range: " + std::to_string(config.agentCount));
+    }
+    if (!(config.blockedRatio >= 0.0 && config.blockedRatio <= 1.0)) {
+        throw std::runtime_error("Scenario blocked ratio must be in [0, 1]");
+    }
+    if (config.distribution == OdDistribution::CLUSTERED && config.clusterCount <= 0) {
+        throw std::runtime_error("Clustered scenarios need at least one cluster");
+    }
+    if (config.clusterSpread < 0.0) {
+        throw std::runtime_error("Scenario cluster spread must be non-negative");
+    }
+}
+
+Preset ScenarioGenerator::generatePreset() const {
+    validateConfig();
+
+    PresetBuilder builder;
+    builder.setName(config.name)
+           .setGridSize(config.rows, config.cols)
+           .setAgentCount(config.agentCount)
+           .setPolicy(config.policy)
+           .setTickInterval(config.tickMs)
+           .addBlockedEdges(generateBlockedEdges())
+           .setAgentRoutes(generateAgentRoutes());
+    return builder.build();
+}
+
+std::vector<std::pair<NodeId, NodeId>> ScenarioGenerator::generateBlockedEdges() const {
+    validateConfig();
+
+    std::vector<std::pair<NodeId, NodeId>> blocked;
+    const int rows = config.rows;
+    const int cols = config.cols;
+    const long long horizontal = static_cast<long long>(rows) * (cols - 1);
+    const long long roads = horizontal + static_cast<long long>(rows - 1) * cols;
+    if (config.blockedRatio <= 0.0 || roads == 0) {
+        return blocked;
+    }
+
+    blocked.reserve(static_cast<size_t>(static_cast<double>(roads) * config.blockedRatio * 1.1) + 16);
+    std::mt19937 rng(config.seed ^ kBlockedStream);
+    std::bernoulli_distribution closed(config.blockedRatio);
+
+    // Road index -> node pair: horizontal roads first, then vertical,
+    // matching the edge order of PresetLoader::createGridTopology
+    for (long long road = 0; road < roads; ++road) {
+        if (!closed(rng)) {
+            continue;
+        }
+        if (road < horizontal) {
+            int row = static_cast<int>(road / (cols - 1));
+            int col = static_cast<int>(road % (cols - 1));
+            NodeId from = row * cols + col;
+            blocked.push_back({from, from + 1});
+        } else {
+            long long vertical = road - horizontal;
+            int row = static_cast<int>(vertical / cols);
+            int col = static_cast<int>(vertical % cols);
+            NodeId from = row * cols + col;
+            blocked.push_back({from, from + cols});
+        }
+    }
+    return blocked;
+}
+
+std::vector<std::pair<NodeId, NodeId>> ScenarioGenerator::generateAgentRoutes() const {
+    validateConfig();
+
+    const int rows = config.rows;
+    const int cols = config.cols;
+    const int nodeCount = rows * cols;
+    std::vector<std::pair<NodeId, NodeId>> routes;
+    routes.reserve(static_cast<size_t>(config.agentCount));
+
+    std::mt19937 rng(config.seed ^ kRouteStream);
+    std::uniform_int_distribution<NodeId> anyNode(0, nodeCount - 1);
+    HotspotSampler sampler(rows, cols, config.clusterSpread);
+
+    std::vector<Hotspot> hotspots;
+    if (config.distribution == OdDistribution::CLUSTERED) {
+        std::uniform_real_distribution<double> rowPos(0.0, rows - 1);
+        std::uniform_real_distribution<double> colPos(0.0, cols - 1);
+        for (int i = 0; i < config.clusterCount; ++i) {
+            double row = rowPos(rng);
+            hotspots.push_back({row, colPos(rng)});
+        }
+    } else if (config.distribution == OdDistribution::COMMUTER) {
+        // Central business district
+        hotspots.push_back({(rows - 1) / 2.0, (cols - 1) / 2.0});
+    }
+    std::uniform_int_distribution<size_t> anyHotspot(0, hotspots.empty() ? 0 : hotspots.size() - 1);
+
+    auto sampleDestination = [&](NodeId origin) {
+        // A few redraws keep the distribution's shape; a uniform fallback
+        // guarantees termination when a hotspot collapses onto one node
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            NodeId destination = config.distribution == OdDistribution::UNIFORM
+                ? anyNode(rng)
+                : sampler.sample(hotspots[anyHotspot(rng)], rng);
+            if (destination != origin) {
+                return destination;
+            }
+        }
+        std::uniform_int_distribution<NodeId> shift(1, nodeCount - 1);
+        return (origin + shift(rng)) % nodeCount;
+    };
+
+    for (int i = 0; i < config.agentCount; ++i) {
+        NodeId origin = config.distribution == OdDistribution::CLUSTERED
+            ? sampler.sample(hotspots[anyHotspot(rng)], rng)
+            : anyNode(rng);
+        NodeId destination = nodeCount > 1 ? sampleDestination(origin) : origin;
+        routes.push_back({origin, destination});
+    }
+    return routes;
+}
+
+std::unique_ptr<City> ScenarioGenerator::generateCity(IGridFactory& factory) const {
+    validateConfig();
+
+    auto city = factory.createGrid(config.rows, config.cols);
+    if (config.blockedRatio <= 0.0) {
+        return city;
+    }
+
+    // Pick roads on the shared topology first, then mutate; a two-way road
+    // is drawn once (from its lower-id end) and closed in both directions
+    const CityTopology& topology = *city->getTopology();
+    std::mt19937 rng(config.seed ^ kBlockedStream);
+    std::bernoulli_distribution closed(config.blockedRatio);
+    std::vector<EdgeId> toBlock;
+
+    auto findReverse = [&](const Edge& edge) -> const Edge* {
+        for (EdgeId id : topology.outgoing(edge.getTo())) {
+            const Edge& candidate = topology.getEdge(id);
+            if (candidate.getTo() == edge.getFrom()) return &candidate;
+        }
+        return nullptr;
+    };
+
+    for (const Edge& edge : topology.getEdges()) {
+        const Edge* reverse = findReverse(edge);
+        if (reverse && edge.getFrom() > edge.getTo()) {
+            continue;  // Drawn with its partner
+        }
+        if (!closed(rng)) {
+            continue;
+        }
+        toBlock.push_back(edge.getId());
+        if (reverse) {
+            toBlock.push_back(reverse->getId());
+        }
+    }
+
+    for (EdgeId id : toBlock) {
+        city->getEdge(id).setBlocked(true);
+    }
+    return city;
+}
+
+void ScenarioGenerator::writePreset(const std::string& path, const std::string& compiledCity) const {
+    Preset preset = generatePreset();
+    preset.setCompiledCity(compiledCity);
+    PresetLoader loader;
+    loader.saveToJson(preset, path);
+}
+
+void ScenarioGenerator::writeCompiledCity(const std::string& path) const {
+    validateConfig();
+    
+    // Only the network inputs: compileCity signs the grid and closures
+    Preset network;
+    network.setRows(config.rows);
+    network.setCols(config.cols);
+    network.setBlockedEdges(generateBlockedEdges());
+    PresetLoader loader;
+    loader.compileCity(network, path);
+}
@@ -0,0 +1,101 @@
+// code/patterns/ScenarioGenerator.h
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../core/Preset.h"
+
+class City;
+class IGridFactory;
+
+/**
+ * ScenarioGenerator - Synthetic stress-test scenarios.
+ *
+ * Produces grid presets far beyond the shipped ones (up to
+ * Preset::kMaxGridDimension per side and Preset::kMaxAgentCount agents)
+ * with a chosen origin/destination distribution and a random fraction of
+ * closed roads. Output goes through PresetBuilder, so every generated
+ * Preset is validated, and can be written as preset JSON (for the
+ * streaming PresetLoader) and as a compiled city (.glcity) for fast loads.
+ *
+ * Node ids follow the grid convention row * cols + col used by
+ * PresetLoader and the grid factories. Generation is deterministic for a
+ * given Config; blocked roads and agent routes draw from separate streams,
+ * so changing the blocked ratio leaves the routes unchanged.
+ */
+class ScenarioGenerator {
+public:
+    enum class OdDistribution {
+        UNIFORM,    // Origins and destinations anywhere on the grid
+        CLUSTERED,  // Both ends near one of clusterCount random hotspots
+        COMMUTER    // Origins anywhere, destinations in a central business district
+    };
+
+    struct Config {
+        std::string name = "generated";
+        int rows = 100;
+        int cols = 100;
+        int agentCount = 1000;
+        OdDistribution distribution = OdDistribution::UNIFORM;
+        int clusterCount = 8;           // CLUSTERED: number of hotspots
+        double clusterSpread = 0.05;    // Hotspot std-dev as a fraction of the longer side
+        double blockedRatio = 0.0;      // Fraction of two-way roads closed (0..1)
+        PolicyType policy = PolicyType::SHORTEST_PATH;
+        int tickMs = 100;
+        std::uint32_t seed = 42;
+    };
+
+    ScenarioGenerator();
+    explicit ScenarioGenerator(const Config& config);
+
+    const Config& getConfig() const { return config; }
+
+    /**
+     * Build the full scenario as a validated Preset (grid size, blocked
+     * roads and one explicit route per agent).
+     * @throws std::runtime_error if the configuration is out of range
+     */
+    Preset generatePreset() const;
+
+    /**
+     * Roads to close, one (from, to) pair per two-way grid road.
+     */
+    std::vector<std::pair<NodeId, NodeId>> generateBlockedEdges() const;
+
+    /**
+     * One (origin, destination) pair per agent; origin != destination
+     * whenever the grid has more than one node.
+     */
+    std::vector<std::pair<NodeId, NodeId>> generateAgentRoutes() const;
+
+    /**
+     * Build a City with any grid factory and close blockedRatio of its
+     * roads (both directions of a two-way road close together).
+     * @param factory Grid factory to create the topology with
+     * @return City owned by the caller
+     */
+    std::unique_ptr<City> generateCity(IGridFactory& factory) const;
+
+    /**
+     * Write the preset as JSON readable by PresetLoader::loadFromJson.
+     * @param compiledCity Compiled city the preset should load (relative to
+     *        the preset file; see writeCompiledCity), or empty for none
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writePreset(const std::string& path, const std::string& compiledCity = "") const;
+
+    /**
+     * Write the blocked grid topology as a compiled city (see
+     * PresetLoader::compileCity).
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void writeCompiledCity(const std::string& path) const;
+
+private:
+    void validateConfig() const;
+
+    Config config;
+};
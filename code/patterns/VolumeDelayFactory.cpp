@@ -0,0 +1,41 @@
+// code/patterns/VolumeDelayFactory.cpp
+#include "VolumeDelayFactory.h"
+
+VolumeDelayFactory::VolumeDelayFactory(VolumeDelayPolicy::Function function, VolumeDelayPolicy::Pricing pricing)
+    : function(function), pricing(pricing) {
+}
+
+std::unique_ptr<IRoutePolicy> VolumeDelayFactory::createPolicy() {
+    return std::make_unique<VolumeDelayPolicy>(function, VolumeDelayPolicy::defaultParameters(function), pricing);
+}
+
+std::string VolumeDelayFactory::getPolicyName() const {
+    if (pricing == VolumeDelayPolicy::Pricing::MARGINAL) {
+        return function == VolumeDelayPolicy::Function::CONICAL ? "ConicalSystemOptimal" : "SystemOptimal";
+    }
+    return function == VolumeDelayPolicy::Function::CONICAL ? "Conical" : "BPR";
+}
+
+std::string VolumeDelayFactory::getDescription() const {
+    if (pricing == VolumeDelayPolicy::Pricing::MARGINAL) {
+        return "System-optimal routing on marginal social cost. "
+               "Cost = length * (f(x) + x f'(x)), x = occupancy / capacity: an agent pays its own delay "
+               "plus the delay it adds to every vehicle already on the edge. Agents reroute at every node.";
+    }
+    if (function == VolumeDelayPolicy::Function::CONICAL) {
+        return "Conical volume-delay function (Spiess). "
+               "Cost = length * (2 + sqrt(a^2 (1-x)^2 + b^2) - a (1-x) - b), x = occupancy / capacity. "
+               "Finite slope at capacity; agents reroute at every node.";
+    }
+    return "Bureau of Public Roads volume-delay function. "
+           "Cost = length * (1 + alpha * (occupancy / capacity)^beta), alpha 0.15, beta 4 by default. "
+           "Agents reroute at every node.";
+}
+
+PolicyType VolumeDelayFactory::getPolicyType() const {
+    if (pricing == VolumeDelayPolicy::Pricing::MARGINAL) {
+        return function == VolumeDelayPolicy::Function::CONICAL ? PolicyType::CONICAL_SYSTEM_OPTIMAL
+                                                                : PolicyType::SYSTEM_OPTIMAL;
+    }
+    return function == VolumeDelayPolicy::Function::CONICAL ? PolicyType::CONICAL : PolicyType::BPR;
+}
@@ -0,0 +1,29 @@
+// code/patterns/VolumeDelayFactory.h
+#pragma once
+
+#include "IPolicyFactory.h"
+#include "../core/VolumeDelayPolicy.h"
+
+/**
+ * Abstract Factory Pattern: Concrete Factory - Volume-Delay Policies
+ * 
+ * One factory class for the whole family; each instance creates policies
+ * of one delay function with that function's default parameters. A BPR
+ * factory with MARGINAL pricing is the system-optimal policy (a conical one
+ * its conical counterpart).
+ */
+class VolumeDelayFactory : public IPolicyFactory {
+public:
+    explicit VolumeDelayFactory(VolumeDelayPolicy::Function function,
+                                VolumeDelayPolicy::Pricing pricing = VolumeDelayPolicy::Pricing::AVERAGE);
+    ~VolumeDelayFactory() override = default;
+    
+    std::unique_ptr<IRoutePolicy> createPolicy() override;
+    std::string getPolicyName() const override;
+    std::string getDescription() const override;
+    PolicyType getPolicyType() const override;
+
+private:
+    VolumeDelayPolicy::Function function;
+    VolumeDelayPolicy::Pricing pricing;
+};
@@ -0,0 +1,307 @@
+// code/tests/test_checkpoint_googletest.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../core/ScenarioBrancher.h"
+#include "../core/SimulationController.h"
+#include "../core/SimulationSnapshot.h"
+#include "../core/City.h"
+#include "../core/Agent.h"
+#include "../core/Metrics.h"
+#include "../core/Preset.h"
+#include "../adapters/SnapshotSerializer.h"
+
+/**
+ * Test Suite: Simulation checkpoint/restore
+ * Tests snapshot capture, binary round-trips, resumed runs and reset.
+ */
+
+class CheckpointTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        preset.setName("checkpoint");
+        preset.setRows(6);
+        preset.setCols(6);
+        preset.setAgentCount(40);
+        preset.setTickMs(100);
+        preset.setPolicy(PolicyType::CONGESTION_AWARE);
+        preset.setBlockedEdges({{0, 1}, {14, 20}});
+    }
+
+    // Comparable summary of everything a tick can change
+    static std::vector<int> fingerprintRun(SimulationController& controller) {
+        std::vector<int> out;
+        City* city = controller.getCity();
+        for (int i = 0; i < city->getEdgeCount(); ++i) {
+            out.push_back(city->occupancy(city->getEdgeIdByIndex(i)));
+        }
+        for (Agent* agent : controller.getAgents()) {
+            out.push_back(agent->getCurrentNode());
+            out.push_back(agent->getCurrentEdge().value_or(-1));
+            out.push_back(agent->getTravelTime());
+            out.push_back(static_cast<int>(agent->getPath().size()));
+        }
+        out.push_back(controller.getMetrics()->getCurrentTick());
+        out.push_back(controller.getMetrics()->totalThroughput());
+        out.push_back(controller.getMetrics()->getMaxEdgeLoad());
+        return out;
+    }
+
+    // Resume one controller from a binary checkpoint of the reference and
+    // fork a branch from it, then check both keep step with the reference
+    void expectResumesIdentically(SimulationController& reference, int ticks) {
+        SnapshotSerializer serializer;
+        std::vector<std::uint8_t> bytes = serializer.serialize(reference.captureSnapshot());
+        SimulationController resumed;
+        resumed.loadPreset(preset);
+        resumed.restoreSnapshot(serializer.deserialize(bytes.data(), bytes.size()));
+        auto branch = ScenarioBrancher(reference).createBranch({"unchanged", {}, {}, std::nullopt});
+
+        // Routing state only shows in later routes, so compare it directly
+        const SimulationSnapshot original = reference.captureSnapshot();
+        for (SimulationController* copy : {&resumed, branch.get()}) {
+            const SimulationSnapshot restored = copy->captureSnapshot();
+            EXPECT_EQ(restored.routeWaves, original.routeWaves);
+            EXPECT_EQ(restored.profileHorizon, original.profileHorizon);
+            EXPECT_EQ(restored.occupancyHistory, original.occupancyHistory);
+            EXPECT_EQ(restored.reservationHorizon, original.reservationHorizon);
+            EXPECT_EQ(restored.agentClaims, original.agentClaims);
+        }
+        for (int i = 0; i < ticks; ++i) {
+            reference.tick();
+            resumed.tick();
+            branch->tick();
+        }
+        EXPECT_EQ(fingerprintRun(resumed), fingerprintRun(reference));
+        EXPECT_EQ(fingerprintRun(*branch), fingerprintRun(reference));
+    }
+
+    Preset preset;
+};
+
+// Test 1: Reset clears occupancy left over from a run
+TEST_F(CheckpointTest, ResetClearsOccupancy) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    for (int i = 0; i < 3; ++i) controller.tick();
+
+    controller.reset();
+    City* city = controller.getCity();
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        EXPECT_EQ(city->occupancy(city->getEdgeIdByIndex(i)), 0);
+    }
+}
+
+// Test 2: In-memory snapshot resumes identically
+TEST_F(CheckpointTest, InMemoryRestoreResumesIdentically) {
+    SimulationController reference;
+    reference.loadPreset(preset);
+    for (int i = 0; i < 5; ++i) reference.tick();
+    SimulationSnapshot snapshot = reference.captureSnapshot();
+    for (int i = 0; i < 10; ++i) reference.tick();
+
+    SimulationController resumed;
+    resumed.restoreSnapshot(snapshot);
+    EXPECT_EQ(resumed.getCity()->getTopology().get(), snapshot.topology.get());
+    for (int i = 0; i < 10; ++i) resumed.tick();
+
+    EXPECT_EQ(fingerprintRun(resumed), fingerprintRun(reference));
+}
+
+// Test 3: Binary round-trip preserves every field
+TEST_F(CheckpointTest, BinaryRoundTrip) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    for (int i = 0; i < 7; ++i) controller.tick();
+    controller.getCity()->setEdgeBlocked(controller.getCity()->getEdgeIdByIndex(3), true);
+
+    SimulationSnapshot original = controller.captureSnapshot();
+    SnapshotSerializer serializer;
+    std::vector<std::uint8_t> bytes = serializer.serialize(original);
+    SimulationSnapshot decoded = serializer.deserialize(bytes.data(), bytes.size());
+
+    EXPECT_EQ(decoded.topology, nullptr);
+    EXPECT_EQ(decoded.topologyFingerprint, original.topologyFingerprint);
+    EXPECT_EQ(decoded.policy, original.policy);
+    EXPECT_EQ(decoded.cityState.occupancyData(), original.cityState.occupancyData());
+    EXPECT_EQ(decoded.cityState.blockedWords(), original.cityState.blockedWords());
+    EXPECT_EQ(decoded.initialAgentRoutes, original.initialAgentRoutes);
+    ASSERT_EQ(decoded.agents.size(), original.agents.size());
+    for (size_t i = 0; i < original.agents.size(); ++i) {
+        EXPECT_EQ(decoded.agents[i].currentNode, original.agents[i].currentNode);
+        EXPECT_EQ(decoded.agents[i].currentEdge, original.agents[i].currentEdge);
+        EXPECT_EQ(decoded.agents[i].path, original.agents[i].path);
+        EXPECT_EQ(decoded.agents[i].arrived, original.agents[i].arrived);
+        EXPECT_EQ(decoded.agents[i].stepsTaken, original.agents[i].stepsTaken);
+    }
+    EXPECT_EQ(decoded.metrics.getCurrentTick(), original.metrics.getCurrentTick());
+    EXPECT_EQ(decoded.metrics.getTripTimes(), original.metrics.getTripTimes());
+    EXPECT_EQ(decoded.metrics.getThroughputPerTick(), original.metrics.getThroughputPerTick());
+    EXPECT_EQ(decoded.metrics.getEdgeLoadHistory(), original.metrics.getEdgeLoadHistory());
+}
+
+// Test 4: File checkpoint resumes identically on the same preset
+TEST_F(CheckpointTest, FileCheckpointResumesIdentically) {
+    std::string path = ::testing::TempDir() + "gridlock_checkpoint_test.bin";
+
+    SimulationController reference;
+    reference.loadPreset(preset);
+    for (int i = 0; i < 4; ++i) reference.tick();
+    reference.saveCheckpoint(path);
+    for (int i = 0; i < 6; ++i) reference.tick();
+
+    SimulationController resumed;
+    resumed.loadPreset(preset);
+    resumed.loadCheckpoint(path);
+    for (int i = 0; i < 6; ++i) resumed.tick();
+    std::remove(path.c_str());
+
+    EXPECT_EQ(fingerprintRun(resumed), fingerprintRun(reference));
+}
+
+// Test 5: Disk snapshots are rejected on a different network
+TEST_F(CheckpointTest, RejectsMismatchedTopology) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    controller.tick();
+    SnapshotSerializer serializer;
+    auto bytes = serializer.serialize(controller.captureSnapshot());
+    SimulationSnapshot decoded = serializer.deserialize(bytes.data(), bytes.size());
+
+    Preset other = preset;
+    other.setRows(5);
+    SimulationController target;
+    target.loadPreset(other);
+    EXPECT_THROW(target.restoreSnapshot(decoded), std::runtime_error);
+}
+
+// Test 6: Corrupt or truncated buffers are rejected
+TEST_F(CheckpointTest, RejectsCorruptData) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    SnapshotSerializer serializer;
+    auto bytes = serializer.serialize(controller.captureSnapshot());
+
+    EXPECT_THROW(serializer.deserialize(bytes.data(), 10), std::runtime_error);
+    EXPECT_THROW(serializer.deserialize(bytes.data(), bytes.size() / 2), std::runtime_error);
+
+    auto badMagic = bytes;
+    badMagic[0] = 'X';
+    EXPECT_THROW(serializer.deserialize(badMagic.data(), badMagic.size()), std::runtime_error);
+
+    auto badVersion = bytes;
+    badVersion[8] = 0x7f;
+    EXPECT_THROW(serializer.deserialize(badVersion.data(), badVersion.size()), std::runtime_error);
+}
+
+// Test 7: Sections are 8-byte aligned for in-place reads
+TEST_F(CheckpointTest, SectionsAreAligned) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    controller.tick();
+    SnapshotSerializer serializer;
+    auto bytes = serializer.serialize(controller.captureSnapshot());
+
+    EXPECT_EQ(bytes.size() % 8, 0u);
+    std::uint32_t sectionCount = 0;
+    std::memcpy(&sectionCount, bytes.data() + 52, sizeof(sectionCount));
+    ASSERT_GT(sectionCount, 0u);
+    for (std::uint32_t i = 0; i < sectionCount; ++i) {
+        std::uint64_t offset = 0;
+        std::memcpy(&offset, bytes.data() + 64 + i * 24 + 8, sizeof(offset));
+        EXPECT_EQ(offset % 8, 0u);
+    }
+}
+
+// Test 8: Wave routing survives checkpoints and branches
+TEST_F(CheckpointTest, RouteWavesRoundTrip) {
+    preset.setPolicy(PolicyType::SYSTEM_OPTIMAL);
+    SimulationController reference;
+    reference.loadPreset(preset);
+    reference.setRouteWaves(3);
+    for (int i = 0; i < 4; ++i) reference.tick();
+    expectResumesIdentically(reference, 8);
+}
+
+// Test 9: Time-dependent routing resumes with its setting and occupancy history
+TEST_F(CheckpointTest, TimeDependentRoutingRoundTrip) {
+    SimulationController reference;
+    reference.loadPreset(preset);
+    reference.setTimeDependentRouting(12);
+    for (int i = 0; i < 6; ++i) reference.tick();
+
+    SimulationSnapshot original = reference.captureSnapshot();
+    ASSERT_FALSE(original.occupancyHistory.empty());
+    SnapshotSerializer serializer;
+    std::vector<std::uint8_t> bytes = serializer.serialize(original);
+    SimulationSnapshot decoded = serializer.deserialize(bytes.data(), bytes.size());
+    EXPECT_EQ(decoded.profileHorizon, 12);
+    EXPECT_EQ(decoded.occupancyHistory, original.occupancyHistory);
+
+    expectResumesIdentically(reference, 10);
+}
+
+// Test 10: Reservation routing resumes with every agent's claims
+TEST_F(CheckpointTest, ReservationRoutingRoundTrip) {
+    preset.setPolicy(PolicyType::SHORTEST_PATH);
+    SimulationController reference;
+    reference.loadPreset(preset);
+    reference.setReservationRouting(16);
+    for (int i = 0; i < 5; ++i) reference.tick();
+
+    SimulationSnapshot original = reference.captureSnapshot();
+    ASSERT_FALSE(original.agentClaims.empty());
+    SnapshotSerializer serializer;
+    std::vector<std::uint8_t> bytes = serializer.serialize(original);
+    SimulationSnapshot decoded = serializer.deserialize(bytes.data(), bytes.size());
+    EXPECT_EQ(decoded.reservationHorizon, 16);
+    EXPECT_EQ(decoded.agentClaims, original.agentClaims);
+
+    expectResumesIdentically(reference, 10);
+}
+
+// Test 11: Restoring keeps the metrics object readers already hold
+TEST_F(CheckpointTest, RestoreKeepsMetricsObject) {
+    SimulationController controller;
+    controller.loadPreset(preset);
+    for (int i = 0; i < 3; ++i) controller.tick();
+    SimulationSnapshot snapshot = controller.captureSnapshot();
+    Metrics* held = controller.getMetrics();
+    for (int i = 0; i < 5; ++i) controller.tick();
+
+    controller.restoreSnapshot(snapshot);
+    EXPECT_EQ(controller.getMetrics(), held);
+    EXPECT_EQ(held->getCurrentTick(), snapshot.metrics.getCurrentTick());
+    EXPECT_EQ(held->getThroughputPerTick(), snapshot.metrics.getThroughputPerTick());
+}
+
+// Test 12: A conical system-optimal run restores with its own policy type
+TEST_F(CheckpointTest, ConicalSystemOptimalRoundTrip) {
+    preset.setPolicy(PolicyType::CONICAL_SYSTEM_OPTIMAL);
+    SimulationController reference;
+    reference.loadPreset(preset);
+    for (int i = 0; i < 4; ++i) reference.tick();
+
+    SnapshotSerializer serializer;
+    std::vector<std::uint8_t> bytes = serializer.serialize(reference.captureSnapshot());
+    EXPECT_EQ(serializer.deserialize(bytes.data(), bytes.size()).policy, PolicyType::CONICAL_SYSTEM_OPTIMAL);
+    expectResumesIdentically(reference, 8);
+}
+
+// Test 13: Time-dependent routing resumed mid-slot rebuilds the profiles
+// the reference built at the slot boundary
+TEST_F(CheckpointTest, TimeDependentRoutingResumesMidSlot) {
+    preset.setRows(8);
+    preset.setCols(8);
+    preset.setAgentCount(200);
+    for (int ticks : {6, 8}) {
+        SimulationController reference;
+        reference.loadPreset(preset);
+        reference.setTimeDependentRouting(12);
+        for (int i = 0; i < ticks; ++i) reference.tick();
+        expectResumesIdentically(reference, 10);
+    }
+}
@@ -0,0 +1,141 @@
+// code/tests/test_city_state_googletest.cpp
+#include <gtest/gtest.h>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../core/CityState.h"
+#include "../core/Node.h"
+#include "../core/Edge.h"
+#include "../core/Agent.h"
+#include "../core/RoutePlanner.h"
+#include "../core/ShortestPathPolicy.h"
+#include "mocks/MockCity.h"
+
+/**
+ * Test Suite: City topology/state split
+ * Tests topology sharing, per-run state isolation and copy-on-write.
+ */
+
+class CityStateTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        city = TestCityBuilder::createSimpleGrid(3, 3);
+    }
+
+    std::unique_ptr<City> city;
+};
+
+// Test 1: Copies share one topology
+TEST_F(CityStateTest, CopySharesTopology) {
+    City run(*city);
+    EXPECT_EQ(run.getTopology().get(), city->getTopology().get());
+    EXPECT_EQ(run.getEdgeCount(), city->getEdgeCount());
+}
+
+// Test 2: Occupancy is private to each run
+TEST_F(CityStateTest, OccupancyIsPerRun) {
+    EdgeId eid = city->getEdgeIdByIndex(0);
+    City run(*city);
+
+    run.incrementOccupancy(eid);
+    EXPECT_EQ(run.occupancy(eid), 1);
+    EXPECT_EQ(city->occupancy(eid), 0);
+}
+
+// Test 3: Run-time closures do not leak into the topology
+TEST_F(CityStateTest, RunTimeClosureIsPerRun) {
+    EdgeId eid = city->getEdgeIdByIndex(0);
+    City run(*city);
+
+    run.setEdgeBlocked(eid, true);
+    EXPECT_TRUE(run.isEdgeBlocked(eid));
+    EXPECT_FALSE(city->isEdgeBlocked(eid));
+    EXPECT_FALSE(std::as_const(run).getEdge(eid).isBlocked());
+    EXPECT_EQ(run.getTopology().get(), city->getTopology().get());
+
+    run.setEdgeBlocked(eid, false);
+    EXPECT_FALSE(run.isEdgeBlocked(eid));
+}
+
+// Test 4: Mutating a shared topology detaches a private copy
+TEST_F(CityStateTest, TopologyMutationIsCopyOnWrite) {
+    City run(*city);
+    int edgesBefore = city->getEdgeCount();
+
+    run.addEdge(Edge(1000, 0, 8, 5.0, 1));
+    EXPECT_NE(run.getTopology().get(), city->getTopology().get());
+    EXPECT_EQ(run.getEdgeCount(), edgesBefore + 1);
+    EXPECT_EQ(city->getEdgeCount(), edgesBefore);
+
+    EdgeId eid = city->getEdgeIdByIndex(1);
+    City other(*city);
+    other.getEdge(eid).setBlocked(true);
+    EXPECT_TRUE(other.isEdgeBlocked(eid));
+    EXPECT_FALSE(city->isEdgeBlocked(eid));
+}
+
+// Test 5: Unshared topology is mutated in place
+TEST_F(CityStateTest, UnsharedTopologyMutatesInPlace) {
+    const CityTopology* before = city->getTopology().get();
+    city->getEdge(city->getEdgeIdByIndex(0)).setBlocked(true);
+    EXPECT_EQ(city->getTopology().get(), before);
+}
+
+// Test 6: Runs constructed from a topology start empty
+TEST_F(CityStateTest, RunFromSharedTopology) {
+    city->incrementOccupancy(city->getEdgeIdByIndex(0));
+    City run(city->getTopology());
+
+    EXPECT_EQ(run.getState().getEdgeCount(), city->getEdgeCount());
+    EXPECT_EQ(run.occupancy(city->getEdgeIdByIndex(0)), 0);
+}
+
+// Test 7: Routing honours per-run closures
+TEST_F(CityStateTest, RoutingHonoursRunTimeClosure) {
+    ShortestPathPolicy policy;
+    RoutePlanner planner(&policy);
+    Agent agent(1, 0, 2);
+
+    auto basePath = planner.computePath(*city, agent);
+    ASSERT_FALSE(basePath.empty());
+
+    City run(*city);
+    run.setEdgeBlocked(basePath.front(), true);
+    auto detour = planner.computePath(run, agent);
+    ASSERT_FALSE(detour.empty());
+    EXPECT_NE(detour.front(), basePath.front());
+}
+
+// Test 8: Per-run state is much smaller than the shared topology
+TEST_F(CityStateTest, StateFootprintIsSmall) {
+    auto big = TestCityBuilder::createSimpleGrid(50, 50);
+    std::vector<City> runs(64, City(big->getTopology()));
+
+    size_t stateBytes = 0;
+    for (const auto& run : runs) {
+        EXPECT_EQ(run.getTopology().get(), big->getTopology().get());
+        stateBytes += run.getState().memoryUsage();
+    }
+    EXPECT_LT(stateBytes / runs.size(), big->getTopology()->memoryUsage() / 4);
+}
+
+// Test 9: Bitset bookkeeping across word boundaries
+TEST(CityStateBitsTest, BlockedBitsAcrossWords) {
+    CityState state(130);
+    state.setBlocked(0, true);
+    state.setBlocked(64, true);
+    state.setBlocked(129, true);
+    EXPECT_TRUE(state.isBlocked(0));
+    EXPECT_TRUE(state.isBlocked(64));
+    EXPECT_TRUE(state.isBlocked(129));
+    EXPECT_FALSE(state.isBlocked(63));
+
+    state.resize(100);
+    state.resize(130);
+    EXPECT_FALSE(state.isBlocked(129));
+
+    state.clear();
+    EXPECT_FALSE(state.isBlocked(0));
+}
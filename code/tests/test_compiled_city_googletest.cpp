@@ -0,0 +1,245 @@
+// code/tests/test_compiled_city_googletest.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../adapters/CompiledCity.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../core/Preset.h"
+#include "mocks/MockCity.h"
+
+/**
+ * Test Suite: Compiled city format
+ * Tests binary round-trips, CSR adjacency, blobs, mapped loading,
+ * rejection of malformed files and presets that load a compiled city.
+ */
+
+class CompiledCityTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Preset preset;
+        preset.setName("compiled");
+        preset.setRows(7);
+        preset.setCols(9);
+        preset.setAgentCount(1);
+        preset.setBlockedEdges({{0, 1}, {10, 19}});
+        PresetLoader loader;
+        city = loader.buildCity(preset);
+    }
+
+    static void expectSameTopology(const CityTopology& a, const CityTopology& b) {
+        ASSERT_EQ(a.getNodeCount(), b.getNodeCount());
+        ASSERT_EQ(a.getEdgeCount(), b.getEdgeCount());
+        for (int i = 0; i < a.getNodeCount(); ++i) {
+            EXPECT_EQ(a.getNodes()[i], b.getNodes()[i]);
+        }
+        for (int i = 0; i < a.getEdgeCount(); ++i) {
+            const Edge& x = a.getEdges()[i];
+            const Edge& y = b.getEdges()[i];
+            EXPECT_EQ(x.getId(), y.getId());
+            EXPECT_EQ(x.getFrom(), y.getFrom());
+            EXPECT_EQ(x.getTo(), y.getTo());
+            EXPECT_DOUBLE_EQ(x.getLength(), y.getLength());
+            EXPECT_EQ(x.getCapacity(), y.getCapacity());
+            EXPECT_EQ(x.isBlocked(), y.isBlocked());
+        }
+        for (const Node& node : a.getNodes()) {
+            EXPECT_EQ(a.outgoing(node.getId()), b.outgoing(node.getId()));
+        }
+        EXPECT_EQ(a.fingerprint(), b.fingerprint());
+    }
+
+    std::unique_ptr<City> city;
+};
+
+// Test 1: Bulk construction matches incremental construction
+TEST_F(CompiledCityTest, BulkTopologyMatchesIncremental) {
+    const CityTopology& original = *city->getTopology();
+    CityTopology bulk(original.getNodes(), original.getEdges());
+    expectSameTopology(original, bulk);
+    EXPECT_THROW(CityTopology({Node(-1, 0, 0)}, {}), std::runtime_error);
+}
+
+// Test 2: Encoded buffer round-trips the whole network
+TEST_F(CompiledCityTest, BufferRoundTrip) {
+    auto bytes = CompiledCity::encode(*city->getTopology());
+    CompiledCity compiled(bytes.data(), bytes.size());
+
+    EXPECT_EQ(compiled.getNodeCount(), city->getNodeCount());
+    EXPECT_EQ(compiled.getEdgeCount(), city->getEdgeCount());
+    EXPECT_EQ(compiled.getFingerprint(), city->getTopology()->fingerprint());
+    expectSameTopology(*city->getTopology(), *compiled.createTopology());
+}
+
+// Test 3: CSR adjacency matches the topology's outgoing lists
+TEST_F(CompiledCityTest, CsrAdjacencyMatches) {
+    auto bytes = CompiledCity::encode(*city->getTopology());
+    CompiledCity compiled(bytes.data(), bytes.size());
+
+    for (const Node& node : city->getTopology()->getNodes()) {
+        NodeId id = node.getId();
+        std::vector<EdgeId> csr(compiled.adjacencyEdges() + compiled.adjacencyOffsets()[id],
+                                compiled.adjacencyEdges() + compiled.adjacencyOffsets()[id + 1]);
+        EXPECT_EQ(csr, city->outgoingEdges(id));
+    }
+}
+
+// Test 4: Mapped file loads a usable City
+TEST_F(CompiledCityTest, MappedFileLoadsCity) {
+    std::string path = ::testing::TempDir() + "gridlock_compiled_city_test.glcity";
+    CompiledCity::writeFile(path, *city->getTopology());
+
+    std::unique_ptr<City> loaded;
+    {
+        CompiledCity compiled(path);
+        loaded = compiled.createCity();
+    }
+    std::remove(path.c_str());
+
+    expectSameTopology(*city->getTopology(), *loaded->getTopology());
+    EdgeId edge = loaded->getEdgeIdByIndex(5);
+    loaded->incrementOccupancy(edge);
+    EXPECT_EQ(loaded->occupancy(edge), 1);
+}
+
+// Test 5: Blobs are stored and reserved ids are rejected
+TEST_F(CompiledCityTest, BlobsRoundTrip) {
+    std::vector<CompiledCity::Blob> blobs = {
+        {CompiledCity::kFirstBlobId, {1, 2, 3, 4, 5}},
+        {CompiledCity::kFirstBlobId + 7, {}}
+    };
+    auto bytes = CompiledCity::encode(*city->getTopology(), blobs);
+    CompiledCity compiled(bytes.data(), bytes.size());
+
+    std::size_t size = 0;
+    const std::uint8_t* blob = compiled.findBlob(CompiledCity::kFirstBlobId, size);
+    ASSERT_NE(blob, nullptr);
+    EXPECT_EQ(std::vector<std::uint8_t>(blob, blob + size), blobs[0].bytes);
+    EXPECT_NE(compiled.findBlob(CompiledCity::kFirstBlobId + 7, size), nullptr);
+    EXPECT_EQ(size, 0u);
+    EXPECT_EQ(compiled.findBlob(CompiledCity::kFirstBlobId + 1, size), nullptr);
+
+    EXPECT_THROW(CompiledCity::encode(*city->getTopology(), {{3, {}}}), std::runtime_error);
+}
+
+// Test 6: Malformed buffers are rejected
+TEST_F(CompiledCityTest, RejectsMalformedData) {
+    auto bytes = CompiledCity::encode(*city->getTopology());
+
+    EXPECT_THROW(CompiledCity(bytes.data(), 16), std::runtime_error);
+    EXPECT_THROW(CompiledCity(bytes.data(), bytes.size() / 2), std::runtime_error);
+
+    auto badMagic = bytes;
+    badMagic[2] = 'X';
+    EXPECT_THROW(CompiledCity(badMagic.data(), badMagic.size()), std::runtime_error);
+
+    auto badVersion = bytes;
+    badVersion[8] = 0x7f;
+    EXPECT_THROW(CompiledCity(badVersion.data(), badVersion.size()), std::runtime_error);
+
+    EXPECT_THROW(CompiledCity("/nonexistent/city.glcity"), std::runtime_error);
+}
+
+// Test 7: Networks with sparse ids and edge-only nodes survive the round-trip
+TEST_F(CompiledCityTest, SparseIdsRoundTrip) {
+    auto sparse = TestCityBuilder::createDisconnectedCity();
+    sparse->addEdge(Edge(500, 42, 0, 3.5, 2));
+    auto bytes = CompiledCity::encode(*sparse->getTopology());
+    CompiledCity compiled(bytes.data(), bytes.size());
+
+    auto topology = compiled.createTopology();
+    expectSameTopology(*sparse->getTopology(), *topology);
+    EXPECT_EQ(topology->outgoing(42), std::vector<EdgeId>{500});
+}
+
+// Test 8: Building from the stored CSR matches the bulk build and checks it
+TEST_F(CompiledCityTest, CsrTopologyMatchesBulk) {
+    const CityTopology& original = *city->getTopology();
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::int32_t> edges;
+    offsets.push_back(0);
+    for (NodeId id = 0; id < original.getNodeCount(); ++id) {
+        for (EdgeId edge : original.outgoing(id)) {
+            edges.push_back(edge);
+        }
+        offsets.push_back(static_cast<std::uint32_t>(edges.size()));
+    }
+    CityTopology csr(original.getNodes(), original.getEdges(), offsets, edges);
+    expectSameTopology(original, csr);
+
+    // An edge listed twice (and another left out) is rejected
+    auto duplicated = edges;
+    duplicated[1] = duplicated[0];
+    EXPECT_THROW(CityTopology(original.getNodes(), original.getEdges(), offsets, duplicated),
+                 std::runtime_error);
+    // So is an edge listed under a node it does not leave
+    auto misplaced = edges;
+    std::swap(misplaced.front(), misplaced.back());
+    EXPECT_THROW(CityTopology(original.getNodes(), original.getEdges(), offsets, misplaced),
+                 std::runtime_error);
+}
+
+// Test 9: A column changed after writing no longer matches the fingerprint
+TEST_F(CompiledCityTest, RejectsFingerprintMismatch) {
+    auto bytes = CompiledCity::encode(*city->getTopology());
+
+    // Walk the section directory after the 64-byte header to the capacity column
+    constexpr std::uint32_t kEdgeCapacitySection = 14;
+    std::uint32_t sectionCount = 0;
+    std::memcpy(&sectionCount, bytes.data() + 36, sizeof(sectionCount));
+    std::uint64_t capacityOffset = 0;
+    for (std::uint32_t i = 0; i < sectionCount; ++i) {
+        const std::uint8_t* entry = bytes.data() + 64 + i * 24;
+        std::uint32_t id = 0;
+        std::memcpy(&id, entry, sizeof(id));
+        if (id == kEdgeCapacitySection) {
+            std::memcpy(&capacityOffset, entry + 8, sizeof(capacityOffset));
+        }
+    }
+    ASSERT_NE(capacityOffset, 0u);
+    bytes[capacityOffset] ^= 0x01;
+
+    CompiledCity compiled(bytes.data(), bytes.size());
+    EXPECT_THROW(compiled.createTopology(), std::runtime_error);
+    EXPECT_THROW(compiled.createCity(), std::runtime_error);
+}
+
+// Test 10: A preset naming its compiled city loads the same network
+TEST_F(CompiledCityTest, PresetLoadsCompiledCity) {
+    const std::string dir = ::testing::TempDir();
+    const std::string cityPath = dir + "gridlock_compiled_preset.glcity";
+    const std::string presetPath = dir + "gridlock_compiled_preset.json";
+
+    PresetLoader loader;
+    Preset preset;
+    preset.setName("compiled");
+    preset.setRows(7);
+    preset.setCols(9);
+    preset.setAgentCount(1);
+    preset.setBlockedEdges({{0, 1}, {10, 19}});
+    loader.compileCity(preset, cityPath);
+    preset.setCompiledCity("gridlock_compiled_preset.glcity");
+    loader.saveToJson(preset, presetPath);
+
+    // The relative path resolves against the preset's directory
+    Preset loaded = loader.loadFromJson(presetPath);
+    EXPECT_EQ(loaded.getCompiledCity(), dir + "gridlock_compiled_preset.glcity");
+    auto compiled = loader.buildCity(loaded);
+    expectSameTopology(*city->getTopology(), *compiled->getTopology());
+
+    // Different closures than the file was compiled from: stale
+    loaded.setBlockedEdges({{0, 1}});
+    EXPECT_THROW(loader.buildCity(loaded), std::runtime_error);
+
+    // A file without the preset signature is stale too
+    CompiledCity::writeFile(cityPath, *city->getTopology());
+    loaded.setBlockedEdges({{0, 1}, {10, 19}});
+    EXPECT_THROW(loader.buildCity(loaded), std::runtime_error);
+
+    std::remove(cityPath.c_str());
+    std::remove(presetPath.c_str());
+}
@@ -0,0 +1,198 @@
+// code/tests/test_edge_cost_profiles_googletest.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "../core/EdgeCostProfiles.h"
+#include "../core/RoutePlanner.h"
+#include "../core/City.h"
+#include "../core/Node.h"
+#include "../core/Edge.h"
+#include "../core/ShortestPathPolicy.h"
+#include "../core/CongestionAwarePolicy.h"
+#include "mocks/MockCity.h"
+
+/**
+ * Test Suite: time-dependent edge costs
+ * Tests profile interpolation and compaction, profiles built from
+ * predicted and recorded occupancy (fresh, rebuilt in place and
+ * updated), and the time-dependent search.
+ */
+
+namespace {
+    // Two routes 0 -> 2: via node 1 (edges 0, 1; length 2) and via
+    // node 3 (edges 2, 3; length 3)
+    std::unique_ptr<City> makeTwoRoutes() {
+        auto city = std::make_unique<City>();
+        for (NodeId n = 0; n < 4; ++n) {
+            city->addNode(Node(n, n, 0));
+        }
+        city->addEdge(Edge(0, 0, 1, 1.0, 4));
+        city->addEdge(Edge(1, 1, 2, 1.0, 4));
+        city->addEdge(Edge(2, 0, 3, 1.5, 4));
+        city->addEdge(Edge(3, 3, 2, 1.5, 4));
+        return city;
+    }
+
+    // Profiles on slots at t = 0, 1, 2 where edge 1 follows the given
+    // samples and every other edge costs its length
+    EdgeCostProfiles withEdgeOne(std::vector<float> edgeOne) {
+        EdgeCostProfiles profiles(0.0, 1.0, 3);
+        profiles.addEdge(std::vector<float>{1.0f, 1.0f, 1.0f});
+        profiles.addEdge(edgeOne);
+        profiles.addEdge(std::vector<float>{1.5f, 1.5f, 1.5f});
+        profiles.addEdge(std::vector<float>{1.5f, 1.5f, 1.5f});
+        return profiles;
+    }
+}
+
+// Test 1: Costs interpolate between breakpoints and flat profiles keep one sample
+TEST(EdgeCostProfilesTest, InterpolatesAndCompacts) {
+    EdgeCostProfiles profiles(10.0, 2.0, 3);
+    profiles.addEdge(std::vector<float>{4.0f, 4.0f, 4.0f});
+    profiles.addEdge(std::vector<float>{1.0f, 3.0f, 5.0f});
+    EXPECT_EQ(profiles.edgeCount(), 2);
+    EXPECT_EQ(profiles.storedSamples(), 4u);
+
+    EXPECT_FLOAT_EQ(profiles.cost(0, 0.0), 4.0f);
+    EXPECT_FLOAT_EQ(profiles.cost(0, 99.0), 4.0f);
+    EXPECT_FLOAT_EQ(profiles.cost(1, 9.0), 1.0f);     // Before the axis
+    EXPECT_FLOAT_EQ(profiles.cost(1, 11.0), 2.0f);
+    EXPECT_FLOAT_EQ(profiles.cost(1, 12.0), 3.0f);
+    EXPECT_FLOAT_EQ(profiles.cost(1, 13.5), 4.5f);
+    EXPECT_FLOAT_EQ(profiles.cost(1, 20.0), 5.0f);    // After the axis
+
+    EXPECT_THROW(profiles.addEdge(std::vector<float>{1.0f}), std::runtime_error);
+    EXPECT_THROW(EdgeCostProfiles(0.0, 0.0, 3), std::runtime_error);
+    EXPECT_THROW(EdgeCostProfiles(0.0, 1.0, 0), std::runtime_error);
+}
+
+// Test 2: Predicted occupancy is priced by the policy
+TEST(EdgeCostProfilesTest, FromOccupancyUsesPolicyCosts) {
+    auto grid = TestCityBuilder::createSimpleGrid(3, 3);
+    const int edges = grid->getEdgeCount();
+    grid->setOccupancy(grid->getEdgeIdByIndex(2), 1);
+    std::vector<std::vector<int>> occupancy(4, std::vector<int>(edges, 0));
+    for (int s = 0; s < 4; ++s) {
+        occupancy[s][2] = s;
+    }
+
+    CongestionAwarePolicy congestion;
+    auto profiles = EdgeCostProfiles::fromOccupancy(*grid, congestion, occupancy, 5.0, 2.0);
+    ASSERT_EQ(profiles.edgeCount(), edges);
+    EXPECT_EQ(profiles.getSlotCount(), 4);
+    EXPECT_EQ(profiles.storedSamples(), static_cast<size_t>(edges - 1 + 4));
+    const EdgeId id = grid->getEdgeIdByIndex(2);
+    for (int s = 0; s < 4; ++s) {
+        double expected = congestion.cost(grid->edgeLength(id), grid->edgeCapacity(id), s);
+        EXPECT_FLOAT_EQ(profiles.cost(2, 5.0 + 2.0 * s), static_cast<float>(expected)) << s;
+    }
+
+    // A load-blind policy gives flat profiles
+    ShortestPathPolicy shortest;
+    auto flat = EdgeCostProfiles::fromOccupancy(*grid, shortest, occupancy, 5.0, 2.0);
+    EXPECT_EQ(flat.storedSamples(), static_cast<size_t>(edges));
+
+    occupancy[1].resize(1);
+    EXPECT_THROW(EdgeCostProfiles::fromOccupancy(*grid, congestion, occupancy, 5.0, 2.0), std::runtime_error);
+}
+
+// Test 3: Recorded occupancy is extended along its trend, within capacity
+TEST(EdgeCostProfilesTest, FromHistoryFollowsTrend) {
+    auto city = makeTwoRoutes();
+    // Edge 0 fills by one vehicle per tick; edge 1 drains; edges 2, 3 stay idle
+    std::vector<std::vector<int>> history = {{0, 3, 0, 0}, {1, 2, 0, 0}, {2, 1, 0, 0}};
+    CongestionAwarePolicy congestion;
+    auto profiles = EdgeCostProfiles::fromHistory(*city, congestion, history, 0.0, 1.0, 4);
+
+    for (int s = 0; s < 4; ++s) {
+        int rising = std::min(2 + s, 4);
+        int falling = std::max(1 - s, 0);
+        EXPECT_FLOAT_EQ(profiles.cost(0, s), static_cast<float>(congestion.cost(1.0, 4, rising))) << s;
+        EXPECT_FLOAT_EQ(profiles.cost(1, s), static_cast<float>(congestion.cost(1.0, 4, falling))) << s;
+    }
+    EXPECT_FLOAT_EQ(profiles.cost(2, 3.0), 1.5f);
+
+    EXPECT_THROW(EdgeCostProfiles::fromHistory(*city, congestion, {}, 0.0, 1.0, 4), std::runtime_error);
+}
+
+// Test 4: Rebuilding in place and updating match a fresh build, for
+// load-aware and load-blind policies alike
+TEST(EdgeCostProfilesTest, RebuildAndUpdateMatchFromHistory) {
+    auto city = makeTwoRoutes();
+    CongestionAwarePolicy congestion;
+    ShortestPathPolicy shortest;
+    // Each step is one slot later: first only edge 3 moves (repriced on its
+    // own), then edges 0 and 1 (the whole network), then the history grows
+    std::vector<std::vector<std::vector<int>>> steps = {
+        {{0, 3, 1, 0}, {1, 2, 1, 0}, {2, 1, 1, 0}},
+        {{0, 3, 1, 0}, {1, 2, 1, 0}, {2, 1, 1, 3}},
+        {{2, 1, 1, 0}, {2, 1, 1, 0}, {0, 3, 1, 3}},
+        {{2, 1, 1, 0}, {2, 1, 1, 0}, {0, 3, 1, 3}, {0, 3, 1, 3}},
+    };
+
+    for (const IRoutePolicy* policy : {static_cast<const IRoutePolicy*>(&congestion),
+                                       static_cast<const IRoutePolicy*>(&shortest)}) {
+        EdgeCostProfiles rebuilt;
+        EdgeCostProfiles updated;
+        updated.rebuild(*city, *policy, steps[0], 0.0, 1.0, 4);
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const double start = static_cast<double>(i);
+            rebuilt.rebuild(*city, *policy, steps[i], start, 1.0, 4);
+            updated.update(*city, *policy, steps[i], start);
+            auto fresh = EdgeCostProfiles::fromHistory(*city, *policy, steps[i], start, 1.0, 4);
+            for (const EdgeCostProfiles* profiles : {&rebuilt, &updated}) {
+                ASSERT_EQ(profiles->edgeCount(), fresh.edgeCount());
+                EXPECT_EQ(profiles->getStartTime(), start);
+                EXPECT_EQ(profiles->storedSamples(), fresh.storedSamples()) << i;
+                for (int e = 0; e < fresh.edgeCount(); ++e) {
+                    for (double t = start - 0.5; t <= start + 4.5; t += 0.5) {
+                        EXPECT_FLOAT_EQ(profiles->cost(e, t), fresh.cost(e, t)) << i << ": " << e << " at " << t;
+                    }
+                }
+            }
+        }
+    }
+
+    // Idle and steady edges keep one sample; a load-blind policy keeps one per edge
+    EdgeCostProfiles profiles;
+    profiles.rebuild(*city, shortest, steps[0], 0.0, 1.0, 4);
+    EXPECT_EQ(profiles.storedSamples(), 4u);
+    profiles.rebuild(*city, congestion, steps[0], 0.0, 1.0, 4);
+    EXPECT_EQ(profiles.storedSamples(), 4u + 4u + 1u + 1u);
+
+    EXPECT_THROW(profiles.rebuild(*city, congestion, {}, 0.0, 1.0, 4), std::runtime_error);
+    EXPECT_EQ(profiles.edgeCount(), 0);
+}
+
+// Test 5: The time-dependent search prices edges at the time it reaches them
+TEST(EdgeCostProfilesTest, SearchUsesArrivalTime) {
+    auto city = makeTwoRoutes();
+    ShortestPathPolicy shortest;
+    RoutePlanner planner(&shortest);
+    const std::deque<EdgeId> viaOne = {0, 1};
+    const std::deque<EdgeId> viaThree = {2, 3};
+
+    // Edge 1 is free now but jams by the time an agent gets there
+    auto jamming = withEdgeOne({1.0f, 10.0f, 10.0f});
+    std::vector<float> now = {1.0f, 1.0f, 1.5f, 1.5f};
+    EXPECT_EQ(planner.computePath(*city, 0, 2, now), viaOne);
+    EXPECT_EQ(planner.computePath(*city, 0, 2, jamming, 0.0), viaThree);
+
+    // Edge 1 is jammed now but clears in time
+    auto clearing = withEdgeOne({10.0f, 1.0f, 1.0f});
+    now[1] = 10.0f;
+    EXPECT_EQ(planner.computePath(*city, 0, 2, now), viaThree);
+    EXPECT_EQ(planner.computePath(*city, 0, 2, clearing, 0.0), viaOne);
+    // Leaving later sees the cleared edge from the start
+    EXPECT_EQ(planner.computePath(*city, 1, 2, clearing, 2.0), std::deque<EdgeId>{1});
+
+    // Closures still apply
+    city->getState().setBlocked(1, true);
+    EXPECT_EQ(planner.computePath(*city, 0, 2, clearing, 0.0), viaThree);
+
+    EdgeCostProfiles tooFew(0.0, 1.0, 1);
+    EXPECT_THROW(planner.computePath(*city, 0, 2, tooFew, 0.0), std::runtime_error);
+}
@@ -6,6 +6,7 @@
 #include <QGraphicsView>
 #include "../ui/GridView.h"
 #include "../core/SimulationController.h"
+#include "../core/SimulationFrame.h"
 #include "../core/Preset.h"
 #include "../adapters/PresetLoader.h"
 #include <memory>
@@ -25,8 +26,8 @@ private slots:
     
     // Basic functionality tests
     void testGridViewCreation();
-    void testSetSimulationController();
-    void testUpdateScene();
+    void testSetFrame();
+    void testIncrementalFrames();
     
     // Node tests
     void testNodeItemsCreated();
@@ -53,9 +54,14 @@ private slots:
     void testGridColor();
 
 private:
+    // Capture the controller's current tick and show it, as SimulationRunner
+    // and MainWindow do between them
+    void showCurrentTick();
+
     QApplication* app;
     GridView* gridView;
     SimulationController* controller;
+    SimulationFrame frame;
     std::unique_ptr<Preset> preset;
 };
 
@@ -70,6 +76,20 @@ void TestGridView::initTestCase() {
     }
 }
 
+void TestGridView::showCurrentTick() {
+    frame.changedEdges.clear();
+    frame.changedAgents.clear();
+    bool complete = controller->takeChanges(frame.changedEdges, frame.changedAgents);
+    controller->captureFrame(frame);
+    frame.fullRefresh = !complete;
+    if (!complete) {
+        frame.changedEdges.clear();
+        frame.changedAgents.clear();
+    }
+    ++frame.sequence;
+    gridView->setFrame(frame);
+}
+
 void TestGridView::cleanupTestCase() {
     // Don't delete app if it was created by QTEST_MAIN
     // Only delete if we created it ourselves
@@ -99,6 +119,7 @@ void TestGridView::init() {
     }
     
     controller->loadPreset(testPreset);
+    frame = SimulationFrame();
 }
 
 void TestGridView::cleanup() {
@@ -125,22 +146,37 @@ void TestGridView::testGridViewCreation() {
     QVERIFY(gridView->scene() != nullptr);
 }
 
-void TestGridView::testSetSimulationController() {
-    gridView->setSimulationController(controller);
+void TestGridView::testSetFrame() {
+    showCurrentTick();
     QVERIFY(gridView->selectedAgent() == nullptr); // No agent selected initially
+    
+    // Scene should have items after the first frame
+    QVERIFY(gridView->scene()->items().size() > 0);
 }
 
-void TestGridView::testUpdateScene() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+void TestGridView::testIncrementalFrames() {
+    showCurrentTick();
+    QVERIFY(frame.fullRefresh); // First frame after a load compares everything
+    
+    // Later frames carry change lists and update items in place
+    for (int i = 0; i < 5; ++i) {
+        controller->tick();
+        showCurrentTick();
+        QVERIFY(!frame.fullRefresh);
+        QCOMPARE(frame.tick, i + 1);
+    }
+    QVERIFY(gridView->scene()->items().size() > 0);
     
-    // Scene should have items after update
+    // A reset sends the view back to tick 0 without a rebuild
+    controller->reset();
+    showCurrentTick();
+    QVERIFY(frame.fullRefresh);
+    QCOMPARE(frame.tick, 0);
     QVERIFY(gridView->scene()->items().size() > 0);
 }
 
 void TestGridView::testNodeItemsCreated() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Should have items in the scene after update
     QGraphicsScene* scene = gridView->scene();
@@ -149,8 +185,7 @@ void TestGridView::testNodeItemsCreated() {
 }
 
 void TestGridView::testNodeLabelsToggle() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Test toggling node labels
     gridView->setShowNodeLabels(true);
@@ -162,8 +197,7 @@ void TestGridView::testNodeLabelsToggle() {
 }
 
 void TestGridView::testEdgeItemsCreated() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Should have items in the scene (edges are part of the items)
     QGraphicsScene* scene = gridView->scene();
@@ -173,19 +207,18 @@ void TestGridView::testEdgeItemsCreated() {
 }
 
 void TestGridView::testEdgeColorUpdates() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
-    // Trigger edge color update
-    gridView->animateStep();
+    // Edge colors follow the next tick's occupancy
+    controller->tick();
+    showCurrentTick();
     
     // Should not crash
     QVERIFY(true);
 }
 
 void TestGridView::testEdgeTooltips() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Tooltips are tested through hover events in integration tests
     // This is a placeholder to ensure the functionality exists
@@ -193,8 +226,7 @@ void TestGridView::testEdgeTooltips() {
 }
 
 void TestGridView::testAgentItemsCreated() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Should have items in the scene
     // Agents may or may not be visible depending on simulation state
@@ -205,19 +237,18 @@ void TestGridView::testAgentItemsCreated() {
 }
 
 void TestGridView::testAgentPositionUpdates() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
-    // Update agent positions
-    gridView->animateStep();
+    // Agents move to the next tick's positions
+    controller->tick();
+    showCurrentTick();
     
     // Should not crash
     QVERIFY(true);
 }
 
 void TestGridView::testAgentSelection() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Initially no agent selected
     QVERIFY(gridView->selectedAgent() == nullptr);
@@ -227,8 +258,7 @@ void TestGridView::testAgentSelection() {
 }
 
 void TestGridView::testZoom() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Test zoom levels
     qreal initialZoom = gridView->zoomLevel();
@@ -247,8 +277,7 @@ void TestGridView::testZoom() {
 }
 
 void TestGridView::testFitToWindow() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Should not crash
     gridView->fitToWindow();
@@ -256,7 +285,7 @@ void TestGridView::testFitToWindow() {
 }
 
 void TestGridView::testGridToggle() {
-    gridView->setSimulationController(controller);
+    showCurrentTick();
     
     // Toggle grid
     gridView->setShowGrid(true);
@@ -268,8 +297,7 @@ void TestGridView::testGridToggle() {
 }
 
 void TestGridView::testPan() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Pan is tested through mouse/keyboard events in integration tests
     // This ensures the functionality exists
@@ -277,7 +305,7 @@ void TestGridView::testPan() {
 }
 
 void TestGridView::testDarkBackground() {
-    gridView->setSimulationController(controller);
+    showCurrentTick();
     
     // Check that GridView has dark background styling
     QString styleSheet = gridView->styleSheet();
@@ -287,8 +315,7 @@ void TestGridView::testDarkBackground() {
 }
 
 void TestGridView::testGridColor() {
-    gridView->setSimulationController(controller);
-    gridView->updateScene();
+    showCurrentTick();
     
     // Grid should use subtle colors
     gridView->setShowGrid(true);
@@ -0,0 +1,132 @@
+// code/tests/test_hotspot_tracker_googletest.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "../analytics/HotspotTracker.h"
+#include "../analytics/TrafficFlowAnalyzer.h"
+#include "../core/City.h"
+#include "../core/CityState.h"
+#include "../core/Edge.h"
+#include "../core/Node.h"
+#include "../core/Preset.h"
+#include "../core/SimulationController.h"
+
+/**
+ * Test Suite: Incremental bottleneck ranking
+ * Tests the indexed heap against a full sort under random updates and
+ * when fed from a running simulation's change lists.
+ */
+
+class HotspotTrackerTest : public ::testing::Test {
+protected:
+    // Ring of edges with mixed capacities (including one closed at zero)
+    static City createRing(int nodes) {
+        City city;
+        for (int i = 0; i < nodes; ++i) {
+            city.addNode(Node(i, 0, i));
+        }
+        for (int i = 0; i < nodes; ++i) {
+            city.addEdge(Edge(100 + i, i, (i + 1) % nodes, 1.0, i == 3 ? 0 : 1 + i % 4));
+        }
+        return city;
+    }
+
+    // Reference ranking: utilization descending, lower edge index first
+    static std::vector<EdgeId> bruteForce(const City& city, int k) {
+        std::vector<int> order;
+        for (int i = 0; i < city.getEdgeCount(); ++i) {
+            if (city.edgeCapacity(city.getEdgeIdByIndex(i)) > 0) order.push_back(i);
+        }
+        auto util = [&](int i) {
+            EdgeId id = city.getEdgeIdByIndex(i);
+            return static_cast<double>(city.occupancy(id)) / city.edgeCapacity(id);
+        };
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return util(a) > util(b); });
+        order.resize(std::min<size_t>(order.size(), k));
+        std::vector<EdgeId> ids;
+        for (int i : order) ids.push_back(city.getEdgeIdByIndex(i));
+        return ids;
+    }
+
+    static std::vector<EdgeId> idsOf(const std::vector<HotspotTracker::Hotspot>& hotspots) {
+        std::vector<EdgeId> ids;
+        for (const auto& hotspot : hotspots) ids.push_back(hotspot.edgeId);
+        return ids;
+    }
+};
+
+// Test 1: A fresh tracker ranks like a full sort and skips zero-capacity edges
+TEST_F(HotspotTrackerTest, ResetMatchesFullSort) {
+    City city = createRing(20);
+    for (int i = 0; i < 20; ++i) {
+        city.getState().setOccupancy(i, (i * 7) % 5);
+    }
+    HotspotTracker tracker;
+    tracker.reset(city);
+    EXPECT_EQ(tracker.trackedEdges(), 19u);
+    EXPECT_EQ(idsOf(tracker.top(8)), bruteForce(city, 8));
+    EXPECT_EQ(tracker.top(100).size(), 19u);
+    EXPECT_TRUE(tracker.top(0).empty());
+
+    auto first = tracker.top(1);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_DOUBLE_EQ(first[0].congestionLevel,
+                     TrafficFlowAnalyzer::calculateCongestionLevel(first[0].currentOccupancy, first[0].capacity));
+}
+
+// Test 2: Random single-edge updates keep the ranking exact
+TEST_F(HotspotTrackerTest, RandomUpdates) {
+    City city = createRing(200);
+    HotspotTracker tracker;
+    tracker.reset(city);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> edge(0, 199);
+    std::uniform_int_distribution<int> value(0, 6);
+    for (int step = 0; step < 2000; ++step) {
+        int index = edge(rng);
+        int occupancy = value(rng);
+        city.getState().setOccupancy(index, occupancy);
+        tracker.update(index, occupancy);
+        if (step % 50 == 0) {
+            ASSERT_EQ(idsOf(tracker.top(10)), bruteForce(city, 10)) << "step " << step;
+        }
+    }
+    EXPECT_EQ(idsOf(tracker.top(200)), bruteForce(city, 200));
+}
+
+// Test 3: Fed from the controller's change lists it tracks a live run
+TEST_F(HotspotTrackerTest, FollowsSimulation) {
+    Preset preset;
+    preset.setName("hotspots");
+    preset.setRows(8);
+    preset.setCols(8);
+    preset.setAgentCount(150);
+    SimulationController controller;
+    controller.loadPreset(preset);
+
+    HotspotTracker tracker;
+    TrafficFlowAnalyzer analyzer;
+    std::vector<int> edges, agents;
+    for (int tick = 0; tick < 30; ++tick) {
+        edges.clear();
+        agents.clear();
+        const City& city = *controller.getCity();
+        if (controller.takeChanges(edges, agents)) {
+            tracker.update(edges, city.getState().occupancyData());
+        } else {
+            tracker.reset(city);
+        }
+        ASSERT_EQ(idsOf(tracker.top(10)), bruteForce(city, 10)) << "tick " << tick;
+
+        // Same utilizations as the full-scan API (its tie order may differ)
+        auto scanned = analyzer.getTopBottlenecks(city, 10);
+        auto tracked = tracker.top(10);
+        ASSERT_EQ(scanned.size(), tracked.size());
+        for (size_t i = 0; i < tracked.size(); ++i) {
+            EXPECT_DOUBLE_EQ(scanned[i].utilization, tracked[i].utilization);
+        }
+        controller.tick();
+    }
+}
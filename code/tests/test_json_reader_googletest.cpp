@@ -0,0 +1,192 @@
+// code/tests/test_json_reader_googletest.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../adapters/JsonReader.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/Preset.h"
+#include "../core/City.h"
+#include "../core/Agent.h"
+
+/**
+ * Test Suite: Streaming JSON parsing
+ * Tests the JsonReader tokenizer, its error reporting and the
+ * recursive-descent preset parser built on it.
+ */
+
+using Token = JsonReader::Token;
+
+class JsonReaderTest : public ::testing::Test {
+protected:
+    std::vector<Token> tokenize(const std::string& json) {
+        std::istringstream in(json);
+        JsonReader reader;
+        reader.attach(in);
+        std::vector<Token> tokens;
+        Token token;
+        do {
+            token = reader.next();
+            tokens.push_back(token);
+        } while (token != Token::END_OF_INPUT);
+        return tokens;
+    }
+
+    std::string writeTemp(const std::string& name, const std::string& content) {
+        std::string path = ::testing::TempDir() + name;
+        std::ofstream out(path);
+        out << content;
+        paths.push_back(path);
+        return path;
+    }
+
+    void TearDown() override {
+        for (const auto& path : paths) {
+            std::remove(path.c_str());
+        }
+    }
+
+    std::vector<std::string> paths;
+};
+
+// Test 1: Token stream for a nested document
+TEST_F(JsonReaderTest, TokenizesNestedDocument) {
+    std::vector<Token> expected = {
+        Token::BEGIN_OBJECT,
+        Token::KEY, Token::STRING,
+        Token::KEY, Token::BEGIN_ARRAY, Token::NUMBER, Token::NUMBER, Token::END_ARRAY,
+        Token::KEY, Token::BEGIN_OBJECT, Token::KEY, Token::TRUE_VALUE, Token::END_OBJECT,
+        Token::KEY, Token::NULL_VALUE,
+        Token::END_OBJECT,
+        Token::END_OF_INPUT
+    };
+    EXPECT_EQ(tokenize(R"({"a": "x", "b": [1, -2.5e3], "c": {"d": true}, "e": null})"), expected);
+}
+
+// Test 2: Scalar values are decoded
+TEST_F(JsonReaderTest, DecodesScalars) {
+    std::istringstream in(R"(["tab\tquote\"é", 42, -0.5])");
+    JsonReader reader;
+    reader.attach(in);
+
+    EXPECT_EQ(reader.next(), Token::BEGIN_ARRAY);
+    EXPECT_EQ(reader.next(), Token::STRING);
+    EXPECT_EQ(reader.stringValue(), "tab\tquote\"\xc3\xa9");
+    EXPECT_EQ(reader.next(), Token::NUMBER);
+    EXPECT_EQ(reader.intValue(), 42);
+    EXPECT_EQ(reader.next(), Token::NUMBER);
+    EXPECT_DOUBLE_EQ(reader.numberValue(), -0.5);
+    EXPECT_THROW(reader.intValue(), std::runtime_error);
+    EXPECT_EQ(reader.next(), Token::END_ARRAY);
+    EXPECT_EQ(reader.next(), Token::END_OF_INPUT);
+}
+
+// Test 3: Malformed documents are rejected
+TEST_F(JsonReaderTest, RejectsMalformedInput) {
+    const std::vector<std::string> bad = {
+        R"({"a" 1})",
+        R"({"a": 1,})",
+        R"([1 2])",
+        R"({"a": })",
+        R"([1, 2)",
+        R"({"a": "unterminated)",
+        R"({} extra)",
+        R"([tru])"
+    };
+    for (const auto& json : bad) {
+        EXPECT_THROW(tokenize(json), std::runtime_error) << json;
+    }
+}
+
+// Test 4: skipValue steps over whole nested values
+TEST_F(JsonReaderTest, SkipValueSkipsNestedValues) {
+    std::istringstream in(R"({"skip": {"x": [1, {"y": [2, 3]}]}, "keep": 7})");
+    JsonReader reader;
+    reader.attach(in);
+
+    EXPECT_EQ(reader.next(), Token::BEGIN_OBJECT);
+    EXPECT_EQ(reader.next(), Token::KEY);
+    reader.skipValue();
+    EXPECT_EQ(reader.next(), Token::KEY);
+    EXPECT_EQ(reader.stringValue(), "keep");
+    EXPECT_EQ(reader.next(), Token::NUMBER);
+    EXPECT_EQ(reader.intValue(), 7);
+}
+
+// Test 5: Tokens spanning chunk boundaries are reassembled
+TEST_F(JsonReaderTest, HandlesValuesAcrossChunks) {
+    std::string longString(200000, 'q');
+    std::string json = "[\"" + longString + "\", 123456789]";
+    std::istringstream in(json);
+    JsonReader reader;
+    reader.attach(in);
+
+    EXPECT_EQ(reader.next(), Token::BEGIN_ARRAY);
+    EXPECT_EQ(reader.next(), Token::STRING);
+    EXPECT_EQ(reader.stringValue(), longString);
+    EXPECT_EQ(reader.next(), Token::NUMBER);
+    EXPECT_EQ(reader.intValue(), 123456789);
+}
+
+// Test 6: Preset parser skips unknown keys and reads agent routes
+TEST_F(JsonReaderTest, LoadsPresetWithUnknownKeysAndRoutes) {
+    std::string path = writeTemp("gridlock_json_reader_routes.json", R"({
+        "meta": {"author": "x", "tags": ["a", {"b": null}]},
+        "name": "routes",
+        "rows": 4,
+        "cols": 3,
+        "blocked": [[0, 1], [4, 5]],
+        "agents": [[0, 11], [3, 8], [2, 9]],
+        "tickMs": 50,
+        "policy": "congestion_aware"
+    })");
+
+    PresetLoader loader;
+    Preset preset = loader.loadFromJson(path);
+    EXPECT_EQ(preset.getName(), "routes");
+    EXPECT_EQ(preset.getRows(), 4);
+    EXPECT_EQ(preset.getCols(), 3);
+    EXPECT_EQ(preset.getTickMs(), 50);
+    EXPECT_EQ(preset.getPolicy(), PolicyType::CONGESTION_AWARE);
+    ASSERT_EQ(preset.getBlockedEdges().size(), 2u);
+    EXPECT_EQ(preset.getBlockedEdges()[1], std::make_pair(4, 5));
+    ASSERT_EQ(preset.getAgentRoutes().size(), 3u);
+    EXPECT_EQ(preset.getAgentCount(), 3);
+
+    auto city = loader.buildCity(preset);
+    auto agents = loader.spawnAgents(preset, *city);
+    ASSERT_EQ(agents.size(), 3u);
+    EXPECT_EQ(agents[1]->getOrigin(), 3);
+    EXPECT_EQ(agents[1]->getDestination(), 8);
+}
+
+// Test 7: Large blocked arrays stream through in one pass
+TEST_F(JsonReaderTest, LoadsLargeBlockedArray) {
+    std::ostringstream json;
+    json << R"({"name": "big", "rows": 100, "cols": 100, "blocked": [)";
+    const int count = 20000;
+    for (int i = 0; i < count; ++i) {
+        json << (i ? ", " : "") << "[" << i % 9999 << ", " << i % 9999 + 1 << "]";
+    }
+    json << "]}";
+    std::string path = writeTemp("gridlock_json_reader_big.json", json.str());
+
+    PresetLoader loader;
+    Preset preset = loader.loadFromJson(path);
+    ASSERT_EQ(preset.getBlockedEdges().size(), static_cast<size_t>(count));
+    EXPECT_EQ(preset.getBlockedEdges().back(), std::make_pair((count - 1) % 9999, (count - 1) % 9999 + 1));
+}
+
+// Test 8: Wrongly typed preset fields are reported
+TEST_F(JsonReaderTest, RejectsWronglyTypedPresetFields) {
+    PresetLoader loader;
+    std::string badRows = writeTemp("gridlock_json_reader_rows.json", R"({"rows": "five"})");
+    std::string badPair = writeTemp("gridlock_json_reader_pair.json", R"({"blocked": [[1, 2, 3]]})");
+    std::string empty = writeTemp("gridlock_json_reader_empty.json", "  \n");
+
+    EXPECT_THROW(loader.loadFromJson(badRows), std::runtime_error);
+    EXPECT_THROW(loader.loadFromJson(badPair), std::runtime_error);
+    EXPECT_THROW(loader.loadFromJson(empty), std::runtime_error);
+}
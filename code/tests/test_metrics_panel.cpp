@@ -15,10 +15,12 @@
 #include <QtCharts/QPieSeries>
 #include "../ui/MetricsPanel.h"
 #include "../core/SimulationController.h"
+#include "../core/SimulationFrame.h"
 #include "../core/Preset.h"
 #include "../core/Metrics.h"
 #include "../core/Agent.h"
 #include "../adapters/PresetLoader.h"
+#include "../analytics/TimeSeriesHistory.h"
 
 /**
  * Test suite for MetricsPanel component with modern UI and charts.
@@ -35,7 +37,7 @@ private slots:
     
     // Basic tests
     void testMetricsPanelCreation();
-    void testSetSimulationController();
+    void testUpdateFromFrame();
     void testUpdateMetrics();
     void testMetricsLabelsExist();
     
@@ -43,6 +45,7 @@ private slots:
     void testChartDataCollection();
     void testChartHistoryLimit();
     void testChartRendering();
+    void testChartSeriesDownsampled();
     
     // UI component tests
     void testTitleLabel();
@@ -84,9 +87,13 @@ private slots:
     void testShareButton();
 
 private:
+    // Capture the controller's current tick and hand it to the panel
+    void showCurrentTick();
+
     QApplication* app;
     MetricsPanel* metricsPanel;
     SimulationController* controller;
+    SimulationFrame frame;
 };
 
 void TestMetricsPanel::initTestCase() {
@@ -100,6 +107,12 @@ void TestMetricsPanel::initTestCase() {
     }
 }
 
+void TestMetricsPanel::showCurrentTick() {
+    controller->captureFrame(frame);
+    ++frame.sequence;
+    metricsPanel->updateMetrics(frame);
+}
+
 void TestMetricsPanel::cleanupTestCase() {
     // Don't delete app if it was created by QTEST_MAIN
     // Only delete if we created it ourselves
@@ -125,6 +138,7 @@ void TestMetricsPanel::init() {
         testPreset.setPolicy(PolicyType::SHORTEST_PATH);
     }
     controller->loadPreset(testPreset);
+    frame = SimulationFrame();
 }
 
 void TestMetricsPanel::cleanup() {
@@ -146,17 +160,32 @@ void TestMetricsPanel::testMetricsPanelCreation() {
     QVERIFY(metricsPanel != nullptr);
 }
 
-void TestMetricsPanel::testSetSimulationController() {
-    metricsPanel->setSimulationController(controller);
-    // Should not crash
-    QVERIFY(true);
+void TestMetricsPanel::testUpdateFromFrame() {
+    showCurrentTick();
+    QCOMPARE(frame.tick, 0);
+    
+    // The stat cards show the frame's values
+    controller->start();
+    for (int i = 0; i < 5; ++i) {
+        controller->tick();
+        showCurrentTick();
+    }
+    controller->pause();
+    QCOMPARE(frame.tick, 5);
+    
+    bool foundCompleted = false;
+    for (QLabel* label : metricsPanel->findChildren<QLabel*>()) {
+        if (label->text() == QString::number(frame.arrivedAgents)) {
+            foundCompleted = true;
+            break;
+        }
+    }
+    QVERIFY(foundCompleted);
 }
 
 void TestMetricsPanel::testUpdateMetrics() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics
-    metricsPanel->updateMetrics();
+    showCurrentTick();
     
     // Should not crash
     QVERIFY(true);
@@ -165,7 +194,7 @@ void TestMetricsPanel::testUpdateMetrics() {
     controller->start();
     for (int i = 0; i < 5; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     controller->pause();
     
@@ -190,12 +219,10 @@ void TestMetricsPanel::testMetricsLabelsExist() {
 }
 
 void TestMetricsPanel::testChartDataCollection() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics multiple times to collect chart data
     for (int i = 0; i < 10; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Chart data should be collected
@@ -203,12 +230,10 @@ void TestMetricsPanel::testChartDataCollection() {
 }
 
 void TestMetricsPanel::testChartHistoryLimit() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update many times to test history limit
     for (int i = 0; i < 150; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Should not crash and should limit history
@@ -216,12 +241,10 @@ void TestMetricsPanel::testChartHistoryLimit() {
 }
 
 void TestMetricsPanel::testChartRendering() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics to generate chart data
     for (int i = 0; i < 20; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Trigger paint event
@@ -232,6 +255,48 @@ void TestMetricsPanel::testChartRendering() {
     QVERIFY(true);
 }
 
+void TestMetricsPanel::testChartSeriesDownsampled() {
+    // A long run: one frame per tick, far more ticks than the plot is wide
+    const int kTicks = 5000;
+    TimeSeriesHistory expected;
+    SimulationFrame longRun;
+    for (int tick = 1; tick <= kTicks; ++tick) {
+        longRun.tick = tick;
+        longRun.averageTravelTime = 10.0 + (tick % 97) * 0.5;
+        metricsPanel->updateMetrics(longRun);
+        expected.append(tick, longRun.averageTravelTime);
+    }
+    
+    QLineSeries* series = nullptr;
+    QChart* chart = nullptr;
+    for (QChartView* view : metricsPanel->findChildren<QChartView*>()) {
+        if (view->chart() && view->chart()->title() == "Trip Time") {
+            chart = view->chart();
+            series = qobject_cast<QLineSeries*>(chart->series().value(0));
+            break;
+        }
+    }
+    QVERIFY(series != nullptr);
+    
+    // The series holds the history decimated to the plot width, not every tick
+    int width = qMax(50, static_cast<int>(chart->plotArea().width()));
+    QVERIFY(series->count() > 0);
+    QVERIFY(series->count() <= width);
+    QVERIFY(series->count() < kTicks);
+    
+    auto points = expected.downsample(expected.firstX(), expected.lastX(), width);
+    QCOMPARE(series->count(), static_cast<int>(points.size()));
+    for (int i = 0; i < series->count(); ++i) {
+        QCOMPARE(series->at(i).x(), points[i].x);
+        QCOMPARE(series->at(i).y(), points[i].y);
+    }
+    
+    // Going back in time (a reset) starts the chart over
+    longRun.tick = 1;
+    metricsPanel->updateMetrics(longRun);
+    QCOMPARE(series->count(), 1);
+}
+
 void TestMetricsPanel::testTitleLabel() {
     QList<QLabel*> labels = metricsPanel->findChildren<QLabel*>();
     bool foundTitle = false;
@@ -317,14 +382,12 @@ void TestMetricsPanel::testSectionHeaders() {
 }
 
 void TestMetricsPanel::testMetricsUpdateDuringSimulation() {
-    metricsPanel->setSimulationController(controller);
-    
     controller->start();
     
     // Update metrics during active simulation
     for (int i = 0; i < 10; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
         QApplication::processEvents(); // Process UI events
     }
     
@@ -335,11 +398,9 @@ void TestMetricsPanel::testMetricsUpdateDuringSimulation() {
 }
 
 void TestMetricsPanel::testMultipleUpdates() {
-    metricsPanel->setSimulationController(controller);
-    
     // Rapid updates
     for (int i = 0; i < 50; ++i) {
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Should handle rapid updates without issues
@@ -347,9 +408,9 @@ void TestMetricsPanel::testMultipleUpdates() {
 }
 
 void TestMetricsPanel::testEmptyState() {
-    // Test with no controller
+    // Test with a frame from before any preset is loaded
     MetricsPanel* emptyPanel = new MetricsPanel();
-    emptyPanel->updateMetrics();
+    emptyPanel->updateMetrics(SimulationFrame());
     
     // Should handle empty state gracefully
     QVERIFY(true);
@@ -394,13 +455,11 @@ void TestMetricsPanel::testStatCardsExist() {
 }
 
 void TestMetricsPanel::testStatCardValues() {
-    metricsPanel->setSimulationController(controller);
-    
     // Run simulation to generate data
     controller->start();
     for (int i = 0; i < 10; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     controller->pause();
     
@@ -423,12 +482,10 @@ void TestMetricsPanel::testStatCardValues() {
 }
 
 void TestMetricsPanel::testStatCardTrends() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics multiple times to generate trends
     for (int i = 0; i < 20; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Trend indicators should be present
@@ -448,11 +505,9 @@ void TestMetricsPanel::testStatCardTrends() {
 }
 
 void TestMetricsPanel::testStatCardAnimations() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics to trigger animations
     controller->tick();
-    metricsPanel->updateMetrics();
+    showCurrentTick();
     
     QApplication::processEvents();
     
@@ -483,12 +538,10 @@ void TestMetricsPanel::testTripTimeChartExists() {
 }
 
 void TestMetricsPanel::testTripTimeChartData() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics to populate chart data
     for (int i = 0; i < 15; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Chart should have data
@@ -513,12 +566,10 @@ void TestMetricsPanel::testTripTimeChartData() {
 }
 
 void TestMetricsPanel::testTripTimeChartRendering() {
-    metricsPanel->setSimulationController(controller);
-    
     // Generate chart data
     for (int i = 0; i < 20; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Trigger rendering
@@ -555,12 +606,10 @@ void TestMetricsPanel::testThroughputChartExists() {
 }
 
 void TestMetricsPanel::testThroughputChartData() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics to populate bar chart data
     for (int i = 0; i < 30; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Chart should have data
@@ -584,12 +633,10 @@ void TestMetricsPanel::testThroughputChartData() {
 }
 
 void TestMetricsPanel::testThroughputChartRendering() {
-    metricsPanel->setSimulationController(controller);
-    
     // Generate chart data
     for (int i = 0; i < 30; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Trigger rendering
@@ -626,12 +673,10 @@ void TestMetricsPanel::testCongestionChartExists() {
 }
 
 void TestMetricsPanel::testCongestionChartData() {
-    metricsPanel->setSimulationController(controller);
-    
     // Update metrics to populate pie chart data
     for (int i = 0; i < 25; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Chart should have data
@@ -655,12 +700,10 @@ void TestMetricsPanel::testCongestionChartData() {
 }
 
 void TestMetricsPanel::testCongestionChartRendering() {
-    metricsPanel->setSimulationController(controller);
-    
     // Generate chart data
     for (int i = 0; i < 25; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Trigger rendering
@@ -690,19 +733,17 @@ void TestMetricsPanel::testComparisonTableExists() {
 }
 
 void TestMetricsPanel::testComparisonTableData() {
-    metricsPanel->setSimulationController(controller);
-    
     // Run simulation with different policies
     controller->setPolicy(PolicyType::SHORTEST_PATH);
     for (int i = 0; i < 10; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     controller->setPolicy(PolicyType::CONGESTION_AWARE);
     for (int i = 0; i < 10; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Table should have data
@@ -717,12 +758,10 @@ void TestMetricsPanel::testComparisonTableData() {
 }
 
 void TestMetricsPanel::testComparisonTableHighlighting() {
-    metricsPanel->setSimulationController(controller);
-    
     // Run simulation to populate comparison data
     for (int i = 0; i < 20; ++i) {
         controller->tick();
-        metricsPanel->updateMetrics();
+        showCurrentTick();
     }
     
     // Table should support highlighting (tested via existence)
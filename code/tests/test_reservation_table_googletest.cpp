@@ -0,0 +1,197 @@
+// code/tests/test_reservation_table_googletest.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../core/ReservationTable.h"
+#include "../core/RoutePlanner.h"
+#include "../core/City.h"
+#include "../core/Node.h"
+#include "../core/Edge.h"
+#include "../core/ShortestPathPolicy.h"
+#include "mocks/MockCity.h"
+
+/**
+ * Test Suite: reservation-based routing
+ * Tests the reservation ring, concurrent claims, and the space-time
+ * search around reserved capacity.
+ */
+
+namespace {
+    // Two routes 0 -> 2 of one-vehicle edges: via node 1 (edges 0, 1;
+    // length 2) and via node 3 (edges 2, 3; length 3)
+    std::unique_ptr<City> makeTwoRoutes() {
+        auto city = std::make_unique<City>();
+        for (NodeId n = 0; n < 4; ++n) {
+            city->addNode(Node(n, n, 0));
+        }
+        city->addEdge(Edge(0, 0, 1, 1.0, 1));
+        city->addEdge(Edge(1, 1, 2, 1.0, 1));
+        city->addEdge(Edge(2, 0, 3, 1.5, 1));
+        city->addEdge(Edge(3, 3, 2, 1.5, 1));
+        return city;
+    }
+
+    bool sameClaims(const std::vector<ReservationTable::Claim>& claims,
+                    const std::vector<std::pair<int, std::int64_t>>& expected) {
+        if (claims.size() != expected.size()) return false;
+        for (size_t i = 0; i < claims.size(); ++i) {
+            if (claims[i].edgeIndex != expected[i].first || claims[i].tick != expected[i].second) return false;
+        }
+        return true;
+    }
+}
+
+// Test 1: Slots fill to capacity inside the window and the ring reuses cleared ticks
+TEST(ReservationTableTest, ReservesWithinCapacityAndWindow) {
+    ReservationTable table(4, 5);
+    EXPECT_TRUE(table.covers(0));
+    EXPECT_TRUE(table.covers(4));
+    EXPECT_FALSE(table.covers(5));
+
+    EXPECT_TRUE(table.tryReserve(1, 2, 2));
+    EXPECT_TRUE(table.tryReserve(1, 2, 2));
+    EXPECT_FALSE(table.tryReserve(1, 2, 2));
+    EXPECT_EQ(table.reserved(1, 2), 2);
+    EXPECT_TRUE(table.tryReserve(1, 7, 0));     // Beyond the window: not stored
+    EXPECT_EQ(table.reserved(1, 7), 0);
+    table.release(1, 2);
+    EXPECT_EQ(table.reserved(1, 2), 1);
+    table.release(0, 0);                        // Empty slot stays empty
+    EXPECT_EQ(table.reserved(0, 0), 0);
+
+    // Ticks 0-2 leave the window; tick 7 lands in tick 2's cleared row
+    ASSERT_TRUE(table.tryReserve(3, 4, 1));
+    table.advance(3);
+    EXPECT_EQ(table.getBaseTick(), 3);
+    EXPECT_EQ(table.reserved(1, 2), 0);
+    EXPECT_EQ(table.reserved(1, 7), 0);
+    EXPECT_EQ(table.reserved(3, 4), 1);
+    EXPECT_TRUE(table.tryReserve(1, 7, 1));
+    EXPECT_EQ(table.reserved(1, 7), 1);
+
+    // Moving back clears everything
+    table.advance(0);
+    EXPECT_EQ(table.reserved(3, 4), 0);
+
+    // Routes are claimed whole or not at all
+    const std::vector<int> capacity = {1, 1, 1, 1};
+    const std::vector<int> empty = {0, 0, 0, 0};
+    ASSERT_TRUE(table.tryReserve(2, 1, 1));
+    std::vector<ReservationTable::Claim> route = {{0, 0}, {2, 1}};
+    EXPECT_FALSE(table.claimRoute(route, capacity, empty, 0));
+    EXPECT_EQ(table.reserved(0, 0), 0);
+    table.release(2, 1);
+    EXPECT_TRUE(table.claimRoute(route, capacity, empty, 0));
+    EXPECT_EQ(table.reserved(0, 0), 1);
+    table.releaseRoute(route);
+    EXPECT_EQ(table.reserved(2, 1), 0);
+
+    EXPECT_THROW(ReservationTable(4, 0), std::runtime_error);
+    EXPECT_THROW(ReservationTable(-1, 4), std::runtime_error);
+}
+
+// Test 2: Parallel routing threads never overbook a slot
+TEST(ReservationTableTest, ConcurrentReservationsNeverOverbook) {
+    constexpr int kEdges = 8;
+    constexpr int kSlots = 6;
+    constexpr int kCapacity = 3;
+    ReservationTable table(kEdges, kSlots);
+    std::atomic<int> granted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            for (int i = 0; i < 2000; ++i) {
+                int edge = static_cast<int>(rng() % kEdges);
+                int tick = static_cast<int>(rng() % kSlots);
+                if (table.tryReserve(edge, tick, kCapacity)) {
+                    granted.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    int total = 0;
+    for (int e = 0; e < kEdges; ++e) {
+        for (int tick = 0; tick < kSlots; ++tick) {
+            EXPECT_EQ(table.reserved(e, tick), kCapacity);   // 8000 tries fill all 48 slots
+            total += table.reserved(e, tick);
+        }
+    }
+    EXPECT_EQ(total, granted.load());
+}
+
+// Test 3: The space-time search waits or detours around full slots
+TEST(ReservationTableTest, SpaceTimeSearchAvoidsReservedCapacity) {
+    auto city = makeTwoRoutes();
+    ShortestPathPolicy shortest;
+    RoutePlanner planner(&shortest);
+    const std::vector<float> costs = {1.0f, 1.0f, 1.5f, 1.5f};
+    const std::deque<EdgeId> viaOne = {0, 1};
+    const std::deque<EdgeId> viaThree = {2, 3};
+    ReservationTable table(4, 10);
+    std::vector<ReservationTable::Claim> claims;
+
+    // Free network: edge 0 at tick 0, edge 1 two ticks later
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, table, 0, 1.0, &claims), viaOne);
+    EXPECT_TRUE(sameClaims(claims, {{0, 0}, {1, 2}}));
+
+    // Edge 1 is taken at tick 2: detour when waiting is dear, wait when it is cheap
+    ASSERT_TRUE(table.tryReserve(1, 2, 1));
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, table, 0, 2.0, &claims), viaThree);
+    EXPECT_TRUE(sameClaims(claims, {{2, 0}, {3, 2}}));
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, table, 0, 0.25, &claims), viaOne);
+    EXPECT_TRUE(sameClaims(claims, {{0, 0}, {1, 3}}));
+    table.release(1, 2);
+
+    // Vehicles already on an edge fill it at the departure tick only
+    city->setOccupancy(0, 1);
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, table, 0, 0.25, &claims), viaOne);
+    EXPECT_TRUE(sameClaims(claims, {{0, 1}, {1, 3}}));
+    city->setOccupancy(0, 0);
+
+    // Only ticks inside the window are claimed
+    ReservationTable shortWindow(4, 2);
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, shortWindow, 0, 1.0, &claims), viaOne);
+    EXPECT_TRUE(sameClaims(claims, {{0, 0}}));
+
+    EXPECT_THROW(planner.computePath(*city, 0, 2, costs, ReservationTable(1, 4), 0, 1.0), std::runtime_error);
+}
+
+// Test 4: Claims follow the search's admission rule on an occupied edge
+TEST(ReservationTableTest, ClaimsRespectOccupancyAtDeparture) {
+    auto city = makeTwoRoutes();
+    ShortestPathPolicy shortest;
+    RoutePlanner planner(&shortest);
+    const std::vector<float> costs = {1.0f, 1.0f, 1.5f, 1.5f};
+    const std::vector<int>& capacity = city->getTopology()->capacityData();
+    ReservationTable table(4, 10);
+    table.advance(5);
+
+    // Edge 0 is full now, so neither the search nor a claim may enter it at tick 5
+    city->setOccupancy(0, 1);
+    const std::vector<int>& occupancy = city->getState().occupancyData();
+    EXPECT_FALSE(table.hasRoom(0, 5, capacity[0], occupancy[0], 5));
+    EXPECT_TRUE(table.hasRoom(0, 6, capacity[0], occupancy[0], 5));
+
+    const std::vector<ReservationTable::Claim> enterNow = {{0, 5}, {1, 7}};
+    EXPECT_FALSE(table.claimRoute(enterNow, capacity, occupancy, 5));
+    EXPECT_EQ(table.reserved(0, 5), 0);
+    EXPECT_EQ(table.reserved(1, 7), 0);
+
+    // The search waits a tick instead, and its claims are accepted
+    std::vector<ReservationTable::Claim> claims;
+    EXPECT_EQ(planner.computePath(*city, 0, 2, costs, table, 5, 0.25, &claims), (std::deque<EdgeId>{0, 1}));
+    EXPECT_TRUE(sameClaims(claims, {{0, 6}, {1, 8}}));
+    EXPECT_TRUE(table.claimRoute(claims, capacity, occupancy, 5));
+    EXPECT_EQ(table.reserved(0, 6), 1);
+}
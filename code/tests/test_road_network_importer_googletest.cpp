@@ -0,0 +1,191 @@
+// code/tests/test_road_network_importer_googletest.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "../adapters/RoadNetworkImporter.h"
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../patterns/RealWorldGridFactory.h"
+
+/**
+ * Test Suite: Real road network import
+ * Tests CSV and GeoJSON parsing, intersection snapping, line splitting,
+ * one-way handling and the RealWorldGridFactory integration.
+ */
+
+class RoadNetworkImporterTest : public ::testing::Test {
+protected:
+    RoadNetworkImporter::Options planar() {
+        RoadNetworkImporter::Options options;
+        options.geographic = false;
+        options.snapTolerance = 0.01;
+        options.cellSize = 1.0;
+        return options;
+    }
+
+    // Looks up the edge from -> to, or nullptr
+    static const Edge* findEdge(const CityTopology& topology, NodeId from, NodeId to) {
+        for (EdgeId id : topology.outgoing(from)) {
+            const Edge& edge = topology.getEdge(id);
+            if (edge.getTo() == to) return &edge;
+        }
+        return nullptr;
+    }
+};
+
+// Test 1: CSV rows become two-way edges between snapped intersections
+TEST_F(RoadNetworkImporterTest, CsvBuildsTwoWayEdges) {
+    std::istringstream csv(
+        "from_x,from_y,to_x,to_y,capacity\n"
+        "0,0,3,4,12\n"
+        "3.001,4,3,10,\n"
+        "\n");
+    RoadNetworkImporter importer(planar());
+    auto topology = importer.importCsv(csv);
+
+    EXPECT_EQ(topology->getNodeCount(), 3);
+    EXPECT_EQ(topology->getEdgeCount(), 4);
+    EXPECT_EQ(importer.getStats().vertices, 3);
+
+    const Edge* first = findEdge(*topology, 0, 1);
+    ASSERT_NE(first, nullptr);
+    EXPECT_DOUBLE_EQ(first->getLength(), 5.0);
+    EXPECT_EQ(first->getCapacity(), 12);
+    ASSERT_NE(findEdge(*topology, 1, 0), nullptr);
+
+    const Edge* second = findEdge(*topology, 1, 2);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->getCapacity(), 10);  // Default
+}
+
+// Test 2: CSV one-way, explicit length and malformed rows
+TEST_F(RoadNetworkImporterTest, CsvOnewayAndErrors) {
+    std::istringstream csv(
+        "oneway,length,to_y,to_x,from_y,from_x\n"
+        "yes,7.5,0,1,0,0\n"
+        "-1,,1,1,0,1\n");
+    RoadNetworkImporter importer(planar());
+    auto topology = importer.importCsv(csv);
+
+    EXPECT_EQ(topology->getEdgeCount(), 2);
+    const Edge* forward = findEdge(*topology, 0, 1);
+    ASSERT_NE(forward, nullptr);
+    EXPECT_DOUBLE_EQ(forward->getLength(), 7.5);
+    EXPECT_EQ(findEdge(*topology, 1, 0), nullptr);
+    EXPECT_NE(findEdge(*topology, 2, 1), nullptr);  // Reversed one-way
+    EXPECT_EQ(findEdge(*topology, 1, 2), nullptr);
+
+    std::istringstream missingColumn("from_x,from_y,to_x\n0,0,1\n");
+    EXPECT_THROW(importer.importCsv(missingColumn), std::runtime_error);
+    std::istringstream badNumber("from_x,from_y,to_x,to_y\n0,zero,1,1\n");
+    EXPECT_THROW(importer.importCsv(badNumber), std::runtime_error);
+}
+
+// Test 3: GeoJSON lines split at shared vertices and keep shape length
+TEST_F(RoadNetworkImporterTest, GeoJsonSplitsAtIntersections) {
+    // A horizontal road through (2,0) crossed by a vertical road; (1,0) is
+    // a shape point only and must not become a node
+    std::istringstream geojson(R"({
+        "type": "FeatureCollection",
+        "features": [
+            {"type": "Feature", "properties": {"capacity": 20},
+             "geometry": {"type": "LineString", "coordinates": [[0, 0], [1, 0], [2, 0], [4, 0]]}},
+            {"type": "Feature",
+             "geometry": {"coordinates": [[2, -1, 5.0], [2, 0], [2, 3]], "type": "LineString"},
+             "properties": {"oneway": "yes", "name": "x"}},
+            {"type": "Feature", "geometry": {"type": "Point", "coordinates": [9, 9]}, "properties": null}
+        ]
+    })");
+    RoadNetworkImporter importer(planar());
+    auto topology = importer.importGeoJson(geojson);
+
+    // Nodes: (0,0), (2,0), (4,0), (2,-1), (2,3)
+    EXPECT_EQ(topology->getNodeCount(), 5);
+    EXPECT_EQ(importer.getStats().vertices, 6);
+    EXPECT_EQ(importer.getStats().skippedFeatures, 1);
+    // Horizontal: 2 segments x 2 directions; vertical one-way: 2 segments
+    EXPECT_EQ(topology->getEdgeCount(), 6);
+
+    const Edge* westSegment = findEdge(*topology, 0, 1);
+    ASSERT_NE(westSegment, nullptr);
+    EXPECT_DOUBLE_EQ(westSegment->getLength(), 2.0);
+    EXPECT_EQ(westSegment->getCapacity(), 20);
+
+    const Edge* up = findEdge(*topology, 3, 1);
+    ASSERT_NE(up, nullptr);
+    EXPECT_EQ(findEdge(*topology, 1, 3), nullptr);
+    ASSERT_NE(findEdge(*topology, 1, 4), nullptr);
+}
+
+// Test 4: MultiLineString and geographic lengths
+TEST_F(RoadNetworkImporterTest, GeoJsonGeographicMultiLine) {
+    // Two 0.001 degree steps of latitude (~110.6 m each) near London
+    std::istringstream geojson(R"({"type": "FeatureCollection", "features": [
+        {"type": "Feature", "properties": {},
+         "geometry": {"type": "MultiLineString",
+                      "coordinates": [[[-0.1, 51.5], [-0.1, 51.501]], [[-0.1, 51.501], [-0.1, 51.502]]]}}
+    ]})");
+    RoadNetworkImporter importer;
+    auto topology = importer.importGeoJson(geojson);
+
+    EXPECT_EQ(topology->getNodeCount(), 3);
+    EXPECT_EQ(topology->getEdgeCount(), 4);
+    EXPECT_NEAR(topology->getEdges()[0].getLength(), 110.574, 0.01);
+}
+
+// Test 5: Malformed GeoJSON is rejected
+TEST_F(RoadNetworkImporterTest, GeoJsonRejectsMalformed) {
+    RoadNetworkImporter importer(planar());
+    std::istringstream notObject("[1, 2]");
+    EXPECT_THROW(importer.importGeoJson(notObject), std::runtime_error);
+    std::istringstream shortPosition(R"({"features": [{"geometry": {"type": "LineString", "coordinates": [[0], [1, 1]]}}]})");
+    EXPECT_THROW(importer.importGeoJson(shortPosition), std::runtime_error);
+    std::istringstream truncated(R"({"features": [{"geometry": )");
+    EXPECT_THROW(importer.importGeoJson(truncated), std::runtime_error);
+}
+
+// Test 6: A large generated grid imports with dense ids and full dedupe
+TEST_F(RoadNetworkImporterTest, LargeCsvDeduplicates) {
+    const int side = 120;
+    std::ostringstream csv;
+    csv << "from_x,from_y,to_x,to_y\n";
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            if (c + 1 < side) csv << c << "," << r << "," << c + 1 << "," << r << "\n";
+            if (r + 1 < side) csv << c << "," << r << "," << c << "," << r + 1 << "\n";
+        }
+    }
+    std::istringstream in(csv.str());
+    RoadNetworkImporter importer(planar());
+    auto topology = importer.importCsv(in);
+
+    EXPECT_EQ(topology->getNodeCount(), side * side);
+    EXPECT_EQ(topology->getEdgeCount(), 4 * side * (side - 1));
+    EXPECT_EQ(topology->getEdges().back().getId(), topology->getEdgeCount() - 1);
+    EXPECT_EQ(topology->getNodes().back().getId(), topology->getNodeCount() - 1);
+}
+
+// Test 7: RealWorldGridFactory uses a loaded network
+TEST_F(RoadNetworkImporterTest, FactoryLoadsFile) {
+    std::string path = ::testing::TempDir() + "gridlock_road_network_test.csv";
+    {
+        std::ofstream out(path);
+        out << "from_x,from_y,to_x,to_y\n-0.1,51.5,-0.1,51.501\n-0.1,51.501,-0.099,51.501\n";
+    }
+
+    RealWorldGridFactory factory;
+    EXPECT_FALSE(factory.hasLoadedNetwork());
+    factory.loadFromFile(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(factory.hasLoadedNetwork());
+
+    auto first = factory.createGrid(5, 5);
+    auto second = factory.createGrid(5, 5);
+    EXPECT_EQ(first->getNodeCount(), 3);
+    EXPECT_EQ(first->getEdgeCount(), 4);
+    EXPECT_EQ(first->getTopology().get(), second->getTopology().get());
+
+    EXPECT_THROW(factory.loadFromFile("/nonexistent/roads.geojson"), std::runtime_error);
+}
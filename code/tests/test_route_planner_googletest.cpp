@@ -1,15 +1,20 @@
 // code/tests/test_route_planner_googletest.cpp
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <set>
 #include "../core/RoutePlanner.h"
+#include "../core/EdgeCostTable.h"
 #include "../core/City.h"
 #include "../core/Node.h"
 #include "../core/Edge.h"
 #include "../core/Agent.h"
 #include "../core/ShortestPathPolicy.h"
 #include "../core/CongestionAwarePolicy.h"
+#include "../core/RouteDiversityPolicy.h"
 #include "mocks/MockPolicy.h"
 #include "mocks/MockCity.h"
 
@@ -259,6 +264,261 @@ TEST_F(RoutePlannerTest, CongestionAwareAvoidsHighOccupancy) {
     // Congestion-aware should prefer less congested paths
 }
 
+// Test 16: Specialized search kernels match the virtual-dispatch fallback
+namespace {
+    // Subclass defeats the exact-type kernel match, forcing IRoutePolicy calls
+    class WrappedCongestionPolicy : public CongestionAwarePolicy {};
+}
+
+TEST_F(RoutePlannerTest, SpecializedKernelMatchesFallback) {
+    auto grid = TestCityBuilder::createSimpleGrid(8, 8);
+    for (int i = 0; i < grid->getEdgeCount(); ++i) {
+        grid->setOccupancy(grid->getEdgeIdByIndex(i), (i * 7) % 5);
+    }
+    WrappedCongestionPolicy wrapped;
+    RoutePlanner fast(congestionPolicy.get());
+    RoutePlanner fallback(&wrapped);
+
+    for (NodeId goal = 1; goal < 64; goal += 3) {
+        Agent agent(1, 0, goal);
+        EXPECT_EQ(fast.computePath(*grid, agent), fallback.computePath(*grid, agent)) << "goal " << goal;
+    }
+}
+
+// Test 17: Edits to the topology after a search are seen by the next one
+TEST_F(RoutePlannerTest, SeesTopologyEditsBetweenSearches) {
+    City line;
+    line.addNode(Node(0, 0, 0));
+    line.addNode(Node(1, 0, 1));
+    line.addNode(Node(2, 0, 2));
+    line.addEdge(Edge(0, 0, 1, 2.0, 10));
+    line.addEdge(Edge(1, 1, 2, 3.0, 10));
+    line.addEdge(Edge(2, 0, 2, 4.0, 10));
+
+    RoutePlanner planner(shortestPolicy.get());
+    Agent agent(1, 0, 2);
+    EXPECT_EQ(planner.computePath(line, agent), std::deque<EdgeId>({2}));
+
+    line.getEdge(2).setBlocked(true);
+    EXPECT_EQ(planner.computePath(line, agent), std::deque<EdgeId>({0, 1}));
+
+    line.setEdgeBlocked(0, true);
+    EXPECT_TRUE(planner.computePath(line, agent).empty());
+}
+
+// Test 18: Searches over a cost table match searches asking the policy
+TEST_F(RoutePlannerTest, CostTableMatchesPolicyCosts) {
+    auto grid = TestCityBuilder::createSimpleGrid(8, 8);
+    for (int i = 0; i < grid->getEdgeCount(); ++i) {
+        grid->setOccupancy(grid->getEdgeIdByIndex(i), (i * 3) % 4);
+    }
+    EdgeCostTable table;
+    table.rebuild(*grid, *congestionPolicy);
+    ASSERT_EQ(table.costs().size(), static_cast<size_t>(grid->getEdgeCount()));
+    for (int i = 0; i < grid->getEdgeCount(); ++i) {
+        EXPECT_FLOAT_EQ(table.costs()[i], congestionPolicy->edgeCost(*grid, grid->getEdgeIdByIndex(i)));
+    }
+
+    RoutePlanner planner(congestionPolicy.get());
+    for (NodeId goal = 5; goal < 64; goal += 7) {
+        Agent agent(1, 0, goal);
+        EXPECT_EQ(planner.computePath(*grid, 0, goal, table.costs()), planner.computePath(*grid, agent));
+    }
+
+    // Single-edge updates agree with a full rebuild
+    grid->setOccupancy(grid->getEdgeIdByIndex(3), 9);
+    table.update(*grid, *congestionPolicy, 3);
+    EdgeCostTable rebuilt;
+    rebuilt.rebuild(*grid, *congestionPolicy);
+    EXPECT_EQ(table.costs(), rebuilt.costs());
+
+    std::vector<float> tooShort(2, 1.0f);
+    EXPECT_THROW(planner.computePath(*grid, 0, 5, tooShort), std::runtime_error);
+}
+
+// Test 19: Batch cost evaluation agrees with edgeCost for every policy kind
+TEST_F(RoutePlannerTest, BatchCostsMatchScalarCosts) {
+    auto grid = TestCityBuilder::createSimpleGrid(7, 7);
+    std::vector<EdgeId> ids;
+    for (int i = 0; i < grid->getEdgeCount(); ++i) {
+        grid->setOccupancy(grid->getEdgeIdByIndex(i), i % 6);
+        ids.push_back(grid->getEdgeIdByIndex(i));
+    }
+    std::vector<EdgeId> someIds = {ids[5], ids[0], ids[17]};
+
+    testing::NiceMock<MockPolicy> mock;
+    ON_CALL(mock, edgeCost).WillByDefault([](const City& c, EdgeId id) { return c.edgeLength(id) * 2.0; });
+    const IRoutePolicy* policies[] = {shortestPolicy.get(), congestionPolicy.get(), &mock};
+
+    for (const IRoutePolicy* policy : policies) {
+        std::vector<float> all(ids.size());
+        policy->allEdgeCosts(*grid, all);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(all[i], static_cast<float>(policy->edgeCost(*grid, ids[i])));
+        }
+
+        std::vector<float> some(someIds.size());
+        policy->edgeCosts(*grid, someIds, some);
+        for (size_t i = 0; i < someIds.size(); ++i) {
+            EXPECT_EQ(some[i], static_cast<float>(policy->edgeCost(*grid, someIds[i])));
+        }
+
+        std::vector<float> tooShort(1);
+        EXPECT_THROW(policy->allEdgeCosts(*grid, tooShort), std::runtime_error);
+        EXPECT_THROW(policy->edgeCosts(*grid, someIds, tooShort), std::runtime_error);
+    }
+}
+
+// Test 20: Planned routes load the cost table and push later searches aside
+TEST_F(RoutePlannerTest, PlannedLoadSteersLaterSearches) {
+    auto grid = TestCityBuilder::createSimpleGrid(4, 4);
+    EdgeCostTable table;
+    table.addRoute(*grid, *congestionPolicy, {grid->getEdgeIdByIndex(0)});  // Not built: ignored
+    table.rebuild(*grid, *congestionPolicy);
+
+    RoutePlanner planner(congestionPolicy.get());
+    const std::deque<EdgeId> first = planner.computePath(*grid, 0, 15, table.costs());
+    ASSERT_FALSE(first.empty());
+    for (int i = 0; i < 3; ++i) {
+        table.addRoute(*grid, *congestionPolicy, first);
+    }
+
+    // Planned vehicles cost what the same occupancy would
+    const int index = grid->getTopology()->edgeIndex(first.front());
+    EXPECT_EQ(table.plannedLoad(index), 3);
+    const double loaded = congestionPolicy->loadedEdgeCost(*grid, first.front(), 3);
+    EXPECT_FLOAT_EQ(table.costs()[index], loaded);
+    EXPECT_DOUBLE_EQ(loaded, congestionPolicy->cost(grid->edgeLength(first.front()),
+                                                    grid->edgeCapacity(first.front()), 3));
+
+    // The next search avoids the loaded route; updates keep the load
+    EXPECT_NE(planner.computePath(*grid, 0, 15, table.costs()), first);
+    table.update(*grid, *congestionPolicy, index);
+    EXPECT_FLOAT_EQ(table.costs()[index], loaded);
+
+    // A planned vehicle entering the edge turns into occupancy, not extra load
+    grid->incrementOccupancy(first.front());
+    table.removePlanned(*grid, *congestionPolicy, index);
+    EXPECT_EQ(table.plannedLoad(index), 2);
+    EXPECT_FLOAT_EQ(table.costs()[index], loaded);
+    grid->decrementOccupancy(first.front());
+    table.update(*grid, *congestionPolicy, index);
+    table.addRoute(*grid, *congestionPolicy, {first.front()});
+
+    // Load-blind policies fall back to edgeCost; clearing or rebuilding drops the load
+    EXPECT_DOUBLE_EQ(shortestPolicy->loadedEdgeCost(*grid, first.front(), 5),
+                     shortestPolicy->edgeCost(*grid, first.front()));
+    EXPECT_EQ(table.clearPlanned(*grid, *congestionPolicy), static_cast<int>(first.size()));
+    EXPECT_EQ(table.plannedLoad(index), 0);
+    EXPECT_FLOAT_EQ(table.costs()[index], congestionPolicy->edgeCost(*grid, first.front()));
+    table.addRoute(*grid, *congestionPolicy, first);
+    table.rebuild(*grid, *congestionPolicy);
+    EXPECT_EQ(table.plannedLoad(index), 0);
+}
+
+// Test 21: Alternative paths are the k cheapest loopless routes, in order
+TEST_F(RoutePlannerTest, AlternativePathsAreCheapestLooplessRoutes) {
+    const int edges = city->getEdgeCount();
+    std::vector<float> costs(edges);
+    for (int e = 0; e < edges; ++e) {
+        costs[e] = 1.0f + 0.25f * static_cast<float>(e % 3);
+    }
+    city->getState().setBlocked(4, true);
+
+    // Every loopless route 0 -> 8 by brute force
+    std::vector<double> allCosts;
+    std::vector<bool> onPath(9, false);
+    std::function<void(NodeId, double)> walk = [&](NodeId node, double cost) {
+        if (node == 8) {
+            allCosts.push_back(cost);
+            return;
+        }
+        onPath[node] = true;
+        for (EdgeId id : city->outgoingEdges(node)) {
+            const int e = city->getTopology()->edgeIndex(id);
+            const NodeId next = city->getEdge(id).getTo();
+            if (!city->getState().isBlocked(e) && !onPath[next]) {
+                walk(next, cost + costs[e]);
+            }
+        }
+        onPath[node] = false;
+    };
+    walk(0, 0.0);
+    std::sort(allCosts.begin(), allCosts.end());
+    ASSERT_GT(allCosts.size(), 6u);
+
+    RoutePlanner planner(shortestPolicy.get());
+    auto routes = planner.alternativePaths(*city, 0, 8, costs, 6);
+    ASSERT_EQ(routes.size(), 6u);
+    std::set<std::deque<EdgeId>> distinct;
+    for (size_t i = 0; i < routes.size(); ++i) {
+        EXPECT_NEAR(routes[i].cost, allCosts[i], 1e-9) << i;
+        // Connected, loopless, open edges only, and priced as reported
+        NodeId node = 0;
+        std::set<NodeId> seen = {0};
+        double cost = 0.0;
+        for (EdgeId id : routes[i].path) {
+            const Edge& edge = city->getEdge(id);
+            EXPECT_EQ(edge.getFrom(), node);
+            EXPECT_FALSE(city->getState().isBlocked(city->getTopology()->edgeIndex(id)));
+            node = edge.getTo();
+            EXPECT_TRUE(seen.insert(node).second) << "route " << i << " revisits " << node;
+            cost += costs[city->getTopology()->edgeIndex(id)];
+        }
+        EXPECT_EQ(node, 8);
+        EXPECT_NEAR(cost, routes[i].cost, 1e-9);
+        distinct.insert(routes[i].path);
+    }
+    EXPECT_EQ(distinct.size(), routes.size());
+    EXPECT_EQ(routes.front().path, planner.computePath(*city, 0, 8, costs));
+
+    // Asking for more than exist returns them all
+    EXPECT_EQ(planner.alternativePaths(*city, 0, 8, costs, 100).size(), allCosts.size());
+    EXPECT_TRUE(planner.alternativePaths(*city, 4, 4, costs, 3).empty());
+    EXPECT_THROW(planner.alternativePaths(*city, 0, 8, costs, 0), std::runtime_error);
+    EXPECT_THROW(planner.alternativePaths(*city, 0, 8, std::vector<float>(1, 1.0f), 3), std::runtime_error);
+}
+
+// Test 22: The route diversity policy deals equal trips over near-shortest routes
+TEST_F(RoutePlannerTest, RouteDiversityDealsAcceptableRoutes) {
+    RouteDiversityPolicy diversity(3, 1.5);
+    EXPECT_THROW(RouteDiversityPolicy(0, 1.5), std::runtime_error);
+    EXPECT_THROW(RouteDiversityPolicy(3, 0.9), std::runtime_error);
+
+    // Routes costing 4, 5 and 7: only the first two are within 1.5x
+    const std::vector<double> routeCosts = {4.0, 5.0, 7.0};
+    std::vector<int> dealt(3, 0);
+    for (int id = 0; id < 10; ++id) {
+        ++dealt[diversity.chooseRoute(Agent(id, 0, 8), routeCosts)];
+    }
+    EXPECT_EQ(dealt, (std::vector<int>{5, 5, 0}));
+    EXPECT_EQ(diversity.chooseRoute(Agent(7, 0, 8), {}), 0u);
+
+    // The planner honours the policy's hooks: equal trips get different
+    // shortest routes, with or without an external cost array
+    RoutePlanner planner(&diversity);
+    std::vector<float> lengths(city->getEdgeCount());
+    diversity.allEdgeCosts(*city, lengths);
+    Agent first(0, 0, 8);
+    Agent second(1, 0, 8);
+    const std::deque<EdgeId> firstRoute = planner.computePath(*city, first);
+    const std::deque<EdgeId> secondRoute = planner.computePath(*city, second);
+    EXPECT_EQ(firstRoute.size(), 4u);
+    EXPECT_EQ(secondRoute.size(), 4u);
+    EXPECT_NE(firstRoute, secondRoute);
+    EXPECT_EQ(planner.computePath(*city, second, lengths), secondRoute);
+
+    // Policies without alternatives route every trip the cheapest way
+    EXPECT_EQ(shortestPolicy->alternativeCount(), 1);
+    EXPECT_EQ(shortestPolicy->chooseRoute(first, routeCosts), 0u);
+    RoutePlanner shortest(shortestPolicy.get());
+    EXPECT_EQ(shortest.computePath(*city, second, lengths), shortest.computePath(*city, 0, 8, lengths));
+
+    // Edge costs are lengths
+    EXPECT_DOUBLE_EQ(diversity.edgeCost(*city, city->getEdgeIdByIndex(0)),
+                     shortestPolicy->edgeCost(*city, city->getEdgeIdByIndex(0)));
+}
+
 // Parameterized test for different grid sizes
 class RoutePlannerParameterizedTest : public ::testing::TestWithParam<std::pair<int, int>> {};
 
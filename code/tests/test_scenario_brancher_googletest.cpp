@@ -0,0 +1,151 @@
+// code/tests/test_scenario_brancher_googletest.cpp
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../core/ScenarioBrancher.h"
+#include "../core/SimulationController.h"
+#include "../core/City.h"
+#include "../core/Agent.h"
+#include "../core/Metrics.h"
+#include "../core/Preset.h"
+
+/**
+ * Test Suite: What-if branching
+ * Tests forking isolation, interventions (including reopening preset
+ * closures) and parallel determinism.
+ */
+
+class ScenarioBrancherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Preset preset;
+        preset.setName("branching");
+        preset.setRows(8);
+        preset.setCols(8);
+        preset.setAgentCount(60);
+        preset.setTickMs(100);
+        preset.setPolicy(PolicyType::SHORTEST_PATH);
+        controller = std::make_unique<SimulationController>();
+        controller->loadPreset(preset);
+        for (int i = 0; i < 5; ++i) controller->tick();
+    }
+
+    std::unique_ptr<SimulationController> controller;
+};
+
+// Test 1: Branching leaves the source run untouched
+TEST_F(ScenarioBrancherTest, SourceIsUntouched) {
+    City* city = controller->getCity();
+    std::vector<int> before;
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        before.push_back(city->occupancy(city->getEdgeIdByIndex(i)));
+    }
+
+    ScenarioBrancher brancher(*controller);
+    ScenarioBrancher::Intervention closeAll{"close", {}, {}, PolicyType::CONGESTION_AWARE};
+    for (int i = 0; i < 10; ++i) closeAll.closeEdges.push_back(city->getEdgeIdByIndex(i));
+    brancher.run({closeAll}, 20);
+
+    std::vector<int> after;
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        after.push_back(city->occupancy(city->getEdgeIdByIndex(i)));
+        EXPECT_FALSE(city->isEdgeBlocked(city->getEdgeIdByIndex(i)));
+    }
+    EXPECT_EQ(before, after);
+    EXPECT_EQ(controller->getMetrics()->getCurrentTick(), 5);
+    EXPECT_EQ(controller->getPolicy(), PolicyType::SHORTEST_PATH);
+}
+
+// Test 2: An empty intervention reproduces the source run
+TEST_F(ScenarioBrancherTest, BaselineBranchMatchesSource) {
+    ScenarioBrancher brancher(*controller);
+    auto results = brancher.run({{"baseline", {}, {}, std::nullopt}}, 15);
+
+    for (int i = 0; i < 15; ++i) controller->tick();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].name, "baseline");
+    EXPECT_EQ(results[0].metrics.getCurrentTick(), controller->getMetrics()->getCurrentTick());
+    EXPECT_EQ(results[0].totalThroughput, controller->getMetrics()->totalThroughput());
+    EXPECT_DOUBLE_EQ(results[0].averageTripTime, controller->getMetrics()->averageTripTime());
+}
+
+// Test 3: Branches share the topology and keep closures private
+TEST_F(ScenarioBrancherTest, BranchesShareTopology) {
+    ScenarioBrancher brancher(*controller);
+    EdgeId closed = controller->getCity()->getEdgeIdByIndex(0);
+    auto branch = brancher.createBranch({"close", {closed}, {}, std::nullopt});
+
+    EXPECT_EQ(branch->getCity()->getTopology().get(), controller->getCity()->getTopology().get());
+    EXPECT_TRUE(branch->getCity()->isEdgeBlocked(closed));
+    EXPECT_FALSE(controller->getCity()->isEdgeBlocked(closed));
+    EXPECT_EQ(brancher.getForkTick(), 5);
+}
+
+// Test 4: Policy switch applies to the branch only
+TEST_F(ScenarioBrancherTest, PolicySwitchPerBranch) {
+    ScenarioBrancher brancher(*controller);
+    auto branch = brancher.createBranch({"aware", {}, {}, PolicyType::CONGESTION_AWARE});
+    EXPECT_EQ(branch->getPolicy(), PolicyType::CONGESTION_AWARE);
+    EXPECT_EQ(controller->getPolicy(), PolicyType::SHORTEST_PATH);
+}
+
+// Test 5: Parallel results match serial results
+TEST_F(ScenarioBrancherTest, ParallelMatchesSerial) {
+    City* city = controller->getCity();
+    std::vector<ScenarioBrancher::Intervention> interventions;
+    interventions.push_back({"baseline", {}, {}, std::nullopt});
+    interventions.push_back({"aware", {}, {}, PolicyType::CONGESTION_AWARE});
+    for (int i = 0; i < 6; ++i) {
+        interventions.push_back({"close" + std::to_string(i),
+                                 {city->getEdgeIdByIndex(i * 7)}, {}, std::nullopt});
+    }
+
+    ScenarioBrancher brancher(*controller);
+    auto serial = brancher.run(interventions, 25, 1);
+    auto parallel = brancher.run(interventions, 25, 4);
+
+    ASSERT_EQ(serial.size(), interventions.size());
+    ASSERT_EQ(parallel.size(), interventions.size());
+    for (size_t i = 0; i < serial.size(); ++i) {
+        EXPECT_EQ(serial[i].name, interventions[i].name);
+        EXPECT_EQ(parallel[i].name, serial[i].name);
+        EXPECT_EQ(parallel[i].totalThroughput, serial[i].totalThroughput);
+        EXPECT_EQ(parallel[i].activeAgents, serial[i].activeAgents);
+        EXPECT_DOUBLE_EQ(parallel[i].averageTripTime, serial[i].averageTripTime);
+    }
+}
+
+// Test 6: Reopening a preset closure lets the branch route across it
+TEST_F(ScenarioBrancherTest, ReopensPresetClosure) {
+    // A single road 0 - 1 - 2, closed between 0 and 1 by the preset
+    Preset line;
+    line.setName("closed-line");
+    line.setRows(1);
+    line.setCols(3);
+    line.setAgentRoutes({{0, 2}});
+    line.setBlockedEdges({{0, 1}});
+    SimulationController source;
+    source.loadPreset(line);
+    source.tick();
+
+    City* sourceCity = source.getCity();
+    EdgeId closed = -1;
+    for (EdgeId edgeId : sourceCity->outgoingEdges(0)) {
+        if (sourceCity->getEdge(edgeId).getTo() == 1) closed = edgeId;
+    }
+    ASSERT_NE(closed, -1);
+    ASSERT_TRUE(sourceCity->isEdgeBlocked(closed));
+
+    ScenarioBrancher brancher(source);
+    auto branch = brancher.createBranch({"reopen", {}, {closed}, std::nullopt});
+    EXPECT_FALSE(branch->getCity()->isEdgeBlocked(closed));
+    EXPECT_NE(branch->getCity()->getTopology().get(), sourceCity->getTopology().get());
+    EXPECT_TRUE(sourceCity->isEdgeBlocked(closed));
+
+    for (int i = 0; i < 12; ++i) {
+        branch->tick();
+        source.tick();
+    }
+    EXPECT_EQ(branch->getMetrics()->totalThroughput(), 1);
+    EXPECT_EQ(source.getMetrics()->totalThroughput(), 0);
+}
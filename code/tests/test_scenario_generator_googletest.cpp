@@ -0,0 +1,207 @@
+// code/tests/test_scenario_generator_googletest.cpp
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../adapters/CompiledCity.h"
+#include "../adapters/PresetLoader.h"
+#include "../core/Agent.h"
+#include "../core/City.h"
+#include "../core/CityTopology.h"
+#include "../core/Preset.h"
+#include "../patterns/RegularGridFactory.h"
+#include "../patterns/ScenarioGenerator.h"
+
+/**
+ * Test Suite: Synthetic scenario generation
+ * Tests determinism, OD distributions, blocked-road ratios, the preset and
+ * compiled-city writers, and stress-scale grid construction.
+ */
+
+class ScenarioGeneratorTest : public ::testing::Test {
+protected:
+    static ScenarioGenerator::Config smallConfig() {
+        ScenarioGenerator::Config config;
+        config.name = "stress";
+        config.rows = 40;
+        config.cols = 30;
+        config.agentCount = 5000;
+        return config;
+    }
+
+    static int countBlocked(const City& city) {
+        int blocked = 0;
+        for (const Edge& edge : city.getTopology()->getEdges()) {
+            if (edge.isBlocked()) ++blocked;
+        }
+        return blocked;
+    }
+};
+
+// Test 1: Same config gives the same scenario; blocked roads do not shift routes
+TEST_F(ScenarioGeneratorTest, DeterministicPerSeed) {
+    auto config = smallConfig();
+    config.blockedRatio = 0.1;
+    ScenarioGenerator first(config);
+    ScenarioGenerator second(config);
+    EXPECT_EQ(first.generateAgentRoutes(), second.generateAgentRoutes());
+    EXPECT_EQ(first.generateBlockedEdges(), second.generateBlockedEdges());
+
+    config.blockedRatio = 0.3;
+    EXPECT_EQ(ScenarioGenerator(config).generateAgentRoutes(), first.generateAgentRoutes());
+
+    config.seed = 7;
+    EXPECT_NE(ScenarioGenerator(config).generateAgentRoutes(), first.generateAgentRoutes());
+}
+
+// Test 2: Preset carries the generated routes and passes validation
+TEST_F(ScenarioGeneratorTest, PresetIsValid) {
+    auto config = smallConfig();
+    config.distribution = ScenarioGenerator::OdDistribution::CLUSTERED;
+    config.blockedRatio = 0.05;
+    config.policy = PolicyType::CONGESTION_AWARE;
+    Preset preset = ScenarioGenerator(config).generatePreset();
+
+    EXPECT_TRUE(preset.validate());
+    EXPECT_EQ(preset.getName(), "stress");
+    EXPECT_EQ(preset.getAgentCount(), 5000);
+    ASSERT_EQ(preset.getAgentRoutes().size(), 5000u);
+    EXPECT_EQ(preset.getPolicy(), PolicyType::CONGESTION_AWARE);
+    for (const auto& route : preset.getAgentRoutes()) {
+        EXPECT_NE(route.first, route.second);
+    }
+}
+
+// Test 3: Clustered and commuter distributions concentrate endpoints
+TEST_F(ScenarioGeneratorTest, DistributionsConcentrate) {
+    auto config = smallConfig();
+    config.rows = 101;
+    config.cols = 101;
+    config.clusterSpread = 0.02;
+
+    // Commuter: destinations within a few spreads of the centre node
+    config.distribution = ScenarioGenerator::OdDistribution::COMMUTER;
+    int nearCentre = 0;
+    for (const auto& route : ScenarioGenerator(config).generateAgentRoutes()) {
+        int row = route.second / config.cols;
+        int col = route.second % config.cols;
+        if (std::abs(row - 50) <= 8 && std::abs(col - 50) <= 8) ++nearCentre;
+    }
+    EXPECT_GT(nearCentre, 4900);
+
+    // Clustered: endpoints fall on far fewer distinct nodes than uniform
+    auto distinctOrigins = [&](ScenarioGenerator::OdDistribution distribution) {
+        config.distribution = distribution;
+        config.clusterCount = 3;
+        std::vector<bool> seen(static_cast<size_t>(config.rows * config.cols));
+        int distinct = 0;
+        for (const auto& route : ScenarioGenerator(config).generateAgentRoutes()) {
+            if (!seen[route.first]) {
+                seen[route.first] = true;
+                ++distinct;
+            }
+        }
+        return distinct;
+    };
+    EXPECT_LT(distinctOrigins(ScenarioGenerator::OdDistribution::CLUSTERED),
+              distinctOrigins(ScenarioGenerator::OdDistribution::UNIFORM) / 3);
+}
+
+// Test 4: Blocked ratio is honoured for presets and factory-built cities
+TEST_F(ScenarioGeneratorTest, BlockedRatio) {
+    auto config = smallConfig();
+    config.blockedRatio = 0.25;
+    ScenarioGenerator generator(config);
+
+    const int roads = 40 * 29 + 39 * 30;
+    auto blocked = generator.generateBlockedEdges();
+    EXPECT_NEAR(static_cast<double>(blocked.size()) / roads, 0.25, 0.04);
+    for (const auto& pair : blocked) {
+        int delta = pair.second - pair.first;
+        EXPECT_TRUE(delta == 1 || delta == config.cols);
+    }
+
+    RegularGridFactory factory;
+    auto city = generator.generateCity(factory);
+    int closedEdges = countBlocked(*city);
+    EXPECT_EQ(closedEdges % 2, 0);  // Both directions close together
+    EXPECT_NEAR(static_cast<double>(closedEdges) / (2 * roads), 0.25, 0.04);
+
+    config.blockedRatio = 0.0;
+    EXPECT_TRUE(ScenarioGenerator(config).generateBlockedEdges().empty());
+}
+
+// Test 5: Written preset and compiled city load back unchanged
+TEST_F(ScenarioGeneratorTest, WritersRoundTrip) {
+    auto config = smallConfig();
+    config.name = "round \"trip\"";
+    config.blockedRatio = 0.1;
+    ScenarioGenerator generator(config);
+    std::string jsonPath = ::testing::TempDir() + "gridlock_scenario_test.json";
+    std::string cityPath = ::testing::TempDir() + "gridlock_scenario_test.glcity";
+    generator.writePreset(jsonPath);
+    generator.writeCompiledCity(cityPath);
+
+    PresetLoader loader;
+    Preset expected = generator.generatePreset();
+    Preset loaded = loader.loadFromJson(jsonPath);
+    EXPECT_EQ(loaded.getName(), expected.getName());
+    EXPECT_EQ(loaded.getRows(), 40);
+    EXPECT_EQ(loaded.getCols(), 30);
+    EXPECT_EQ(loaded.getAgentCount(), 5000);
+    EXPECT_EQ(loaded.getBlockedEdges(), expected.getBlockedEdges());
+    EXPECT_EQ(loaded.getAgentRoutes(), expected.getAgentRoutes());
+
+    auto city = loader.buildCity(loaded);
+    CompiledCity compiled(cityPath);
+    auto topology = compiled.createTopology();
+    EXPECT_EQ(topology->fingerprint(), city->getTopology()->fingerprint());
+    EXPECT_EQ(countBlocked(*city), 2 * static_cast<int>(expected.getBlockedEdges().size()));
+
+    auto agents = loader.spawnAgents(loaded, *city);
+    ASSERT_EQ(agents.size(), 5000u);
+    EXPECT_EQ(agents[0]->getOrigin(), expected.getAgentRoutes()[0].first);
+
+    std::remove(jsonPath.c_str());
+    std::remove(cityPath.c_str());
+}
+
+// Test 6: Out-of-range configurations are rejected
+TEST_F(ScenarioGeneratorTest, RejectsInvalidConfig) {
+    auto config = smallConfig();
+    config.rows = Preset::kMaxGridDimension + 1;
+    EXPECT_THROW(ScenarioGenerator(config).generatePreset(), std::runtime_error);
+
+    config = smallConfig();
+    config.agentCount = Preset::kMaxAgentCount + 1;
+    EXPECT_THROW(ScenarioGenerator(config).generateAgentRoutes(), std::runtime_error);
+
+    config = smallConfig();
+    config.blockedRatio = 1.5;
+    EXPECT_THROW(ScenarioGenerator(config).generateBlockedEdges(), std::runtime_error);
+
+    config = smallConfig();
+    config.distribution = ScenarioGenerator::OdDistribution::CLUSTERED;
+    config.clusterCount = 0;
+    EXPECT_THROW(ScenarioGenerator(config).generateAgentRoutes(), std::runtime_error);
+}
+
+// Test 7: Stress scale - 1000x1000 grid with a million agents
+TEST_F(ScenarioGeneratorTest, MaximumScale) {
+    ScenarioGenerator::Config config;
+    config.rows = Preset::kMaxGridDimension;
+    config.cols = Preset::kMaxGridDimension;
+    config.agentCount = Preset::kMaxAgentCount;
+    config.distribution = ScenarioGenerator::OdDistribution::COMMUTER;
+    config.blockedRatio = 0.02;
+    Preset preset = ScenarioGenerator(config).generatePreset();
+    EXPECT_EQ(preset.getAgentRoutes().size(), static_cast<size_t>(Preset::kMaxAgentCount));
+
+    PresetLoader loader;
+    auto city = loader.buildCity(preset);
+    EXPECT_EQ(city->getNodeCount(), 1000 * 1000);
+    EXPECT_EQ(city->getEdgeCount(), 4 * 1000 * 999);
+    EXPECT_EQ(countBlocked(*city), 2 * static_cast<int>(preset.getBlockedEdges().size()));
+}
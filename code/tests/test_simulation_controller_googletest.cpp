@@ -1,10 +1,15 @@
 // code/tests/test_simulation_controller_googletest.cpp
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <map>
 #include <memory>
+#include <set>
+#include <stdexcept>
 #include "../core/SimulationController.h"
 #include "../core/Preset.h"
 #include "../core/Metrics.h"
+#include "../core/Agent.h"
+#include "../core/City.h"
 #include "mocks/MockCity.h"
 
 /**
@@ -188,6 +193,178 @@ TEST_F(SimulationControllerTest, LargePresetHandling) {
     EXPECT_EQ(controller->getAgents().size(), 50);
 }
 
+// Test 13: Wave routing gives every waiting agent a route in the first tick
+TEST_F(SimulationControllerTest, RouteWaves) {
+    EXPECT_EQ(controller->getRouteWaves(), 1);
+    EXPECT_THROW(controller->setRouteWaves(0), std::runtime_error);
+
+    Preset preset;
+    preset.setName("waves");
+    preset.setRows(6);
+    preset.setCols(6);
+    preset.setAgentCount(40);
+    preset.setTickMs(100);
+    preset.setPolicy(PolicyType::SYSTEM_OPTIMAL);
+    controller->loadPreset(preset);
+    controller->setRouteWaves(4);
+    EXPECT_EQ(controller->getRouteWaves(), 4);
+
+    controller->tick();
+    for (Agent* agent : controller->getAgents()) {
+        EXPECT_TRUE(agent->hasArrived() || agent->getCurrentEdge().has_value() || !agent->getPath().empty());
+    }
+    for (int i = 0; i < 200; ++i) {
+        controller->tick();
+    }
+    EXPECT_GT(controller->getMetrics()->totalThroughput(), 0);
+}
+
+// Test 14: Time-dependent routing predicts from recorded occupancy and
+// still brings agents home
+TEST_F(SimulationControllerTest, TimeDependentRouting) {
+    EXPECT_EQ(controller->getTimeDependentHorizon(), 0);
+    EXPECT_THROW(controller->setTimeDependentRouting(-1), std::runtime_error);
+
+    Preset preset;
+    preset.setName("predicted");
+    preset.setRows(5);
+    preset.setCols(5);
+    preset.setAgentCount(30);
+    preset.setTickMs(100);
+    preset.setPolicy(PolicyType::CONGESTION_AWARE);
+    controller->loadPreset(preset);
+    controller->setTimeDependentRouting(12);
+    EXPECT_EQ(controller->getTimeDependentHorizon(), 12);
+
+    for (int i = 0; i < 200; ++i) {
+        controller->tick();
+    }
+    EXPECT_GT(controller->getMetrics()->totalThroughput(), 0);
+
+    controller->setTimeDependentRouting(0);
+    EXPECT_NO_THROW(controller->tick());
+}
+
+// Test 15: Route diversity sends equal trips down different routes
+TEST_F(SimulationControllerTest, RouteDiversitySpreadsEqualTrips) {
+    auto distinctRoutes = [this](PolicyType policy) {
+        Preset preset;
+        preset.setName("diverse");
+        preset.setRows(5);
+        preset.setCols(5);
+        preset.setTickMs(100);
+        preset.setPolicy(policy);
+        preset.setAgentRoutes(std::vector<std::pair<NodeId, NodeId>>(8, {0, 24}));
+        controller->loadPreset(preset);
+        controller->tick();
+        std::set<std::deque<EdgeId>> routes;
+        for (Agent* agent : controller->getAgents()) {
+            std::deque<EdgeId> route = agent->getPath();
+            if (agent->getCurrentEdge()) {
+                route.push_front(*agent->getCurrentEdge());
+            }
+            routes.insert(route);
+        }
+        return routes.size();
+    };
+
+    EXPECT_EQ(distinctRoutes(PolicyType::SHORTEST_PATH), 1u);
+    EXPECT_GT(distinctRoutes(PolicyType::ROUTE_DIVERSITY), 1u);
+    for (int i = 0; i < 100; ++i) {
+        controller->tick();
+    }
+    EXPECT_EQ(controller->getMetrics()->totalThroughput(), 8);
+}
+
+// Test 16: Reservation-based routing claims capacity ahead and still brings agents home
+TEST_F(SimulationControllerTest, ReservationRouting) {
+    EXPECT_EQ(controller->getReservationHorizon(), 0);
+    EXPECT_THROW(controller->setReservationRouting(-1), std::runtime_error);
+
+    Preset preset;
+    preset.setName("reserved");
+    preset.setRows(5);
+    preset.setCols(5);
+    preset.setTickMs(100);
+    preset.setPolicy(PolicyType::SHORTEST_PATH);
+    preset.setAgentRoutes(std::vector<std::pair<NodeId, NodeId>>(12, {0, 24}));
+    controller->loadPreset(preset);
+    controller->setReservationRouting(16);
+    EXPECT_EQ(controller->getReservationHorizon(), 16);
+
+    for (int i = 0; i < 200; ++i) {
+        controller->tick();
+    }
+    EXPECT_EQ(controller->getMetrics()->totalThroughput(), 12);
+
+    controller->reset();
+    controller->setReservationRouting(0);
+    EXPECT_NO_THROW(controller->tick());
+}
+
+// Test 17: At a shared bottleneck reserved agents keep to their schedule:
+// they hold at a node with room ahead, or detour, where unreserved ones queue
+TEST_F(SimulationControllerTest, ReservationsWaitOrDetourAtBottleneck) {
+    struct Outcome {
+        int holds = 0;          // Ticks spent at a node whose next edge had room
+        size_t routes = 0;      // Distinct routes driven
+        int throughput = 0;
+    };
+    auto run = [this](int horizon) {
+        // Every trip crosses the top row of a 3 x 3 grid (capacity 2);
+        // the detour through the rows below is twice as long
+        Preset preset;
+        preset.setName("bottleneck");
+        preset.setRows(3);
+        preset.setCols(3);
+        preset.setTickMs(100);
+        preset.setPolicy(PolicyType::SHORTEST_PATH);
+        preset.setAgentRoutes(std::vector<std::pair<NodeId, NodeId>>(12, {0, 2}));
+        controller->loadPreset(preset);
+        controller->setReservationRouting(horizon);
+        City* city = controller->getCity();
+
+        Outcome outcome;
+        std::map<int, std::vector<EdgeId>> driven;
+        for (int i = 0; i < 100; ++i) {
+            std::vector<bool> roomAhead;
+            for (Agent* agent : controller->getAgents()) {
+                const bool atNode = !agent->hasArrived() && !agent->getCurrentEdge() && !agent->getPath().empty();
+                const EdgeId next = atNode ? agent->getPath().front() : -1;
+                roomAhead.push_back(atNode && city->occupancy(next) < city->edgeCapacity(next));
+            }
+            controller->tick();
+            for (size_t k = 0; k < roomAhead.size(); ++k) {
+                Agent* agent = controller->getAgents()[k];
+                if (roomAhead[k] && !agent->getCurrentEdge() && !agent->hasArrived()) {
+                    ++outcome.holds;
+                }
+                std::vector<EdgeId>& route = driven[agent->getId()];
+                if (agent->getCurrentEdge() && (route.empty() || route.back() != *agent->getCurrentEdge())) {
+                    route.push_back(*agent->getCurrentEdge());
+                }
+            }
+        }
+        std::set<std::vector<EdgeId>> routes;
+        for (const auto& [id, route] : driven) {
+            routes.insert(route);
+        }
+        outcome.routes = routes.size();
+        outcome.throughput = controller->getMetrics()->totalThroughput();
+        return outcome;
+    };
+
+    const Outcome queued = run(0);
+    EXPECT_EQ(queued.holds, 0);
+    EXPECT_EQ(queued.routes, 1u);
+    EXPECT_EQ(queued.throughput, 12);
+
+    const Outcome reserved = run(16);
+    EXPECT_GT(reserved.holds, 0);      // Planned waits are kept
+    EXPECT_GT(reserved.routes, 1u);     // and some trips take the detour
+    EXPECT_EQ(reserved.throughput, 12);
+}
+
 // Parameterized test for different policy types
 class SimulationControllerPolicyTest : public ::testing::TestWithParam<PolicyType> {};
 
@@ -213,7 +390,9 @@ INSTANTIATE_TEST_SUITE_P(
     SimulationControllerPolicyTest,
     ::testing::Values(
         PolicyType::SHORTEST_PATH,
-        PolicyType::CONGESTION_AWARE
+        PolicyType::CONGESTION_AWARE,
+        PolicyType::SYSTEM_OPTIMAL,
+        PolicyType::ROUTE_DIVERSITY
     )
 );
 
@@ -0,0 +1,283 @@
+// code/tests/test_simulation_runner_googletest.cpp
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../core/Agent.h"
+#include "../core/City.h"
+#include "../core/Preset.h"
+#include "../core/SimulationController.h"
+#include "../core/SimulationRunner.h"
+#include "../core/TripleBuffer.h"
+
+/**
+ * Test Suite: Simulation thread and frame hand-off
+ * Tests the lock-free triple buffer, frame capture and the worker-thread
+ * runner (pacing, pause, exclusive controller access, auto-pause).
+ */
+
+class SimulationRunnerTest : public ::testing::Test {
+protected:
+    static Preset createPreset(int agents) {
+        Preset preset;
+        preset.setName("runner");
+        preset.setRows(6);
+        preset.setCols(6);
+        preset.setAgentCount(agents);
+        return preset;
+    }
+
+    // Polls until pred() holds or the timeout passes
+    template <typename Pred>
+    static bool waitFor(Pred pred, std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!pred()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+};
+
+// Test 1: Triple buffer hands over the latest value only
+TEST_F(SimulationRunnerTest, TripleBufferLatestWins) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.update());
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+    EXPECT_TRUE(buffer.hasFresh());
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.read(), 2);
+    EXPECT_FALSE(buffer.update());
+    EXPECT_EQ(buffer.read(), 2);
+
+    buffer.writeBuffer() = 3;
+    buffer.publish();
+    EXPECT_TRUE(buffer.update());
+    EXPECT_EQ(buffer.read(), 3);
+}
+
+// Test 2: Concurrent producer/consumer never observe a torn or stale value
+TEST_F(SimulationRunnerTest, TripleBufferConcurrent) {
+    struct Payload {
+        std::uint64_t value = 0;
+        std::vector<std::uint64_t> copies = std::vector<std::uint64_t>(64);
+    };
+    TripleBuffer<Payload> buffer;
+    constexpr std::uint64_t kCount = 200000;
+
+    std::thread producer([&] {
+        for (std::uint64_t i = 1; i <= kCount; ++i) {
+            Payload& slot = buffer.writeBuffer();
+            slot.value = i;
+            for (auto& copy : slot.copies) copy = i;
+            buffer.publish();
+        }
+    });
+
+    std::uint64_t last = 0;
+    bool consistent = true;
+    while (last < kCount) {
+        if (!buffer.update()) continue;
+        const Payload& payload = buffer.read();
+        for (auto copy : payload.copies) {
+            if (copy != payload.value) consistent = false;
+        }
+        if (payload.value <= last) consistent = false;
+        last = payload.value;
+    }
+    producer.join();
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(last, kCount);
+}
+
+// Test 3: captureFrame mirrors the controller state
+TEST_F(SimulationRunnerTest, CaptureFrame) {
+    SimulationController controller;
+    SimulationFrame frame;
+    controller.captureFrame(frame);
+    EXPECT_EQ(frame.topology, nullptr);
+    EXPECT_TRUE(frame.agents.empty());
+    EXPECT_FALSE(frame.finished);
+
+    controller.loadPreset(createPreset(8));
+    for (int i = 0; i < 3; ++i) controller.tick();
+    controller.captureFrame(frame);
+
+    EXPECT_EQ(frame.tick, 3);
+    EXPECT_EQ(frame.topology, controller.getCity()->getTopology());
+    ASSERT_EQ(frame.edgeOccupancy.size(), static_cast<size_t>(controller.getCity()->getEdgeCount()));
+    auto& agents = controller.getAgents();
+    ASSERT_EQ(frame.totalAgents(), 8);
+    int onEdges = 0;
+    for (size_t i = 0; i < agents.size(); ++i) {
+        EXPECT_EQ(frame.agents[i].currentNode, agents[i]->getCurrentNode());
+        EXPECT_EQ(frame.agents[i].arrived, agents[i]->hasArrived());
+        if (frame.agents[i].currentEdge >= 0) ++onEdges;
+    }
+    int occupied = 0;
+    for (int occupancy : frame.edgeOccupancy) occupied += occupancy;
+    EXPECT_EQ(occupied, onEdges);
+    EXPECT_EQ(frame.activeAgents + frame.arrivedAgents, 8);
+
+    // Holding the topology in a frame must not make ticks copy it
+    auto shared = frame.topology;
+    controller.tick();
+    controller.captureFrame(frame);
+    EXPECT_EQ(frame.topology, shared);
+}
+
+// Test 4: The worker ticks, publishes frames and stops on pause
+TEST_F(SimulationRunnerTest, WorkerTicksAndPauses) {
+    SimulationController controller;
+    controller.loadPreset(createPreset(200));
+    SimulationRunner runner(controller);
+    ASSERT_TRUE(runner.pollFrame());
+    std::uint64_t firstSequence = runner.currentFrame().sequence;
+
+    runner.setTickInterval(std::chrono::microseconds(0));
+    runner.start();
+    ASSERT_TRUE(waitFor([&] { return runner.getTicksRun() >= 5; }));
+    runner.pause();
+    EXPECT_FALSE(runner.isRunning());
+
+    std::uint64_t ticks = runner.getTicksRun();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(runner.getTicksRun(), ticks);
+
+    ASSERT_TRUE(runner.pollFrame());
+    const SimulationFrame& frame = runner.currentFrame();
+    EXPECT_GT(frame.sequence, firstSequence);
+    int tick = runner.withController([](SimulationController& c) {
+        return c.getMetrics()->getCurrentTick();
+    });
+    EXPECT_EQ(frame.tick, tick);
+}
+
+// Test 5: Tick interval paces the worker
+TEST_F(SimulationRunnerTest, TickIntervalPaces) {
+    SimulationController controller;
+    controller.loadPreset(createPreset(5));
+    SimulationRunner runner(controller);
+    runner.setTickInterval(std::chrono::milliseconds(20));
+    EXPECT_EQ(runner.getTickInterval(), std::chrono::microseconds(20000));
+
+    runner.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    runner.pause();
+    // ~5 ticks expected; allow scheduling slack but rule out free-running
+    EXPECT_GE(runner.getTicksRun(), 2u);
+    EXPECT_LE(runner.getTicksRun(), 8u);
+}
+
+// Test 6: withController and step publish immediately; finished runs auto-pause
+TEST_F(SimulationRunnerTest, ControlAndAutoPause) {
+    SimulationController controller;
+    SimulationRunner runner(controller);
+    runner.pollFrame();
+    EXPECT_EQ(runner.currentFrame().topology, nullptr);
+
+    runner.withController([&](SimulationController& c) { c.loadPreset(createPreset(4)); });
+    ASSERT_TRUE(runner.pollFrame());
+    EXPECT_NE(runner.currentFrame().topology, nullptr);
+    EXPECT_EQ(runner.currentFrame().totalAgents(), 4);
+
+    runner.step();
+    ASSERT_TRUE(runner.pollFrame());
+    EXPECT_EQ(runner.currentFrame().tick, 1);
+
+    runner.setTickInterval(std::chrono::microseconds(0));
+    runner.start();
+    ASSERT_TRUE(waitFor([&] { return !runner.isRunning(); }));
+    runner.pollFrame();
+    EXPECT_TRUE(runner.currentFrame().finished);
+    EXPECT_EQ(runner.currentFrame().arrivedAgents, 4);
+}
+
+// Test 7: Controller change lists cover every edge and agent that changed
+TEST_F(SimulationRunnerTest, ControllerTracksChanges) {
+    SimulationController controller;
+    controller.loadPreset(createPreset(30));
+    std::vector<int> edges, agents;
+    EXPECT_FALSE(controller.takeChanges(edges, agents));
+
+    SimulationFrame before, after;
+    controller.captureFrame(before);
+    for (int t = 0; t < 6; ++t) {
+        edges.clear();
+        agents.clear();
+        controller.tick();
+        ASSERT_TRUE(controller.takeChanges(edges, agents));
+        controller.captureFrame(after);
+
+        std::vector<bool> edgeListed(after.edgeOccupancy.size(), false);
+        std::vector<bool> agentListed(after.agents.size(), false);
+        for (int e : edges) edgeListed[e] = true;
+        for (int a : agents) agentListed[a] = true;
+        for (size_t e = 0; e < after.edgeOccupancy.size(); ++e) {
+            if (after.edgeOccupancy[e] != before.edgeOccupancy[e]) {
+                EXPECT_TRUE(edgeListed[e]) << "edge " << e << " at tick " << after.tick;
+            }
+        }
+        for (size_t a = 0; a < after.agents.size(); ++a) {
+            const AgentFrame& was = before.agents[a];
+            const AgentFrame& now = after.agents[a];
+            if (was.currentNode != now.currentNode || was.currentEdge != now.currentEdge ||
+                was.arrived != now.arrived) {
+                EXPECT_TRUE(agentListed[a]) << "agent " << a << " at tick " << after.tick;
+            }
+        }
+        std::swap(before, after);
+    }
+
+    edges.clear();
+    agents.clear();
+    EXPECT_TRUE(controller.takeChanges(edges, agents));
+    EXPECT_TRUE(edges.empty());
+    EXPECT_TRUE(agents.empty());
+
+    controller.reset();
+    EXPECT_FALSE(controller.takeChanges(edges, agents));
+}
+
+// Test 8: Frames the display skipped fold their changes into the next one
+TEST_F(SimulationRunnerTest, FramesCarrySkippedChanges) {
+    SimulationController controller;
+    controller.loadPreset(createPreset(30));
+    SimulationRunner runner(controller);
+    ASSERT_TRUE(runner.pollFrame());
+    EXPECT_TRUE(runner.currentFrame().fullRefresh);
+
+    // Display copy that only ever receives the incremental updates
+    std::vector<int> occupancy = runner.currentFrame().edgeOccupancy;
+    std::vector<AgentFrame> agents = runner.currentFrame().agents;
+
+    for (int round = 0; round < 4; ++round) {
+        for (int t = 0; t <= round; ++t) runner.step();
+        ASSERT_TRUE(runner.pollFrame());
+        const SimulationFrame& frame = runner.currentFrame();
+        ASSERT_FALSE(frame.fullRefresh);
+        for (int e : frame.changedEdges) occupancy[e] = frame.edgeOccupancy[e];
+        for (int a : frame.changedAgents) agents[a] = frame.agents[a];
+
+        EXPECT_EQ(occupancy, frame.edgeOccupancy);
+        for (size_t a = 0; a < agents.size(); ++a) {
+            EXPECT_EQ(agents[a].currentNode, frame.agents[a].currentNode);
+            EXPECT_EQ(agents[a].currentEdge, frame.agents[a].currentEdge);
+            EXPECT_EQ(agents[a].arrived, frame.agents[a].arrived);
+        }
+    }
+
+    runner.withController([&](SimulationController& c) { c.reset(); });
+    ASSERT_TRUE(runner.pollFrame());
+    EXPECT_TRUE(runner.currentFrame().fullRefresh);
+    EXPECT_TRUE(runner.currentFrame().changedAgents.empty());
+    runner.step();
+    ASSERT_TRUE(runner.pollFrame());
+    EXPECT_FALSE(runner.currentFrame().fullRefresh);
+}
@@ -0,0 +1,185 @@
+// code/tests/test_tick_profiler_googletest.cpp
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include "../adapters/JsonReader.h"
+#include "../core/Preset.h"
+#include "../core/SimulationController.h"
+#include "../core/TickProfiler.h"
+
+/**
+ * Test Suite: Tick profiler
+ * Tests the ring buffer (including its lazy allocation), exclusive phase timing, counters, Chrome trace
+ * export and the SimulationController instrumentation.
+ */
+
+class TickProfilerTest : public ::testing::Test {
+protected:
+    static void recordTicks(TickProfiler& profiler, int first, int count) {
+        for (int tick = first; tick < first + count; ++tick) {
+            TickProfiler::TickScope scope(profiler, tick);
+            TickProfiler::count(TickCounter::REROUTES, static_cast<std::uint64_t>(tick));
+        }
+    }
+
+    static Preset createPreset(PolicyType policy) {
+        Preset preset;
+        preset.setName("profiled");
+        preset.setRows(10);
+        preset.setCols(10);
+        preset.setAgentCount(60);
+        preset.setPolicy(policy);
+        return preset;
+    }
+};
+
+// Test 1: Ring buffer keeps the newest records, oldest first
+TEST_F(TickProfilerTest, RingBufferKeepsNewest) {
+    TickProfiler profiler(4);
+    EXPECT_EQ(profiler.getLastRecord(), nullptr);
+    recordTicks(profiler, 1, 6);
+
+    auto records = profiler.getRecords();
+    ASSERT_EQ(records.size(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(records[i].tick, i + 3);
+        EXPECT_EQ(records[i].counter(TickCounter::REROUTES), static_cast<std::uint64_t>(i + 3));
+    }
+    ASSERT_NE(profiler.getLastRecord(), nullptr);
+    EXPECT_EQ(profiler.getLastRecord()->tick, 6);
+    EXPECT_GE(records[1].startNs, records[0].startNs);
+
+    profiler.setCapacity(2);
+    EXPECT_EQ(profiler.getRecordCount(), 0u);
+    EXPECT_EQ(profiler.getCapacity(), 2u);
+}
+
+// Test 2: Nested phases are charged exclusively
+TEST_F(TickProfilerTest, NestedPhasesAreExclusive) {
+    TickProfiler profiler;
+    {
+        TickProfiler::TickScope scope(profiler, 1);
+        TickProfiler::ScopedPhase step(TickPhase::STEP);
+        {
+            TickProfiler::ScopedPhase route(TickPhase::ROUTE);
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+    const TickRecord* record = profiler.getLastRecord();
+    ASSERT_NE(record, nullptr);
+    EXPECT_GE(record->phase(TickPhase::ROUTE), 5'000'000);
+    EXPECT_LT(record->phase(TickPhase::STEP), record->phase(TickPhase::ROUTE));
+    EXPECT_LE(record->phase(TickPhase::STEP) + record->phase(TickPhase::ROUTE), record->totalNs);
+
+    // Timers outside a tick, or without an active profiler, are no-ops
+    { TickProfiler::ScopedPhase stray(TickPhase::ROUTE); }
+    TickProfiler::count(TickCounter::DIJKSTRA_POPS, 3);
+    profiler.addPhaseTime(TickPhase::STEP, 100);
+    EXPECT_EQ(profiler.getRecordCount(), 1u);
+    EXPECT_EQ(TickProfiler::active(), nullptr);
+
+    profiler.addToLastTick(TickPhase::UI, 1234);
+    EXPECT_EQ(profiler.getLastRecord()->phase(TickPhase::UI), 1234);
+}
+
+// Test 3: A disabled profiler records nothing
+TEST_F(TickProfilerTest, DisabledRecordsNothing) {
+    TickProfiler profiler;
+    profiler.setEnabled(false);
+    recordTicks(profiler, 1, 3);
+    profiler.addToLastTick(TickPhase::UI, 10);
+    EXPECT_EQ(profiler.getRecordCount(), 0u);
+    EXPECT_FALSE(profiler.inTick());
+}
+
+// Test 4: Chrome trace export is valid JSON with tick, phase and counter events
+TEST_F(TickProfilerTest, ChromeTraceExport) {
+    TickProfiler profiler;
+    {
+        TickProfiler::TickScope scope(profiler, 7);
+        TickProfiler::ScopedPhase metrics(TickPhase::METRICS);
+        TickProfiler::count(TickCounter::CAPACITY_WAITS, 2);
+    }
+    profiler.addToLastTick(TickPhase::UI, 2000);
+
+    std::stringstream trace;
+    profiler.exportChromeTrace(trace);
+    std::string text = trace.str();
+    EXPECT_NE(text.find("\"name\": \"tick 7\""), std::string::npos);
+    EXPECT_NE(text.find("\"name\": \"metrics\""), std::string::npos);
+    EXPECT_NE(text.find("\"name\": \"ui\""), std::string::npos);
+    EXPECT_NE(text.find("\"capacity_waits\": 2"), std::string::npos);
+
+    JsonReader reader;
+    reader.attach(trace);
+    ASSERT_EQ(reader.next(), JsonReader::Token::BEGIN_OBJECT);
+    int keys = 0;
+    while (reader.next() != JsonReader::Token::END_OBJECT) {
+        ++keys;
+        reader.skipValue();
+    }
+    EXPECT_EQ(keys, 2);
+    EXPECT_EQ(reader.next(), JsonReader::Token::END_OF_INPUT);
+
+    EXPECT_THROW(profiler.exportChromeTrace("/nonexistent/dir/trace.json"), std::runtime_error);
+}
+
+// Test 5: SimulationController reports phases and counters per tick
+TEST_F(TickProfilerTest, ControllerInstrumentation) {
+#if !GRIDLOCK_PROFILING
+    GTEST_SKIP() << "Built without GRIDLOCK_PROFILING";
+#else
+    SimulationController controller;
+    controller.loadPreset(createPreset(PolicyType::CONGESTION_AWARE));
+    for (int i = 0; i < 20; ++i) {
+        controller.tick();
+    }
+
+    auto records = controller.getProfiler().getRecords();
+    ASSERT_EQ(records.size(), 20u);
+    EXPECT_EQ(records.front().tick, 1);
+    EXPECT_EQ(records.back().tick, 20);
+
+    const TickRecord& first = records.front();
+    EXPECT_GT(first.phase(TickPhase::ROUTE), 0);
+    EXPECT_GT(first.phase(TickPhase::STEP), 0);
+    EXPECT_GT(first.phase(TickPhase::METRICS), 0);
+    EXPECT_GT(first.counter(TickCounter::DIJKSTRA_POPS), 0u);
+    EXPECT_GT(first.counter(TickCounter::EDGE_RELAXATIONS), 0u);
+
+    std::int64_t phaseSum = 0;
+    for (std::int64_t ns : first.phaseNs) phaseSum += ns;
+    EXPECT_LE(phaseSum, first.totalNs);
+
+    std::uint64_t reroutes = 0;
+    for (const auto& record : records) {
+        reroutes += record.counter(TickCounter::REROUTES);
+    }
+    EXPECT_GT(reroutes, 0u);
+    EXPECT_EQ(TickProfiler::active(), nullptr);
+#endif
+}
+
+// Test 6: The ring buffer appears with the first record, and again after a resize
+TEST_F(TickProfilerTest, EmptyProfilerIsUsable) {
+    TickProfiler profiler(3);
+    EXPECT_TRUE(profiler.getRecords().empty());
+    profiler.addToLastTick(TickPhase::UI, 100);
+    EXPECT_EQ(profiler.getCapacity(), 3u);
+
+    recordTicks(profiler, 1, 1);
+    profiler.addToLastTick(TickPhase::UI, 100);
+    ASSERT_EQ(profiler.getRecordCount(), 1u);
+    EXPECT_EQ(profiler.getLastRecord()->phase(TickPhase::UI), 100);
+
+    profiler.setCapacity(2);
+    EXPECT_TRUE(profiler.getRecords().empty());
+    recordTicks(profiler, 2, 3);
+    auto records = profiler.getRecords();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].tick, 3);
+    EXPECT_EQ(records[1].tick, 4);
+}
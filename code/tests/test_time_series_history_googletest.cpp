@@ -0,0 +1,130 @@
+// code/tests/test_time_series_history_googletest.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../analytics/TimeSeriesHistory.h"
+
+/**
+ * Test Suite: Multi-resolution chart history
+ * Tests bucket aggregation, the memory bound, level selection for long
+ * ranges and LTTB downsampling.
+ */
+
+class TimeSeriesHistoryTest : public ::testing::Test {};
+
+// Test 1: Short histories come back as raw samples
+TEST_F(TimeSeriesHistoryTest, ShortHistoryIsRaw) {
+    TimeSeriesHistory history;
+    EXPECT_TRUE(history.empty());
+    EXPECT_TRUE(history.downsample(0, 100, 50).empty());
+
+    for (int tick = 1; tick <= 10; ++tick) {
+        history.append(tick, tick * 2.0);
+    }
+    auto points = history.downsample(0, 100, 50);
+    ASSERT_EQ(points.size(), 10u);
+    EXPECT_DOUBLE_EQ(points.front().x, 1.0);
+    EXPECT_DOUBLE_EQ(points.back().y, 20.0);
+    EXPECT_EQ(history.sampleCount(), 10u);
+    EXPECT_DOUBLE_EQ(history.firstX(), 1.0);
+    EXPECT_DOUBLE_EQ(history.lastX(), 10.0);
+
+    // Only the requested window
+    points = history.downsample(4, 6, 50);
+    ASSERT_EQ(points.size(), 3u);
+    EXPECT_DOUBLE_EQ(points.front().x, 4.0);
+}
+
+// Test 2: Coarser levels hold min / max / mean of their samples
+TEST_F(TimeSeriesHistoryTest, BucketAggregates) {
+    TimeSeriesHistory history(8, 4, 3);
+    for (int tick = 0; tick < 16; ++tick) {
+        history.append(tick, tick % 4 == 3 ? 10.0 : 1.0);
+    }
+    // 16 raw samples exceed 8 buckets, so level 0 no longer covers tick 0
+    auto buckets = history.buckets(0, 15, 100);
+    ASSERT_EQ(buckets.size(), 4u);
+    for (const auto& bucket : buckets) {
+        EXPECT_EQ(bucket.count, 4u);
+        EXPECT_DOUBLE_EQ(bucket.min, 1.0);
+        EXPECT_DOUBLE_EQ(bucket.max, 10.0);
+        EXPECT_DOUBLE_EQ(bucket.mean(), 13.0 / 4.0);
+    }
+    EXPECT_DOUBLE_EQ(buckets[1].firstX, 4.0);
+    EXPECT_DOUBLE_EQ(buckets[1].lastX, 7.0);
+
+    // A recent window is still served from raw samples
+    auto recent = history.buckets(12, 15, 100);
+    ASSERT_EQ(recent.size(), 4u);
+    EXPECT_EQ(recent[0].count, 1u);
+}
+
+// Test 3: Memory stays bounded and long ranges still cover the whole run
+TEST_F(TimeSeriesHistoryTest, BoundedAndCovering) {
+    TimeSeriesHistory history(256, 4, 8);
+    constexpr int kSamples = 1000000;
+    for (int tick = 0; tick < kSamples; ++tick) {
+        history.append(tick, std::sin(tick * 0.001));
+    }
+    EXPECT_LE(history.retainedBuckets(), 8u * 257u);
+
+    auto points = history.downsample(0, kSamples - 1, 400);
+    ASSERT_LE(points.size(), 400u);
+    ASSERT_GE(points.size(), 100u);
+    EXPECT_LT(points.front().x, kSamples * 0.01);
+    EXPECT_GT(points.back().x, kSamples * 0.99);
+    for (size_t i = 1; i < points.size(); ++i) {
+        EXPECT_LT(points[i - 1].x, points[i].x);
+    }
+
+    auto range = history.valueRange(0, kSamples - 1);
+    EXPECT_NEAR(range.first, -1.0, 1e-3);
+    EXPECT_NEAR(range.second, 1.0, 1e-3);
+}
+
+// Test 4: A spike survives downsampling and shows in the value range
+TEST_F(TimeSeriesHistoryTest, SpikeSurvives) {
+    TimeSeriesHistory history(128, 4, 6);
+    for (int tick = 0; tick < 20000; ++tick) {
+        history.append(tick, tick == 12345 ? 500.0 : 1.0);
+    }
+    auto range = history.valueRange(0, 19999);
+    EXPECT_DOUBLE_EQ(range.second, 500.0);
+    EXPECT_DOUBLE_EQ(range.first, 1.0);
+
+    auto points = history.downsample(0, 19999, 100);
+    double peak = 0.0;
+    for (const auto& point : points) peak = std::max(peak, point.y);
+    EXPECT_GT(peak, 1.0);
+}
+
+// Test 5: LTTB keeps the endpoints and the most significant point
+TEST_F(TimeSeriesHistoryTest, LargestTriangleThreeBuckets) {
+    std::vector<TimeSeriesHistory::Point> points;
+    for (int i = 0; i < 100; ++i) {
+        points.push_back({static_cast<double>(i), i == 57 ? 50.0 : 0.0});
+    }
+    auto sampled = TimeSeriesHistory::lttb(points, 10);
+    ASSERT_EQ(sampled.size(), 10u);
+    EXPECT_DOUBLE_EQ(sampled.front().x, 0.0);
+    EXPECT_DOUBLE_EQ(sampled.back().x, 99.0);
+    bool keptSpike = false;
+    for (const auto& point : sampled) keptSpike = keptSpike || point.x == 57.0;
+    EXPECT_TRUE(keptSpike);
+
+    EXPECT_EQ(TimeSeriesHistory::lttb(points, 200).size(), 100u);
+    EXPECT_EQ(TimeSeriesHistory::lttb(points, 2).size(), 2u);
+    EXPECT_TRUE(TimeSeriesHistory::lttb(points, 0).empty());
+}
+
+// Test 6: clear() starts over
+TEST_F(TimeSeriesHistoryTest, Clear) {
+    TimeSeriesHistory history(4, 2, 3);
+    for (int tick = 0; tick < 50; ++tick) history.append(tick, tick);
+    history.clear();
+    EXPECT_TRUE(history.empty());
+    EXPECT_EQ(history.retainedBuckets(), 0u);
+    history.append(3, 7);
+    auto points = history.downsample(0, 10, 10);
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_DOUBLE_EQ(points[0].y, 7.0);
+}
@@ -0,0 +1,265 @@
+// code/tests/test_traffic_assignment_googletest.cpp
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "../analytics/PolicyEffectivenessAnalyzer.h"
+#include "../analytics/TrafficAssignment.h"
+#include "../core/VolumeDelayPolicy.h"
+#include "../core/City.h"
+#include "../core/Node.h"
+#include "../core/Edge.h"
+#include "../core/Agent.h"
+
+/**
+ * Static traffic assignment: Frank-Wolfe user equilibrium on small
+ * networks with known solutions, determinism across thread counts and
+ * demand bookkeeping; plus the simulated price of anarchy.
+ */
+
+namespace {
+    // Two parallel links 0 -> 1: edge 0 (length 10) and edge 1 (length 15)
+    std::unique_ptr<City> makeParallelLinks(int capacity) {
+        auto city = std::make_unique<City>();
+        city->addNode(Node(0, 0, 0));
+        city->addNode(Node(1, 0, 1));
+        city->addEdge(Edge(0, 0, 1, 10.0, capacity));
+        city->addEdge(Edge(1, 0, 1, 15.0, capacity));
+        return city;
+    }
+
+    // size x size grid with edges both ways between neighbours
+    std::unique_ptr<City> makeGrid(int size, int capacity) {
+        auto city = std::make_unique<City>();
+        for (int r = 0; r < size; ++r) {
+            for (int c = 0; c < size; ++c) {
+                city->addNode(Node(r * size + c, c, r));
+            }
+        }
+        EdgeId id = 0;
+        for (int r = 0; r < size; ++r) {
+            for (int c = 0; c < size; ++c) {
+                NodeId n = r * size + c;
+                if (c + 1 < size) {
+                    city->addEdge(Edge(id++, n, n + 1, 1.0, capacity));
+                    city->addEdge(Edge(id++, n + 1, n, 1.0, capacity));
+                }
+                if (r + 1 < size) {
+                    city->addEdge(Edge(id++, n, n + size, 1.0, capacity));
+                    city->addEdge(Edge(id++, n + size, n, 1.0, capacity));
+                }
+            }
+        }
+        return city;
+    }
+
+    std::vector<TrafficAssignment::OdDemand> gridDemand(int size, double trips) {
+        std::vector<TrafficAssignment::OdDemand> demand;
+        const NodeId last = size * size - 1;
+        for (int i = 0; i < size; ++i) {
+            demand.push_back({i, last - i, trips});
+            demand.push_back({i * size, last - i * size, trips});
+        }
+        return demand;
+    }
+}
+
+// Test 1: Two parallel links reach the analytic equilibrium with equal costs
+TEST(TrafficAssignmentTest, ParallelLinksEquilibrate) {
+    auto city = makeParallelLinks(10);
+    // Linear BPR: cost = length * (1 + flow / capacity)
+    TrafficAssignment assignment(*city, VolumeDelayPolicy(VolumeDelayPolicy::Function::BPR, {1.0, 1.0}));
+
+    TrafficAssignment::Options options;
+    options.relativeGapTarget = 1e-6;
+    auto result = assignment.solveUserEquilibrium({{0, 1, 30.0}}, options);
+
+    // 10 (1 + x / 10) = 15 (1 + (30 - x) / 10)  =>  x = 20
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(result.edgeFlows[0], 20.0, 1e-2);
+    EXPECT_NEAR(result.edgeFlows[1], 10.0, 1e-2);
+    EXPECT_NEAR(result.edgeCosts[0], 30.0, 1e-2);
+    EXPECT_NEAR(result.edgeCosts[1], 30.0, 1e-2);
+    EXPECT_NEAR(result.totalCost, 900.0, 1.0);
+    EXPECT_DOUBLE_EQ(result.unroutedTrips, 0.0);
+}
+
+// Test 2: Light demand stays on the free-flow shortest path
+TEST(TrafficAssignmentTest, LightDemandUsesShortestPath) {
+    auto city = makeParallelLinks(10);
+    TrafficAssignment assignment(*city, VolumeDelayPolicy(VolumeDelayPolicy::Function::BPR, {1.0, 1.0}));
+
+    // Link 0 stays cheaper than 15 for any flow below 5
+    auto result = assignment.solveUserEquilibrium({{0, 1, 4.0}});
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(result.edgeFlows[0], 4.0, 1e-9);
+    EXPECT_NEAR(result.edgeFlows[1], 0.0, 1e-9);
+}
+
+// Test 3: The gap shrinks and flows do not depend on the thread count
+TEST(TrafficAssignmentTest, GridConvergesDeterministically) {
+    auto city = makeGrid(8, 4);
+    TrafficAssignment assignment(*city);
+    auto demand = gridDemand(8, 6.0);
+
+    TrafficAssignment::Options single;
+    single.maxThreads = 1;
+    single.relativeGapTarget = 2e-2;
+    TrafficAssignment::Options parallel = single;
+    parallel.maxThreads = 4;
+
+    auto a = assignment.solveUserEquilibrium(demand, single);
+    auto b = assignment.solveUserEquilibrium(demand, parallel);
+
+    EXPECT_TRUE(a.converged);
+    EXPECT_LE(a.relativeGap, 2e-2);
+    ASSERT_FALSE(a.gapHistory.empty());
+    EXPECT_LT(a.gapHistory.back(), a.gapHistory.front());
+    EXPECT_EQ(a.iterations, b.iterations);
+    ASSERT_EQ(a.edgeFlows.size(), b.edgeFlows.size());
+    for (size_t e = 0; e < a.edgeFlows.size(); ++e) {
+        EXPECT_NEAR(a.edgeFlows[e], b.edgeFlows[e], 1e-9) << e;
+    }
+}
+
+// Test 4: Closed edges carry no flow; unreachable demand is reported
+TEST(TrafficAssignmentTest, ClosuresAndUnreachableDemand) {
+    auto city = makeParallelLinks(10);
+    city->addNode(Node(2, 5, 5));
+    city->setEdgeBlocked(0, true);
+    TrafficAssignment assignment(*city);
+
+    auto result = assignment.solveUserEquilibrium({{0, 1, 5.0}, {0, 2, 3.0}, {1, 1, 2.0}});
+    EXPECT_DOUBLE_EQ(result.edgeFlows[0], 0.0);
+    EXPECT_NEAR(result.edgeFlows[1], 5.0, 1e-9);
+    EXPECT_DOUBLE_EQ(result.unroutedTrips, 3.0);
+
+    EXPECT_THROW(assignment.solveUserEquilibrium({{0, 1, -1.0}}), std::runtime_error);
+    EXPECT_THROW(assignment.solveUserEquilibrium({{0, 42, 1.0}}), std::runtime_error);
+}
+
+// Test 5: Agents become a merged OD matrix
+TEST(TrafficAssignmentTest, DemandFromAgentsMergesPairs) {
+    Agent a(1, 0, 1);
+    Agent b(2, 0, 1);
+    Agent c(3, 1, 0);
+    auto demand = TrafficAssignment::demandFromAgents({&a, nullptr, &b, &c});
+
+    ASSERT_EQ(demand.size(), 2u);
+    EXPECT_EQ(demand[0].origin, 0);
+    EXPECT_EQ(demand[0].destination, 1);
+    EXPECT_DOUBLE_EQ(demand[0].trips, 2.0);
+    EXPECT_EQ(demand[1].origin, 1);
+    EXPECT_DOUBLE_EQ(demand[1].trips, 1.0);
+}
+
+// Test 6: The bush-based solver reaches a tight gap on the parallel links
+TEST(TrafficAssignmentTest, BushBasedParallelLinks) {
+    auto city = makeParallelLinks(10);
+    TrafficAssignment assignment(*city, VolumeDelayPolicy(VolumeDelayPolicy::Function::BPR, {1.0, 1.0}));
+
+    TrafficAssignment::Options options;
+    options.method = TrafficAssignment::Method::BUSH_BASED;
+    options.relativeGapTarget = 1e-9;
+    auto result = assignment.solveUserEquilibrium({{0, 1, 30.0}}, options);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_NEAR(result.edgeFlows[0], 20.0, 1e-6);
+    EXPECT_NEAR(result.edgeFlows[1], 10.0, 1e-6);
+    EXPECT_LE(result.iterations, 5);
+}
+
+// Test 7: The bush-based solver reaches 1e-6 on a grid full of equal-length
+// routes, agrees with Frank-Wolfe and is independent of the thread count
+TEST(TrafficAssignmentTest, BushBasedGridConverges) {
+    auto city = makeGrid(8, 10);
+    TrafficAssignment assignment(*city);
+    auto demand = gridDemand(8, 6.0);
+
+    TrafficAssignment::Options options;
+    options.method = TrafficAssignment::Method::BUSH_BASED;
+    options.relativeGapTarget = 1e-6;
+    options.maxThreads = 1;
+    auto a = assignment.solveUserEquilibrium(demand, options);
+    options.maxThreads = 4;
+    auto b = assignment.solveUserEquilibrium(demand, options);
+
+    EXPECT_TRUE(a.converged);
+    EXPECT_LE(a.relativeGap, 1e-6);
+    ASSERT_EQ(a.timeHistory.size(), a.gapHistory.size());
+    EXPECT_GE(a.wallSeconds, a.timeHistory.back());
+    EXPECT_EQ(a.iterations, b.iterations);
+    for (size_t e = 0; e < a.edgeFlows.size(); ++e) {
+        EXPECT_DOUBLE_EQ(a.edgeFlows[e], b.edgeFlows[e]) << e;
+    }
+
+    // Same equilibrium; Frank-Wolfe does not get that close in as many iterations
+    TrafficAssignment::Options frankWolfe;
+    frankWolfe.relativeGapTarget = 1e-6;
+    frankWolfe.maxIterations = options.maxIterations;
+    auto fw = assignment.solveUserEquilibrium(demand, frankWolfe);
+    EXPECT_FALSE(fw.converged);
+    EXPECT_GT(fw.relativeGap, 10 * a.relativeGap);
+    EXPECT_NEAR(fw.totalCost, a.totalCost, 1e-2 * a.totalCost);
+}
+
+// Test 8: The system optimum equalizes marginal costs and never costs more
+// than the user equilibrium
+TEST(TrafficAssignmentTest, SystemOptimumAndPriceOfAnarchy) {
+    auto city = makeParallelLinks(10);
+    TrafficAssignment assignment(*city, VolumeDelayPolicy(VolumeDelayPolicy::Function::BPR, {1.0, 1.0}));
+
+    TrafficAssignment::Options options;
+    options.method = TrafficAssignment::Method::BUSH_BASED;
+    options.relativeGapTarget = 1e-8;
+    auto ue = assignment.solveUserEquilibrium({{0, 1, 30.0}}, options);
+    auto so = assignment.solveSystemOptimum({{0, 1, 30.0}}, options);
+
+    // 10 + 2x = 15 + 3 (30 - x)  =>  x = 19; costs are the actual ones
+    EXPECT_TRUE(so.converged);
+    EXPECT_NEAR(so.edgeFlows[0], 19.0, 1e-4);
+    EXPECT_NEAR(so.edgeFlows[1], 11.0, 1e-4);
+    EXPECT_NEAR(so.edgeCosts[0], 29.0, 1e-4);
+    EXPECT_NEAR(so.edgeCosts[1], 31.5, 1e-4);
+    EXPECT_NEAR(so.totalCost, 897.5, 1e-2);
+    EXPECT_NEAR(TrafficAssignment::priceOfAnarchy(ue, so), 900.0 / 897.5, 1e-5);
+
+    // On a congested grid selfish routing costs more, and Frank-Wolfe's
+    // approximate optimum costs at least the bush's
+    auto grid = makeGrid(6, 3);
+    TrafficAssignment gridAssignment(*grid);
+    auto demand = gridDemand(6, 5.0);
+    options.relativeGapTarget = 1e-6;
+    auto gridUe = gridAssignment.solveUserEquilibrium(demand, options);
+    auto gridSo = gridAssignment.solveSystemOptimum(demand, options);
+    EXPECT_TRUE(gridSo.converged);
+    EXPECT_GT(TrafficAssignment::priceOfAnarchy(gridUe, gridSo), 1.0);
+
+    TrafficAssignment::Options frankWolfe;
+    frankWolfe.maxIterations = 300;
+    frankWolfe.relativeGapTarget = 1e-3;
+    auto fwSo = gridAssignment.solveSystemOptimum(demand, frankWolfe);
+    EXPECT_NEAR(fwSo.totalCost, gridSo.totalCost, 5e-2 * gridSo.totalCost);
+    EXPECT_GE(fwSo.totalCost, gridSo.totalCost * (1.0 - 1e-9));
+}
+
+// Test 9: The simulated price of anarchy charges agents still travelling
+TEST(TrafficAssignmentTest, SimulatedPriceOfAnarchyCountsUnfinishedTrips) {
+    // Selfish run cut off with 2 of 5 agents arrived (10 ticks each) and 3
+    // still travelling after 12 ticks; the optimal run finished all 5 in 11
+    PolicyEffectivenessAnalyzer::PolicyMetrics selfish{};
+    selfish.averageTripTime = 10.0;
+    selfish.totalThroughput = 2;
+    selfish.enRouteTime = 3 * 12.0;
+    PolicyEffectivenessAnalyzer::PolicyMetrics optimal{};
+    optimal.averageTripTime = 11.0;
+    optimal.totalThroughput = 5;
+
+    EXPECT_NEAR(PolicyEffectivenessAnalyzer::priceOfAnarchy(selfish, optimal), 56.0 / 55.0, 1e-12);
+    selfish.enRouteTime = 0.0;
+    EXPECT_NEAR(PolicyEffectivenessAnalyzer::priceOfAnarchy(selfish, optimal), 20.0 / 55.0, 1e-12);
+
+    PolicyEffectivenessAnalyzer::PolicyMetrics idle{};
+    EXPECT_DOUBLE_EQ(PolicyEffectivenessAnalyzer::priceOfAnarchy(selfish, idle), 1.0);
+}
@@ -6,6 +6,7 @@
 #include "../ui/GridView.h"
 #include "../core/SimulationController.h"
 #include "../core/City.h"
+#include "../core/SimulationFrame.h"
 #include "../core/Preset.h"
 #include "../adapters/PresetLoader.h"
 
@@ -55,10 +56,11 @@ int main() {
         std::cout << "   ✓ City has " << controller.getCity()->getEdgeCount() << " edges\n";
         std::cout << "   ✓ " << controller.getAgents().size() << " agents created\n";
         
-        // 4. Connect and update scene
+        // 4. Show the first frame
         std::cout << "\n4. Updating scene...\n";
-        gridView.setSimulationController(&controller);
-        gridView.updateScene();
+        SimulationFrame frame;
+        controller.captureFrame(frame);
+        gridView.setFrame(frame);
         std::cout << "   ✓ Scene updated\n";
         std::cout << "   ✓ Scene has " << scene->items().size() << " graphics items\n";
         
@@ -102,7 +104,13 @@ int main() {
         
         // 9. Test animation step
         std::cout << "\n9. Testing animation...\n";
-        gridView.animateStep();
+        std::vector<int> changedEdges;
+        std::vector<int> changedAgents;
+        controller.takeChanges(changedEdges, changedAgents);
+        controller.tick();
+        frame.fullRefresh = !controller.takeChanges(frame.changedEdges, frame.changedAgents);
+        controller.captureFrame(frame);
+        gridView.setFrame(frame);
         std::cout << "   ✓ Animation step executed\n";
         
         // 10. Test agent selection
@@ -0,0 +1,216 @@
+// code/tests/test_volume_delay_policy_googletest.cpp
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "../core/VolumeDelayPolicy.h"
+#include "../core/RoutePlanner.h"
+#include "../core/City.h"
+#include "../core/Node.h"
+#include "../core/Edge.h"
+#include "../core/Agent.h"
+#include "../patterns/PolicyRegistry.h"
+#include "mocks/MockCity.h"
+
+/**
+ * Volume-delay policies: BPR and conical cost functions, per-edge
+ * parameters, the pow-free fast paths and registry wiring.
+ */
+
+namespace {
+    // One edge 0 -> 1 of the given length and capacity
+    std::unique_ptr<City> makeLink(double length, int capacity) {
+        auto city = std::make_unique<City>();
+        city->addNode(Node(0, 0, 0));
+        city->addNode(Node(1, 0, 1));
+        city->addEdge(Edge(0, 0, 1, length, capacity));
+        return city;
+    }
+
+    double bpr(double x, double alpha, double beta) {
+        return 1.0 + alpha * std::pow(x, beta);
+    }
+
+    double conical(double x, double alpha) {
+        double b = (2.0 * alpha - 1.0) / (2.0 * alpha - 2.0);
+        return 2.0 + std::sqrt(alpha * alpha * (1 - x) * (1 - x) + b * b) - alpha * (1 - x) - b;
+    }
+
+    // Subclass defeats the exact-type kernel match, forcing IRoutePolicy calls
+    class WrappedVolumeDelayPolicy : public VolumeDelayPolicy {
+    public:
+        using VolumeDelayPolicy::VolumeDelayPolicy;
+    };
+}
+
+// Test 1: BPR follows the closed form, integer and fractional exponents
+TEST(VolumeDelayPolicyTest, BprMatchesClosedForm) {
+    auto city = makeLink(10.0, 8);
+    VolumeDelayPolicy integer(VolumeDelayPolicy::Function::BPR);
+    VolumeDelayPolicy fractional(VolumeDelayPolicy::Function::BPR, {0.5, 2.5});
+
+    for (int occupancy : {0, 1, 4, 7, 8}) {
+        city->setOccupancy(0, occupancy);
+        double x = occupancy / 8.0;
+        EXPECT_NEAR(integer.edgeCost(*city, 0), 10.0 * bpr(x, 0.15, 4.0), 1e-9) << occupancy;
+        EXPECT_NEAR(fractional.edgeCost(*city, 0), 10.0 * bpr(x, 0.5, 2.5), 1e-3 * 10.0 * bpr(x, 0.5, 2.5))
+            << occupancy;
+    }
+}
+
+// Test 2: Conical delay is 1 when empty, 2 at capacity and follows the closed form
+TEST(VolumeDelayPolicyTest, ConicalMatchesClosedForm) {
+    auto city = makeLink(5.0, 10);
+    VolumeDelayPolicy policy(VolumeDelayPolicy::Function::CONICAL);
+
+    EXPECT_NEAR(policy.delayFactor(0, 0.0), 1.0, 1e-12);
+    EXPECT_NEAR(policy.delayFactor(0, 1.0), 2.0, 1e-12);
+    for (int occupancy : {0, 3, 9, 10}) {
+        city->setOccupancy(0, occupancy);
+        EXPECT_NEAR(policy.edgeCost(*city, 0), 5.0 * conical(occupancy / 10.0, 4.0), 1e-9);
+    }
+}
+
+// Test 3: Per-edge parameters override the defaults for that edge only
+TEST(VolumeDelayPolicyTest, PerEdgeParameters) {
+    auto city = TestCityBuilder::createSimpleGrid(3, 3);
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        city->setOccupancy(city->getEdgeIdByIndex(i), 2);
+    }
+    VolumeDelayPolicy policy(VolumeDelayPolicy::Function::BPR);
+    std::vector<double> before;
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        before.push_back(policy.edgeCost(*city, city->getEdgeIdByIndex(i)));
+    }
+
+    policy.setEdgeParameters(2, {1.0, 1.0});
+    EXPECT_EQ(policy.getEdgeParameters(2).alpha, 1.0);
+    EXPECT_EQ(policy.getEdgeParameters(3).alpha, 0.15);
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        double cost = policy.edgeCost(*city, city->getEdgeIdByIndex(i));
+        if (i == 2) {
+            EXPECT_GT(cost, before[i]);
+        } else {
+            EXPECT_EQ(cost, before[i]);
+        }
+    }
+
+    EXPECT_THROW(policy.setEdgeParameters(0, {-1.0, 4.0}), std::runtime_error);
+    EXPECT_THROW(policy.setEdgeParameters(-1, {0.15, 4.0}), std::runtime_error);
+    EXPECT_THROW(VolumeDelayPolicy(VolumeDelayPolicy::Function::CONICAL, {1.0, 0.0}), std::runtime_error);
+}
+
+// Test 4: Batch costs and the specialized search agree with edgeCost
+TEST(VolumeDelayPolicyTest, BatchAndSearchMatchScalar) {
+    auto city = TestCityBuilder::createSimpleGrid(8, 8);
+    std::vector<EdgeId> ids;
+    for (int i = 0; i < city->getEdgeCount(); ++i) {
+        city->setOccupancy(city->getEdgeIdByIndex(i), (i * 5) % 7);
+        ids.push_back(city->getEdgeIdByIndex(i));
+    }
+
+    for (auto function : {VolumeDelayPolicy::Function::BPR, VolumeDelayPolicy::Function::CONICAL}) {
+        VolumeDelayPolicy policy(function);
+        WrappedVolumeDelayPolicy wrapped(function);
+        if (function == VolumeDelayPolicy::Function::BPR) {
+            policy.setEdgeParameters(7, {0.8, 1.5});
+            wrapped.setEdgeParameters(7, {0.8, 1.5});
+        }
+
+        std::vector<float> all(ids.size());
+        policy.allEdgeCosts(*city, all);
+        std::vector<float> some(ids.size());
+        policy.edgeCosts(*city, ids, some);
+        for (size_t i = 0; i < ids.size(); ++i) {
+            EXPECT_EQ(all[i], static_cast<float>(policy.edgeCost(*city, ids[i])));
+            EXPECT_EQ(some[i], all[i]);
+        }
+
+        RoutePlanner fast(&policy);
+        RoutePlanner fallback(&wrapped);
+        for (NodeId goal = 3; goal < 64; goal += 5) {
+            Agent agent(1, 0, goal);
+            EXPECT_EQ(fast.computePath(*city, agent), fallback.computePath(*city, agent));
+        }
+    }
+}
+
+// Test 5: Registry exposes both functions by name and by policy type
+TEST(VolumeDelayPolicyTest, RegisteredInPolicyRegistry) {
+    PolicyRegistry& registry = PolicyRegistry::getInstance();
+    ASSERT_TRUE(registry.isRegistered("BPR"));
+    ASSERT_TRUE(registry.isRegistered("Conical"));
+
+    auto bprPolicy = registry.createPolicy(PolicyType::BPR);
+    auto* bprDelay = dynamic_cast<VolumeDelayPolicy*>(bprPolicy.get());
+    ASSERT_NE(bprDelay, nullptr);
+    EXPECT_EQ(bprDelay->getFunction(), VolumeDelayPolicy::Function::BPR);
+
+    auto conicalPolicy = registry.createPolicy("Conical");
+    auto* conicalDelay = dynamic_cast<VolumeDelayPolicy*>(conicalPolicy.get());
+    ASSERT_NE(conicalDelay, nullptr);
+    EXPECT_EQ(conicalDelay->getFunction(), VolumeDelayPolicy::Function::CONICAL);
+}
+
+// Test 6: Slope agrees with a central difference of the delay factor
+TEST(VolumeDelayPolicyTest, SlopeMatchesFiniteDifference) {
+    VolumeDelayPolicy bpr(VolumeDelayPolicy::Function::BPR);
+    VolumeDelayPolicy linear(VolumeDelayPolicy::Function::BPR, {0.5, 1.0});
+    VolumeDelayPolicy conical(VolumeDelayPolicy::Function::CONICAL);
+    const double h = 1e-6;
+
+    for (double x : {0.1, 0.5, 1.0, 1.7}) {
+        for (const VolumeDelayPolicy* policy : {&bpr, &linear, &conical}) {
+            double numeric = (policy->delayFactor(0, x + h) - policy->delayFactor(0, x - h)) / (2 * h);
+            EXPECT_NEAR(policy->delayFactorSlope(0, x), numeric, 1e-5 * std::max(1.0, numeric)) << x;
+        }
+    }
+    EXPECT_DOUBLE_EQ(bpr.delayFactorSlope(0, 0.0), 0.0);
+    EXPECT_DOUBLE_EQ(linear.delayFactorSlope(0, 0.0), 0.5);
+}
+
+// Test 7: Marginal pricing charges f(x) + x f'(x) and its slope matches
+TEST(VolumeDelayPolicyTest, MarginalPricing) {
+    const VolumeDelayPolicy::Function functions[] = {VolumeDelayPolicy::Function::BPR,
+                                                     VolumeDelayPolicy::Function::CONICAL};
+    const double h = 1e-6;
+    for (VolumeDelayPolicy::Function function : functions) {
+        VolumeDelayPolicy average(function);
+        VolumeDelayPolicy marginal(function, VolumeDelayPolicy::defaultParameters(function),
+                                   VolumeDelayPolicy::Pricing::MARGINAL);
+        EXPECT_EQ(average.getPricing(), VolumeDelayPolicy::Pricing::AVERAGE);
+        EXPECT_EQ(marginal.getPricing(), VolumeDelayPolicy::Pricing::MARGINAL);
+
+        for (double x : {0.0, 0.3, 1.0, 1.6}) {
+            double expected = average.delayFactor(0, x) + x * average.delayFactorSlope(0, x);
+            EXPECT_NEAR(marginal.marginalDelayFactor(0, x), expected, 1e-9) << x;
+            EXPECT_NEAR(marginal.priceFactor(0, x), expected, 1e-9) << x;
+            EXPECT_DOUBLE_EQ(average.priceFactor(0, x), average.delayFactor(0, x));
+            if (x > 0.0) {
+                double numeric = (marginal.priceFactor(0, x + h) - marginal.priceFactor(0, x - h)) / (2 * h);
+                EXPECT_NEAR(marginal.priceFactorSlope(0, x), numeric, 1e-5 * std::max(1.0, numeric)) << x;
+            }
+        }
+        // Marginal cost never undercuts the average cost
+        EXPECT_GE(marginal.cost(0, 10.0, 4, 3), average.cost(0, 10.0, 4, 3));
+        EXPECT_NEAR(marginal.cost(0, 10.0, 4, 3), 10.0 * marginal.marginalDelayFactor(0, 0.75), 1e-12);
+    }
+
+    PolicyRegistry& registry = PolicyRegistry::getInstance();
+    ASSERT_TRUE(registry.isRegistered("SystemOptimal"));
+    auto policy = registry.createPolicy(PolicyType::SYSTEM_OPTIMAL);
+    auto* delay = dynamic_cast<VolumeDelayPolicy*>(policy.get());
+    ASSERT_NE(delay, nullptr);
+    EXPECT_EQ(delay->getFunction(), VolumeDelayPolicy::Function::BPR);
+    EXPECT_EQ(delay->getPricing(), VolumeDelayPolicy::Pricing::MARGINAL);
+
+    // The conical system optimum has its own type, so it is rebuilt as itself
+    ASSERT_TRUE(registry.isRegistered("ConicalSystemOptimal"));
+    auto conical = registry.createPolicy(PolicyType::CONICAL_SYSTEM_OPTIMAL);
+    auto* conicalDelay = dynamic_cast<VolumeDelayPolicy*>(conical.get());
+    ASSERT_NE(conicalDelay, nullptr);
+    EXPECT_EQ(conicalDelay->getFunction(), VolumeDelayPolicy::Function::CONICAL);
+    EXPECT_EQ(conicalDelay->getPricing(), VolumeDelayPolicy::Pricing::MARGINAL);
+    EXPECT_EQ(registry.getPolicyInfo("ConicalSystemOptimal").first, "ConicalSystemOptimal");
+}
@@ -4,6 +4,7 @@
 #include "../core/Metrics.h"
 #include "../core/City.h"
 #include "../analytics/TrafficFlowAnalyzer.h"
+#include "../analytics/HotspotTracker.h"
 #include "../analytics/PolicyEffectivenessAnalyzer.h"
 #include "../analytics/PredictiveAnalyzer.h"
 #include "../analytics/ReportExporter.h"
@@ -35,7 +36,9 @@
 AnalyticsPanel::AnalyticsPanel(QWidget* parent)
     : QWidget(parent),
       m_controller(nullptr),
+      m_runner(nullptr),
       m_flowAnalyzer(std::make_unique<TrafficFlowAnalyzer>()),
+      m_hotspots(std::make_unique<HotspotTracker>()),
       m_policyAnalyzer(std::make_unique<PolicyEffectivenessAnalyzer>()),
       m_predictiveAnalyzer(std::make_unique<PredictiveAnalyzer>()),
       m_reportExporter(std::make_unique<ReportExporter>()) {
@@ -44,11 +47,28 @@ AnalyticsPanel::AnalyticsPanel(QWidget* parent)
 
 AnalyticsPanel::~AnalyticsPanel() = default;
 
-void AnalyticsPanel::setSimulationController(SimulationController* controller) {
+void AnalyticsPanel::setSimulationController(SimulationController* controller, SimulationRunner* runner) {
     m_controller = controller;
+    m_runner = runner;
+    m_hotspotTopology.reset();
+    m_hotspots->clear();
     updateAnalytics();
 }
 
+void AnalyticsPanel::applyFrame(const SimulationFrame& frame) {
+    if (!frame.topology) {
+        m_hotspotTopology.reset();
+        m_hotspots->clear();
+        return;
+    }
+    if (frame.fullRefresh || frame.topology != m_hotspotTopology) {
+        m_hotspotTopology = frame.topology;
+        m_hotspots->reset(*frame.topology, frame.edgeOccupancy);
+    } else {
+        m_hotspots->update(frame.changedEdges, frame.edgeOccupancy);
+    }
+}
+
 void AnalyticsPanel::setupUI() {
     QVBoxLayout* mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(16, 16, 16, 16);
@@ -171,12 +191,17 @@ void AnalyticsPanel::setupExportButtons() {
 }
 
 void AnalyticsPanel::updateAnalytics() {
-    if (!m_controller || !m_controller->getCity()) {
+    if (!m_controller) {
         return;
     }
-    updateFlowAnalysis();
-    updatePolicyComparison();
-    updatePredictiveAnalytics();
+    withSimulation([this]() {
+        if (!m_controller->getCity()) {
+            return;
+        }
+        updateFlowAnalysis();
+        updatePolicyComparison();
+        updatePredictiveAnalytics();
+    });
 }
 
 void AnalyticsPanel::updateFlowAnalysis() {
@@ -192,7 +217,9 @@ void AnalyticsPanel::updateHotspotTable() {
         return;
     }
     
-    auto hotspots = m_flowAnalyzer->getTopBottlenecks(*m_controller->getCity(), 10);
+    // Frame-fed ranking when available; a full scan otherwise
+    auto hotspots = m_hotspotTopology ? m_hotspots->top(10)
+                                      : m_flowAnalyzer->getTopBottlenecks(*m_controller->getCity(), 10);
     m_hotspotTable->setRowCount(static_cast<int>(hotspots.size()));
     
     for (size_t i = 0; i < hotspots.size(); ++i) {
@@ -282,8 +309,11 @@ void AnalyticsPanel::onExportPDF() {
     if (filepath.isEmpty()) return;
     
     try {
-        bool success = m_reportExporter->exportPDF(filepath, *m_controller,
-            *m_flowAnalyzer, *m_policyAnalyzer, *m_predictiveAnalyzer);
+        bool success = false;
+        withSimulation([&]() {
+            success = m_reportExporter->exportPDF(filepath, *m_controller,
+                *m_flowAnalyzer, *m_policyAnalyzer, *m_predictiveAnalyzer);
+        });
         if (success) {
             QMessageBox::information(this, "Success", "PDF report exported successfully!");
         } else {
@@ -307,7 +337,10 @@ void AnalyticsPanel::onExportPowerPoint() {
     if (filepath.isEmpty()) return;
     
     try {
-        bool success = m_reportExporter->exportPowerPoint(filepath, *m_controller, *m_flowAnalyzer);
+        bool success = false;
+        withSimulation([&]() {
+            success = m_reportExporter->exportPowerPoint(filepath, *m_controller, *m_flowAnalyzer);
+        });
         if (success) {
             QMessageBox::information(this, "Success", "PowerPoint export completed!");
         } else {
@@ -331,7 +364,10 @@ void AnalyticsPanel::onExportCSV() {
     if (filepath.isEmpty()) return;
     
     try {
-        bool success = m_reportExporter->exportCSV(filepath, *m_controller, *m_flowAnalyzer, true);
+        bool success = false;
+        withSimulation([&]() {
+            success = m_reportExporter->exportCSV(filepath, *m_controller, *m_flowAnalyzer, true);
+        });
         if (success) {
             QMessageBox::information(this, "Success", "CSV exported successfully!");
         } else {
@@ -355,8 +391,11 @@ void AnalyticsPanel::onExportJSON() {
     if (filepath.isEmpty()) return;
     
     try {
-        QString json = m_reportExporter->exportJSON(*m_controller, *m_flowAnalyzer,
-            *m_policyAnalyzer, *m_predictiveAnalyzer);
+        QString json;
+        withSimulation([&]() {
+            json = m_reportExporter->exportJSON(*m_controller, *m_flowAnalyzer,
+                *m_policyAnalyzer, *m_predictiveAnalyzer);
+        });
         bool success = m_reportExporter->saveJSON(filepath, json);
         if (success) {
             QMessageBox::information(this, "Success", "JSON API exported successfully!");
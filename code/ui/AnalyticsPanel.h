@@ -11,11 +11,13 @@
 #include <QTextEdit>
 #include <QComboBox>
 #include <memory>
+#include "../core/SimulationRunner.h"
 
 class QChart;
 class QChartView;
 class SimulationController;
 class TrafficFlowAnalyzer;
+class HotspotTracker;
 class PolicyEffectivenessAnalyzer;
 class PredictiveAnalyzer;
 class ReportExporter;
@@ -36,8 +38,19 @@ public:
     explicit AnalyticsPanel(QWidget* parent = nullptr);
     ~AnalyticsPanel();
     
-    void setSimulationController(SimulationController* controller);
+    /**
+     * @param runner When the controller is driven by a SimulationRunner,
+     *               every read is made between two ticks through it
+     */
+    void setSimulationController(SimulationController* controller, SimulationRunner* runner = nullptr);
     void updateAnalytics();
+    
+    /**
+     * Keep the bottleneck ranking current from a displayed frame's changed
+     * edges, so the hotspot table never rescans the city. Call with every
+     * frame the display takes.
+     */
+    void applyFrame(const SimulationFrame& frame);
 
 private slots:
     void onExportPDF();
@@ -94,9 +107,22 @@ private:
     QPushButton* m_exportCSVButton;
     QPushButton* m_exportJSONButton;
     
+    // Runs fn between simulation ticks when a runner drives the controller
+    template <typename Fn>
+    void withSimulation(Fn fn) {
+        if (m_runner) {
+            m_runner->withControllerNoPublish([&](SimulationController&) { fn(); });
+        } else {
+            fn();
+        }
+    }
+    
     // Data
     SimulationController* m_controller;
+    SimulationRunner* m_runner;
     std::unique_ptr<TrafficFlowAnalyzer> m_flowAnalyzer;
+    std::unique_ptr<HotspotTracker> m_hotspots;
+    std::shared_ptr<const CityTopology> m_hotspotTopology;   // Null until a frame was applied
     std::unique_ptr<PolicyEffectivenessAnalyzer> m_policyAnalyzer;
     std::unique_ptr<PredictiveAnalyzer> m_predictiveAnalyzer;
     std::unique_ptr<ReportExporter> m_reportExporter;
@@ -1,27 +1,252 @@
 // code/ui/GridView.cpp
 #include "GridView.h"
-#include "../core/SimulationController.h"
-#include "../core/City.h"
+#include "../core/CityTopology.h"
 #include "../core/Node.h"
 #include "../core/Edge.h"
-#include "../core/Agent.h"
 #include "../core/Preset.h"
+#include "../core/SimulationFrame.h"
 #include <QGraphicsScene>
 #include <QGraphicsItem>
 #include <QGraphicsObject>
 #include <QWheelEvent>
 #include <QMouseEvent>
+#include <QResizeEvent>
 #include <QKeyEvent>
 #include <QPainter>
 #include <QToolTip>
 #include <QGraphicsSceneHoverEvent>
 #include <QGraphicsSceneMouseEvent>
+#include <QStyleOptionGraphicsItem>
 #include <QPropertyAnimation>
 #include <QEasingCurve>
 #include <QScrollBar>
+#include <QElapsedTimer>
 #include <QtMath>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+// Scene layout: intersection (row, col) sits at kGridOrigin + (col, row) * kNodeSpacing
+constexpr qreal kNodeSpacing = 100.0;
+constexpr qreal kGridOrigin = 150.0;
+
+QPointF gridPosition(int row, int col) {
+    return QPointF(kGridOrigin + col * kNodeSpacing, kGridOrigin + row * kNodeSpacing);
+}
+
+} // namespace
+
+// ============================================================================
+// NetworkOverviewItem Implementation - Large-City Raster
+// ============================================================================
+
+NetworkOverviewItem::NetworkOverviewItem(const CityTopology& topology, int maxRow, int maxCol,
+                                         const QRectF& rect, QGraphicsItem* parent)
+    : QGraphicsItem(parent), m_rect(rect), m_maxRow(maxRow), m_maxCol(maxCol),
+      m_blockCols(maxCol / kBlockSize + 1), m_levelCount(1), m_paintCount(0),
+      m_density(maxCol + 1, maxRow + 1, QImage::Format_ARGB32_Premultiplied) {
+    setZValue(4); // Below per-item edges, nodes and agents
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true); // Fills exposedRect
+    m_density.fill(Qt::transparent);
+    
+    // Coarsen until the whole city fits in one tile
+    int cells = std::max(maxRow, maxCol) + 1;
+    while (levelPixels(m_levelCount - 1) * cells > kTileSize && m_levelCount < 30) {
+        ++m_levelCount;
+    }
+    
+    // Edge endpoints in grid cells, plus a coarse block index so a tile
+    // finds its edges without scanning the whole network
+    const std::vector<Edge>& edges = topology.getEdges();
+    m_spans.resize(edges.size());
+    m_colors.assign(edges.size(), 0);
+    m_occupied.assign(edges.size(), false);
+    m_blocks.resize(static_cast<size_t>(m_blockCols) * (maxRow / kBlockSize + 1));
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const Node& from = topology.getNode(edges[i].getFrom());
+        const Node& to = topology.getNode(edges[i].getTo());
+        EdgeSpan& span = m_spans[i];
+        span = {from.getRow(), from.getCol(), to.getRow(), to.getCol()};
+        if (span.fromRow < 0 || span.fromCol < 0 || span.toRow < 0 || span.toCol < 0) {
+            span.fromRow = -1;
+            continue;
+        }
+        int blockTop = std::min(span.fromRow, span.toRow) / kBlockSize;
+        int blockBottom = std::max(span.fromRow, span.toRow) / kBlockSize;
+        int blockLeft = std::min(span.fromCol, span.toCol) / kBlockSize;
+        int blockRight = std::max(span.fromCol, span.toCol) / kBlockSize;
+        for (int by = blockTop; by <= blockBottom; ++by) {
+            for (int bx = blockLeft; bx <= blockRight; ++bx) {
+                m_blocks[static_cast<size_t>(by) * m_blockCols + bx].push_back(static_cast<int>(i));
+            }
+        }
+    }
+}
+
+QRectF NetworkOverviewItem::boundingRect() const {
+    return m_rect;
+}
+
+void NetworkOverviewItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    
+    // Coarsest level that still gives at least one tile pixel per screen pixel
+    qreal screenPixels = option->levelOfDetailFromTransform(painter->worldTransform()) * kNodeSpacing;
+    int level = 0;
+    while (level < m_levelCount - 1 && levelPixels(level + 1) >= screenPixels) {
+        ++level;
+    }
+    qreal tileExtent = kTileSize * kNodeSpacing / levelPixels(level);
+    
+    QRectF exposed = option->exposedRect.intersected(m_rect);
+    if (exposed.isEmpty()) return;
+    int firstX = static_cast<int>((exposed.left() - m_rect.left()) / tileExtent);
+    int firstY = static_cast<int>((exposed.top() - m_rect.top()) / tileExtent);
+    int lastX = static_cast<int>((exposed.right() - m_rect.left()) / tileExtent);
+    int lastY = static_cast<int>((exposed.bottom() - m_rect.top()) / tileExtent);
+    
+    // Crisp pixels: each density pixel is an intersection
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, false);
+    ++m_paintCount;
+    QElapsedTimer budget;
+    budget.start();
+    for (int tileY = firstY; tileY <= lastY; ++tileY) {
+        for (int tileX = firstX; tileX <= lastX; ++tileX) {
+            QRectF target(m_rect.left() + tileX * tileExtent, m_rect.top() + tileY * tileExtent,
+                          tileExtent, tileExtent);
+            bool refresh = budget.elapsed() < kRefreshBudgetMs;
+            painter->drawImage(target, tileImage(level, tileX, tileY, refresh));
+        }
+    }
+    painter->drawImage(m_rect, m_density);
+    evictTiles();
+}
+
+void NetworkOverviewItem::setEdge(size_t edgeIndex, QRgb color, bool occupied) {
+    // Colors are bucketed by utilization, so equal colors mean nothing to redraw
+    if (m_colors[edgeIndex] == color && m_occupied[edgeIndex] == occupied) return;
+    m_colors[edgeIndex] = color;
+    m_occupied[edgeIndex] = occupied;
+    
+    const EdgeSpan& span = m_spans[edgeIndex];
+    if (span.fromRow < 0 || m_tiles.isEmpty()) return;
+    
+    for (int level = 0; level < m_levelCount; ++level) {
+        qreal cellsPerTile = kTileSize / levelPixels(level);
+        int firstX = static_cast<int>(std::min(span.fromCol, span.toCol) / cellsPerTile);
+        // One cell of slack: a cell's pixels can spill into the next tile
+        int lastX = static_cast<int>((std::max(span.fromCol, span.toCol) + 1) / cellsPerTile);
+        int firstY = static_cast<int>(std::min(span.fromRow, span.toRow) / cellsPerTile);
+        int lastY = static_cast<int>((std::max(span.fromRow, span.toRow) + 1) / cellsPerTile);
+        for (int tileY = firstY; tileY <= lastY; ++tileY) {
+            for (int tileX = firstX; tileX <= lastX; ++tileX) {
+                auto it = m_tiles.find(tileKey(level, tileX, tileY));
+                if (it != m_tiles.end()) {
+                    it->stale = true;
+                }
+            }
+        }
+    }
+}
+
+quint64 NetworkOverviewItem::tileKey(int level, int tileX, int tileY) {
+    return (static_cast<quint64>(level) << 56) | (static_cast<quint64>(tileY) << 28) | static_cast<quint64>(tileX);
+}
+
+const QImage& NetworkOverviewItem::tileImage(int level, int tileX, int tileY, bool refresh) {
+    Tile& tile = m_tiles[tileKey(level, tileX, tileY)];
+    // A tile never drawn has to be rendered now; a stale one can wait
+    if (tile.image.isNull() || (tile.stale && refresh)) {
+        if (tile.image.isNull()) {
+            tile.image = QImage(kTileSize, kTileSize, QImage::Format_ARGB32_Premultiplied);
+        }
+        renderTile(tile.image, level, tileX, tileY);
+        tile.stale = false;
+    }
+    tile.lastUsed = m_paintCount;
+    return tile.image;
+}
+
+void NetworkOverviewItem::renderTile(QImage& image, int level, int tileX, int tileY) const {
+    image.fill(Qt::transparent);
+    
+    // Grid cells under the tile; intersection (row, col) sits at the center
+    // of its cell, (col + 0.5, row + 0.5) * pixels in level coordinates
+    qreal pixels = levelPixels(level);
+    qreal cellsPerTile = kTileSize / pixels;
+    int firstCol = static_cast<int>(tileX * cellsPerTile);
+    int lastCol = std::min(m_maxCol, static_cast<int>((tileX + 1) * cellsPerTile));
+    int firstRow = static_cast<int>(tileY * cellsPerTile);
+    int lastRow = std::min(m_maxRow, static_cast<int>((tileY + 1) * cellsPerTile));
+    if (firstCol > lastCol || firstRow > lastRow) return;
+    qreal originX = tileX * kTileSize - pixels / 2;
+    qreal originY = tileY * kTileSize - pixels / 2;
+    
+    // Empty roads first so a congested direction is never hidden under
+    // its empty opposite. Long edges sit in several blocks and may be
+    // drawn twice, which is harmless.
+    auto forEachEdge = [&](auto&& draw) {
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int by = firstRow / kBlockSize; by <= lastRow / kBlockSize; ++by) {
+                for (int bx = firstCol / kBlockSize; bx <= lastCol / kBlockSize; ++bx) {
+                    for (int index : m_blocks[static_cast<size_t>(by) * m_blockCols + bx]) {
+                        if (m_occupied[index] == (pass == 1)) {
+                            draw(m_spans[index], m_colors[index]);
+                        }
+                    }
+                }
+            }
+        }
+    };
+    
+    if (pixels >= 2) {
+        QPainter painter(&image);
+        painter.translate(-originX, -originY);
+        QPen pen;
+        pen.setWidthF(std::max(1.0, pixels / 8));
+        pen.setCapStyle(Qt::SquareCap);
+        forEachEdge([&](const EdgeSpan& span, QRgb color) {
+            pen.setColor(QColor::fromRgba(color));
+            painter.setPen(pen);
+            painter.drawLine(QPointF(span.fromCol * pixels, span.fromRow * pixels),
+                             QPointF(span.toCol * pixels, span.toRow * pixels));
+        });
+        return;
+    }
+    
+    // Several intersections per pixel: plain pixel runs, no painter
+    forEachEdge([&](const EdgeSpan& span, QRgb color) {
+        int x0 = qFloor((span.fromCol + 0.5) * pixels) - tileX * kTileSize;
+        int y0 = qFloor((span.fromRow + 0.5) * pixels) - tileY * kTileSize;
+        int x1 = qFloor((span.toCol + 0.5) * pixels) - tileX * kTileSize;
+        int y1 = qFloor((span.toRow + 0.5) * pixels) - tileY * kTileSize;
+        int steps = std::max(std::abs(x1 - x0), std::abs(y1 - y0));
+        for (int i = 0; i <= steps; ++i) {
+            int x = steps > 0 ? x0 + (x1 - x0) * i / steps : x0;
+            int y = steps > 0 ? y0 + (y1 - y0) * i / steps : y0;
+            if (x >= 0 && x < kTileSize && y >= 0 && y < kTileSize) {
+                reinterpret_cast<QRgb*>(image.scanLine(y))[x] = color;
+            }
+        }
+    });
+}
+
+void NetworkOverviewItem::evictTiles() {
+    // Drop the least recently drawn tiles; never ones drawn this paint
+    while (m_tiles.size() > kMaxCachedTiles) {
+        auto oldest = m_tiles.end();
+        for (auto it = m_tiles.begin(); it != m_tiles.end(); ++it) {
+            if (oldest == m_tiles.end() || it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+        if (oldest->lastUsed == m_paintCount) break;
+        m_tiles.erase(oldest);
+    }
+}
 
 // ============================================================================
 // NodeGraphicsItem Implementation - Traffic Intersection Style
@@ -209,8 +434,8 @@ void EdgeGraphicsItem::hoverLeaveEvent(QGraphicsSceneHoverEvent* event) {
 // AgentGraphicsItem Implementation - Car Style
 // ============================================================================
 
-AgentGraphicsItem::AgentGraphicsItem(Agent* agent, PolicyType policy, QGraphicsItem* parent)
-    : QGraphicsObject(parent), m_agent(agent), m_policy(policy), m_selected(false), m_showTrail(true) {
+AgentGraphicsItem::AgentGraphicsItem(int agentId, PolicyType policy, QGraphicsItem* parent)
+    : QGraphicsObject(parent), m_agentId(agentId), m_policy(policy), m_selected(false), m_showTrail(true) {
     setAcceptHoverEvents(true);
     setZValue(20); // Agents above everything
     setFlag(QGraphicsItem::ItemIsSelectable, true);
@@ -357,8 +582,15 @@ void AgentGraphicsItem::setSelected(bool selected) {
     update();
 }
 
+void AgentGraphicsItem::setPolicy(PolicyType policy) {
+    if (m_policy != policy) {
+        m_policy = policy;
+        update();
+    }
+}
+
 void AgentGraphicsItem::mousePressEvent(QGraphicsSceneMouseEvent* event) {
-    if (event->button() == Qt::LeftButton && m_agent) {
+    if (event->button() == Qt::LeftButton) {
         setSelected(true);
         event->accept();
     }
@@ -370,7 +602,10 @@ void AgentGraphicsItem::mousePressEvent(QGraphicsSceneMouseEvent* event) {
 // ============================================================================
 
 GridView::GridView(QWidget* parent)
-    : QGraphicsView(parent), m_controller(nullptr), m_scene(new QGraphicsScene(this)),
+    : QGraphicsView(parent), m_scene(new QGraphicsScene(this)),
+      m_policy(PolicyType::SHORTEST_PATH), m_lastTick(0),
+      m_agentCount(0), m_maxRow(0), m_maxCol(0), m_overviewItem(nullptr),
+      m_detailTimer(new QTimer(this)), m_minZoom(0.2),
       m_zoomLevel(1.0), m_showGrid(true), m_showNodeLabels(false),
       m_showTrails(true), m_showHeatMap(false),
       m_panning(false), m_animationTimer(new QTimer(this)), m_selectedAgent(nullptr) {
@@ -388,6 +623,11 @@ GridView::GridView(QWidget* parent)
     connect(m_animationTimer, &QTimer::timeout, this, &GridView::onAnimationFrame);
     m_animationTimer->start();
     
+    // Pans and zooms settle before the detail area is rebuilt
+    m_detailTimer->setSingleShot(true);
+    m_detailTimer->setInterval(30);
+    connect(m_detailTimer, &QTimer::timeout, this, &GridView::updateViewportDetail);
+    
     setupScene();
 }
 
@@ -397,21 +637,55 @@ void GridView::setupScene() {
     m_scene->setSceneRect(-100, -100, 2000, 2000);
 }
 
-void GridView::setSimulationController(SimulationController* controller) {
-    m_controller = controller;
-    updateScene();
-}
-
-void GridView::updateScene() {
-    if (!m_controller) {
+void GridView::setFrame(const SimulationFrame& frame) {
+    // Items only need recreating for a different city or agent set
+    if (frame.topology != m_topology || frame.totalAgents() != m_agentCount) {
+        m_policy = frame.policy;
+        m_lastTick = frame.tick;
+        m_edgeOccupancy.assign(frame.edgeOccupancy.begin(), frame.edgeOccupancy.end());
+        rebuildScene(frame);
         return;
     }
     
-    City* city = m_controller->getCity();
-    if (!city) {
-        return;
+    // A reset jumps every agent back; old trails would cross the map
+    if (frame.tick < m_lastTick) {
+        clearAgentTrails();
+    }
+    m_lastTick = frame.tick;
+    
+    // A policy switch recolors agents (and edges, with the heat map on)
+    bool policyChanged = frame.policy != m_policy;
+    if (policyChanged) {
+        m_policy = frame.policy;
+        for (auto* item : m_agentItems.values()) {
+            item->setPolicy(m_policy);
+        }
     }
     
+    if (!frame.fullRefresh && !policyChanged) {
+        applyChanges(frame);
+    } else {
+        m_edgeOccupancy.assign(frame.edgeOccupancy.begin(), frame.edgeOccupancy.end());
+        if (isLargeCity()) {
+            m_agents.assign(frame.agents.begin(), frame.agents.end());
+            renderOverview();
+            updateEdgeColors();
+            syncDetailAgents(true);
+        } else {
+            updateEdgeColors();
+            updateAgentPositions(frame);
+        }
+    }
+    
+    for (auto* item : m_agentItems.values()) {
+        item->updateTrail();
+    }
+}
+
+void GridView::rebuildScene(const SimulationFrame& frame) {
+    bool cityChanged = frame.topology != m_topology;
+    m_topology = frame.topology;
+    
     // Stop any running animations
     for (auto* anim : m_agentAnimations.values()) {
         anim->stop();
@@ -444,122 +718,138 @@ void GridView::updateScene() {
     }
     m_agentItems.clear();
     
-    m_selectedAgent = nullptr;
+    if (m_overviewItem) {
+        m_scene->removeItem(m_overviewItem);
+        delete m_overviewItem;
+        m_overviewItem = nullptr;
+    }
+    m_nodeAt.clear();
+    m_agents.clear();
+    m_densityCounts.clear();
+    m_detailCells = QRect();
+    m_agentCount = frame.totalAgents();
+    
+    if (m_selectedAgent) {
+        m_selectedAgent = nullptr;
+        emit agentSelected(-1);
+    }
+    
+    if (!m_topology) {
+        viewport()->update();
+        return;
+    }
     
     // Reset scene rect based on new city size
-    int nodeCount = city->getNodeCount();
-    if (nodeCount > 0) {
-        // Estimate grid dimensions
-        int maxRow = 0, maxCol = 0;
-        for (int i = 0; i < nodeCount; ++i) {
-            NodeId nodeId = city->getNodeIdByIndex(i);
-            const Node& node = city->getNode(nodeId);
-            maxRow = std::max(maxRow, node.getRow());
-            maxCol = std::max(maxCol, node.getCol());
-        }
-        
-        qreal sceneWidth = (maxCol + 2) * 100.0 + 200;
-        qreal sceneHeight = (maxRow + 2) * 100.0 + 200;
+    m_maxRow = 0;
+    m_maxCol = 0;
+    for (const Node& node : m_topology->getNodes()) {
+        m_maxRow = std::max(m_maxRow, node.getRow());
+        m_maxCol = std::max(m_maxCol, node.getCol());
+    }
+    if (m_topology->getNodeCount() > 0) {
+        qreal sceneWidth = (m_maxCol + 2) * kNodeSpacing + 200;
+        qreal sceneHeight = (m_maxRow + 2) * kNodeSpacing + 200;
         m_scene->setSceneRect(0, 0, sceneWidth, sceneHeight);
     }
     
-    // Create graphics items in correct order
-    createEdgeItems();   // Edges first (below)
-    createNodeItems();   // Then nodes
-    createAgentItems();  // Agents on top
-    
-    // Update edge colors
-    updateEdgeColors();
+    if (m_topology->getNodeCount() > kMaxDetailNodes) {
+        // Large city: tiled overview now, per-item detail once zoomed in
+        QRectF overviewRect(kGridOrigin - kNodeSpacing / 2, kGridOrigin - kNodeSpacing / 2,
+                            (m_maxCol + 1) * kNodeSpacing, (m_maxRow + 1) * kNodeSpacing);
+        m_overviewItem = new NetworkOverviewItem(*m_topology, m_maxRow, m_maxCol, overviewRect);
+        m_scene->addItem(m_overviewItem);
+        
+        m_nodeAt.assign(static_cast<size_t>(m_maxRow + 1) * (m_maxCol + 1), -1);
+        const std::vector<Node>& nodes = m_topology->getNodes();
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if (nodes[i].getRow() < 0 || nodes[i].getCol() < 0) continue;
+            m_nodeAt[static_cast<size_t>(nodes[i].getRow()) * (m_maxCol + 1) + nodes[i].getCol()] = static_cast<int>(i);
+        }
+        m_agents.assign(frame.agents.begin(), frame.agents.end());
+        renderOverview();
+    } else {
+        // Create graphics items in correct order
+        createEdgeItems();          // Edges first (below)
+        createNodeItems();          // Then nodes
+        createAgentItems(frame);    // Agents on top
+        
+        // Update edge colors
+        updateEdgeColors();
+    }
     
     // Force viewport update
     viewport()->update();
     
-    // Fit to window
-    fitToWindow();
+    // Fit to window when a different city came in
+    if (cityChanged) {
+        fitToWindow();
+    }
+    if (isLargeCity()) {
+        updateViewportDetail();
+    }
 }
 
 void GridView::createNodeItems() {
-    if (!m_controller || !m_controller->getCity()) return;
+    if (!m_topology) return;
     
-    City* city = m_controller->getCity();
-    
-    // Calculate spacing for a nice grid layout
-    const qreal SPACING = 100.0;
-    qreal startX = 150;
-    qreal startY = 150;
-    
-    int nodeCount = city->getNodeCount();
-    for (int i = 0; i < nodeCount; ++i) {
-        NodeId nodeId = city->getNodeIdByIndex(i);
-        const Node& node = city->getNode(nodeId);
-        QPointF pos(startX + node.getCol() * SPACING, startY + node.getRow() * SPACING);
-        
-        NodeGraphicsItem* item = new NodeGraphicsItem(nodeId, pos);
-        item->setShowLabel(m_showNodeLabels);
-        m_scene->addItem(item);
-        m_nodeItems[nodeId] = item;
+    for (const Node& node : m_topology->getNodes()) {
+        addNodeItem(node);
     }
 }
 
 void GridView::createEdgeItems() {
-    if (!m_controller || !m_controller->getCity()) return;
-    
-    City* city = m_controller->getCity();
+    if (!m_topology) return;
     
-    // We need node positions first, so create a temporary map
-    const qreal SPACING = 100.0;
-    qreal startX = 150;
-    qreal startY = 150;
-    
-    QMap<NodeId, QPointF> nodePositions;
-    int nodeCount = city->getNodeCount();
-    for (int i = 0; i < nodeCount; ++i) {
-        NodeId nodeId = city->getNodeIdByIndex(i);
-        const Node& node = city->getNode(nodeId);
-        nodePositions[nodeId] = QPointF(startX + node.getCol() * SPACING, 
-                                        startY + node.getRow() * SPACING);
+    for (const Edge& edge : m_topology->getEdges()) {
+        addEdgeItem(edge);
     }
-    
-    int edgeCount = city->getEdgeCount();
-    for (int i = 0; i < edgeCount; ++i) {
-        EdgeId edgeId = city->getEdgeIdByIndex(i);
-        const Edge& edge = city->getEdge(edgeId);
-        
-        QPointF fromPos = nodePositions.value(edge.getFrom(), QPointF());
-        QPointF toPos = nodePositions.value(edge.getTo(), QPointF());
-        
-        if (fromPos.isNull() || toPos.isNull()) continue;
-        
-        EdgeGraphicsItem* item = new EdgeGraphicsItem(edgeId, edge.getFrom(), edge.getTo(), fromPos, toPos);
-        m_scene->addItem(item);
-        m_edgeItems[edgeId] = item;
+}
+
+void GridView::createAgentItems(const SimulationFrame& frame) {
+    for (const AgentFrame& agent : frame.agents) {
+        addAgentItem(agent, frame.policy);
     }
 }
 
-void GridView::createAgentItems() {
-    if (!m_controller) return;
-    
-    auto& agents = m_controller->getAgents();
-    PolicyType policy = m_controller->getPolicy();
+void GridView::addNodeItem(const Node& node) {
+    NodeGraphicsItem* item = new NodeGraphicsItem(node.getId(), gridPosition(node.getRow(), node.getCol()));
+    item->setShowLabel(m_showNodeLabels);
+    m_scene->addItem(item);
+    m_nodeItems[node.getId()] = item;
+}
+
+void GridView::addEdgeItem(const Edge& edge) {
+    if (m_topology->nodeIndex(edge.getFrom()) < 0 || m_topology->nodeIndex(edge.getTo()) < 0) return;
     
-    for (Agent* agent : agents) {
-        if (!agent) continue;
-        
-        QPointF pos = nodePosition(agent->getCurrentNode());
-        AgentGraphicsItem* item = new AgentGraphicsItem(agent, policy);
-        item->setPosition(pos);
-        item->setVisible(!agent->hasArrived());
-        item->setShowTrail(m_showTrails);
-        m_scene->addItem(item);
-        m_agentItems[agent] = item;
-    }
+    EdgeGraphicsItem* item = new EdgeGraphicsItem(edge.getId(), edge.getFrom(), edge.getTo(),
+                                                  nodePosition(edge.getFrom()), nodePosition(edge.getTo()));
+    m_scene->addItem(item);
+    m_edgeItems[edge.getId()] = item;
+}
+
+void GridView::addAgentItem(const AgentFrame& agent, PolicyType policy) {
+    AgentGraphicsItem* item = new AgentGraphicsItem(agent.id, policy);
+    item->setPosition(agentPosition(agent));
+    item->setVisible(!agent.arrived);
+    item->setShowTrail(m_showTrails);
+    m_scene->addItem(item);
+    m_agentItems[agent.id] = item;
 }
 
 QPointF GridView::nodePosition(NodeId nodeId) const {
-    if (m_nodeItems.contains(nodeId)) {
-        return m_nodeItems[nodeId]->pos();
+    if (!m_topology || m_topology->nodeIndex(nodeId) < 0) {
+        return QPointF(0, 0);
+    }
+    const Node& node = m_topology->getNode(nodeId);
+    return gridPosition(node.getRow(), node.getCol());
+}
+
+QPointF GridView::agentPosition(const AgentFrame& agent) const {
+    if (agent.currentEdge >= 0) {
+        const Edge& edge = m_topology->getEdge(agent.currentEdge);
+        return interpolatePosition(edge.getFrom(), edge.getTo(), 0.5);
     }
-    return QPointF(0, 0);
+    return nodePosition(agent.currentNode);
 }
 
 QPointF GridView::interpolatePosition(NodeId from, NodeId to, qreal progress) const {
@@ -568,34 +858,76 @@ QPointF GridView::interpolatePosition(NodeId from, NodeId to, qreal progress) co
     return fromPos + (toPos - fromPos) * progress;
 }
 
-void GridView::updateEdgeColors() {
-    if (!m_controller || !m_controller->getCity()) return;
+void GridView::applyChanges(const SimulationFrame& frame) {
+    if (!m_topology) return;
+    
+    const std::vector<Edge>& edges = m_topology->getEdges();
+    for (int index : frame.changedEdges) {
+        m_edgeOccupancy[index] = frame.edgeOccupancy[index];
+        const Edge& edge = edges[index];
+        if (EdgeGraphicsItem* item = m_edgeItems.value(edge.getId(), nullptr)) {
+            updateEdgeItem(item, edge, m_edgeOccupancy[index]);
+        }
+        if (isLargeCity()) {
+            updateOverviewEdge(static_cast<size_t>(index));
+        }
+    }
     
-    City* city = m_controller->getCity();
-    PolicyType currentPolicy = m_controller->getPolicy();
+    QColor trail = trailColor();
+    if (isLargeCity()) {
+        // Move each changed agent between density cells, then in or out
+        // of the detail area
+        for (int index : frame.changedAgents) {
+            const AgentFrame& agent = frame.agents[index];
+            int before = densityCell(m_agents[index]);
+            int after = densityCell(agent);
+            m_agents[index] = agent;
+            if (before != after) {
+                if (before >= 0) {
+                    --m_densityCounts[before];
+                    plotDensityCell(before);
+                }
+                if (after >= 0) {
+                    ++m_densityCounts[after];
+                    plotDensityCell(after);
+                }
+            }
+            syncDetailAgent(agent, trail, true);
+        }
+        if (!frame.changedEdges.empty() || !frame.changedAgents.empty()) {
+            m_overviewItem->update();
+        }
+    } else {
+        for (int index : frame.changedAgents) {
+            updateAgentItem(frame.agents[index], trail);
+        }
+    }
+}
+
+void GridView::updateEdgeColors() {
+    if (!m_topology) return;
     
     for (auto it = m_edgeItems.begin(); it != m_edgeItems.end(); ++it) {
-        EdgeId edgeId = it.key();
-        EdgeGraphicsItem* item = it.value();
-        
-        const Edge& edge = city->getEdge(edgeId);
-        int occupancy = city->occupancy(edgeId);
-        int capacity = edge.getCapacity();
-        double length = edge.getLength();
-        
-        item->setCongestion(occupancy, capacity, length);
-        
-        // Get target color based on policy and occupancy
-        QColor targetColor;
-        if (m_showHeatMap && currentPolicy == PolicyType::CONGESTION_AWARE) {
-            // For congestion-aware, show "perceived cost" - 
-            // roads with ANY traffic are penalized more
-            targetColor = getCongestionAwareColor(occupancy, capacity);
-        } else {
-            targetColor = getCongestionColor(occupancy, capacity);
-        }
-        item->setColor(targetColor);
+        const Edge& edge = m_topology->getEdge(it.key());
+        size_t index = static_cast<size_t>(m_topology->edgeIndex(it.key()));
+        int occupancy = index < m_edgeOccupancy.size() ? m_edgeOccupancy[index] : 0;
+        updateEdgeItem(it.value(), edge, occupancy);
+    }
+}
+
+void GridView::updateEdgeItem(EdgeGraphicsItem* item, const Edge& edge, int occupancy) {
+    item->setCongestion(occupancy, edge.getCapacity(), edge.getLength());
+    item->setColor(edgeColor(occupancy, edge.getCapacity()));
+}
+
+QColor GridView::edgeColor(int occupancy, int capacity) const {
+    // Get target color based on policy and occupancy
+    if (m_showHeatMap && m_policy != PolicyType::SHORTEST_PATH) {
+        // For congestion-aware, show "perceived cost" - 
+        // roads with ANY traffic are penalized more
+        return getCongestionAwareColor(occupancy, capacity);
     }
+    return getCongestionColor(occupancy, capacity);
 }
 
 QColor GridView::getCongestionColor(int occupancy, int capacity) const {
@@ -648,72 +980,199 @@ QColor GridView::getCongestionAwareColor(int occupancy, int capacity) const {
     }
 }
 
-void GridView::updateAgentPositions() {
-    if (!m_controller) return;
+void GridView::updateAgentPositions(const SimulationFrame& frame) {
+    QColor trail = trailColor();
+    for (const AgentFrame& agent : frame.agents) {
+        updateAgentItem(agent, trail);
+    }
+}
+
+void GridView::updateAgentItem(const AgentFrame& agent, const QColor& trailColor) {
+    AgentGraphicsItem* item = m_agentItems.value(agent.id, nullptr);
+    if (!item) return;
     
-    auto& agents = m_controller->getAgents();
+    // Hide arrived agents
+    if (agent.arrived) {
+        item->setVisible(false);
+        return;
+    }
+    
+    item->setVisible(true);
+    
+    QPointF targetPos = agentPosition(agent);
     
-    // Build set of valid agents
-    QSet<Agent*> validAgents;
-    for (Agent* agent : agents) {
-        if (agent) validAgents.insert(agent);
+    // Move agent and update trail
+    item->setPosition(targetPos);
+    item->addTrailPoint(targetPos, trailColor);
+}
+
+QColor GridView::trailColor() const {
+    return m_policy != PolicyType::SHORTEST_PATH ? QColor(50, 180, 100) : QColor(70, 130, 220);
+}
+
+void GridView::renderOverview() {
+    // Roads: the overview only re-renders tiles whose edges changed color
+    for (size_t i = 0; i < m_topology->getEdges().size(); ++i) {
+        updateOverviewEdge(i);
     }
     
-    // Remove invalid agent items
-    QList<Agent*> agentsToRemove;
-    for (auto it = m_agentItems.begin(); it != m_agentItems.end(); ++it) {
-        if (!validAgents.contains(it.key())) {
-            agentsToRemove.append(it.key());
+    // Agents: en-route count per intersection (agents on an edge count at
+    // its start), shaded against a fixed saturation so that one agent
+    // moving only repaints the two cells it left and entered
+    m_densityCounts.assign(m_nodeAt.size(), 0);
+    for (const AgentFrame& agent : m_agents) {
+        int cell = densityCell(agent);
+        if (cell >= 0) {
+            ++m_densityCounts[cell];
         }
     }
-    for (Agent* agent : agentsToRemove) {
-        AgentGraphicsItem* item = m_agentItems[agent];
-        m_scene->removeItem(item);
-        delete item;
-        m_agentItems.remove(agent);
-        if (m_selectedAgent && m_selectedAgent->agent() == agent) {
-            m_selectedAgent = nullptr;
+    m_overviewItem->density().fill(Qt::transparent);
+    for (size_t cell = 0; cell < m_densityCounts.size(); ++cell) {
+        if (m_densityCounts[cell] > 0) {
+            plotDensityCell(static_cast<int>(cell));
         }
     }
+    m_overviewItem->update();
+}
+
+void GridView::updateOverviewEdge(size_t edgeIndex) {
+    int occupancy = edgeIndex < m_edgeOccupancy.size() ? m_edgeOccupancy[edgeIndex] : 0;
+    int capacity = m_topology->getEdges()[edgeIndex].getCapacity();
+    m_overviewItem->setEdge(edgeIndex, edgeColor(occupancy, capacity).rgba(), occupancy > 0);
+}
+
+int GridView::densityCell(const AgentFrame& agent) const {
+    if (agent.arrived) return -1;
+    NodeId at = agent.currentEdge >= 0 ? m_topology->getEdge(agent.currentEdge).getFrom() : agent.currentNode;
+    const Node& node = m_topology->getNode(at);
+    if (node.getRow() < 0 || node.getCol() < 0) return -1;
+    return node.getRow() * (m_maxCol + 1) + node.getCol();
+}
+
+void GridView::plotDensityCell(int cell) {
+    int count = m_densityCounts[cell];
+    QRgb pixel = 0;     // Transparent
+    if (count > 0) {
+        QColor base = trailColor();
+        int alpha = 80 + 175 * std::min(count, kDensitySaturation) / kDensitySaturation;
+        pixel = qPremultiply(qRgba(base.red(), base.green(), base.blue(), alpha));
+    }
+    QImage& density = m_overviewItem->density();
+    reinterpret_cast<QRgb*>(density.scanLine(cell / (m_maxCol + 1)))[cell % (m_maxCol + 1)] = pixel;
+}
+
+void GridView::scheduleDetailUpdate() {
+    if (isLargeCity()) {
+        m_detailTimer->start();
+    }
+}
+
+void GridView::updateViewportDetail() {
+    if (!isLargeCity()) return;
+    
+    // Intersections under the viewport; detail only when few enough
+    QRectF visible = mapToScene(viewport()->rect()).boundingRect();
+    int left = std::max(0, qFloor((visible.left() - kGridOrigin) / kNodeSpacing));
+    int top = std::max(0, qFloor((visible.top() - kGridOrigin) / kNodeSpacing));
+    int right = std::min(m_maxCol, qCeil((visible.right() - kGridOrigin) / kNodeSpacing));
+    int bottom = std::min(m_maxRow, qCeil((visible.bottom() - kGridOrigin) / kNodeSpacing));
+    
+    QRect cells;
+    if (left <= right && top <= bottom
+        && static_cast<qint64>(right - left + 1) * (bottom - top + 1) <= kMaxDetailNodes) {
+        cells = QRect(QPoint(left, top), QPoint(right, bottom));
+    }
+    if (cells == m_detailCells) return;
     
-    // Update agent positions
-    for (Agent* agent : agents) {
-        if (!agent || !m_agentItems.contains(agent)) continue;
-        
-        AgentGraphicsItem* item = m_agentItems[agent];
-        
-        // Hide arrived agents
-        if (agent->hasArrived()) {
-            item->setVisible(false);
-            continue;
-        }
-        
-        item->setVisible(true);
-        
-        QPointF targetPos;
-        if (agent->getCurrentEdge().has_value()) {
-            EdgeId edgeId = agent->getCurrentEdge().value();
-            const Edge& edge = m_controller->getCity()->getEdge(edgeId);
-            targetPos = interpolatePosition(edge.getFrom(), edge.getTo(), 0.5);
-        } else {
-            targetPos = nodePosition(agent->getCurrentNode());
+    clearDetailItems();
+    m_detailCells = cells;
+    
+    if (!cells.isNull()) {
+        const std::vector<Node>& nodes = m_topology->getNodes();
+        for (int row = top; row <= bottom; ++row) {
+            for (int col = left; col <= right; ++col) {
+                int index = m_nodeAt[static_cast<size_t>(row) * (m_maxCol + 1) + col];
+                if (index < 0) continue;
+                
+                const Node& node = nodes[index];
+                addNodeItem(node);
+                for (EdgeId edgeId : m_topology->outgoing(node.getId())) {
+                    addEdgeItem(m_topology->getEdge(edgeId));
+                }
+            }
         }
-        
-        // Move agent and update trail
-        item->setPosition(targetPos);
-        
-        QColor trailColor = (m_controller->getPolicy() == PolicyType::CONGESTION_AWARE ? 
-                            QColor(50, 180, 100) : QColor(70, 130, 220));
-        item->addTrailPoint(targetPos, trailColor);
+        updateEdgeColors();
+        syncDetailAgents(false);
     }
+    viewport()->update();
 }
 
-void GridView::animateStep() {
-    updateEdgeColors();
-    updateAgentPositions();
+void GridView::clearDetailItems() {
+    for (auto* item : m_nodeItems.values()) {
+        m_scene->removeItem(item);
+        delete item;
+    }
+    m_nodeItems.clear();
+    
+    for (auto* item : m_edgeItems.values()) {
+        m_scene->removeItem(item);
+        delete item;
+    }
+    m_edgeItems.clear();
     
     for (auto* item : m_agentItems.values()) {
-        item->updateTrail();
+        m_scene->removeItem(item);
+        delete item;
+    }
+    m_agentItems.clear();
+    
+    if (m_selectedAgent) {
+        m_selectedAgent = nullptr;
+        emit agentSelected(-1);
+    }
+}
+
+void GridView::syncDetailAgents(bool advance) {
+    if (m_detailCells.isNull()) return;
+    
+    QColor trail = trailColor();
+    for (const AgentFrame& agent : m_agents) {
+        syncDetailAgent(agent, trail, advance);
+    }
+}
+
+void GridView::syncDetailAgent(const AgentFrame& agent, const QColor& trailColor, bool advance) {
+    if (m_detailCells.isNull()) return;
+    
+    AgentGraphicsItem* item = m_agentItems.value(agent.id, nullptr);
+    
+    bool inView = false;
+    if (!agent.arrived) {
+        NodeId at = agent.currentEdge >= 0 ? m_topology->getEdge(agent.currentEdge).getFrom() : agent.currentNode;
+        const Node& node = m_topology->getNode(at);
+        inView = m_detailCells.contains(node.getCol(), node.getRow());
+    }
+    
+    if (!inView) {
+        // Left the detail area (or arrived): back to the density layer
+        if (item) {
+            if (item == m_selectedAgent) {
+                m_selectedAgent = nullptr;
+                emit agentSelected(-1);
+            }
+            m_scene->removeItem(item);
+            delete item;
+            m_agentItems.remove(agent.id);
+        }
+        return;
+    }
+    
+    if (!item) {
+        addAgentItem(agent, m_policy);
+    } else if (advance) {
+        QPointF pos = agentPosition(agent);
+        item->setPosition(pos);
+        item->addTrailPoint(pos, trailColor);
     }
 }
 
@@ -733,6 +1192,9 @@ void GridView::fitToWindow() {
     itemsRect.adjust(-80, -80, 80, 80);
     fitInView(itemsRect, Qt::KeepAspectRatio);
     m_zoomLevel = transform().m11();
+    // Large cities fit well below the usual minimum zoom
+    m_minZoom = qMin(0.2, m_zoomLevel * 0.5);
+    scheduleDetailUpdate();
 }
 
 void GridView::setShowGrid(bool show) {
@@ -762,17 +1224,21 @@ void GridView::setShowHeatMap(bool show) {
     m_showHeatMap = show;
     // Update edge colors to show heat map
     updateEdgeColors();
+    if (isLargeCity()) {
+        renderOverview();
+    }
     viewport()->update();
 }
 
 void GridView::setZoomLevel(qreal level) {
-    level = qBound(0.2, level, 4.0);
-    if (qAbs(level - m_zoomLevel) < 0.01) return;
+    level = qBound(m_minZoom, level, 4.0);
+    if (qAbs(level - m_zoomLevel) < 0.01 * qMin(1.0, level)) return;
     
     m_zoomLevel = level;
     QTransform t;
     t.scale(level, level);
     setTransform(t);
+    scheduleDetailUpdate();
 }
 
 void GridView::wheelEvent(QWheelEvent* event) {
@@ -807,29 +1273,13 @@ void GridView::mousePressEvent(QMouseEvent* event) {
             m_selectedAgent->setSelected(false);
         }
         
-        if (agentItem) {
-            Agent* agent = agentItem->agent();
-            if (agent && m_controller) {
-                bool isValid = false;
-                auto& agents = m_controller->getAgents();
-                for (Agent* a : agents) {
-                    if (a == agent) {
-                        isValid = true;
-                        break;
-                    }
-                }
-                if (isValid) {
-                    m_selectedAgent = agentItem;
-                    agentItem->setSelected(true);
-                    emit agentSelected(agent);
-                } else {
-                    m_selectedAgent = nullptr;
-                    emit agentSelected(nullptr);
-                }
-            }
+        if (agentItem && m_agentItems.value(agentItem->agentId(), nullptr) == agentItem) {
+            m_selectedAgent = agentItem;
+            agentItem->setSelected(true);
+            emit agentSelected(agentItem->agentId());
         } else {
             m_selectedAgent = nullptr;
-            emit agentSelected(nullptr);
+            emit agentSelected(-1);
         }
     }
     
@@ -880,6 +1330,16 @@ void GridView::keyPressEvent(QKeyEvent* event) {
     }
 }
 
+void GridView::resizeEvent(QResizeEvent* event) {
+    QGraphicsView::resizeEvent(event);
+    scheduleDetailUpdate();
+}
+
+void GridView::scrollContentsBy(int dx, int dy) {
+    QGraphicsView::scrollContentsBy(dx, dy);
+    scheduleDetailUpdate();
+}
+
 void GridView::drawBackground(QPainter* painter, const QRectF& rect) {
     // Soft grass green background
     QLinearGradient gradient(rect.topLeft(), rect.bottomRight());
@@ -888,9 +1348,10 @@ void GridView::drawBackground(QPainter* painter, const QRectF& rect) {
     gradient.setColorAt(1, QColor(65, 117, 70));    // Deeper green
     painter->fillRect(rect, gradient);
     
-    // Draw grass texture pattern
-    if (m_showGrid) {
-        const qreal blockSize = 80.0;
+    // Draw grass texture pattern (skipped once blocks shrink to a few
+    // pixels; zoomed out over a large city that would be millions of shapes)
+    const qreal blockSize = 80.0;
+    if (m_showGrid && blockSize * transform().m11() >= 12.0) {
         
         qreal left = qFloor(rect.left() / blockSize) * blockSize;
         qreal top = qFloor(rect.top() / blockSize) * blockSize;
@@ -974,13 +1435,8 @@ void GridView::drawBackground(QPainter* painter, const QRectF& rect) {
     }
 }
 
-void GridView::updateAgentTrail(AgentGraphicsItem* agentItem, Agent* agent) {
-    Q_UNUSED(agentItem);
-    Q_UNUSED(agent);
-}
-
 void GridView::clearAgentTrails() {
     for (auto* item : m_agentItems.values()) {
-        // Trails are cleared in AgentGraphicsItem
+        item->clearTrail();
     }
 }
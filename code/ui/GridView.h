@@ -5,36 +5,64 @@
 #include <QTimer>
 #include <QPropertyAnimation>
 #include <QGraphicsItem>
+#include <QHash>
+#include <QImage>
 #include <QMap>
 #include <QSet>
 #include <memory>
+#include <vector>
 #include "../core/Types.h"
 #include "../core/Preset.h"
 
 // Forward declarations
-class City;
-class Agent;
-class SimulationController;
+class CityTopology;
+class Node;
+class Edge;
+struct AgentFrame;
+struct SimulationFrame;
 class NodeGraphicsItem;
 class EdgeGraphicsItem;
 class AgentGraphicsItem;
+class NetworkOverviewItem;
 
 /**
  * Modern grid view with smooth animations, zoom, pan, and interactive features.
  * Implements a professional dark-themed visualization.
+ *
+ * Renders SimulationFrames handed over by the display timer and never
+ * touches the live City or Agents, so painting cannot race the simulation
+ * thread.
+ *
+ * Level of detail: cities up to kMaxDetailNodes nodes get one item per
+ * node, edge and agent. Larger cities are drawn as a NetworkOverviewItem
+ * (cached road tiles colored by congestion plus an agent-density layer);
+ * per-item detail is only created for the part of the city inside the
+ * viewport, and only once the view is zoomed in far enough that it holds
+ * at most kMaxDetailNodes nodes.
+ *
+ * Frames are applied incrementally: only the edges and agents listed in
+ * the frame's change lists are touched, in both modes. Everything is
+ * compared again only on a full-refresh frame or a policy switch.
  */
 class GridView : public QGraphicsView {
     Q_OBJECT
     Q_PROPERTY(qreal zoomLevel READ zoomLevel WRITE setZoomLevel)
 
 public:
+    // Most nodes drawn as individual items (whole city or visible part)
+    static constexpr int kMaxDetailNodes = 400;
+    // Agents at one intersection for the darkest density shade
+    static constexpr int kDensitySaturation = 8;
+
     explicit GridView(QWidget* parent = nullptr);
     ~GridView();
 
-    // Setup and update
-    void setSimulationController(SimulationController* controller);
-    void updateScene();
-    void animateStep();
+    /**
+     * Show a frame. The scene is rebuilt only when the city or the number
+     * of agents changed; otherwise the frame's changed edges and agents are
+     * updated in place (all of them on a full-refresh frame).
+     */
+    void setFrame(const SimulationFrame& frame);
 
     // View controls
     void fitToWindow();
@@ -49,7 +77,7 @@ public:
     AgentGraphicsItem* selectedAgent() const { return m_selectedAgent; }
 
 signals:
-    void agentSelected(Agent* agent);
+    void agentSelected(int agentId);    // -1 when the selection is cleared
 
 protected:
     void wheelEvent(QWheelEvent* event) override;
@@ -57,32 +85,72 @@ protected:
     void mouseMoveEvent(QMouseEvent* event) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void scrollContentsBy(int dx, int dy) override;
     void drawBackground(QPainter* painter, const QRectF& rect) override;
 
 private slots:
     void onAnimationFrame();
+    void updateViewportDetail();
 
 private:
     void setupScene();
+    void rebuildScene(const SimulationFrame& frame);
     void createNodeItems();
     void createEdgeItems();
-    void createAgentItems();
+    void createAgentItems(const SimulationFrame& frame);
+    void addNodeItem(const Node& node);
+    void addEdgeItem(const Edge& edge);
+    void addAgentItem(const AgentFrame& agent, PolicyType policy);
+    void applyChanges(const SimulationFrame& frame);
     void updateEdgeColors();
-    void updateAgentPositions();
+    void updateEdgeItem(EdgeGraphicsItem* item, const Edge& edge, int occupancy);
+    void updateAgentPositions(const SimulationFrame& frame);
+    void updateAgentItem(const AgentFrame& agent, const QColor& trailColor);
+    QColor trailColor() const;
+    QColor edgeColor(int occupancy, int capacity) const;
     QColor getCongestionColor(int occupancy, int capacity) const;
     QColor getCongestionAwareColor(int occupancy, int capacity) const;
     QPointF nodePosition(NodeId nodeId) const;
+    QPointF agentPosition(const AgentFrame& agent) const;
+    
+    // Large-city level of detail
+    bool isLargeCity() const { return m_overviewItem != nullptr; }
+    void renderOverview();
+    void updateOverviewEdge(size_t edgeIndex);
+    int densityCell(const AgentFrame& agent) const;
+    void plotDensityCell(int cell);
+    void scheduleDetailUpdate();
+    void clearDetailItems();
+    void syncDetailAgents(bool advance);
+    void syncDetailAgent(const AgentFrame& agent, const QColor& trailColor, bool advance);
     QPointF interpolatePosition(NodeId from, NodeId to, qreal progress) const;
-    void updateAgentTrail(AgentGraphicsItem* agentItem, Agent* agent);
     void clearAgentTrails();
 
-    SimulationController* m_controller;
     QGraphicsScene* m_scene;
     
+    // What the scene was built from (kept from the last frame)
+    std::shared_ptr<const CityTopology> m_topology;
+    PolicyType m_policy;
+    int m_lastTick;
+    std::vector<int> m_edgeOccupancy;   // By edge index, for heat-map toggles
+    int m_agentCount;
+    int m_maxRow;
+    int m_maxCol;
+    
+    // Large cities: raster overview and the viewport's detail area
+    NetworkOverviewItem* m_overviewItem;
+    std::vector<int> m_nodeAt;          // Node index by row * (m_maxCol + 1) + col, -1 if none
+    std::vector<AgentFrame> m_agents;   // Last frame's agents, for detail after pans
+    std::vector<int> m_densityCounts;   // En-route agents by intersection cell
+    QRect m_detailCells;                // Visible (col, row) range with detail; null if none
+    QTimer* m_detailTimer;              // Coalesces scroll/zoom into one detail update
+    qreal m_minZoom;
+    
     // Graphics items
     QMap<NodeId, NodeGraphicsItem*> m_nodeItems;
     QMap<EdgeId, EdgeGraphicsItem*> m_edgeItems;
-    QMap<Agent*, AgentGraphicsItem*> m_agentItems;
+    QMap<int, AgentGraphicsItem*> m_agentItems;     // By agent id
     
     // View state
     qreal m_zoomLevel;
@@ -110,6 +178,78 @@ private:
     QMap<AgentGraphicsItem*, QList<TrailPoint>> m_agentTrails;
 };
 
+/**
+ * Whole-network picture for large cities: roads colored by congestion and
+ * agents aggregated into a per-intersection density layer.
+ *
+ * Roads are rendered into kTileSize-pixel tiles at a pyramid of zoom
+ * levels: level 0 has kFinestPixels pixels per node spacing and each level
+ * halves that, down to one where the whole city fits in a tile. A paint
+ * draws only the visible tiles of the level matching the view scale, so
+ * panning and zooming cost a handful of image blits however many edges the
+ * city has. Tiles stay cached (up to kMaxCachedTiles, least recently drawn
+ * dropped first). setEdge() marks tiles stale only when an edge's color
+ * bucket changes; stale tiles are redrawn within kRefreshBudgetMs per
+ * paint and show their previous picture until then.
+ */
+class NetworkOverviewItem : public QGraphicsItem {
+public:
+    static constexpr int kTileSize = 256;
+    static constexpr int kFinestPixels = 64;
+    static constexpr int kMaxCachedTiles = 128;
+    static constexpr int kRefreshBudgetMs = 6;
+    
+    /**
+     * @param topology City to draw (node rows/cols give the layout)
+     * @param rect Scene rect covering one node spacing around every node
+     */
+    NetworkOverviewItem(const CityTopology& topology, int maxRow, int maxCol,
+                        const QRectF& rect, QGraphicsItem* parent = nullptr);
+    
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
+    
+    /**
+     * Set the color an edge is drawn in; occupied edges are drawn over
+     * empty ones sharing the same road. Only the cached tiles the edge
+     * crosses are invalidated, and only if the color changed.
+     */
+    void setEdge(size_t edgeIndex, QRgb color, bool occupied);
+    
+    // One pixel per intersection; call update() after changing it
+    QImage& density() { return m_density; }
+    
+private:
+    struct EdgeSpan {
+        int fromRow, fromCol, toRow, toCol;
+    };
+    struct Tile {
+        QImage image;
+        bool stale = true;
+        quint64 lastUsed = 0;
+    };
+    static constexpr int kBlockSize = 16;   // Nodes per side of a spatial-index block
+    
+    static quint64 tileKey(int level, int tileX, int tileY);
+    static qreal levelPixels(int level) { return qreal(kFinestPixels) / (1 << level); }
+    const QImage& tileImage(int level, int tileX, int tileY, bool refresh);
+    void renderTile(QImage& image, int level, int tileX, int tileY) const;
+    void evictTiles();
+    
+    QRectF m_rect;
+    int m_maxRow;
+    int m_maxCol;
+    std::vector<EdgeSpan> m_spans;          // By edge index; fromRow < 0 if not drawable
+    std::vector<QRgb> m_colors;
+    std::vector<bool> m_occupied;
+    std::vector<std::vector<int>> m_blocks; // Edge indices by kBlockSize x kBlockSize node block
+    int m_blockCols;
+    int m_levelCount;
+    QHash<quint64, Tile> m_tiles;
+    quint64 m_paintCount;
+    QImage m_density;
+};
+
 /**
  * Graphics item for a node (intersection).
  * Circular with subtle glow effect.
@@ -182,12 +322,12 @@ private:
 class AgentGraphicsItem : public QGraphicsObject {
     Q_OBJECT
 public:
-    AgentGraphicsItem(Agent* agent, PolicyType policy, QGraphicsItem* parent = nullptr);
+    AgentGraphicsItem(int agentId, PolicyType policy, QGraphicsItem* parent = nullptr);
     
     QRectF boundingRect() const override;
     void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) override;
     
-    Agent* agent() const { return m_agent; }
+    int agentId() const { return m_agentId; }
     void setPosition(const QPointF& pos);
     QPointF position() const { return m_position; }
     void addTrailPoint(const QPointF& pos, const QColor& color);
@@ -196,6 +336,7 @@ public:
     void setShowTrail(bool show) { m_showTrail = show; }
     void setSelected(bool selected);
     bool isSelected() const { return m_selected; }
+    void setPolicy(PolicyType policy);
     
 protected:
     void mousePressEvent(QGraphicsSceneMouseEvent* event) override;
@@ -207,7 +348,7 @@ private:
         QColor color;
     };
     
-    Agent* m_agent;
+    int m_agentId;
     PolicyType m_policy;
     QPointF m_position;
     QList<TrailPoint> m_trail;
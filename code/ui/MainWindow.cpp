@@ -2,9 +2,9 @@
 #include "GridView.h"
 #include "MetricsPanel.h"
 #include "../core/SimulationController.h"
-#include "../core/Agent.h"
+#include "../core/SimulationFrame.h"
+#include "../core/SimulationRunner.h"
 #include "../core/Preset.h"
-#include "../core/Metrics.h"
 #include "../adapters/PresetLoader.h"
 #include <vector>
 #include <string>
@@ -32,6 +32,7 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QtMath>
 #include <QFrame>
 #include <QScrollArea>
@@ -39,7 +40,7 @@
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent), m_gridView(nullptr), m_metricsPanel(nullptr),
-      m_analyticsPanel(nullptr), m_controller(nullptr), m_simulationTimer(new QTimer(this)), 
+      m_analyticsPanel(nullptr), m_controller(nullptr), m_displayTimer(new QTimer(this)), 
       m_fpsTimer(new QTimer(this)), m_isRunning(false), m_currentSpeed(1),
       m_frameCount(0), m_lastFpsUpdate(0), m_zoomSlider(nullptr), m_zoomLabel(nullptr),
       m_toastLabel(nullptr), m_toastAnimation(nullptr),
@@ -56,8 +57,10 @@ MainWindow::MainWindow(QWidget* parent)
     setupStyles();
     connectSignals();
     
-    // Create default simulation controller
+    // Create default simulation controller, ticked on its own thread
     m_controller = &SimulationController::getInstance();
+    m_runner = std::make_unique<SimulationRunner>(*m_controller);
+    applyTickInterval();
     
     // Load a default preset
     PresetLoader loader;
@@ -91,10 +94,7 @@ MainWindow::MainWindow(QWidget* parent)
             preset.setPolicy(PolicyType::SHORTEST_PATH);
         }
         
-        m_controller->loadPreset(preset);
-        m_gridView->setSimulationController(m_controller);
-        m_metricsPanel->setSimulationController(m_controller);
-        m_gridView->updateScene();
+        m_runner->withController([&](SimulationController& c) { c.loadPreset(preset); });
         
         // Initialize traffic legend for default 5x5 grid (capacity 2)
         updateTrafficLegend(2);
@@ -105,7 +105,8 @@ MainWindow::MainWindow(QWidget* parent)
     }
     
     updateControls();
-    updateToolbarStats();
+    onDisplayFrame();
+    m_displayTimer->start();
     
     QTimer::singleShot(100, this, [this]() {
         if (m_gridView) {
@@ -117,13 +118,19 @@ MainWindow::MainWindow(QWidget* parent)
 MainWindow::~MainWindow() = default;
 
 void MainWindow::setSimulationController(SimulationController* controller) {
+    // Stop the old worker before it can outlive its controller
+    m_runner.reset();
+    m_isRunning = false;
     m_controller = controller;
-    if (m_gridView) {
-        m_gridView->setSimulationController(controller);
+    if (m_controller) {
+        m_runner = std::make_unique<SimulationRunner>(*m_controller);
+        applyTickInterval();
     }
-    if (m_metricsPanel) {
-        m_metricsPanel->setSimulationController(controller);
+    if (m_analyticsPanel) {
+        m_analyticsPanel->setSimulationController(m_controller, m_runner.get());
     }
+    updateControls();
+    onDisplayFrame();
 }
 
 void MainWindow::setupUI() {
@@ -265,6 +272,7 @@ void MainWindow::setupMenuBar() {
     m_fileMenu->addSeparator();
     m_fileMenu->addAction("Export Results (CSV)...", this, &MainWindow::onExportCSV);
     m_fileMenu->addAction("Export Results (JSON)...", this, &MainWindow::onExportJSON);
+    m_fileMenu->addAction("Export Tick Profile (Chrome Trace)...", this, &MainWindow::onExportProfile);
     m_fileMenu->addSeparator();
     m_fileMenu->addAction("Quit", this, &QWidget::close, QKeySequence::Quit);
     
@@ -325,11 +333,19 @@ void MainWindow::setupToolBar() {
     m_toolbar->addWidget(policyLabel);
     
     m_policyCombo = new QComboBox(this);
-    m_policyCombo->addItem("Shortest Path");
-    m_policyCombo->addItem("Congestion-Aware");
+    m_policyCombo->addItem("Shortest Path", static_cast<int>(PolicyType::SHORTEST_PATH));
+    m_policyCombo->addItem("Congestion-Aware", static_cast<int>(PolicyType::CONGESTION_AWARE));
+    m_policyCombo->addItem("BPR Volume-Delay", static_cast<int>(PolicyType::BPR));
+    m_policyCombo->addItem("Conical Volume-Delay", static_cast<int>(PolicyType::CONICAL));
+    m_policyCombo->addItem("System Optimal", static_cast<int>(PolicyType::SYSTEM_OPTIMAL));
+    m_policyCombo->addItem("Conical System Optimal", static_cast<int>(PolicyType::CONICAL_SYSTEM_OPTIMAL));
+    m_policyCombo->addItem("Route Diversity", static_cast<int>(PolicyType::ROUTE_DIVERSITY));
     m_policyCombo->setToolTip("Choose how vehicles find their routes:\n"
                               "• Shortest Path: Always take the quickest route (ignores traffic)\n"
-                              "• Congestion-Aware: Avoids busy roads, may take longer routes");
+                              "• Congestion-Aware: Avoids busy roads, may take longer routes\n"
+                              "• BPR / Conical: Travel time grows with load as in traffic-planning models\n"
+                              "• System Optimal: Routes on the delay each vehicle causes others, not just its own\n"
+                              "• Route Diversity: Spreads vehicles with the same trip over several short routes");
     m_policyCombo->setMinimumWidth(160);
     m_policyCombo->setSizeAdjustPolicy(QComboBox::AdjustToContents);
     m_toolbar->addWidget(m_policyCombo);
@@ -969,8 +985,8 @@ void MainWindow::connectSignals() {
         connect(m_gridView, &GridView::agentSelected, this, &MainWindow::onAgentSelected);
     }
     
-    connect(m_simulationTimer, &QTimer::timeout, this, &MainWindow::onTick);
-    m_simulationTimer->setInterval(300);
+    connect(m_displayTimer, &QTimer::timeout, this, &MainWindow::onDisplayFrame);
+    m_displayTimer->setInterval(16); // ~60 FPS, independent of the tick rate
 }
 
 void MainWindow::updateControls() {
@@ -986,52 +1002,25 @@ void MainWindow::updateControls() {
     }
 }
 
-void MainWindow::updateToolbarStats() {
-    if (!m_controller) {
-        m_tickLabel->setText("  Time: 0  ");
-        m_agentsLabel->setText("  Vehicles: 0/0  ");
-        return;
-    }
-    
-    Metrics* metrics = m_controller->getMetrics();
-    auto& agents = m_controller->getAgents();
-    
-    if (metrics) {
-        m_tickLabel->setText(QString("  Time: %1  ").arg(metrics->getCurrentTick()));
-    }
-    
-    int totalAgents = agents.size();
-    int activeAgents = 0;
-    for (Agent* agent : agents) {
-        if (agent && !agent->hasArrived()) {
-            activeAgents++;
-        }
-    }
-    
-    m_agentsLabel->setText(QString("  Vehicles: %1/%2  ").arg(activeAgents).arg(totalAgents));
+void MainWindow::updateToolbarStats(const SimulationFrame& frame) {
+    m_tickLabel->setText(QString("  Time: %1  ").arg(frame.tick));
+    m_agentsLabel->setText(QString("  Vehicles: %1/%2  ").arg(frame.activeAgents).arg(frame.totalAgents()));
     
     // Update quick stats
-    if (metrics) {
-        int arrivedCount = totalAgents - activeAgents;
-        double avgTrip = 0.0;
-        if (arrivedCount > 0) {
-            int totalTime = 0;
-            for (Agent* agent : agents) {
-                if (agent && agent->hasArrived()) {
-                    totalTime += agent->getTravelTime();
-                }
-            }
-            avgTrip = static_cast<double>(totalTime) / arrivedCount;
-        }
-        
-        if (arrivedCount > 0) {
-            m_avgTripLabel->setText(QString("Avg. Trip Time: %1 steps").arg(avgTrip, 0, 'f', 1));
-        } else {
-            m_avgTripLabel->setText("Avg. Trip Time: -- steps");
-        }
-        m_throughputLabel->setText(QString("Completed Trips: %1").arg(arrivedCount));
-        m_maxLoadLabel->setText(QString("Busiest Road: %1 vehicles").arg(metrics->getMaxEdgeLoad()));
+    if (frame.arrivedAgents > 0) {
+        m_avgTripLabel->setText(QString("Avg. Trip Time: %1 steps").arg(frame.averageTravelTime, 0, 'f', 1));
+    } else {
+        m_avgTripLabel->setText("Avg. Trip Time: -- steps");
     }
+    m_throughputLabel->setText(QString("Completed Trips: %1").arg(frame.arrivedAgents));
+    m_maxLoadLabel->setText(QString("Busiest Road: %1 vehicles").arg(frame.maxEdgeLoad));
+}
+
+void MainWindow::applyTickInterval() {
+    if (!m_runner) return;
+    
+    int baseInterval = 300;
+    m_runner->setTickInterval(std::chrono::milliseconds(baseInterval / m_currentSpeed));
 }
 
 void MainWindow::updateTrafficLegend(int capacity) {
@@ -1125,75 +1114,68 @@ void MainWindow::updateFPS() {
 }
 
 void MainWindow::onStartClicked() {
-    if (!m_controller) return;
+    if (!m_runner) return;
     
-    m_controller->start();
+    applyTickInterval();
+    m_runner->start();
     m_isRunning = true;
     
-    int baseInterval = 300;
-    int actualInterval = baseInterval / m_currentSpeed;
-    m_simulationTimer->setInterval(qMax(30, actualInterval));
-    m_simulationTimer->start();
-    
     updateControls();
 }
 
 void MainWindow::onPauseClicked() {
-    if (!m_controller) return;
+    if (!m_runner) return;
     
-    m_controller->pause();
+    m_runner->pause();
     m_isRunning = false;
-    m_simulationTimer->stop();
     updateControls();
 }
 
 void MainWindow::onResetClicked() {
-    if (!m_controller) return;
+    if (!m_runner) return;
     
-    m_controller->reset();
+    m_runner->pause();
+    m_runner->withController([](SimulationController& c) { c.reset(); });
     m_isRunning = false;
-    m_simulationTimer->stop();
-    
-    if (m_gridView) {
-        m_gridView->updateScene();
-    }
-    if (m_metricsPanel) {
-        m_metricsPanel->updateMetrics();
-    }
     
     updateControls();
-    updateToolbarStats();
+    onDisplayFrame();
 }
 
-void MainWindow::onTick() {
-    if (!m_controller || !m_isRunning) return;
+void MainWindow::onDisplayFrame() {
+    if (!m_runner || !m_runner->pollFrame()) return;
     
-    m_controller->tick();
+    const SimulationFrame& frame = m_runner->currentFrame();
     m_frameCount++;
     
+#if GRIDLOCK_PROFILING
+    QElapsedTimer uiTimer;
+    uiTimer.start();
+#endif
+    
     if (m_gridView) {
-        m_gridView->animateStep();
+        m_gridView->setFrame(frame);
     }
     if (m_metricsPanel) {
-        m_metricsPanel->updateMetrics();
+        m_metricsPanel->updateMetrics(frame);
+    }
+    if (m_analyticsPanel) {
+        m_analyticsPanel->applyFrame(frame);
     }
     
-    updateToolbarStats();
+    updateToolbarStats(frame);
     
-    // Check if all agents have arrived - auto-pause simulation
-    auto& agents = m_controller->getAgents();
-    int activeAgents = 0;
-    for (Agent* agent : agents) {
-        if (agent && !agent->hasArrived()) {
-            activeAgents++;
-        }
-    }
+#if GRIDLOCK_PROFILING
+    // Charge the repaint work to the newest recorded tick
+    qint64 uiNs = uiTimer.nsecsElapsed();
+    m_runner->withControllerNoPublish([uiNs](SimulationController& c) {
+        c.getProfiler().addToLastTick(TickPhase::UI, uiNs);
+    });
+#endif
     
-    if (activeAgents == 0 && !agents.empty()) {
-        // All agents have arrived - pause simulation
+    // The runner pauses itself once every agent has arrived
+    if (m_isRunning && frame.finished) {
         m_isRunning = false;
-        m_simulationTimer->stop();
-        m_controller->pause();
         updateControls();
         statusBar()->showMessage("Simulation Complete - All vehicles reached their destinations!", 0);
         showToast("Simulation complete!");
@@ -1208,8 +1190,8 @@ void MainWindow::onTick() {
     lastUpdate = now;
 }
 
-void MainWindow::onAgentSelected(Agent* agent) {
-    Q_UNUSED(agent);
+void MainWindow::onAgentSelected(int agentId) {
+    Q_UNUSED(agentId);
 }
 
 void MainWindow::onFitToWindow() {
@@ -1251,25 +1233,18 @@ void MainWindow::onToggleHeatMap() {
 }
 
 void MainWindow::onPolicyChanged(int index) {
-    if (!m_controller) return;
+    if (!m_runner) return;
     
-    PolicyType policy = (index == 0) ? PolicyType::SHORTEST_PATH : PolicyType::CONGESTION_AWARE;
-    m_controller->setPolicy(policy);
-    
-    if (m_gridView) {
-        m_gridView->updateScene();
-    }
+    PolicyType policy = static_cast<PolicyType>(m_policyCombo->itemData(index).toInt());
+    // The published frame carries the new policy; GridView rebuilds on it
+    m_runner->withController([policy](SimulationController& c) { c.setPolicy(policy); });
 }
 
 void MainWindow::onSpeedChanged(int value) {
     m_currentSpeed = value;
     m_speedLabel->setText(QString(" %1x ").arg(value));
     
-    if (m_isRunning && m_simulationTimer) {
-        int baseInterval = 300;
-        int actualInterval = baseInterval / value;
-        m_simulationTimer->setInterval(qMax(30, actualInterval));
-    }
+    applyTickInterval();
 }
 
 void MainWindow::onLoadPreset() {
@@ -1310,8 +1285,7 @@ void MainWindow::onLoadPreset() {
     // Stop simulation first
     if (m_isRunning) {
         m_isRunning = false;
-        m_simulationTimer->stop();
-        if (m_controller) m_controller->pause();
+        if (m_runner) m_runner->pause();
     }
     
     // Create preset directly (don't rely on file loading)
@@ -1323,8 +1297,7 @@ void MainWindow::onLoadPreset() {
     preset.setTickMs(100);
     
     // Set policy based on current combo selection
-    PolicyType policy = (m_policyCombo->currentIndex() == 0) ? 
-                        PolicyType::SHORTEST_PATH : PolicyType::CONGESTION_AWARE;
+    PolicyType policy = static_cast<PolicyType>(m_policyCombo->currentData().toInt());
     preset.setPolicy(policy);
     
     // Add blocked edges for larger grids
@@ -1338,21 +1311,15 @@ void MainWindow::onLoadPreset() {
     
     try {
         // Reset and load the new preset
-        if (m_controller) {
-            m_controller->reset();
-            m_controller->loadPreset(preset);
+        if (m_runner) {
+            m_runner->withController([&](SimulationController& c) {
+                c.reset();
+                c.loadPreset(preset);
+            });
         }
         
-        // Force complete scene rebuild
-        if (m_gridView && m_controller) {
-            m_gridView->setSimulationController(m_controller);
-            m_gridView->updateScene();
-        }
-        
-        if (m_metricsPanel && m_controller) {
-            m_metricsPanel->setSimulationController(m_controller);
-            m_metricsPanel->updateMetrics();
-        }
+        // The new city's frame is already published; show it right away
+        onDisplayFrame();
         
         // Update zoom slider
         if (m_zoomSlider) {
@@ -1388,7 +1355,6 @@ void MainWindow::onLoadPreset() {
         });
         
         updateControls();
-        updateToolbarStats();
         showToast("Loaded: " + cityName + " (" + QString::number(agentCount) + " vehicles)");
         
     } catch (const std::exception& e) {
@@ -1418,6 +1384,34 @@ void MainWindow::onExportJSON() {
     }
 }
 
+void MainWindow::onExportProfile() {
+    if (!m_runner) return;
+    
+    size_t recorded = m_runner->withControllerNoPublish([](SimulationController& c) {
+        return c.getProfiler().getRecordCount();
+    });
+    if (recorded == 0) {
+        QMessageBox::information(this, "Export Tick Profile",
+            "No tick profile recorded. Build with GRIDLOCK_ENABLE_PROFILING=ON and run the simulation first.");
+        return;
+    }
+    
+    QString fileName = QFileDialog::getSaveFileName(this, "Export Tick Profile",
+        QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + "/gridlock_trace.json",
+        "Chrome Trace (*.json)");
+    
+    if (!fileName.isEmpty()) {
+        try {
+            m_runner->withControllerNoPublish([&](SimulationController& c) {
+                c.getProfiler().exportChromeTrace(fileName.toStdString());
+            });
+            showToast("Tick profile exported");
+        } catch (const std::exception& e) {
+            QMessageBox::warning(this, "Export Tick Profile", e.what());
+        }
+    }
+}
+
 void MainWindow::onSaveConfig() {
     QString fileName = QFileDialog::getSaveFileName(this, "Save Configuration",
         QStandardPaths::writableLocation(QStandardPaths::DownloadLocation) + "/config.json",
@@ -1462,7 +1456,7 @@ void MainWindow::onAbout() {
 void MainWindow::onOpenAnalytics() {
     if (!m_analyticsPanel) {
         m_analyticsPanel = new AnalyticsPanel(this);
-        m_analyticsPanel->setSimulationController(m_controller);
+        m_analyticsPanel->setSimulationController(m_controller, m_runner.get());
         m_analyticsPanel->setWindowTitle("Traffic Analytics Dashboard");
         m_analyticsPanel->resize(1000, 700);
     }
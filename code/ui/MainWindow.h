@@ -27,11 +27,15 @@
 class GridView;
 class MetricsPanel;
 class SimulationController;
-class Agent;
+class SimulationRunner;
+struct SimulationFrame;
 
 /**
  * Main window with modern dark theme and professional UI.
  * Features: Toolbar, collapsible control panel, metrics panel, status bar, menu bar.
+ *
+ * The simulation ticks on a SimulationRunner thread; the window only polls
+ * for the latest frame at display rate and sends commands to the runner.
  */
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -46,8 +50,8 @@ private slots:
     void onStartClicked();
     void onPauseClicked();
     void onResetClicked();
-    void onTick();
-    void onAgentSelected(Agent* agent);
+    void onDisplayFrame();
+    void onAgentSelected(int agentId);
     void onFitToWindow();
     void onToggleGrid();
     void onToggleNodeLabels();
@@ -58,6 +62,7 @@ private slots:
     void onLoadPreset();
     void onExportCSV();
     void onExportJSON();
+    void onExportProfile();
     void onSaveConfig();
     void onZoomIn();
     void onZoomOut();
@@ -75,7 +80,8 @@ private:
     void setupStyles();
     void connectSignals();
     void updateControls();
-    void updateToolbarStats();
+    void updateToolbarStats(const SimulationFrame& frame);
+    void applyTickInterval();
     void showToast(const QString& message);
     void updateFPS();
     
@@ -147,7 +153,8 @@ private:
     
     // Simulation
     SimulationController* m_controller;
-    QTimer* m_simulationTimer;
+    std::unique_ptr<SimulationRunner> m_runner;
+    QTimer* m_displayTimer;     // Polls the runner for new frames
     QTimer* m_fpsTimer;
     bool m_isRunning;
     int m_currentSpeed; // 1-10x multiplier
@@ -1,7 +1,5 @@
 #include "MetricsPanel.h"
-#include "../core/SimulationController.h"
-#include "../core/Metrics.h"
-#include "../core/Agent.h"
+#include "../core/SimulationFrame.h"
 #include "../core/Preset.h"
 #include "../core/Types.h"
 #include <QVBoxLayout>
@@ -36,7 +34,8 @@
 QT_USE_NAMESPACE
 
 MetricsPanel::MetricsPanel(QWidget* parent)
-    : QWidget(parent), m_controller(nullptr),
+    : QWidget(parent),
+      m_lastChartTick(-1),
       m_prevAvgTime(0.0), m_prevCompleted(0), m_prevMaxLoad(0),
       m_shortestPathAvgTime(0.0), m_congestionAwareAvgTime(0.0),
       m_shortestPathThroughput(0), m_congestionAwareThroughput(0),
@@ -56,11 +55,6 @@ MetricsPanel::MetricsPanel(QWidget* parent)
 
 MetricsPanel::~MetricsPanel() = default;
 
-void MetricsPanel::setSimulationController(SimulationController* controller) {
-    m_controller = controller;
-    updateMetrics();
-}
-
 void MetricsPanel::setupUI() {
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(16, 16, 16, 16);
@@ -387,44 +381,19 @@ void MetricsPanel::applyChartTheme(QChart* chart) {
     }
 }
 
-void MetricsPanel::updateMetrics() {
-    if (!m_controller) {
-        return;
-    }
-    
-    Metrics* metrics = m_controller->getMetrics();
-    auto& agents = m_controller->getAgents();
-    
-    if (!metrics) {
-        return;
-    }
-    
-    // Calculate metrics
-    int activeCount = 0;
-    int arrivedCount = 0;
-    int totalTravelTime = 0;
-    int maxLoad = metrics->getMaxEdgeLoad();
-    
-    for (Agent* agent : agents) {
-        if (!agent) continue;
-        if (agent->hasArrived()) {
-            arrivedCount++;
-            totalTravelTime += agent->getTravelTime();
-        } else {
-            activeCount++;
-        }
-    }
-    
-    double avgTravelTime = arrivedCount > 0 ? static_cast<double>(totalTravelTime) / arrivedCount : 0.0;
+void MetricsPanel::updateMetrics(const SimulationFrame& frame) {
+    int arrivedCount = frame.arrivedAgents;
+    int maxLoad = frame.maxEdgeLoad;
+    double avgTravelTime = frame.averageTravelTime;
     
     // Update stat cards
     updateStatCards(avgTravelTime, arrivedCount, maxLoad);
     
     // Update charts
-    updateCharts(avgTravelTime, arrivedCount, maxLoad);
+    updateCharts(frame.tick, avgTravelTime, arrivedCount, maxLoad);
     
     // Update comparison table
-    updateComparisonTable();
+    updateComparisonTable(frame);
 }
 
 void MetricsPanel::updateStatCards(double avgTime, int completed, int maxLoad) {
@@ -483,84 +452,35 @@ void MetricsPanel::updateStatCards(double avgTime, int completed, int maxLoad) {
     }
 }
 
-void MetricsPanel::updateCharts(double avgTime, int completed, int maxLoad) {
-    // Update Trip Time Line Chart
-    int currentTick = m_controller->getMetrics()->getCurrentTick();
-    m_tripTimeData.append(QPointF(currentTick, avgTime));
-    
-    if (m_tripTimeData.size() > MAX_HISTORY) {
-        m_tripTimeData.removeFirst();
+void MetricsPanel::updateCharts(int tick, double avgTime, int completed, int maxLoad) {
+    // One sample per tick; going back in time means a reset or new preset
+    if (tick < m_lastChartTick) {
+        m_tripTimeHistory.clear();
+        m_throughputHistory.clear();
+        m_maxLoadHistory.clear();
+    } else if (tick == m_lastChartTick) {
+        return;
     }
+    m_lastChartTick = tick;
     
-    m_tripTimeSeries->clear();
-    for (const QPointF& point : m_tripTimeData) {
-        m_tripTimeSeries->append(point);
-    }
+    m_tripTimeHistory.append(tick, avgTime);
+    m_throughputHistory.append(tick, completed);
+    m_maxLoadHistory.append(tick, maxLoad);
     
-    // Update axis ranges for trip time
-    if (!m_tripTimeData.isEmpty()) {
-        double maxX = m_tripTimeData.last().x();
-        double maxY = 20;
-        
-        for (const QPointF& point : m_tripTimeData) {
-            maxY = qMax(maxY, point.y());
-        }
-        
-        m_tripTimeAxisY->setRange(0, maxY * 1.1);
-        m_tripTimeAxisX->setRange(qMax(0.0, maxX - 50), qMax(50.0, maxX));
-    }
+    // Update Trip Time Line Chart
+    refreshSeries(m_tripTimeChart, m_tripTimeSeries, m_tripTimeAxisX, m_tripTimeHistory);
+    double maxTime = m_tripTimeHistory.valueRange(m_tripTimeHistory.firstX(), m_tripTimeHistory.lastX()).second;
+    m_tripTimeAxisY->setRange(0, qMax(20.0, maxTime) * 1.1);
     
     // Update Throughput Line Chart
-    static QVector<QPointF> throughputLineData;
-    throughputLineData.append(QPointF(currentTick, completed));
+    refreshSeries(m_throughputChart, m_throughputLineSeries, m_throughputLineAxisX, m_throughputHistory);
+    int maxCompleted = static_cast<int>(m_throughputHistory.valueRange(m_throughputHistory.firstX(), m_throughputHistory.lastX()).second);
+    m_throughputLineAxisY->setRange(0, qMax(10, maxCompleted) + 2);
     
-    if (throughputLineData.size() > MAX_HISTORY) {
-        throughputLineData.removeFirst();
-    }
-    
-    m_throughputLineSeries->clear();
-    for (const QPointF& point : throughputLineData) {
-        m_throughputLineSeries->append(point);
-    }
-    
-    // Update axis ranges for throughput
-    if (!throughputLineData.isEmpty()) {
-        double maxX = throughputLineData.last().x();
-        int maxY = 10;
-        
-        for (const QPointF& point : throughputLineData) {
-            maxY = qMax(maxY, (int)point.y());
-        }
-        
-        m_throughputLineAxisY->setRange(0, maxY + 2);
-        m_throughputLineAxisX->setRange(qMax(0.0, maxX - 50), qMax(50.0, maxX));
-    }
-    
-    // Update Congestion Line Chart  
-    static QVector<QPointF> congestionLineData;
-    congestionLineData.append(QPointF(currentTick, maxLoad));
-    
-    if (congestionLineData.size() > MAX_HISTORY) {
-        congestionLineData.removeFirst();
-    }
-    
-    m_congestionLineSeries->clear();
-    for (const QPointF& point : congestionLineData) {
-        m_congestionLineSeries->append(point);
-    }
-    
-    // Update axis ranges for congestion
-    if (!congestionLineData.isEmpty()) {
-        double maxX = congestionLineData.last().x();
-        int maxY = 10;
-        
-        for (const QPointF& point : congestionLineData) {
-            maxY = qMax(maxY, (int)point.y());
-        }
-        
-        m_congestionLineAxisY->setRange(0, maxY + 2);
-        m_congestionLineAxisX->setRange(qMax(0.0, maxX - 50), qMax(50.0, maxX));
-    }
+    // Update Congestion Line Chart
+    refreshSeries(m_congestionChart, m_congestionLineSeries, m_congestionLineAxisX, m_maxLoadHistory);
+    int peakLoad = static_cast<int>(m_maxLoadHistory.valueRange(m_maxLoadHistory.firstX(), m_maxLoadHistory.lastX()).second);
+    m_congestionLineAxisY->setRange(0, qMax(10, peakLoad) + 2);
     
     // Keep old pie chart code but don't use it (for compatibility)
     Q_UNUSED(m_throughputSeries);
@@ -596,25 +516,28 @@ void MetricsPanel::updateCharts(double avgTime, int completed, int maxLoad) {
     */
 }
 
-void MetricsPanel::updateComparisonTable() {
-    if (!m_controller) return;
-    
-    // Calculate comparison metrics
-    auto& agents = m_controller->getAgents();
-    PolicyType currentPolicy = m_controller->getPolicy();
-    
-    int arrivedCount = 0;
-    int totalTime = 0;
-    int maxLoad = m_controller->getMetrics()->getMaxEdgeLoad();
-    
-    for (Agent* agent : agents) {
-        if (agent && agent->hasArrived()) {
-            arrivedCount++;
-            totalTime += agent->getTravelTime();
-        }
+void MetricsPanel::refreshSeries(QChart* chart, QLineSeries* series, QValueAxis* axisX,
+                                 const TimeSeriesHistory& history) {
+    // Whole run on the x axis (at least 50 ticks), decimated to the plot
+    // width; replace() swaps the points in one go instead of per append
+    double first = history.firstX();
+    double last = qMax(first + 50.0, history.lastX());
+    int width = qMax(50, static_cast<int>(chart->plotArea().width()));
+    
+    QList<QPointF> points;
+    for (const TimeSeriesHistory::Point& point : history.downsample(first, last, width)) {
+        points.append(QPointF(point.x, point.y));
     }
-    
-    double avgTime = arrivedCount > 0 ? static_cast<double>(totalTime) / arrivedCount : 0.0;
+    series->replace(points);
+    axisX->setRange(first, last);
+}
+
+void MetricsPanel::updateComparisonTable(const SimulationFrame& frame) {
+    // Calculate comparison metrics
+    PolicyType currentPolicy = frame.policy;
+    int arrivedCount = frame.arrivedAgents;
+    int maxLoad = frame.maxEdgeLoad;
+    double avgTime = frame.averageTravelTime;
     
     if (currentPolicy == PolicyType::SHORTEST_PATH) {
         m_shortestPathAvgTime = avgTime;
@@ -23,13 +23,14 @@
 #include <QtCharts/QPieSeries>
 #include <QtCharts/QValueAxis>
 #include <QtCharts/QBarCategoryAxis>
+#include "../analytics/TimeSeriesHistory.h"
 
-class SimulationController;
-class Metrics;
+struct SimulationFrame;
 
 /**
  * Professional metrics panel with real-time animated charts.
  * Features: Stat cards, line chart, bar chart, heat map, comparison table.
+ * Fed with SimulationFrames at display rate; never reads the live simulation.
  */
 class MetricsPanel : public QWidget {
     Q_OBJECT
@@ -38,8 +39,7 @@ public:
     explicit MetricsPanel(QWidget* parent = nullptr);
     ~MetricsPanel();
     
-    void setSimulationController(SimulationController* controller);
-    void updateMetrics();
+    void updateMetrics(const SimulationFrame& frame);
 
 private slots:
     void onExportImage();
@@ -53,13 +53,13 @@ private:
     void setupCharts();
     void setupComparisonTable();
     void updateStatCards(double avgTime, int completed, int maxLoad);
-    void updateCharts(double avgTime, int completed, int maxLoad);
-    void updateComparisonTable();
+    void updateCharts(int tick, double avgTime, int completed, int maxLoad);
+    void refreshSeries(QChart* chart, QLineSeries* series, QValueAxis* axisX,
+                       const TimeSeriesHistory& history);
+    void updateComparisonTable(const SimulationFrame& frame);
     void applyChartTheme(QChart* chart);
     QColor getGradientColor(double value, double min, double max) const;
     
-    SimulationController* m_controller;
-    
     // Stat Cards
     QWidget* m_statCardsWidget;
     QLabel* m_avgTimeCard;
@@ -103,11 +103,13 @@ private:
     QPushButton* m_copyButton;
     QPushButton* m_shareButton;
     
-    // Data
-    QVector<QPointF> m_tripTimeData;
+    // Data: whole-run chart histories, drawn at one point per plot pixel
+    TimeSeriesHistory m_tripTimeHistory;
+    TimeSeriesHistory m_throughputHistory;
+    TimeSeriesHistory m_maxLoadHistory;
+    int m_lastChartTick;
     QVector<int> m_throughputData;
     QVector<int> m_congestionLevels; // 0-5 levels
-    static constexpr int MAX_HISTORY = 100;
     static constexpr int INTERVAL_SIZE = 10; // For throughput intervals
     
     // Previous values for trend calculation